@@ -25,6 +25,7 @@
 #include "ns3/ipv4-address-helper.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv4-interface-container.h"
+#include "ns3/mptcp-socket-base.h"
 #include "ns3/node-container.h"
 #include "ns3/node.h"
 #include "ns3/nstime.h"
@@ -261,6 +262,104 @@ BulkSendSeqTsSizeTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_received, 300000, "Received the full 300000 bytes");
 }
 
+/**
+ * \ingroup applications-test
+ * \ingroup tests
+ *
+ * This test checks a transfer over a Multipath TCP connection between two
+ * nodes connected by two links, hence using two subflows.
+ */
+class BulkSendMpTcpTestCase : public TestCase
+{
+  public:
+    BulkSendMpTcpTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Record a packet successfully sent
+     * \param p the packet
+     */
+    void SendTx(Ptr<const Packet> p);
+    /**
+     * Record a packet successfully received
+     * \param p the packet
+     * \param addr the sender's address
+     */
+    void ReceiveRx(Ptr<const Packet> p, const Address& addr);
+    uint64_t m_sent{0};     //!< number of bytes sent
+    uint64_t m_received{0}; //!< number of bytes received
+};
+
+BulkSendMpTcpTestCase::BulkSendMpTcpTestCase()
+    : TestCase("Check a 300KB transfer over Multipath TCP")
+{
+}
+
+void
+BulkSendMpTcpTestCase::SendTx(Ptr<const Packet> p)
+{
+    m_sent += p->GetSize();
+}
+
+void
+BulkSendMpTcpTestCase::ReceiveRx(Ptr<const Packet> p, const Address& addr)
+{
+    m_received += p->GetSize();
+}
+
+void
+BulkSendMpTcpTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetDeviceAttribute("DataRate", StringValue("10Mbps"));
+    simpleHelper.SetChannelAttribute("Delay", StringValue("10ms"));
+    NetDeviceContainer firstDevices = simpleHelper.Install(nodes);
+    NetDeviceContainer secondDevices = simpleHelper.Install(nodes);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer i = ipv4.Assign(firstDevices);
+    ipv4.SetBase("10.1.2.0", "255.255.255.0");
+    ipv4.Assign(secondDevices);
+    uint16_t port = 9;
+    BulkSendHelper sourceHelper("ns3::MpTcpSocketFactory",
+                                InetSocketAddress(i.GetAddress(1), port));
+    sourceHelper.SetAttribute("MaxBytes", UintegerValue(300000));
+    ApplicationContainer sourceApp = sourceHelper.Install(nodes.Get(0));
+    sourceApp.Start(Seconds(0.0));
+    sourceApp.Stop(Seconds(10.0));
+    PacketSinkHelper sinkHelper("ns3::MpTcpSocketFactory",
+                                InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer sinkApp = sinkHelper.Install(nodes.Get(1));
+    sinkApp.Start(Seconds(0.0));
+    sinkApp.Stop(Seconds(10.0));
+
+    Ptr<BulkSendApplication> source = DynamicCast<BulkSendApplication>(sourceApp.Get(0));
+    Ptr<PacketSink> sink = DynamicCast<PacketSink>(sinkApp.Get(0));
+
+    source->TraceConnectWithoutContext("Tx", MakeCallback(&BulkSendMpTcpTestCase::SendTx, this));
+    sink->TraceConnectWithoutContext("Rx", MakeCallback(&BulkSendMpTcpTestCase::ReceiveRx, this));
+
+    uint32_t nSubflows = 0;
+    Simulator::Schedule(Seconds(5), [&]() {
+        for (const auto& socket : sink->GetAcceptedSockets())
+        {
+            nSubflows += DynamicCast<MpTcpSocketBase>(socket)->GetNSubflows();
+        }
+    });
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(m_sent, 300000, "Sent the full 300000 bytes");
+    NS_TEST_ASSERT_MSG_EQ(m_received, 300000, "Received the full 300000 bytes");
+    NS_TEST_ASSERT_MSG_EQ(nSubflows, 2, "The connection did not use both links");
+}
+
 /**
  * \ingroup applications-test
  * \ingroup tests
@@ -278,6 +377,7 @@ BulkSendTestSuite::BulkSendTestSuite()
 {
     AddTestCase(new BulkSendBasicTestCase, TestCase::QUICK);
     AddTestCase(new BulkSendSeqTsSizeTestCase, TestCase::QUICK);
+    AddTestCase(new BulkSendMpTcpTestCase, TestCase::QUICK);
 }
 
 static BulkSendTestSuite g_bulkSendTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,301 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef VAL_ARRAY_H
+#define VAL_ARRAY_H
+
+#include "assert.h"
+
+#include <complex>
+#include <cstddef>
+#include <valarray>
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::ValArray declaration and implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup core
+ *
+ * \brief A 3D array of numbers stored in a single contiguous block of memory.
+ *
+ * The array is made of a number of pages, each page being a matrix with a
+ * number of rows and columns. The elements are stored in column-major order:
+ * the elements of a column are contiguous, the columns of a page are
+ * contiguous and so are the pages. Hence, each page can be processed as a
+ * contiguous matrix, e.g., by loops that the compiler can vectorize, and the
+ * whole array is allocated at once (unlike nested std::vector objects).
+ *
+ * The storage is a std::valarray, which is allocated with the alignment
+ * guaranteed by operator new (which is suitable for SIMD instructions operating
+ * on pairs of doubles). The element type can be any numeric type, e.g.,
+ * std::complex<float> when single precision is enough.
+ *
+ * \tparam T the type of the elements
+ */
+template <class T>
+class ValArray
+{
+  public:
+    ValArray() = default;
+
+    /**
+     * Create an array of the given dimensions whose elements are value-initialized.
+     *
+     * \param numRows the number of rows of each page
+     * \param numCols the number of columns of each page
+     * \param numPages the number of pages
+     */
+    ValArray(std::size_t numRows, std::size_t numCols = 1, std::size_t numPages = 1);
+
+    /**
+     * \return the number of rows of each page
+     */
+    std::size_t GetNumRows() const;
+
+    /**
+     * \return the number of columns of each page
+     */
+    std::size_t GetNumCols() const;
+
+    /**
+     * \return the number of pages
+     */
+    std::size_t GetNumPages() const;
+
+    /**
+     * \return the total number of elements
+     */
+    std::size_t GetSize() const;
+
+    /**
+     * \param rowIndex the row index
+     * \param colIndex the column index
+     * \param pageIndex the page index
+     * \return a reference to the element at the given position
+     */
+    T& operator()(std::size_t rowIndex, std::size_t colIndex, std::size_t pageIndex);
+
+    /**
+     * \param rowIndex the row index
+     * \param colIndex the column index
+     * \param pageIndex the page index
+     * \return a const reference to the element at the given position
+     */
+    const T& operator()(std::size_t rowIndex, std::size_t colIndex, std::size_t pageIndex) const;
+
+    /**
+     * \param rowIndex the row index
+     * \param colIndex the column index
+     * \return a reference to the element at the given position of an array with a single page
+     */
+    T& operator()(std::size_t rowIndex, std::size_t colIndex);
+
+    /**
+     * \param rowIndex the row index
+     * \param colIndex the column index
+     * \return a const reference to the element at the given position of an array with a
+     *         single page
+     */
+    const T& operator()(std::size_t rowIndex, std::size_t colIndex) const;
+
+    /**
+     * \param index the index of the element in the storage order
+     * \return a reference to the element at the given index
+     */
+    T& operator[](std::size_t index);
+
+    /**
+     * \param index the index of the element in the storage order
+     * \return a const reference to the element at the given index
+     */
+    const T& operator[](std::size_t index) const;
+
+    /**
+     * \param pageIndex the page index
+     * \return a pointer to the first element of the given page, whose elements are
+     *         contiguous in column-major order
+     */
+    T* GetPagePtr(std::size_t pageIndex);
+
+    /**
+     * \param pageIndex the page index
+     * \return a const pointer to the first element of the given page, whose elements
+     *         are contiguous in column-major order
+     */
+    const T* GetPagePtr(std::size_t pageIndex) const;
+
+    /**
+     * \param rhs the array to compare with
+     * \return true if the arrays have the same dimensions and elements
+     */
+    bool operator==(const ValArray<T>& rhs) const;
+
+    /**
+     * \param rhs the array to compare with
+     * \return true if the arrays differ in dimensions or elements
+     */
+    bool operator!=(const ValArray<T>& rhs) const;
+
+  private:
+    std::size_t m_numRows{0};  //!< the number of rows of each page
+    std::size_t m_numCols{0};  //!< the number of columns of each page
+    std::size_t m_numPages{0}; //!< the number of pages
+    std::valarray<T> m_values; //!< the elements, in column-major order
+};
+
+/// A 3D array of complex numbers in double precision
+using ComplexValArray = ValArray<std::complex<double>>;
+
+/*************************************************
+ **  Implementation of the templated methods
+ *************************************************/
+
+template <class T>
+ValArray<T>::ValArray(std::size_t numRows, std::size_t numCols, std::size_t numPages)
+    : m_numRows(numRows),
+      m_numCols(numCols),
+      m_numPages(numPages),
+      m_values(numRows * numCols * numPages)
+{
+}
+
+template <class T>
+inline std::size_t
+ValArray<T>::GetNumRows() const
+{
+    return m_numRows;
+}
+
+template <class T>
+inline std::size_t
+ValArray<T>::GetNumCols() const
+{
+    return m_numCols;
+}
+
+template <class T>
+inline std::size_t
+ValArray<T>::GetNumPages() const
+{
+    return m_numPages;
+}
+
+template <class T>
+inline std::size_t
+ValArray<T>::GetSize() const
+{
+    return m_values.size();
+}
+
+template <class T>
+inline T&
+ValArray<T>::operator()(std::size_t rowIndex, std::size_t colIndex, std::size_t pageIndex)
+{
+    NS_ASSERT_MSG(rowIndex < m_numRows && colIndex < m_numCols && pageIndex < m_numPages,
+                  "Index out of bounds");
+    return m_values[rowIndex + m_numRows * (colIndex + m_numCols * pageIndex)];
+}
+
+template <class T>
+inline const T&
+ValArray<T>::operator()(std::size_t rowIndex, std::size_t colIndex, std::size_t pageIndex) const
+{
+    NS_ASSERT_MSG(rowIndex < m_numRows && colIndex < m_numCols && pageIndex < m_numPages,
+                  "Index out of bounds");
+    return m_values[rowIndex + m_numRows * (colIndex + m_numCols * pageIndex)];
+}
+
+template <class T>
+inline T&
+ValArray<T>::operator()(std::size_t rowIndex, std::size_t colIndex)
+{
+    NS_ASSERT_MSG(m_numPages == 1, "The array has more than one page");
+    return (*this)(rowIndex, colIndex, 0);
+}
+
+template <class T>
+inline const T&
+ValArray<T>::operator()(std::size_t rowIndex, std::size_t colIndex) const
+{
+    NS_ASSERT_MSG(m_numPages == 1, "The array has more than one page");
+    return (*this)(rowIndex, colIndex, 0);
+}
+
+template <class T>
+inline T&
+ValArray<T>::operator[](std::size_t index)
+{
+    NS_ASSERT_MSG(index < m_values.size(), "Index out of bounds");
+    return m_values[index];
+}
+
+template <class T>
+inline const T&
+ValArray<T>::operator[](std::size_t index) const
+{
+    NS_ASSERT_MSG(index < m_values.size(), "Index out of bounds");
+    return m_values[index];
+}
+
+template <class T>
+inline T*
+ValArray<T>::GetPagePtr(std::size_t pageIndex)
+{
+    NS_ASSERT_MSG(pageIndex < m_numPages, "Page index out of bounds");
+    return &m_values[m_numRows * m_numCols * pageIndex];
+}
+
+template <class T>
+inline const T*
+ValArray<T>::GetPagePtr(std::size_t pageIndex) const
+{
+    NS_ASSERT_MSG(pageIndex < m_numPages, "Page index out of bounds");
+    return &m_values[m_numRows * m_numCols * pageIndex];
+}
+
+template <class T>
+bool
+ValArray<T>::operator==(const ValArray<T>& rhs) const
+{
+    if (m_numRows != rhs.m_numRows || m_numCols != rhs.m_numCols || m_numPages != rhs.m_numPages)
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < m_values.size(); ++i)
+    {
+        if (m_values[i] != rhs.m_values[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class T>
+inline bool
+ValArray<T>::operator!=(const ValArray<T>& rhs) const
+{
+    return !(*this == rhs);
+}
+
+} // namespace ns3
+
+#endif /* VAL_ARRAY_H */
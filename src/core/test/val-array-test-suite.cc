@@ -0,0 +1,138 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/test.h>
+#include <ns3/val-array.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("ValArrayTest");
+
+/**
+ * \file
+ * \ingroup core-tests
+ * ValArray test suite
+ */
+
+/**
+ * \ingroup core-tests
+ *
+ * \brief ValArray test case checking the layout of the elements
+ *
+ * \tparam T the type of the elements
+ */
+template <class T>
+class ValArrayTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param name the name of the test case
+     */
+    ValArrayTestCase(const std::string& name);
+
+  private:
+    void DoRun() override;
+};
+
+template <class T>
+ValArrayTestCase<T>::ValArrayTestCase(const std::string& name)
+    : TestCase(name)
+{
+}
+
+template <class T>
+void
+ValArrayTestCase<T>::DoRun()
+{
+    const std::size_t numRows = 3;
+    const std::size_t numCols = 4;
+    const std::size_t numPages = 5;
+    ValArray<T> array(numRows, numCols, numPages);
+
+    NS_TEST_ASSERT_MSG_EQ(array.GetNumRows(), numRows, "Unexpected number of rows");
+    NS_TEST_ASSERT_MSG_EQ(array.GetNumCols(), numCols, "Unexpected number of columns");
+    NS_TEST_ASSERT_MSG_EQ(array.GetNumPages(), numPages, "Unexpected number of pages");
+    NS_TEST_ASSERT_MSG_EQ(array.GetSize(), numRows * numCols * numPages, "Unexpected size");
+    for (std::size_t i = 0; i < array.GetSize(); ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ((array[i] == T()), true, "Elements must be value-initialized");
+    }
+
+    for (std::size_t p = 0; p < numPages; ++p)
+    {
+        for (std::size_t c = 0; c < numCols; ++c)
+        {
+            for (std::size_t r = 0; r < numRows; ++r)
+            {
+                array(r, c, p) = T(100 * p + 10 * c + r);
+            }
+        }
+    }
+
+    // the elements are stored in column-major order and pages are contiguous
+    std::size_t index = 0;
+    for (std::size_t p = 0; p < numPages; ++p)
+    {
+        const T* page = array.GetPagePtr(p);
+        NS_TEST_ASSERT_MSG_EQ((page == &array[index]), true, "Pages must be contiguous");
+        for (std::size_t c = 0; c < numCols; ++c)
+        {
+            for (std::size_t r = 0; r < numRows; ++r)
+            {
+                NS_TEST_ASSERT_MSG_EQ((array[index] == T(100 * p + 10 * c + r)),
+                                      true,
+                                      "Unexpected element at index " << index);
+                NS_TEST_ASSERT_MSG_EQ((page[r + numRows * c] == array(r, c, p)),
+                                      true,
+                                      "Unexpected element in page " << p);
+                ++index;
+            }
+        }
+    }
+
+    ValArray<T> copy = array;
+    NS_TEST_ASSERT_MSG_EQ((copy == array), true, "Copies must be equal");
+    copy(1, 2, 3) = T(-1);
+    NS_TEST_ASSERT_MSG_EQ((copy != array), true, "Arrays with different elements are equal");
+    NS_TEST_ASSERT_MSG_EQ((ValArray<T>(numRows * numCols, 1, numPages) != array),
+                          true,
+                          "Arrays with different dimensions are equal");
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * \brief ValArray test suite
+ */
+class ValArrayTestSuite : public TestSuite
+{
+  public:
+    ValArrayTestSuite();
+};
+
+ValArrayTestSuite::ValArrayTestSuite()
+    : TestSuite("val-array-test", UNIT)
+{
+    AddTestCase(new ValArrayTestCase<double>("ValArray<double>"), TestCase::QUICK);
+    AddTestCase(new ValArrayTestCase<std::complex<float>>("ValArray<std::complex<float>>"),
+                TestCase::QUICK);
+    AddTestCase(new ValArrayTestCase<std::complex<double>>("ValArray<std::complex<double>>"),
+                TestCase::QUICK);
+}
+
+static ValArrayTestSuite g_valArrayTestSuite; //!< Static variable for test initialization
@@ -38,6 +38,7 @@
 #include "ns3/ipv6-static-routing-helper.h"
 #include "ns3/ipv6.h"
 #include "ns3/log.h"
+#include "ns3/mptcp-socket-factory.h"
 #include "ns3/names.h"
 #include "ns3/net-device.h"
 #include "ns3/node-list.h"
@@ -263,6 +264,15 @@ InternetStackHelper::AssignStreams(NodeContainer c, int64_t stream)
             }
         }
     }
+    // after the streams above, so that their numbers are unchanged
+    for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i)
+    {
+        Ptr<MpTcpSocketFactory> mptcpFactory = (*i)->GetObject<MpTcpSocketFactory>();
+        if (mptcpFactory)
+        {
+            currentStream += mptcpFactory->AssignStreams(currentStream);
+        }
+    }
     return (currentStream - stream);
 }
 
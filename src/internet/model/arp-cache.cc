@@ -31,6 +31,8 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -198,39 +200,42 @@ void
 ArpCache::HandleWaitReplyTimeout()
 {
     NS_LOG_FUNCTION(this);
-    ArpCache::Entry* entry;
     bool restartWaitReplyTimer = false;
-    for (CacheI i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // Only the entries waiting for a reply are visited; they are copied first
+    // because marking an entry dead removes it from m_waitReplyEntries
+    std::vector<ArpCache::Entry*> waitReplyEntries;
+    waitReplyEntries.reserve(m_waitReplyEntries.size());
+    for (const auto& waiting : m_waitReplyEntries)
+    {
+        waitReplyEntries.push_back(waiting.second);
+    }
+    for (ArpCache::Entry* entry : waitReplyEntries)
     {
-        entry = (*i).second;
-        if (entry != nullptr && entry->IsWaitReply())
+        if (entry->GetRetries() < m_maxRetries)
         {
-            if (entry->GetRetries() < m_maxRetries)
-            {
-                NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", ArpWaitTimeout for "
-                                     << entry->GetIpv4Address()
-                                     << " expired -- retransmitting arp request since retries = "
-                                     << entry->GetRetries());
-                m_arpRequestCallback(this, entry->GetIpv4Address());
-                restartWaitReplyTimer = true;
-                entry->IncrementRetries();
-            }
-            else
+            NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", ArpWaitTimeout for "
+                                 << entry->GetIpv4Address()
+                                 << " expired -- retransmitting arp request since retries = "
+                                 << entry->GetRetries());
+            m_arpRequestCallback(this, entry->GetIpv4Address());
+            restartWaitReplyTimer = true;
+            entry->IncrementRetries();
+        }
+        else
+        {
+            NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", wait reply for "
+                                 << entry->GetIpv4Address()
+                                 << " expired -- drop since max retries exceeded: "
+                                 << entry->GetRetries());
+            entry->MarkDead();
+            entry->ClearRetries();
+            Ipv4PayloadHeaderPair pending = entry->DequeuePending();
+            while (pending.first)
             {
-                NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", wait reply for "
-                                     << entry->GetIpv4Address()
-                                     << " expired -- drop since max retries exceeded: "
-                                     << entry->GetRetries());
-                entry->MarkDead();
-                entry->ClearRetries();
-                Ipv4PayloadHeaderPair pending = entry->DequeuePending();
-                while (pending.first)
-                {
-                    // add the Ipv4 header for tracing purposes
-                    pending.first->AddHeader(pending.second);
-                    m_dropTrace(pending.first);
-                    pending = entry->DequeuePending();
-                }
+                // add the Ipv4 header for tracing purposes
+                pending.first->AddHeader(pending.second);
+                m_dropTrace(pending.first);
+                pending = entry->DequeuePending();
             }
         }
     }
@@ -250,7 +255,10 @@ ArpCache::Flush()
     {
         delete (*i).second;
     }
-    m_arpCache.erase(m_arpCache.begin(), m_arpCache.end());
+    m_arpCache.clear();
+    m_macIndex.clear();
+    m_waitReplyEntries.clear();
+    m_pendingPool.clear();
     if (m_waitReplyTimer.IsRunning())
     {
         NS_LOG_LOGIC("Stopping WaitReplyTimer at " << Simulator::Now().GetSeconds()
@@ -265,7 +273,9 @@ ArpCache::PrintArpCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (CacheI i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // the entries are printed sorted by IPv4 address
+    std::map<Ipv4Address, ArpCache::Entry*> sortedCache(m_arpCache.begin(), m_arpCache.end());
+    for (auto i = sortedCache.begin(); i != sortedCache.end(); i++)
     {
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
@@ -311,9 +321,9 @@ ArpCache::RemoveAutoGeneratedEntries()
     {
         if (i->second->IsAutoGenerated())
         {
-            i->second->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
+            Unlink(i->second); // clear the pending packets for entry's ipaddress
             delete i->second;
-            m_arpCache.erase(i++);
+            i = m_arpCache.erase(i);
             continue;
         }
         i++;
@@ -326,13 +336,10 @@ ArpCache::LookupInverse(Address to)
     NS_LOG_FUNCTION(this << to);
 
     std::list<ArpCache::Entry*> entryList;
-    for (CacheI i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    auto range = m_macIndex.equal_range(to);
+    for (auto i = range.first; i != range.second; i++)
     {
-        ArpCache::Entry* entry = (*i).second;
-        if (entry->GetMacAddress() == to)
-        {
-            entryList.push_back(entry);
-        }
+        entryList.push_back(i->second);
     }
     return entryList;
 }
@@ -366,17 +373,61 @@ ArpCache::Remove(ArpCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (CacheI i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    CacheI i = m_arpCache.find(entry->GetIpv4Address());
+    if (i != m_arpCache.end() && i->second == entry)
     {
-        if ((*i).second == entry)
+        m_arpCache.erase(i);
+        Unlink(entry); // clear the pending packets for entry's ipaddress
+        delete entry;
+        return;
+    }
+    NS_LOG_WARN("Entry not found in this ARP Cache");
+}
+
+void
+ArpCache::UpdateMacIndex(ArpCache::Entry* entry, const Address& oldMac)
+{
+    NS_LOG_FUNCTION(this << entry << oldMac);
+    const Address& newMac = entry->GetMacAddress();
+    if (!oldMac.IsInvalid())
+    {
+        if (oldMac == newMac)
         {
-            m_arpCache.erase(i);
-            entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
-            delete entry;
+            return;
+        }
+        RemoveFromMacIndex(entry, oldMac);
+    }
+    if (!newMac.IsInvalid())
+    {
+        m_macIndex.emplace(newMac, entry);
+    }
+}
+
+void
+ArpCache::RemoveFromMacIndex(ArpCache::Entry* entry, const Address& mac)
+{
+    NS_LOG_FUNCTION(this << entry << mac);
+    auto range = m_macIndex.equal_range(mac);
+    for (auto i = range.first; i != range.second; i++)
+    {
+        if (i->second == entry)
+        {
+            m_macIndex.erase(i);
             return;
         }
     }
-    NS_LOG_WARN("Entry not found in this ARP Cache");
+}
+
+void
+ArpCache::Unlink(ArpCache::Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    if (!entry->GetMacAddress().IsInvalid())
+    {
+        RemoveFromMacIndex(entry, entry->GetMacAddress());
+    }
+    m_waitReplyEntries.erase(entry->GetIpv4Address());
+    entry->ClearPendingPacket();
 }
 
 ArpCache::Entry::Entry(ArpCache* arp)
@@ -427,7 +478,7 @@ ArpCache::Entry::MarkDead()
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(m_state == ALIVE || m_state == WAIT_REPLY || m_state == DEAD);
-    m_state = DEAD;
+    SetState(DEAD);
     ClearRetries();
     UpdateSeen();
 }
@@ -437,8 +488,8 @@ ArpCache::Entry::MarkAlive(Address macAddress)
 {
     NS_LOG_FUNCTION(this << macAddress);
     NS_ASSERT(m_state == WAIT_REPLY);
-    m_macAddress = macAddress;
-    m_state = ALIVE;
+    SetMacAddress(macAddress);
+    SetState(ALIVE);
     ClearRetries();
     UpdateSeen();
 }
@@ -449,7 +500,7 @@ ArpCache::Entry::MarkPermanent()
     NS_LOG_FUNCTION(this << m_macAddress);
     NS_ASSERT(!m_macAddress.IsInvalid());
 
-    m_state = PERMANENT;
+    SetState(PERMANENT);
     ClearRetries();
     UpdateSeen();
 }
@@ -460,7 +511,7 @@ ArpCache::Entry::MarkAutoGenerated()
     NS_LOG_FUNCTION(this << m_macAddress);
     NS_ASSERT(!m_macAddress.IsInvalid());
 
-    m_state = STATIC_AUTOGENERATED;
+    SetState(STATIC_AUTOGENERATED);
     ClearRetries();
     UpdateSeen();
 }
@@ -478,7 +529,7 @@ ArpCache::Entry::UpdateWaitReply(Ipv4PayloadHeaderPair waiting)
     {
         return false;
     }
-    m_pending.push_back(waiting);
+    EnqueuePending(waiting);
     return true;
 }
 
@@ -490,8 +541,8 @@ ArpCache::Entry::MarkWaitReply(Ipv4PayloadHeaderPair waiting)
     NS_ASSERT(m_pending.empty());
     NS_ASSERT_MSG(waiting.first, "Can not add a null packet to the ARP queue");
 
-    m_state = WAIT_REPLY;
-    m_pending.push_back(waiting);
+    SetState(WAIT_REPLY);
+    EnqueuePending(waiting);
     UpdateSeen();
     m_arp->StartWaitReplyTimer();
 }
@@ -507,7 +558,9 @@ void
 ArpCache::Entry::SetMacAddress(Address macAddress)
 {
     NS_LOG_FUNCTION(this);
+    Address oldMac = m_macAddress;
     m_macAddress = macAddress;
+    m_arp->UpdateMacIndex(this, oldMac);
 }
 
 Ipv4Address
@@ -570,16 +623,50 @@ ArpCache::Entry::DequeuePending()
     else
     {
         Ipv4PayloadHeaderPair p = m_pending.front();
-        m_pending.pop_front();
+        // give the list node back to the pool, without holding the packet
+        m_pending.front().first = nullptr;
+        m_arp->m_pendingPool.splice(m_arp->m_pendingPool.end(), m_pending, m_pending.begin());
         return p;
     }
 }
 
+void
+ArpCache::Entry::EnqueuePending(const Ipv4PayloadHeaderPair& waiting)
+{
+    NS_LOG_FUNCTION(this << waiting.first);
+    if (m_arp->m_pendingPool.empty())
+    {
+        m_pending.push_back(waiting);
+        return;
+    }
+    m_pending.splice(m_pending.end(), m_arp->m_pendingPool, m_arp->m_pendingPool.begin());
+    m_pending.back() = waiting;
+}
+
 void
 ArpCache::Entry::ClearPendingPacket()
 {
     NS_LOG_FUNCTION(this);
-    m_pending.clear();
+    for (auto& pending : m_pending)
+    {
+        pending.first = nullptr;
+    }
+    m_arp->m_pendingPool.splice(m_arp->m_pendingPool.end(), m_pending);
+}
+
+void
+ArpCache::Entry::SetState(ArpCacheEntryState_e state)
+{
+    NS_LOG_FUNCTION(this << state);
+    if (m_state == WAIT_REPLY && state != WAIT_REPLY)
+    {
+        m_arp->m_waitReplyEntries.erase(m_ipv4Address);
+    }
+    else if (m_state != WAIT_REPLY && state == WAIT_REPLY)
+    {
+        m_arp->m_waitReplyEntries[m_ipv4Address] = this;
+    }
+    m_state = state;
 }
 
 void
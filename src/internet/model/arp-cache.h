@@ -34,6 +34,7 @@
 #include <list>
 #include <map>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -308,6 +309,19 @@ class ArpCache : public Object
          */
         Time GetTimeout() const;
 
+        /**
+         * \brief Append a packet to the pending queue, reusing a list node
+         * from the pool of the owning cache if possible
+         * \param waiting the packet and its IPv4 header
+         */
+        void EnqueuePending(const Ipv4PayloadHeaderPair& waiting);
+        /**
+         * \brief Change the entry state, keeping track of the entries
+         * waiting for a reply in the owning cache
+         * \param state the new state
+         */
+        void SetState(ArpCacheEntryState_e state);
+
         ArpCache* m_arp;              //!< pointer to the ARP cache owning the entry
         ArpCacheEntryState_e m_state; //!< state of the entry
         Time m_lastSeen;              //!< last moment a packet from that address has been seen
@@ -321,14 +335,37 @@ class ArpCache : public Object
     /**
      * \brief ARP Cache container
      */
-    typedef std::map<Ipv4Address, ArpCache::Entry*> Cache;
+    typedef std::unordered_map<Ipv4Address, ArpCache::Entry*, Ipv4AddressHash> Cache;
     /**
      * \brief ARP Cache container iterator
      */
-    typedef std::map<Ipv4Address, ArpCache::Entry*>::iterator CacheI;
+    typedef Cache::iterator CacheI;
+    /**
+     * \brief Reverse index from MAC address to the entries resolved to it
+     */
+    typedef std::unordered_multimap<Address, ArpCache::Entry*, AddressHash> MacIndex;
 
     void DoDispose() override;
 
+    /**
+     * \brief Update the reverse index after the MAC address of an entry changed
+     * \param entry the entry
+     * \param oldMac the MAC address previously associated with the entry
+     */
+    void UpdateMacIndex(ArpCache::Entry* entry, const Address& oldMac);
+    /**
+     * \brief Remove an entry from the reverse index
+     * \param entry the entry
+     * \param mac the MAC address under which the entry is indexed
+     */
+    void RemoveFromMacIndex(ArpCache::Entry* entry, const Address& mac);
+    /**
+     * \brief Remove an entry from all the indexes and release its pending
+     * packets, before the entry is deleted
+     * \param entry the entry
+     */
+    void Unlink(ArpCache::Entry* entry);
+
     Ptr<NetDevice> m_device;        //!< NetDevice associated with the cache
     Ptr<Ipv4Interface> m_interface; //!< Ipv4Interface associated with the cache
     Time m_aliveTimeout;            //!< cache alive state timeout
@@ -347,6 +384,11 @@ class ArpCache : public Object
     void HandleWaitReplyTimeout();
     uint32_t m_pendingQueueSize; //!< number of packets waiting for a resolution
     Cache m_arpCache;            //!< the ARP cache
+    MacIndex m_macIndex;         //!< entries indexed by MAC address
+    std::map<Ipv4Address, ArpCache::Entry*>
+        m_waitReplyEntries; //!< entries in WAIT_REPLY state, scanned on WaitReplyTimeout
+    std::list<Ipv4PayloadHeaderPair>
+        m_pendingPool; //!< recycled list nodes for the pending packet queues of the entries
     TracedCallback<Ptr<const Packet>>
         m_dropTrace; //!< trace for packets dropped by the ARP cache queue
 };
@@ -326,6 +326,17 @@ SPFVertex::GetRootExitDirection() const
     return GetRootExitDirection(0);
 }
 
+void
+SPFVertex::AddRootExitDirection(Ipv4Address nextHop, int32_t id)
+{
+    NS_LOG_FUNCTION(this << nextHop << id);
+    NodeExit_t exit(nextHop, id);
+    if (std::find(m_ecmpRootExits.begin(), m_ecmpRootExits.end(), exit) == m_ecmpRootExits.end())
+    {
+        m_ecmpRootExits.push_back(exit);
+    }
+}
+
 void
 SPFVertex::MergeRootExitDirections(const SPFVertex* vertex)
 {
@@ -1104,6 +1115,7 @@ GlobalRouteManagerImpl::SPFNexthopCalculation(SPFVertex* v,
             // examining the destination's router-LSA...
             NS_ASSERT(w->GetVertexType() == SPFVertex::VertexRouter);
             GlobalRoutingLinkRecord* linkRemote = nullptr;
+            bool firstExit = true;
             while ((linkRemote = SPFGetNextLink(w, v, linkRemote)))
             {
                 /* ...For each link in the router-LSA that points back to the
@@ -1114,7 +1126,16 @@ GlobalRouteManagerImpl::SPFNexthopCalculation(SPFVertex* v,
                  */
                 Ipv4Address nextHop = linkRemote->GetLinkData();
                 uint32_t outIf = v->GetRootExitDirection().second;
-                w->SetRootExitDirection(nextHop, outIf);
+                // keep all the next hops, they are equal-cost paths
+                if (firstExit)
+                {
+                    w->SetRootExitDirection(nextHop, outIf);
+                    firstExit = false;
+                }
+                else
+                {
+                    w->AddRootExitDirection(nextHop, outIf);
+                }
                 NS_LOG_LOGIC("Next hop from " << v->GetVertexId() << " to " << w->GetVertexId()
                                               << " goes through next hop " << nextHop
                                               << " via outgoing interface " << outIf);
@@ -1122,7 +1143,8 @@ GlobalRouteManagerImpl::SPFNexthopCalculation(SPFVertex* v,
         }
         else
         {
-            w->SetRootExitDirection(v->GetRootExitDirection());
+            // the network may be reached through several equal-cost paths
+            w->InheritAllRootExitDirections(v);
         }
     }
     else
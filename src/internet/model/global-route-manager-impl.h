@@ -357,6 +357,16 @@ class SPFVertex
      * 'this' vertex from the root
      */
     NodeExit_t GetRootExitDirection() const;
+    /**
+     * \brief Add an exit direction from the root to the ones already known
+     *
+     * This is necessary when several equal-cost next hops are found at once,
+     * e.g., several links of a router to the same network.
+     *
+     * \param nextHop The next hop IP address
+     * \param id The outgoing interface index
+     */
+    void AddRootExitDirection(Ipv4Address nextHop, int32_t id);
     /**
      * \brief Merge into 'this' vertex the list of exit directions from
      * another vertex
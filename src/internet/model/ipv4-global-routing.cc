@@ -19,7 +19,9 @@
 
 #include "global-route-manager.h"
 
+#include "ns3/abort.h"
 #include "ns3/boolean.h"
+#include "ns3/enum.h"
 #include "ns3/ipv4-route.h"
 #include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/log.h"
@@ -29,8 +31,11 @@
 #include "ns3/object.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/tcp-l4-protocol.h"
+#include "ns3/udp-l4-protocol.h"
 
 #include <iomanip>
+#include <limits>
 #include <vector>
 
 namespace ns3
@@ -53,6 +58,25 @@ Ipv4GlobalRouting::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(&Ipv4GlobalRouting::m_randomEcmpRouting),
                           MakeBooleanChecker())
+            .AddAttribute("EcmpMode",
+                          "How packets are spread among equal-cost routes. The Random mode is "
+                          "also used if EcmpMode is None and RandomEcmpRouting is true",
+                          EnumValue(Ipv4GlobalRouting::ECMP_NONE),
+                          MakeEnumAccessor(&Ipv4GlobalRouting::m_ecmpMode),
+                          MakeEnumChecker(Ipv4GlobalRouting::ECMP_NONE,
+                                          "None",
+                                          Ipv4GlobalRouting::ECMP_RANDOM,
+                                          "Random",
+                                          Ipv4GlobalRouting::ECMP_FLOW_HASH,
+                                          "FlowHash",
+                                          Ipv4GlobalRouting::ECMP_FLOWLET,
+                                          "Flowlet"))
+            .AddAttribute("FlowletGap",
+                          "Minimum pause between two packets of a flow that starts a new flowlet "
+                          "(Flowlet mode only)",
+                          TimeValue(MicroSeconds(500)),
+                          MakeTimeAccessor(&Ipv4GlobalRouting::m_flowletGap),
+                          MakeTimeChecker())
             .AddAttribute("RespondToInterfaceEvents",
                           "Set to true if you want to dynamically recompute the global routes upon "
                           "Interface notification events (up/down, or add/remove address)",
@@ -64,7 +88,9 @@ Ipv4GlobalRouting::GetTypeId()
 
 Ipv4GlobalRouting::Ipv4GlobalRouting()
     : m_randomEcmpRouting(false),
-      m_respondToInterfaceEvents(false)
+      m_ecmpMode(ECMP_NONE),
+      m_respondToInterfaceEvents(false),
+      m_hasher(Create<Hash::Function::Murmur3>())
 {
     NS_LOG_FUNCTION(this);
 
@@ -128,8 +154,12 @@ Ipv4GlobalRouting::AddASExternalRouteTo(Ipv4Address network,
 }
 
 Ptr<Ipv4Route>
-Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
+Ipv4GlobalRouting::LookupGlobal(const Ipv4Header& header,
+                                Ptr<const Packet> p,
+                                bool usePorts,
+                                Ptr<NetDevice> oif)
 {
+    Ipv4Address dest = header.GetDestination();
     NS_LOG_FUNCTION(this << dest << oif);
     NS_LOG_LOGIC("Looking for route for destination " << dest);
     Ptr<Ipv4Route> rtentry = nullptr;
@@ -158,6 +188,10 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     if (allRoutes.size() == 0) // if no host route is found
     {
         NS_LOG_LOGIC("Number of m_networkRoutes" << m_networkRoutes.size());
+        // with the EcmpMode attribute, only the routes with the longest
+        // matching prefix are equal-cost routes
+        bool longestPrefixOnly = m_ecmpMode != ECMP_NONE;
+        uint16_t longestPrefix = 0;
         for (NetworkRoutesI j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
         {
             Ipv4Mask mask = (*j)->GetDestNetworkMask();
@@ -172,6 +206,16 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
                         continue;
                     }
                 }
+                uint16_t prefix = mask.GetPrefixLength();
+                if (longestPrefixOnly && !allRoutes.empty() && prefix < longestPrefix)
+                {
+                    continue;
+                }
+                if (longestPrefixOnly && prefix > longestPrefix)
+                {
+                    allRoutes.clear();
+                    longestPrefix = prefix;
+                }
                 allRoutes.push_back(*j);
                 NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << *j);
             }
@@ -201,17 +245,10 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     }
     if (allRoutes.size() > 0) // if route(s) is found
     {
-        // pick up one of the routes uniformly at random if random
-        // ECMP routing is enabled, or always select the first route
-        // consistently if random ECMP routing is disabled
-        uint32_t selectIndex;
-        if (m_randomEcmpRouting)
-        {
-            selectIndex = m_rand->GetInteger(0, allRoutes.size() - 1);
-        }
-        else
+        uint32_t selectIndex = 0;
+        if (allRoutes.size() > 1)
         {
-            selectIndex = 0;
+            selectIndex = SelectRoute(allRoutes, header, p, usePorts);
         }
         Ipv4RoutingTableEntry* route = allRoutes.at(selectIndex);
         // create a Ipv4Route object from the selected routing table entry
@@ -230,6 +267,131 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     }
 }
 
+uint32_t
+Ipv4GlobalRouting::SelectRoute(const std::vector<Ipv4RoutingTableEntry*>& routes,
+                               const Ipv4Header& header,
+                               Ptr<const Packet> p,
+                               bool usePorts)
+{
+    NS_LOG_FUNCTION(this << routes.size() << usePorts);
+
+    EcmpMode mode = m_ecmpMode;
+    if (mode == ECMP_NONE && m_randomEcmpRouting)
+    {
+        mode = ECMP_RANDOM;
+    }
+    if (mode == ECMP_NONE)
+    {
+        // always select the first route consistently
+        return 0;
+    }
+
+    // WCMP weights of the routes; if all of them are zero, use equal weights
+    std::vector<uint32_t> weights;
+    weights.reserve(routes.size());
+    uint64_t totalWeight = 0;
+    for (const auto route : routes)
+    {
+        weights.push_back(GetInterfaceWeight(route->GetInterface()));
+        totalWeight += weights.back();
+    }
+    if (totalWeight == 0)
+    {
+        weights.assign(routes.size(), 1);
+        totalWeight = routes.size();
+    }
+    NS_ABORT_MSG_IF(totalWeight > std::numeric_limits<uint32_t>::max(),
+                    "The sum of the ECMP weights overflows");
+
+    uint32_t value = 0;
+    if (mode == ECMP_RANDOM)
+    {
+        // pick up one of the routes at random
+        value = m_rand->GetInteger(0, totalWeight - 1);
+    }
+    else if (mode == ECMP_FLOW_HASH)
+    {
+        value = GetFlowHash(header, p, usePorts) % totalWeight;
+    }
+    else
+    {
+        NS_ASSERT(mode == ECMP_FLOWLET);
+        Time now = Simulator::Now();
+        if (now - m_lastFlowletSweep > m_flowletGap)
+        {
+            // forget the flowlets that ended
+            for (auto it = m_flowlets.begin(); it != m_flowlets.end();)
+            {
+                it = (now - it->second.lastSeen > m_flowletGap) ? m_flowlets.erase(it) : ++it;
+            }
+            m_lastFlowletSweep = now;
+        }
+
+        auto [it, isNew] = m_flowlets.try_emplace(GetFlowHash(header, p, usePorts));
+        Flowlet& flowlet = it->second;
+        if (isNew || now - flowlet.lastSeen > m_flowletGap || flowlet.choice >= totalWeight)
+        {
+            // new flowlet, draw its path
+            flowlet.choice = m_rand->GetInteger(0, totalWeight - 1);
+            NS_LOG_LOGIC("New flowlet " << it->first << " with choice " << flowlet.choice);
+        }
+        flowlet.lastSeen = now;
+        value = flowlet.choice;
+    }
+
+    for (uint32_t i = 0; i < routes.size(); ++i)
+    {
+        if (value < weights[i])
+        {
+            return i;
+        }
+        value -= weights[i];
+    }
+    NS_ASSERT_MSG(false, "Weighted ECMP selection out of range");
+    return 0;
+}
+
+uint32_t
+Ipv4GlobalRouting::GetFlowHash(const Ipv4Header& header, Ptr<const Packet> p, bool usePorts) const
+{
+    // source, destination, protocol, ports and node ID
+    uint8_t buf[17] = {0};
+    header.GetSource().Serialize(buf);
+    header.GetDestination().Serialize(buf + 4);
+    uint8_t protocol = header.GetProtocol();
+    buf[8] = protocol;
+    // ports are only present in the first fragment; use them for unfragmented packets only
+    if (usePorts && p && p->GetSize() >= 4 && header.IsLastFragment() &&
+        header.GetFragmentOffset() == 0 &&
+        (protocol == TcpL4Protocol::PROT_NUMBER || protocol == UdpL4Protocol::PROT_NUMBER))
+    {
+        p->CopyData(buf + 9, 4);
+    }
+    uint32_t nodeId = m_ipv4->GetObject<Node>()->GetId();
+    buf[13] = nodeId >> 24;
+    buf[14] = nodeId >> 16;
+    buf[15] = nodeId >> 8;
+    buf[16] = nodeId;
+    return m_hasher.clear().GetHash32(reinterpret_cast<const char*>(buf), sizeof(buf));
+}
+
+void
+Ipv4GlobalRouting::SetInterfaceWeight(uint32_t interface, uint32_t weight)
+{
+    NS_LOG_FUNCTION(this << interface << weight);
+    if (interface >= m_interfaceWeights.size())
+    {
+        m_interfaceWeights.resize(interface + 1, 1);
+    }
+    m_interfaceWeights[interface] = weight;
+}
+
+uint32_t
+Ipv4GlobalRouting::GetInterfaceWeight(uint32_t interface) const
+{
+    return interface < m_interfaceWeights.size() ? m_interfaceWeights[interface] : 1;
+}
+
 uint32_t
 Ipv4GlobalRouting::GetNRoutes() const
 {
@@ -365,6 +527,7 @@ Ipv4GlobalRouting::DoDispose()
     {
         delete (*l);
     }
+    m_flowlets.clear();
 
     Ipv4RoutingProtocol::DoDispose();
 }
@@ -457,7 +620,9 @@ Ipv4GlobalRouting::RouteOutput(Ptr<Packet> p,
     // See if this is a unicast packet we have a route for.
     //
     NS_LOG_LOGIC("Unicast destination- looking up");
-    Ptr<Ipv4Route> rtentry = LookupGlobal(header.GetDestination(), oif);
+    // the TCP segments already carry their header, unlike the UDP datagrams
+    bool usePorts = header.GetProtocol() == TcpL4Protocol::PROT_NUMBER;
+    Ptr<Ipv4Route> rtentry = LookupGlobal(header, p, usePorts, oif);
     if (rtentry)
     {
         sockerr = Socket::ERROR_NOTERROR;
@@ -512,7 +677,7 @@ Ipv4GlobalRouting::RouteInput(Ptr<const Packet> p,
     }
     // Next, try to find a route
     NS_LOG_LOGIC("Unicast destination- looking up global route");
-    Ptr<Ipv4Route> rtentry = LookupGlobal(header.GetDestination());
+    Ptr<Ipv4Route> rtentry = LookupGlobal(header, p, true);
     if (rtentry)
     {
         NS_LOG_LOGIC("Found unicast destination- calling unicast callback");
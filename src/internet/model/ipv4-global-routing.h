@@ -19,15 +19,19 @@
 #ifndef IPV4_GLOBAL_ROUTING_H
 #define IPV4_GLOBAL_ROUTING_H
 
+#include "ns3/hash.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv4-header.h"
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/ipv4.h"
+#include "ns3/nstime.h"
 #include "ns3/ptr.h"
 #include "ns3/random-variable-stream.h"
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -65,6 +69,27 @@ class Node;
  *
  * This class deals with Ipv4 unicast routes only.
  *
+ * When several routes lead to the destination, i.e., when the
+ * GlobalRouteManager found equal-cost paths, the EcmpMode attribute selects
+ * how packets are spread among them (except with None, only among the
+ * network routes of the longest matching prefix):
+ *  - None: the first route is always used;
+ *  - Random: a route is drawn for each packet (packets of a flow may be
+ *    reordered);
+ *  - FlowHash: a route is selected by a Murmur3 hash of the 5-tuple of the
+ *    packet (addresses, protocol and, for the first fragment of TCP and UDP
+ *    packets, ports), so that all the packets of a flow follow the same path;
+ *  - Flowlet: the packets of a flow follow the same path as long as they are
+ *    separated by less than FlowletGap; after a longer pause, the next burst
+ *    (flowlet) is sent on a path drawn at random.
+ *
+ * Routes are weighted by the weight of their output interface (see
+ * SetInterfaceWeight), which allows WCMP; all weights are 1 by default.
+ * The node ID is part of the hashed data, so that the routers on the path
+ * of a flow take independent decisions. The UDP packets sent by the node
+ * itself are hashed on their addresses and protocol only, as their header is
+ * added after RouteOutput is called.
+ *
  * \see Ipv4RoutingProtocol
  * \see GlobalRouteManager
  */
@@ -76,6 +101,16 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      * \return the object TypeId
      */
     static TypeId GetTypeId();
+
+    /// How packets are spread among equal-cost routes
+    enum EcmpMode
+    {
+        ECMP_NONE,      //!< Always use the first route
+        ECMP_RANDOM,    //!< Select a route at random for each packet
+        ECMP_FLOW_HASH, //!< Select a route by hashing the 5-tuple of the packet
+        ECMP_FLOWLET    //!< Select a route at random for each flowlet
+    };
+
     /**
      * \brief Construct an empty Ipv4GlobalRouting routing protocol,
      *
@@ -231,6 +266,26 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      */
     int64_t AssignStreams(int64_t stream);
 
+    /**
+     * \brief Set the WCMP weight of the routes through an interface
+     *
+     * When several equal-cost routes lead to a destination, each one is
+     * selected with a probability proportional to the weight of its output
+     * interface. A weight of zero excludes the interface, unless all the
+     * candidate routes have a zero weight.
+     *
+     * \param interface the interface index
+     * \param weight the weight of the interface
+     */
+    void SetInterfaceWeight(uint32_t interface, uint32_t weight);
+
+    /**
+     * \brief Get the WCMP weight of the routes through an interface
+     * \param interface the interface index
+     * \return the weight of the interface (1 unless set)
+     */
+    uint32_t GetInterfaceWeight(uint32_t interface) const;
+
   protected:
     void DoDispose() override;
 
@@ -238,11 +293,31 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     /// Set to true if packets are randomly routed among ECMP; set to false for using only one route
     /// consistently
     bool m_randomEcmpRouting;
+    /// How packets are spread among equal-cost routes
+    EcmpMode m_ecmpMode;
+    /// Minimum pause between the packets of a flow that starts a new flowlet
+    Time m_flowletGap;
     /// Set to true if this interface should respond to interface events by globallly recomputing
     /// routes
     bool m_respondToInterfaceEvents;
     /// A uniform random number generator for randomly routing packets among ECMP
     Ptr<UniformRandomVariable> m_rand;
+    /// WCMP weights of the interfaces, by interface index
+    std::vector<uint32_t> m_interfaceWeights;
+
+    /// State of the flowlet of a flow
+    struct Flowlet
+    {
+        Time lastSeen;   //!< Time of the last packet of the flow
+        uint32_t choice; //!< Index of the route used by the current flowlet
+    };
+
+    /// Flowlets, by hash of the 5-tuple of the flow
+    std::unordered_map<uint32_t, Flowlet> m_flowlets;
+    /// Time of the last removal of the expired flowlets
+    Time m_lastFlowletSweep;
+    /// Murmur3 hasher of the 5-tuples
+    mutable Hasher m_hasher;
 
     /// container of Ipv4RoutingTableEntry (routes to hosts)
     typedef std::list<Ipv4RoutingTableEntry*> HostRoutes;
@@ -266,12 +341,39 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     typedef std::list<Ipv4RoutingTableEntry*>::iterator ASExternalRoutesI;
 
     /**
-     * \brief Lookup in the forwarding table for destination.
-     * \param dest destination address
+     * \brief Lookup in the forwarding table for the destination of a packet.
+     * \param header the IPv4 header of the packet
+     * \param p the packet, without the IPv4 header (may be nullptr)
+     * \param usePorts true if the packet starts with its transport header
      * \param oif output interface if any (put 0 otherwise)
-     * \return Ipv4Route to route the packet to reach dest address
+     * \return Ipv4Route to route the packet to reach its destination
+     */
+    Ptr<Ipv4Route> LookupGlobal(const Ipv4Header& header,
+                                Ptr<const Packet> p,
+                                bool usePorts,
+                                Ptr<NetDevice> oif = nullptr);
+
+    /**
+     * \brief Select one of the equal-cost routes to a destination
+     * \param routes the candidate routes (at least one)
+     * \param header the IPv4 header of the packet
+     * \param p the packet, without the IPv4 header (may be nullptr)
+     * \param usePorts true if the packet starts with its transport header
+     * \return the index of the selected route
+     */
+    uint32_t SelectRoute(const std::vector<Ipv4RoutingTableEntry*>& routes,
+                         const Ipv4Header& header,
+                         Ptr<const Packet> p,
+                         bool usePorts);
+
+    /**
+     * \brief Compute the hash of the 5-tuple of a packet
+     * \param header the IPv4 header of the packet
+     * \param p the packet, without the IPv4 header (may be nullptr)
+     * \param usePorts true if the packet starts with its transport header
+     * \return the Murmur3 hash of the 5-tuple and of the node ID
      */
-    Ptr<Ipv4Route> LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif = nullptr);
+    uint32_t GetFlowHash(const Ipv4Header& header, Ptr<const Packet> p, bool usePorts) const;
 
     HostRoutes m_hostRoutes;             //!< Routes to hosts
     NetworkRoutes m_networkRoutes;       //!< Routes to networks
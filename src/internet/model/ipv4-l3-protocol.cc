@@ -43,6 +43,9 @@
 #include "ns3/traffic-control-layer.h"
 #include "ns3/uinteger.h"
 
+#include <iterator>
+#include <limits>
+
 namespace ns3
 {
 
@@ -347,6 +350,7 @@ Ipv4L3Protocol::DoDispose()
         m_cleanDpd.Cancel();
     }
     m_dups.clear();
+    m_dupExpiry.clear();
 
     Object::DoDispose();
 }
@@ -1614,10 +1618,18 @@ Ipv4L3Protocol::ProcessFragment(Ptr<Packet>& packet, Ipv4Header& ipHeader, uint3
     return ret;
 }
 
+std::size_t
+Ipv4L3Protocol::FragmentKeyHash::operator()(const FragmentKey_t& key) const
+{
+    uint64_t h = key.first ^ (uint64_t(key.second) * 0x9e3779b97f4a7c15ULL);
+    return std::hash<uint64_t>()(h ^ (h >> 29));
+}
+
 Ipv4L3Protocol::Fragments::Fragments()
-    : m_moreFragment(0)
 {
     NS_LOG_FUNCTION(this);
+    // the whole packet is missing, its length is unknown until the last fragment
+    m_holes.emplace_back(0, std::numeric_limits<uint32_t>::max());
 }
 
 void
@@ -1627,22 +1639,44 @@ Ipv4L3Protocol::Fragments::AddFragment(Ptr<Packet> fragment,
 {
     NS_LOG_FUNCTION(this << fragment << fragmentOffset << moreFragment);
 
-    std::list<std::pair<Ptr<Packet>, uint16_t>>::iterator it;
-
-    for (it = m_fragments.begin(); it != m_fragments.end(); it++)
+    // fragments are mostly received in order, look for the position from the end
+    std::list<std::pair<Ptr<Packet>, uint16_t>>::iterator it = m_fragments.end();
+    while (it != m_fragments.begin() && std::prev(it)->second > fragmentOffset)
     {
-        if (it->second > fragmentOffset)
-        {
-            break;
-        }
+        it--;
     }
+    m_fragments.insert(it, std::pair<Ptr<Packet>, uint16_t>(fragment, fragmentOffset));
 
-    if (it == m_fragments.end())
+    // RFC 815 hole descriptor update
+    uint32_t first = fragmentOffset;
+    uint32_t last = first + fragment->GetSize();
+    auto hole = m_holes.begin();
+    while (hole != m_holes.end())
     {
-        m_moreFragment = moreFragment;
+        if (first >= hole->second || last <= hole->first)
+        {
+            if (!moreFragment && hole->first >= last)
+            {
+                // beyond the end of the packet
+                hole = m_holes.erase(hole);
+            }
+            else
+            {
+                hole++;
+            }
+            continue;
+        }
+        std::pair<uint32_t, uint32_t> filled = *hole;
+        hole = m_holes.erase(hole);
+        if (first > filled.first)
+        {
+            m_holes.insert(hole, std::make_pair(filled.first, first));
+        }
+        if (last < filled.second && moreFragment)
+        {
+            m_holes.insert(hole, std::make_pair(last, filled.second));
+        }
     }
-
-    m_fragments.insert(it, std::pair<Ptr<Packet>, uint16_t>(fragment, fragmentOffset));
 }
 
 bool
@@ -1650,31 +1684,7 @@ Ipv4L3Protocol::Fragments::IsEntire() const
 {
     NS_LOG_FUNCTION(this);
 
-    bool ret = !m_moreFragment && m_fragments.size() > 0;
-
-    if (ret)
-    {
-        uint16_t lastEndOffset = 0;
-
-        for (std::list<std::pair<Ptr<Packet>, uint16_t>>::const_iterator it = m_fragments.begin();
-             it != m_fragments.end();
-             it++)
-        {
-            // overlapping fragments do exist
-            NS_LOG_LOGIC("Checking overlaps " << lastEndOffset << " - " << it->second);
-
-            if (lastEndOffset < it->second)
-            {
-                ret = false;
-                break;
-            }
-            // fragments might overlap in strange ways
-            uint16_t fragmentEnd = it->first->GetSize() + it->second;
-            lastEndOffset = std::max(lastEndOffset, fragmentEnd);
-        }
-    }
-
-    return ret;
+    return m_holes.empty();
 }
 
 Ptr<Packet>
@@ -1851,9 +1861,22 @@ Ipv4L3Protocol::UpdateDuplicate(Ptr<const Packet> p, const Ipv4Header& header)
 
     // set the expiration event
     iter->second = Simulator::Now() + m_expire;
+    if (m_purge.IsStrictlyPositive())
+    {
+        m_dupExpiry.emplace_back(iter->second, key);
+    }
     return isDup;
 }
 
+std::size_t
+Ipv4L3Protocol::DupTupleHash::operator()(const DupTuple_t& key) const
+{
+    uint64_t h = std::get<0>(key);
+    h ^= (uint64_t(std::get<2>(key).Get()) << 32 | std::get<3>(key).Get()) * 0x9e3779b97f4a7c15ULL;
+    h ^= uint64_t(std::get<1>(key)) << 24;
+    return std::hash<uint64_t>()(h ^ (h >> 29));
+}
+
 void
 Ipv4L3Protocol::RemoveDuplicates()
 {
@@ -1861,22 +1884,21 @@ Ipv4L3Protocol::RemoveDuplicates()
 
     DupMap_t::size_type n = 0;
     Time expire = Simulator::Now();
-    auto iter = m_dups.cbegin();
-    while (iter != m_dups.cend())
+    // only the head of the expiration queue is visited, entries refreshed after
+    // being queued have a later expiration time in the map and are kept
+    while (!m_dupExpiry.empty() && m_dupExpiry.front().first < expire)
     {
-        if (iter->second < expire)
+        auto iter = m_dups.find(m_dupExpiry.front().second);
+        if (iter != m_dups.end() && iter->second < expire)
         {
             NS_LOG_LOGIC("Remove key = (" << std::hex << std::get<0>(iter->first) << ", "
                                           << std::dec << +std::get<1>(iter->first) << ", "
                                           << std::get<2>(iter->first) << ", "
                                           << std::get<3>(iter->first) << ")");
-            iter = m_dups.erase(iter);
+            m_dups.erase(iter);
             ++n;
         }
-        else
-        {
-            ++iter;
-        }
+        m_dupExpiry.pop_front();
     }
 
     NS_LOG_DEBUG("Purged " << n << " expired duplicate entries out of " << (n + m_dups.size()));
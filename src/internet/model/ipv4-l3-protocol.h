@@ -30,9 +30,11 @@
 #include "ns3/simulator.h"
 #include "ns3/traced-callback.h"
 
+#include <deque>
 #include <list>
 #include <map>
 #include <stdint.h>
+#include <unordered_map>
 #include <vector>
 
 class Ipv4L3ProtocolTestCase;
@@ -501,6 +503,17 @@ class Ipv4L3Protocol : public Ipv4
     /// Key identifying a fragmented packet
     typedef std::pair<uint64_t, uint32_t> FragmentKey_t;
 
+    /// Hash function for the key identifying a fragmented packet
+    struct FragmentKeyHash
+    {
+        /**
+         * \brief Hash a fragmented packet key.
+         * \param key the key
+         * \return the hash
+         */
+        std::size_t operator()(const FragmentKey_t& key) const;
+    };
+
     /// Container for fragment timeouts.
     typedef std::list<std::tuple<Time, FragmentKey_t, Ipv4Header, uint32_t>>
         FragmentsTimeoutsList_t;
@@ -547,6 +560,10 @@ class Ipv4L3Protocol : public Ipv4
 
         /**
          * \brief Add a fragment.
+         *
+         * The missing parts of the packet are tracked with hole descriptors
+         * (RFC 815), so that completeness is known without walking the fragments.
+         *
          * \param fragment the fragment
          * \param fragmentOffset the offset of the fragment
          * \param moreFragment the bit "More Fragment"
@@ -585,12 +602,12 @@ class Ipv4L3Protocol : public Ipv4
 
       private:
         /**
-         * \brief True if other fragments will be sent.
+         * \brief The missing byte ranges [first, last) of the packet (RFC 815 holes).
          */
-        bool m_moreFragment;
+        std::list<std::pair<uint32_t, uint32_t>> m_holes;
 
         /**
-         * \brief The current fragments.
+         * \brief The current fragments, sorted by offset.
          */
         std::list<std::pair<Ptr<Packet>, uint16_t>> m_fragments;
 
@@ -601,7 +618,7 @@ class Ipv4L3Protocol : public Ipv4
     };
 
     /// Container of fragments, stored as pairs(src+dst addr, src+dst port) / fragment
-    typedef std::map<FragmentKey_t, Ptr<Fragments>> MapFragments_t;
+    typedef std::unordered_map<FragmentKey_t, Ptr<Fragments>, FragmentKeyHash> MapFragments_t;
 
     MapFragments_t m_fragments;       //!< Fragmented packets.
     Time m_fragmentExpirationTimeout; //!< Expiration timeout
@@ -610,8 +627,22 @@ class Ipv4L3Protocol : public Ipv4
     /// RFC 6621 recommended duplicate packet tuple: {IPV hash, IP protocol, IP source address, IP
     /// destination address}
     typedef std::tuple<uint64_t, uint8_t, Ipv4Address, Ipv4Address> DupTuple_t;
+
+    /// Hash function for the packet duplicate tuple
+    struct DupTupleHash
+    {
+        /**
+         * \brief Hash a packet duplicate tuple.
+         * \param key the tuple
+         * \return the hash
+         */
+        std::size_t operator()(const DupTuple_t& key) const;
+    };
+
     /// Maps packet duplicate tuple to expiration time
-    typedef std::map<DupTuple_t, Time> DupMap_t;
+    typedef std::unordered_map<DupTuple_t, Time, DupTupleHash> DupMap_t;
+    /// Packet duplicate tuples in the order of their (re)insertion, with their expiration time
+    typedef std::deque<std::pair<Time, DupTuple_t>> DupExpiryQueue_t;
 
     /**
      * Registers duplicate entry, return false if new
@@ -625,11 +656,12 @@ class Ipv4L3Protocol : public Ipv4
      */
     void RemoveDuplicates();
 
-    bool m_enableDpd;   //!< Enable multicast duplicate packet detection
-    DupMap_t m_dups;    //!< map of packet duplicate tuples to expiry event
-    Time m_expire;      //!< duplicate entry expiration delay
-    Time m_purge;       //!< time between purging expired duplicate entries
-    EventId m_cleanDpd; //!< event to cleanup expired duplicate entries
+    bool m_enableDpd;             //!< Enable multicast duplicate packet detection
+    DupMap_t m_dups;              //!< map of packet duplicate tuples to expiry event
+    DupExpiryQueue_t m_dupExpiry; //!< expiration queue of the duplicate entries
+    Time m_expire;                //!< duplicate entry expiration delay
+    Time m_purge;                 //!< time between purging expired duplicate entries
+    EventId m_cleanDpd;           //!< event to cleanup expired duplicate entries
 };
 
 } // Namespace ns3
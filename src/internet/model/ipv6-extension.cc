@@ -38,7 +38,10 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <ctime>
+#include <iterator>
+#include <limits>
 #include <list>
 
 namespace ns3
@@ -703,13 +706,7 @@ Ipv6ExtensionFragment::HandleTimeout()
     NS_LOG_FUNCTION(this);
     Time now = Simulator::Now();
 
-    // std::list Time, Fragment_key_t, Ipv6Header
-    // Fragment key is a pair: Ipv6Address, uint32_t ipHeaderId
-    for (auto& element : m_timeoutEventList)
-    {
-        NS_LOG_DEBUG("Handle time " << std::get<0>(element).GetSeconds() << " IP hdr id "
-                                    << std::get<1>(element).second);
-    }
+    // the timeout is the same for all the packets, so the list is sorted by expiration time
     while (!m_timeoutEventList.empty() && std::get<0>(*m_timeoutEventList.begin()) == now)
     {
         HandleFragmentsTimeout(std::get<1>(*m_timeoutEventList.begin()),
@@ -727,9 +724,17 @@ Ipv6ExtensionFragment::HandleTimeout()
     m_timeoutEvent = Simulator::Schedule(difference, &Ipv6ExtensionFragment::HandleTimeout, this);
 }
 
+std::size_t
+Ipv6ExtensionFragment::FragmentKeyHash::operator()(const FragmentKey_t& key) const
+{
+    return Ipv6AddressHash()(key.first) ^ std::hash<uint32_t>()(key.second) * 0x9e3779b9U;
+}
+
 Ipv6ExtensionFragment::Fragments::Fragments()
-    : m_moreFragment(0)
+    : m_overlapping(false)
 {
+    // the whole packet is missing, its length is unknown until the last fragment
+    m_holes.emplace_back(0, std::numeric_limits<uint32_t>::max());
 }
 
 Ipv6ExtensionFragment::Fragments::~Fragments()
@@ -742,22 +747,53 @@ Ipv6ExtensionFragment::Fragments::AddFragment(Ptr<Packet> fragment,
                                               bool moreFragment)
 {
     NS_LOG_FUNCTION(this << fragment << fragmentOffset << moreFragment);
-    std::list<std::pair<Ptr<Packet>, uint16_t>>::iterator it;
 
-    for (it = m_packetFragments.begin(); it != m_packetFragments.end(); it++)
+    // fragments are mostly received in order, look for the position from the end
+    std::list<std::pair<Ptr<Packet>, uint16_t>>::iterator it = m_packetFragments.end();
+    while (it != m_packetFragments.begin() && std::prev(it)->second > fragmentOffset)
+    {
+        it--;
+    }
+    m_packetFragments.insert(it, std::pair<Ptr<Packet>, uint16_t>(fragment, fragmentOffset));
+
+    // RFC 815 hole descriptor update, counting the bytes that were actually missing
+    uint32_t first = fragmentOffset;
+    uint32_t last = first + fragment->GetSize();
+    uint32_t missing = 0;
+    auto hole = m_holes.begin();
+    while (hole != m_holes.end())
     {
-        if (it->second > fragmentOffset)
+        if (first >= hole->second || last <= hole->first)
         {
-            break;
+            if (!moreFragment && hole->first >= last)
+            {
+                // beyond the end of the packet
+                hole = m_holes.erase(hole);
+            }
+            else
+            {
+                hole++;
+            }
+            continue;
+        }
+        std::pair<uint32_t, uint32_t> filled = *hole;
+        missing += std::min(last, filled.second) - std::max(first, filled.first);
+        hole = m_holes.erase(hole);
+        if (first > filled.first)
+        {
+            m_holes.insert(hole, std::make_pair(filled.first, first));
+        }
+        if (last < filled.second && moreFragment)
+        {
+            m_holes.insert(hole, std::make_pair(last, filled.second));
         }
     }
 
-    if (it == m_packetFragments.end())
+    if (missing < fragment->GetSize())
     {
-        m_moreFragment = moreFragment;
+        NS_LOG_LOGIC("Overlapping fragment at offset " << fragmentOffset);
+        m_overlapping = true;
     }
-
-    m_packetFragments.insert(it, std::pair<Ptr<Packet>, uint16_t>(fragment, fragmentOffset));
 }
 
 void
@@ -770,28 +806,7 @@ Ipv6ExtensionFragment::Fragments::SetUnfragmentablePart(Ptr<Packet> unfragmentab
 bool
 Ipv6ExtensionFragment::Fragments::IsEntire() const
 {
-    bool ret = !m_moreFragment && m_packetFragments.size() > 0;
-
-    if (ret)
-    {
-        uint16_t lastEndOffset = 0;
-
-        for (std::list<std::pair<Ptr<Packet>, uint16_t>>::const_iterator it =
-                 m_packetFragments.begin();
-             it != m_packetFragments.end();
-             it++)
-        {
-            if (lastEndOffset != it->second)
-            {
-                ret = false;
-                break;
-            }
-
-            lastEndOffset += it->first->GetSize();
-        }
-    }
-
-    return ret;
+    return m_holes.empty() && !m_overlapping;
 }
 
 Ptr<Packet>
@@ -36,6 +36,7 @@
 #include <list>
 #include <map>
 #include <tuple>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -325,6 +326,19 @@ class Ipv6ExtensionFragment : public Ipv6Extension
      */
     typedef std::pair<Ipv6Address, uint32_t> FragmentKey_t;
 
+    /**
+     * Hash function for the key identifying a fragmented packet
+     */
+    struct FragmentKeyHash
+    {
+        /**
+         * \brief Hash a fragmented packet key.
+         * \param key the key
+         * \return the hash
+         */
+        std::size_t operator()(const FragmentKey_t& key) const;
+    };
+
     /**
      * Container for fragment timeouts.
      */
@@ -355,6 +369,10 @@ class Ipv6ExtensionFragment : public Ipv6Extension
 
         /**
          * \brief Add a fragment.
+         *
+         * The missing parts of the packet are tracked with hole descriptors
+         * (RFC 815), so that completeness is known without walking the fragments.
+         *
          * \param fragment the fragment
          * \param fragmentOffset the offset of the fragment
          * \param moreFragment the bit "More Fragment"
@@ -399,12 +417,17 @@ class Ipv6ExtensionFragment : public Ipv6Extension
 
       private:
         /**
-         * \brief If other fragments will be sent.
+         * \brief The missing byte ranges [first, last) of the packet (RFC 815 holes).
+         */
+        std::list<std::pair<uint32_t, uint32_t>> m_holes;
+
+        /**
+         * \brief If some fragments overlap, in which case the packet is never rebuilt (RFC 5722).
          */
-        bool m_moreFragment;
+        bool m_overlapping;
 
         /**
-         * \brief The current fragments.
+         * \brief The current fragments, sorted by offset.
          */
         std::list<std::pair<Ptr<Packet>, uint16_t>> m_packetFragments;
 
@@ -446,7 +469,7 @@ class Ipv6ExtensionFragment : public Ipv6Extension
     /**
      * \brief Container for the packet fragments.
      */
-    typedef std::map<FragmentKey_t, Ptr<Fragments>> MapFragments_t;
+    typedef std::unordered_map<FragmentKey_t, Ptr<Fragments>, FragmentKeyHash> MapFragments_t;
 
     /**
      * \brief The hash of fragmented packets.
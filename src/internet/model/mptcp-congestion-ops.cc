@@ -0,0 +1,455 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mptcp-congestion-ops.h"
+
+#include "tcp-socket-state.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MpTcpCongestionOps");
+
+NS_OBJECT_ENSURE_REGISTERED(MpTcpCongestionOps);
+
+TypeId
+MpTcpCongestionOps::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MpTcpCongestionOps").SetParent<TcpNewReno>().SetGroupName("Internet");
+    return tid;
+}
+
+MpTcpCongestionOps::MpTcpCongestionOps()
+    : TcpNewReno(),
+      m_cwndCnt(0.0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MpTcpCongestionOps::MpTcpCongestionOps(const MpTcpCongestionOps& sock)
+    : TcpNewReno(sock),
+      m_cwndCnt(0.0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MpTcpCongestionOps::~MpTcpCongestionOps()
+{
+    NS_LOG_FUNCTION(this);
+    Decouple();
+}
+
+void
+MpTcpCongestionOps::Init(Ptr<TcpSocketState> tcb)
+{
+    NS_LOG_FUNCTION(this << tcb);
+    m_tcb = tcb;
+}
+
+void
+MpTcpCongestionOps::Couple(Ptr<MpTcpCongestionOps> other)
+{
+    NS_LOG_FUNCTION(this << other);
+    NS_ASSERT(other);
+
+    if (other == this || (m_group && m_group == other->m_group))
+    {
+        return;
+    }
+
+    Decouple();
+    if (!other->m_group)
+    {
+        other->m_group = Create<Group>();
+        other->m_group->members.push_back(PeekPointer(other));
+    }
+    m_group = other->m_group;
+    m_group->members.push_back(this);
+}
+
+void
+MpTcpCongestionOps::Decouple()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_group)
+    {
+        auto& members = m_group->members;
+        members.erase(std::remove(members.begin(), members.end(), this), members.end());
+        m_group = nullptr;
+    }
+}
+
+uint32_t
+MpTcpCongestionOps::GetNSubflows() const
+{
+    return m_group ? m_group->members.size() : 1;
+}
+
+std::vector<const MpTcpCongestionOps*>
+MpTcpCongestionOps::GetGroup() const
+{
+    std::vector<const MpTcpCongestionOps*> group;
+    if (!m_group)
+    {
+        group.push_back(this);
+        return group;
+    }
+
+    for (const auto member : m_group->members)
+    {
+        if (member->m_tcb && member->GetRtt() > 0.0)
+        {
+            group.push_back(member);
+        }
+    }
+    return group;
+}
+
+double
+MpTcpCongestionOps::GetWindow() const
+{
+    return static_cast<double>(m_tcb->m_cWnd.Get()) / m_tcb->m_segmentSize;
+}
+
+double
+MpTcpCongestionOps::GetRtt() const
+{
+    return m_tcb->m_lastRtt.Get().GetSeconds();
+}
+
+void
+MpTcpCongestionOps::CongestionAvoidance(Ptr<TcpSocketState> tcb, uint32_t segmentsAcked)
+{
+    NS_LOG_FUNCTION(this << tcb << segmentsAcked);
+
+    if (segmentsAcked == 0)
+    {
+        return;
+    }
+
+    double cwnd = static_cast<double>(tcb->m_cWnd.Get()) / tcb->m_segmentSize;
+    double increase = 1.0 / std::max(cwnd, 1.0);
+    if (m_tcb == tcb && GetRtt() > 0.0)
+    {
+        increase = GetIncrease(tcb);
+    }
+
+    m_cwndCnt += increase * segmentsAcked;
+    if (m_cwndCnt >= 1.0)
+    {
+        auto segments = static_cast<uint32_t>(m_cwndCnt);
+        m_cwndCnt -= segments;
+        tcb->m_cWnd += segments * tcb->m_segmentSize;
+    }
+    else if (m_cwndCnt <= -1.0)
+    {
+        m_cwndCnt += 1.0;
+        if (tcb->m_cWnd >= 2 * tcb->m_segmentSize)
+        {
+            tcb->m_cWnd -= tcb->m_segmentSize;
+        }
+    }
+    NS_LOG_INFO("In CongAvoid, updated to cwnd " << tcb->m_cWnd << " ssthresh "
+                                                 << tcb->m_ssThresh);
+}
+
+// MpTcpLia
+
+NS_OBJECT_ENSURE_REGISTERED(MpTcpLia);
+
+TypeId
+MpTcpLia::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::MpTcpLia")
+                            .SetParent<MpTcpCongestionOps>()
+                            .AddConstructor<MpTcpLia>()
+                            .SetGroupName("Internet");
+    return tid;
+}
+
+MpTcpLia::MpTcpLia()
+    : MpTcpCongestionOps()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MpTcpLia::MpTcpLia(const MpTcpLia& sock)
+    : MpTcpCongestionOps(sock)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MpTcpLia::~MpTcpLia()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+std::string
+MpTcpLia::GetName() const
+{
+    return "MpTcpLia";
+}
+
+Ptr<TcpCongestionOps>
+MpTcpLia::Fork()
+{
+    return CopyObject<MpTcpLia>(this);
+}
+
+double
+MpTcpLia::GetIncrease(Ptr<const TcpSocketState> tcb) const
+{
+    double totalWindow = 0.0;
+    double maxRatio = 0.0;
+    double sumRatio = 0.0;
+    for (const auto subflow : GetGroup())
+    {
+        double w = subflow->GetWindow();
+        double rtt = subflow->GetRtt();
+        totalWindow += w;
+        maxRatio = std::max(maxRatio, w / (rtt * rtt));
+        sumRatio += w / rtt;
+    }
+
+    double window = GetWindow();
+    double alpha = totalWindow * maxRatio / (sumRatio * sumRatio);
+    double increase = std::min(alpha / totalWindow, 1.0 / window);
+    NS_LOG_DEBUG("alpha " << alpha << " total window " << totalWindow << " increase "
+                          << increase);
+    return increase;
+}
+
+// MpTcpOlia
+
+NS_OBJECT_ENSURE_REGISTERED(MpTcpOlia);
+
+TypeId
+MpTcpOlia::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::MpTcpOlia")
+                            .SetParent<MpTcpCongestionOps>()
+                            .AddConstructor<MpTcpOlia>()
+                            .SetGroupName("Internet");
+    return tid;
+}
+
+MpTcpOlia::MpTcpOlia()
+    : MpTcpCongestionOps(),
+      m_l1(0),
+      m_l2(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MpTcpOlia::MpTcpOlia(const MpTcpOlia& sock)
+    : MpTcpCongestionOps(sock),
+      m_l1(sock.m_l1),
+      m_l2(sock.m_l2)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MpTcpOlia::~MpTcpOlia()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+std::string
+MpTcpOlia::GetName() const
+{
+    return "MpTcpOlia";
+}
+
+Ptr<TcpCongestionOps>
+MpTcpOlia::Fork()
+{
+    return CopyObject<MpTcpOlia>(this);
+}
+
+uint32_t
+MpTcpOlia::GetSsThresh(Ptr<const TcpSocketState> tcb, uint32_t bytesInFlight)
+{
+    NS_LOG_FUNCTION(this << tcb << bytesInFlight);
+    m_l1 = m_l2;
+    m_l2 = 0;
+    return TcpNewReno::GetSsThresh(tcb, bytesInFlight);
+}
+
+void
+MpTcpOlia::PktsAcked(Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time& rtt)
+{
+    NS_LOG_FUNCTION(this << tcb << segmentsAcked << rtt);
+    m_l2 += segmentsAcked;
+}
+
+double
+MpTcpOlia::GetInterLoss() const
+{
+    return std::max(m_l1, m_l2);
+}
+
+double
+MpTcpOlia::GetIncrease(Ptr<const TcpSocketState> tcb) const
+{
+    std::vector<const MpTcpCongestionOps*> group = GetGroup();
+
+    double sumRatio = 0.0;
+    double maxWindow = 0.0;
+    double maxQuality = 0.0;
+    for (const auto subflow : group)
+    {
+        double w = subflow->GetWindow();
+        double rtt = subflow->GetRtt();
+        double l = static_cast<const MpTcpOlia*>(subflow)->GetInterLoss();
+        sumRatio += w / rtt;
+        maxWindow = std::max(maxWindow, w);
+        maxQuality = std::max(maxQuality, l * l / rtt);
+    }
+
+    // Best paths (largest l^2/rtt) that do not have the largest window,
+    // and paths with the largest window
+    uint32_t nCollected = 0;
+    uint32_t nMaxWindow = 0;
+    bool isCollected = false;
+    bool isMaxWindow = false;
+    for (const auto subflow : group)
+    {
+        double l = static_cast<const MpTcpOlia*>(subflow)->GetInterLoss();
+        bool maxW = subflow->GetWindow() >= maxWindow;
+        bool best = l * l / subflow->GetRtt() >= maxQuality;
+        nMaxWindow += maxW;
+        nCollected += best && !maxW;
+        if (subflow == this)
+        {
+            isMaxWindow = maxW;
+            isCollected = best && !maxW;
+        }
+    }
+
+    double alpha = 0.0;
+    if (nCollected > 0)
+    {
+        if (isCollected)
+        {
+            alpha = 1.0 / (group.size() * nCollected);
+        }
+        else if (isMaxWindow)
+        {
+            alpha = -1.0 / (group.size() * nMaxWindow);
+        }
+    }
+
+    double window = GetWindow();
+    double rtt = GetRtt();
+    double increase = (window / (rtt * rtt)) / (sumRatio * sumRatio) + alpha / window;
+    NS_LOG_DEBUG("alpha " << alpha << " increase " << increase);
+    return increase;
+}
+
+// MpTcpBalia
+
+NS_OBJECT_ENSURE_REGISTERED(MpTcpBalia);
+
+TypeId
+MpTcpBalia::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::MpTcpBalia")
+                            .SetParent<MpTcpCongestionOps>()
+                            .AddConstructor<MpTcpBalia>()
+                            .SetGroupName("Internet");
+    return tid;
+}
+
+MpTcpBalia::MpTcpBalia()
+    : MpTcpCongestionOps()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MpTcpBalia::MpTcpBalia(const MpTcpBalia& sock)
+    : MpTcpCongestionOps(sock)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MpTcpBalia::~MpTcpBalia()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+std::string
+MpTcpBalia::GetName() const
+{
+    return "MpTcpBalia";
+}
+
+Ptr<TcpCongestionOps>
+MpTcpBalia::Fork()
+{
+    return CopyObject<MpTcpBalia>(this);
+}
+
+double
+MpTcpBalia::GetAlpha() const
+{
+    double maxRate = 0.0;
+    for (const auto subflow : GetGroup())
+    {
+        maxRate = std::max(maxRate, subflow->GetWindow() / subflow->GetRtt());
+    }
+    return maxRate / (GetWindow() / GetRtt());
+}
+
+uint32_t
+MpTcpBalia::GetSsThresh(Ptr<const TcpSocketState> tcb, uint32_t bytesInFlight)
+{
+    NS_LOG_FUNCTION(this << tcb << bytesInFlight);
+
+    if (m_tcb != tcb || GetRtt() <= 0.0)
+    {
+        return TcpNewReno::GetSsThresh(tcb, bytesInFlight);
+    }
+
+    double decrease = (bytesInFlight / 2.0) * std::min(GetAlpha(), 1.5);
+    auto ssThresh = static_cast<uint32_t>(std::max(0.0, bytesInFlight - decrease));
+    return std::max(2 * tcb->m_segmentSize, ssThresh);
+}
+
+double
+MpTcpBalia::GetIncrease(Ptr<const TcpSocketState> tcb) const
+{
+    double sumRate = 0.0;
+    for (const auto subflow : GetGroup())
+    {
+        sumRate += subflow->GetWindow() / subflow->GetRtt();
+    }
+
+    double rtt = GetRtt();
+    double rate = GetWindow() / rtt;
+    double alpha = GetAlpha();
+    double increase =
+        (rate / (rtt * sumRate * sumRate)) * ((1 + alpha) / 2) * ((4 + alpha) / 5);
+    NS_LOG_DEBUG("alpha " << alpha << " increase " << increase);
+    return increase;
+}
+
+} // namespace ns3
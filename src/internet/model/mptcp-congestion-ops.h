@@ -0,0 +1,284 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MPTCP_CONGESTION_OPS_H
+#define MPTCP_CONGESTION_OPS_H
+
+#include "tcp-congestion-ops.h"
+
+#include "ns3/simple-ref-count.h"
+
+#include <vector>
+
+namespace ns3
+{
+
+class TcpSocketState;
+
+/**
+ * \ingroup congestionOps
+ *
+ * \brief Base class of the coupled congestion controls of Multipath TCP
+ *
+ * Each subflow of an MPTCP connection owns its own instance of the congestion
+ * control; the instances of the subflows of the same connection are coupled
+ * together, so that the increase of the congestion window of one subflow
+ * depends on the windows and the RTTs of all the subflows.
+ *
+ * Slow start and the reaction to losses are the ones of NewReno, unless
+ * redefined by the subclass; the subclasses define the per-ACK increase
+ * of the congestion avoidance phase. With a single subflow, all the
+ * coupled controls behave as NewReno.
+ */
+class MpTcpCongestionOps : public TcpNewReno
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    MpTcpCongestionOps();
+
+    /**
+     * \brief Copy constructor
+     *
+     * The copy is not coupled with any other subflow.
+     *
+     * \param sock the object to copy
+     */
+    MpTcpCongestionOps(const MpTcpCongestionOps& sock);
+    ~MpTcpCongestionOps() override;
+
+    void Init(Ptr<TcpSocketState> tcb) override;
+
+    /**
+     * \brief Couple this congestion control with the ones of another subflow
+     *
+     * After the call, this instance belongs to the same group as \p other.
+     *
+     * \param other the congestion control of a subflow of the same connection
+     */
+    void Couple(Ptr<MpTcpCongestionOps> other);
+
+    /**
+     * \brief Remove this congestion control from its group
+     */
+    void Decouple();
+
+    /**
+     * \brief Get the number of subflows coupled with this one (this one included)
+     * \return the size of the group
+     */
+    uint32_t GetNSubflows() const;
+
+    /**
+     * \brief Get the congestion window of a subflow
+     * \return the congestion window, in segments
+     */
+    double GetWindow() const;
+
+    /**
+     * \brief Get the RTT of a subflow
+     * \return the last RTT sample, in seconds
+     */
+    double GetRtt() const;
+
+  protected:
+    /**
+     * \brief Coupled congestion avoidance
+     *
+     * Accumulates the increase returned by GetIncrease() and applies it
+     * to the congestion window one segment at a time.
+     *
+     * \param tcb internal congestion state
+     * \param segmentsAcked count of segments acked
+     */
+    void CongestionAvoidance(Ptr<TcpSocketState> tcb, uint32_t segmentsAcked) override;
+
+    /**
+     * \brief Get the increase of the congestion window for each segment acked
+     * \param tcb internal congestion state of this subflow
+     * \return the increase, in segments
+     */
+    virtual double GetIncrease(Ptr<const TcpSocketState> tcb) const = 0;
+
+    /**
+     * \brief Get the subflows coupled with this one (this one included)
+     *
+     * Only the subflows that already have a congestion state and an RTT
+     * sample are returned.
+     *
+     * \return the list of the coupled congestion controls
+     */
+    std::vector<const MpTcpCongestionOps*> GetGroup() const;
+
+    Ptr<TcpSocketState> m_tcb; //!< Congestion state of this subflow
+
+  private:
+    /**
+     * \brief The congestion controls of the subflows of a connection
+     */
+    struct Group : public SimpleRefCount<Group>
+    {
+        std::vector<MpTcpCongestionOps*> members; //!< Members of the group
+    };
+
+    Ptr<Group> m_group; //!< The group this subflow belongs to
+    double m_cwndCnt;   //!< Increase not yet applied to the window, in segments
+};
+
+/**
+ * \ingroup congestionOps
+ *
+ * \brief Linked Increases Algorithm (LIA), \RFC{6356}
+ *
+ * For each segment acked on subflow r, the congestion window is increased by
+ *
+ *     min (alpha / w_total, 1 / w_r)
+ *
+ * with alpha = w_total * max (w_i / rtt_i^2) / (sum (w_i / rtt_i))^2
+ */
+class MpTcpLia : public MpTcpCongestionOps
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    MpTcpLia();
+
+    /**
+     * \brief Copy constructor
+     * \param sock the object to copy
+     */
+    MpTcpLia(const MpTcpLia& sock);
+    ~MpTcpLia() override;
+
+    std::string GetName() const override;
+    Ptr<TcpCongestionOps> Fork() override;
+
+  protected:
+    double GetIncrease(Ptr<const TcpSocketState> tcb) const override;
+};
+
+/**
+ * \ingroup congestionOps
+ *
+ * \brief Opportunistic Linked Increases Algorithm (OLIA)
+ *
+ * R. Khalili, N. Gast, M. Popovic, J.-Y. Le Boudec, "MPTCP Is Not
+ * Pareto-Optimal: Performance Issues and a Possible Solution", IEEE/ACM
+ * Transactions on Networking, 2013.
+ *
+ * For each segment acked on subflow r, the congestion window is increased by
+ *
+ *     (w_r / rtt_r^2) / (sum (w_i / rtt_i))^2 + alpha_r / w_r
+ *
+ * where alpha_r moves window from the subflows with the largest window
+ * towards the best subflows, i.e., the ones with the largest l_r^2 / rtt_r,
+ * l_r being the number of segments acked between the last two losses.
+ */
+class MpTcpOlia : public MpTcpCongestionOps
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    MpTcpOlia();
+
+    /**
+     * \brief Copy constructor
+     * \param sock the object to copy
+     */
+    MpTcpOlia(const MpTcpOlia& sock);
+    ~MpTcpOlia() override;
+
+    std::string GetName() const override;
+    uint32_t GetSsThresh(Ptr<const TcpSocketState> tcb, uint32_t bytesInFlight) override;
+    void PktsAcked(Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time& rtt) override;
+    Ptr<TcpCongestionOps> Fork() override;
+
+  protected:
+    double GetIncrease(Ptr<const TcpSocketState> tcb) const override;
+
+  private:
+    /**
+     * \brief Get the estimation of the number of segments between losses
+     * \return max (l1, l2)
+     */
+    double GetInterLoss() const;
+
+    uint32_t m_l1; //!< Segments acked between the last two losses
+    uint32_t m_l2; //!< Segments acked since the last loss
+};
+
+/**
+ * \ingroup congestionOps
+ *
+ * \brief Balanced Linked Adaptation (BALIA)
+ *
+ * Q. Peng, A. Walid, J. Hwang, S. H. Low, "Multipath TCP: Analysis, Design,
+ * and Implementation", IEEE/ACM Transactions on Networking, 2016.
+ *
+ * With x_r = w_r / rtt_r and alpha_r = max (x_i) / x_r, for each segment
+ * acked on subflow r the congestion window is increased by
+ *
+ *     (x_r / (rtt_r * (sum (x_i))^2)) * ((1 + alpha_r) / 2) * ((4 + alpha_r) / 5)
+ *
+ * and on a loss it is decreased by (w_r / 2) * min (alpha_r, 1.5).
+ */
+class MpTcpBalia : public MpTcpCongestionOps
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    MpTcpBalia();
+
+    /**
+     * \brief Copy constructor
+     * \param sock the object to copy
+     */
+    MpTcpBalia(const MpTcpBalia& sock);
+    ~MpTcpBalia() override;
+
+    std::string GetName() const override;
+    uint32_t GetSsThresh(Ptr<const TcpSocketState> tcb, uint32_t bytesInFlight) override;
+    Ptr<TcpCongestionOps> Fork() override;
+
+  protected:
+    double GetIncrease(Ptr<const TcpSocketState> tcb) const override;
+
+  private:
+    /**
+     * \brief Get the alpha of this subflow
+     * \return max (x_i) / x_r
+     */
+    double GetAlpha() const;
+};
+
+} // namespace ns3
+
+#endif // MPTCP_CONGESTION_OPS_H
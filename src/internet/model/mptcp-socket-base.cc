@@ -0,0 +1,1272 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mptcp-socket-base.h"
+
+#include "ipv4.h"
+#include "mptcp-congestion-ops.h"
+#include "mptcp-subflow.h"
+#include "tcp-l4-protocol.h"
+
+#include "ns3/boolean.h"
+#include "ns3/hash.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MpTcpSocketBase");
+
+NS_OBJECT_ENSURE_REGISTERED(MpTcpSocketBase);
+
+/**
+ * \brief Compute the token of a connection
+ * \param key the key of the end of the connection
+ * \return the token identifying the connection at that end
+ */
+static uint32_t
+GetToken(uint64_t key)
+{
+    return Hash32(reinterpret_cast<const char*>(&key), sizeof(key));
+}
+
+/**
+ * \brief Compute the initial data sequence number of an end of the connection
+ * \param key the key of the end of the connection
+ * \return the data sequence number of the first byte sent by that end
+ */
+static uint64_t
+GetInitialDataSeq(uint64_t key)
+{
+    return Hash64(reinterpret_cast<const char*>(&key), sizeof(key)) + 1;
+}
+
+TypeId
+MpTcpSocketBase::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MpTcpSocketBase")
+            .SetParent<TcpSocket>()
+            .SetGroupName("Internet")
+            .AddConstructor<MpTcpSocketBase>()
+            .AddAttribute("CongestionOps",
+                          "Congestion control of the subflows; the subclasses of "
+                          "MpTcpCongestionOps are coupled",
+                          TypeIdValue(MpTcpLia::GetTypeId()),
+                          MakeTypeIdAccessor(&MpTcpSocketBase::m_congestionTypeId),
+                          MakeTypeIdChecker())
+            .AddAttribute("MaxSubflows",
+                          "Maximum number of subflows of a connection",
+                          UintegerValue(8),
+                          MakeUintegerAccessor(&MpTcpSocketBase::m_maxSubflows),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("FullMesh",
+                          "Open a subflow between each pair of local and remote IPv4 addresses, "
+                          "instead of only between addresses of the same network",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&MpTcpSocketBase::m_fullMesh),
+                          MakeBooleanChecker());
+    return tid;
+}
+
+MpTcpSocketBase::MpTcpSocketBase()
+    : TcpSocket()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MpTcpSocketBase::MpTcpSocketBase(const MpTcpSocketBase& sock)
+    : TcpSocket(sock),
+      m_node(sock.m_node),
+      m_tcp(sock.m_tcp),
+      m_rng(sock.m_rng),
+      m_congestionTypeId(sock.m_congestionTypeId),
+      m_maxSubflows(sock.m_maxSubflows),
+      m_fullMesh(sock.m_fullMesh),
+      m_sndBufSize(sock.m_sndBufSize),
+      m_rcvBufSize(sock.m_rcvBufSize),
+      m_segmentSize(sock.m_segmentSize),
+      m_initialSsThresh(sock.m_initialSsThresh),
+      m_initialCwnd(sock.m_initialCwnd),
+      m_cnTimeout(sock.m_cnTimeout),
+      m_synRetries(sock.m_synRetries),
+      m_dataRetries(sock.m_dataRetries),
+      m_delAckTimeout(sock.m_delAckTimeout),
+      m_delAckMaxCount(sock.m_delAckMaxCount),
+      m_noDelay(sock.m_noDelay),
+      m_persistTimeout(sock.m_persistTimeout)
+{
+    NS_LOG_FUNCTION(this);
+    // Reset all callbacks to null
+    Callback<void, Ptr<Socket>> vPS = MakeNullCallback<void, Ptr<Socket>>();
+    Callback<void, Ptr<Socket>, const Address&> vPSA =
+        MakeNullCallback<void, Ptr<Socket>, const Address&>();
+    Callback<void, Ptr<Socket>, uint32_t> vPSUI = MakeNullCallback<void, Ptr<Socket>, uint32_t>();
+    SetConnectCallback(vPS, vPS);
+    SetDataSentCallback(vPSUI);
+    SetSendCallback(vPSUI);
+    SetRecvCallback(vPS);
+}
+
+MpTcpSocketBase::~MpTcpSocketBase()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& [token, connection] : m_tokens)
+    {
+        connection->m_listener = nullptr;
+    }
+    if (m_initial)
+    {
+        m_initial->Detach();
+    }
+    for (auto& subflow : m_subflows)
+    {
+        subflow->Detach();
+    }
+}
+
+void
+MpTcpSocketBase::SetNode(Ptr<Node> node)
+{
+    NS_LOG_FUNCTION(this << node);
+    m_node = node;
+}
+
+void
+MpTcpSocketBase::SetTcp(Ptr<TcpL4Protocol> tcp)
+{
+    NS_LOG_FUNCTION(this << tcp);
+    m_tcp = tcp;
+}
+
+void
+MpTcpSocketBase::SetRandomVariable(Ptr<UniformRandomVariable> rng)
+{
+    NS_LOG_FUNCTION(this << rng);
+    m_rng = rng;
+}
+
+uint32_t
+MpTcpSocketBase::GetNSubflows() const
+{
+    return m_subflows.size();
+}
+
+Ptr<MpTcpSubflow>
+MpTcpSocketBase::GetSubflow(uint32_t index) const
+{
+    NS_ASSERT(index < m_subflows.size());
+    return m_subflows[index];
+}
+
+bool
+MpTcpSocketBase::IsFallback() const
+{
+    return m_fallback;
+}
+
+bool
+MpTcpSocketBase::HasDataAck() const
+{
+    return m_rxStarted && !m_fallback;
+}
+
+uint64_t
+MpTcpSocketBase::GetDataAck() const
+{
+    return m_rxNextDataSeq;
+}
+
+Ptr<MpTcpSubflow>
+MpTcpSocketBase::CreateSubflow()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(m_tcp, "MpTcpSocketBase not associated with a TCP protocol");
+
+    if (!m_rng)
+    {
+        m_rng = CreateObject<UniformRandomVariable>();
+    }
+
+    TypeIdValue recoveryType;
+    m_tcp->GetAttribute("RecoveryType", recoveryType);
+    Ptr<MpTcpSubflow> subflow = DynamicCast<MpTcpSubflow>(
+        m_tcp->CreateSocket(m_congestionTypeId, recoveryType.Get(), MpTcpSubflow::GetTypeId()));
+
+    subflow->SetAttribute("SndBufSize", UintegerValue(m_sndBufSize));
+    subflow->SetAttribute("RcvBufSize", UintegerValue(m_rcvBufSize));
+    subflow->SetAttribute("SegmentSize", UintegerValue(m_segmentSize));
+    subflow->SetAttribute("InitialSlowStartThreshold", UintegerValue(m_initialSsThresh));
+    subflow->SetAttribute("InitialCwnd", UintegerValue(m_initialCwnd));
+    subflow->SetAttribute("ConnTimeout", TimeValue(m_cnTimeout));
+    subflow->SetAttribute("ConnCount", UintegerValue(m_synRetries));
+    subflow->SetAttribute("DataRetries", UintegerValue(m_dataRetries));
+    subflow->SetAttribute("DelAckTimeout", TimeValue(m_delAckTimeout));
+    subflow->SetAttribute("DelAckCount", UintegerValue(m_delAckMaxCount));
+    subflow->SetAttribute("TcpNoDelay", BooleanValue(m_noDelay));
+    subflow->SetAttribute("PersistTimeout", TimeValue(m_persistTimeout));
+    subflow->SetRandomVariable(m_rng);
+    return subflow;
+}
+
+void
+MpTcpSocketBase::AttachSubflow(Ptr<MpTcpSubflow> subflow)
+{
+    NS_LOG_FUNCTION(this << subflow);
+
+    subflow->SetMeta(this);
+    subflow->SetRecvCallback(MakeCallback(&MpTcpSocketBase::SubflowRecv, this));
+    subflow->SetSendCallback(MakeCallback(&MpTcpSocketBase::SubflowSend, this));
+    subflow->SetCloseCallbacks(MakeCallback(&MpTcpSocketBase::SubflowNormalClose, this),
+                               MakeCallback(&MpTcpSocketBase::SubflowErrorClose, this));
+
+    if (!m_subflows.empty())
+    {
+        Ptr<MpTcpCongestionOps> cc =
+            DynamicCast<MpTcpCongestionOps>(subflow->GetCongestionControl());
+        Ptr<MpTcpCongestionOps> first =
+            DynamicCast<MpTcpCongestionOps>(m_subflows.front()->GetCongestionControl());
+        if (cc && first)
+        {
+            cc->Couple(first);
+        }
+    }
+    m_subflows.push_back(subflow);
+}
+
+void
+MpTcpSocketBase::SetupDataSequence()
+{
+    NS_LOG_FUNCTION(this);
+    m_txNextDataSeq = GetInitialDataSeq(m_localKey);
+    m_rxNextDataSeq = GetInitialDataSeq(m_peerKey);
+    m_rxStarted = true;
+}
+
+// Socket interface
+
+Socket::SocketErrno
+MpTcpSocketBase::GetErrno() const
+{
+    return m_errno;
+}
+
+Socket::SocketType
+MpTcpSocketBase::GetSocketType() const
+{
+    return NS3_SOCK_STREAM;
+}
+
+Ptr<Node>
+MpTcpSocketBase::GetNode() const
+{
+    return m_node;
+}
+
+int
+MpTcpSocketBase::Bind()
+{
+    NS_LOG_FUNCTION(this);
+    return Bind(InetSocketAddress(Ipv4Address::GetAny(), 0));
+}
+
+int
+MpTcpSocketBase::Bind6()
+{
+    NS_LOG_FUNCTION(this);
+    return Bind(Inet6SocketAddress(Ipv6Address::GetAny(), 0));
+}
+
+int
+MpTcpSocketBase::Bind(const Address& address)
+{
+    NS_LOG_FUNCTION(this << address);
+
+    if (m_initial || !m_subflows.empty())
+    {
+        m_errno = ERROR_INVAL;
+        return -1;
+    }
+
+    Ptr<MpTcpSubflow> subflow = CreateSubflow();
+    if (subflow->Bind(address) != 0)
+    {
+        m_errno = subflow->GetErrno();
+        return -1;
+    }
+    if (m_boundDevice)
+    {
+        subflow->BindToNetDevice(m_boundDevice);
+    }
+    m_initial = subflow;
+    return 0;
+}
+
+int
+MpTcpSocketBase::Connect(const Address& address)
+{
+    NS_LOG_FUNCTION(this << address);
+
+    if (!m_initial)
+    {
+        int ret = InetSocketAddress::IsMatchingType(address) ? Bind() : Bind6();
+        if (ret != 0)
+        {
+            return ret;
+        }
+    }
+
+    if (InetSocketAddress::IsMatchingType(address))
+    {
+        InetSocketAddress transport = InetSocketAddress::ConvertFrom(address);
+        m_peerPort = transport.GetPort();
+        m_peerAddresses.emplace_back(transport.GetIpv4(), 0);
+    }
+    else if (Inet6SocketAddress::IsMatchingType(address))
+    {
+        m_peerPort = Inet6SocketAddress::ConvertFrom(address).GetPort();
+    }
+
+    m_isClient = true;
+    m_localKey = m_rng->GetInteger(0, std::numeric_limits<uint32_t>::max());
+    m_localKey = (m_localKey << 32) | m_rng->GetInteger(0, std::numeric_limits<uint32_t>::max());
+
+    Ptr<MpTcpSubflow> subflow = m_initial;
+    m_initial = nullptr;
+    subflow->SetLocalKey(m_localKey);
+    AttachSubflow(subflow);
+    subflow->SetConnectCallback(MakeCallback(&MpTcpSocketBase::SubflowConnected, this),
+                                MakeCallback(&MpTcpSocketBase::SubflowConnectionFailed, this));
+    int ret = subflow->Connect(address);
+    if (ret != 0)
+    {
+        m_errno = subflow->GetErrno();
+    }
+    return ret;
+}
+
+int
+MpTcpSocketBase::Listen()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_initial && Bind() != 0)
+    {
+        return -1;
+    }
+
+    m_initial->SetMeta(this);
+    m_initial->SetAcceptCallback(MakeCallback(&MpTcpSocketBase::SubflowConnectionRequest, this),
+                                 MakeCallback(&MpTcpSocketBase::SubflowAccepted, this));
+    int ret = m_initial->Listen();
+    if (ret != 0)
+    {
+        m_errno = m_initial->GetErrno();
+    }
+    return ret;
+}
+
+int
+MpTcpSocketBase::Close()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_initial)
+    {
+        return m_initial->Close();
+    }
+
+    if (!m_connected)
+    {
+        for (auto& subflow : m_subflows)
+        {
+            subflow->Close();
+        }
+        return 0;
+    }
+
+    m_closeOnEmpty = true;
+    SendPendingData();
+    return 0;
+}
+
+int
+MpTcpSocketBase::ShutdownSend()
+{
+    NS_LOG_FUNCTION(this);
+    m_shutdownSend = true;
+    SendPendingData();
+    return 0;
+}
+
+int
+MpTcpSocketBase::ShutdownRecv()
+{
+    NS_LOG_FUNCTION(this);
+    m_shutdownRecv = true;
+    return 0;
+}
+
+int
+MpTcpSocketBase::Send(Ptr<Packet> p, uint32_t flags)
+{
+    NS_LOG_FUNCTION(this << p);
+    NS_ABORT_MSG_IF(flags, "use of flags is not supported in MpTcpSocketBase::Send()");
+
+    if (m_shutdownSend || m_closeOnEmpty)
+    {
+        m_errno = ERROR_SHUTDOWN;
+        return -1;
+    }
+    if (m_subflows.empty())
+    {
+        m_errno = ERROR_NOTCONN;
+        return -1;
+    }
+    if (p->GetSize() > GetTxAvailable())
+    {
+        m_errno = ERROR_MSGSIZE;
+        return -1;
+    }
+
+    m_unsent.push_back(p);
+    m_unsentSize += p->GetSize();
+    SendPendingData();
+    return p->GetSize();
+}
+
+int
+MpTcpSocketBase::SendTo(Ptr<Packet> p, uint32_t flags, const Address& toAddress)
+{
+    NS_LOG_FUNCTION(this << p << flags << toAddress);
+    return Send(p, flags);
+}
+
+Ptr<Packet>
+MpTcpSocketBase::Recv(uint32_t maxSize, uint32_t flags)
+{
+    NS_LOG_FUNCTION(this << maxSize << flags);
+    NS_ABORT_MSG_IF(flags, "use of flags is not supported in MpTcpSocketBase::Recv()");
+
+    if (m_rxReady.empty())
+    {
+        return nullptr;
+    }
+
+    Ptr<Packet> out = Create<Packet>();
+    while (!m_rxReady.empty() && out->GetSize() < maxSize)
+    {
+        Ptr<Packet> front = m_rxReady.front();
+        uint32_t needed = maxSize - out->GetSize();
+        if (front->GetSize() <= needed)
+        {
+            out->AddAtEnd(front);
+            m_rxReady.pop_front();
+        }
+        else
+        {
+            out->AddAtEnd(front->CreateFragment(0, needed));
+            m_rxReady.front() = front->CreateFragment(needed, front->GetSize() - needed);
+        }
+    }
+    m_rxReadySize -= out->GetSize();
+    return out;
+}
+
+Ptr<Packet>
+MpTcpSocketBase::RecvFrom(uint32_t maxSize, uint32_t flags, Address& fromAddress)
+{
+    NS_LOG_FUNCTION(this << maxSize << flags);
+    Ptr<Packet> packet = Recv(maxSize, flags);
+    if (packet)
+    {
+        GetPeerName(fromAddress);
+    }
+    return packet;
+}
+
+uint32_t
+MpTcpSocketBase::GetTxAvailable() const
+{
+    uint32_t used = m_unsentSize + m_inFlightSize;
+    return used < m_sndBufSize ? m_sndBufSize - used : 0;
+}
+
+uint32_t
+MpTcpSocketBase::GetRxAvailable() const
+{
+    return m_rxReadySize;
+}
+
+int
+MpTcpSocketBase::GetSockName(Address& address) const
+{
+    NS_LOG_FUNCTION(this);
+    Ptr<MpTcpSubflow> subflow = m_initial ? m_initial : nullptr;
+    if (!subflow && !m_subflows.empty())
+    {
+        subflow = m_subflows.front();
+    }
+    if (!subflow)
+    {
+        address = InetSocketAddress(Ipv4Address::GetZero(), 0);
+        return 0;
+    }
+    return subflow->GetSockName(address);
+}
+
+int
+MpTcpSocketBase::GetPeerName(Address& address) const
+{
+    NS_LOG_FUNCTION(this);
+    if (m_subflows.empty())
+    {
+        m_errno = ERROR_NOTCONN;
+        return -1;
+    }
+    return m_subflows.front()->GetPeerName(address);
+}
+
+void
+MpTcpSocketBase::BindToNetDevice(Ptr<NetDevice> netdevice)
+{
+    NS_LOG_FUNCTION(this << netdevice);
+    Socket::BindToNetDevice(netdevice);
+    m_boundDevice = netdevice;
+    if (m_initial)
+    {
+        m_initial->BindToNetDevice(netdevice);
+    }
+}
+
+bool
+MpTcpSocketBase::SetAllowBroadcast(bool allowBroadcast)
+{
+    // Broadcast is not implemented. Return true only if allowBroadcast==false
+    return (!allowBroadcast);
+}
+
+bool
+MpTcpSocketBase::GetAllowBroadcast() const
+{
+    return false;
+}
+
+// Path management
+
+void
+MpTcpSocketBase::CreateJoinSubflows()
+{
+    NS_LOG_FUNCTION(this);
+
+    Ptr<Ipv4> ipv4 = m_node->GetObject<Ipv4>();
+    if (!ipv4)
+    {
+        return;
+    }
+
+    uint32_t token = GetToken(m_peerKey);
+    for (uint32_t i = 0; i < ipv4->GetNInterfaces(); ++i)
+    {
+        if (!ipv4->IsUp(i))
+        {
+            continue;
+        }
+        for (uint32_t j = 0; j < ipv4->GetNAddresses(i); ++j)
+        {
+            Ipv4InterfaceAddress ifAddress = ipv4->GetAddress(i, j);
+            Ipv4Address local = ifAddress.GetLocal();
+            if (local.IsLocalhost())
+            {
+                continue;
+            }
+            for (const auto& peer : m_peerAddresses)
+            {
+                if (m_subflows.size() >= m_maxSubflows)
+                {
+                    return;
+                }
+                if (m_usedPairs.count({local, peer.first}) ||
+                    (!m_fullMesh && !ifAddress.GetMask().IsMatch(local, peer.first)))
+                {
+                    continue;
+                }
+                m_usedPairs.insert({local, peer.first});
+
+                NS_LOG_LOGIC("Opening a subflow from " << local << " to " << peer.first);
+                Ptr<MpTcpSubflow> subflow = CreateSubflow();
+                subflow->SetJoin(token, static_cast<uint8_t>(i));
+                if (subflow->Bind(InetSocketAddress(local, 0)) != 0)
+                {
+                    continue;
+                }
+                subflow->BindToNetDevice(ipv4->GetNetDevice(i));
+                AttachSubflow(subflow);
+                subflow->SetConnectCallback(
+                    MakeCallback(&MpTcpSocketBase::SubflowConnected, this),
+                    MakeCallback(&MpTcpSocketBase::SubflowConnectionFailed, this));
+                subflow->Connect(InetSocketAddress(peer.first, m_peerPort));
+            }
+        }
+    }
+}
+
+void
+MpTcpSocketBase::AnnounceAddresses(Ptr<MpTcpSubflow> subflow)
+{
+    NS_LOG_FUNCTION(this << subflow);
+
+    Ptr<Ipv4> ipv4 = m_node->GetObject<Ipv4>();
+    Address name;
+    if (!ipv4 || subflow->GetSockName(name) != 0 || !InetSocketAddress::IsMatchingType(name))
+    {
+        return;
+    }
+
+    Ipv4Address used = InetSocketAddress::ConvertFrom(name).GetIpv4();
+    for (uint32_t i = 0; i < ipv4->GetNInterfaces(); ++i)
+    {
+        if (!ipv4->IsUp(i))
+        {
+            continue;
+        }
+        for (uint32_t j = 0; j < ipv4->GetNAddresses(i); ++j)
+        {
+            Ipv4Address local = ipv4->GetAddress(i, j).GetLocal();
+            if (!local.IsLocalhost() && local != used)
+            {
+                subflow->AnnounceAddress(local, static_cast<uint8_t>(i));
+            }
+        }
+    }
+}
+
+void
+MpTcpSocketBase::AddRemoteAddress(const Address& address, uint8_t addressId)
+{
+    NS_LOG_FUNCTION(this << address << +addressId);
+
+    if (!Ipv4Address::IsMatchingType(address))
+    {
+        return;
+    }
+    Ipv4Address peer = Ipv4Address::ConvertFrom(address);
+    for (const auto& known : m_peerAddresses)
+    {
+        if (known.first == peer)
+        {
+            return;
+        }
+    }
+    m_peerAddresses.emplace_back(peer, addressId);
+
+    if (m_isClient && m_connected && !m_fallback && !m_subflowsClosing)
+    {
+        CreateJoinSubflows();
+    }
+}
+
+// Data transfer
+
+Ptr<MpTcpSubflow>
+MpTcpSocketBase::SelectSubflow(const MpTcpSubflow* exclude) const
+{
+    Ptr<MpTcpSubflow> best;
+    Ptr<MpTcpSubflow> excluded;
+    for (const auto& subflow : m_subflows)
+    {
+        uint32_t space = subflow->GetSendSpace();
+        if (space == 0 || (space < m_segmentSize && space < m_unsentSize))
+        {
+            continue;
+        }
+        if (PeekPointer(subflow) == exclude)
+        {
+            excluded = subflow;
+        }
+        else if (!best || subflow->GetRttEstimate() < best->GetRttEstimate())
+        {
+            best = subflow;
+        }
+    }
+    return best ? best : excluded;
+}
+
+void
+MpTcpSocketBase::SendPendingData()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_connected)
+    {
+        return;
+    }
+
+    // Mappings are at most 64 KB long; keep them a multiple of the segment size
+    uint32_t maxChunk = std::numeric_limits<uint16_t>::max() / m_segmentSize * m_segmentSize;
+
+    while (true)
+    {
+        // Reinjected data goes first, on a subflow other than the one that lost it
+        while (!m_reinject.empty() && m_inFlight.find(m_reinject.front()) == m_inFlight.end())
+        {
+            m_reinject.pop_front();
+        }
+        if (!m_reinject.empty())
+        {
+            auto it = m_inFlight.find(m_reinject.front());
+            Ptr<MpTcpSubflow> subflow = SelectSubflow(it->second.subflow);
+            if (!subflow)
+            {
+                break;
+            }
+            m_reinject.pop_front();
+            if (PeekPointer(subflow) != it->second.subflow &&
+                subflow->SendMapping(it->second.packet->Copy(), it->first) > 0)
+            {
+                NS_LOG_LOGIC("Reinjected " << it->second.packet->GetSize() << " bytes at "
+                                           << it->first);
+                it->second.subflow = PeekPointer(subflow);
+            }
+            continue;
+        }
+
+        if (m_unsentSize == 0)
+        {
+            break;
+        }
+        Ptr<MpTcpSubflow> subflow = SelectSubflow(nullptr);
+        if (!subflow)
+        {
+            break;
+        }
+
+        uint32_t size = std::min({subflow->GetSendSpace(), m_unsentSize, maxChunk});
+        Ptr<Packet> chunk = Create<Packet>();
+        while (chunk->GetSize() < size)
+        {
+            Ptr<Packet> front = m_unsent.front();
+            uint32_t needed = size - chunk->GetSize();
+            if (front->GetSize() <= needed)
+            {
+                chunk->AddAtEnd(front);
+                m_unsent.pop_front();
+            }
+            else
+            {
+                chunk->AddAtEnd(front->CreateFragment(0, needed));
+                m_unsent.front() = front->CreateFragment(needed, front->GetSize() - needed);
+            }
+        }
+        m_unsentSize -= size;
+
+        uint64_t dataSeq = m_txNextDataSeq;
+        int sent = subflow->SendMapping(chunk->Copy(), dataSeq);
+        NS_ASSERT_MSG(sent == static_cast<int>(size), "Subflow refused " << size << " bytes");
+        m_txNextDataSeq += size;
+        if (!m_fallback)
+        {
+            m_inFlight[dataSeq] = {chunk, PeekPointer(subflow), false};
+            m_inFlightSize += size;
+        }
+        NS_LOG_LOGIC("Sent " << size << " bytes at " << dataSeq << " on " << subflow);
+        NotifyDataSent(size);
+    }
+
+    if ((m_closeOnEmpty || m_shutdownSend) && m_unsentSize == 0 && m_reinject.empty())
+    {
+        CloseSubflows();
+    }
+}
+
+void
+MpTcpSocketBase::CloseSubflows()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_subflowsClosing)
+    {
+        return;
+    }
+    m_subflowsClosing = true;
+    for (auto& subflow : m_subflows)
+    {
+        if (m_closeOnEmpty)
+        {
+            subflow->Close();
+        }
+        else
+        {
+            subflow->ShutdownSend();
+        }
+    }
+}
+
+void
+MpTcpSocketBase::ReceivedDataAck(uint64_t dataAck)
+{
+    NS_LOG_FUNCTION(this << dataAck);
+
+    uint32_t acked = 0;
+    auto it = m_inFlight.begin();
+    while (it != m_inFlight.end() && it->first + it->second.packet->GetSize() <= dataAck)
+    {
+        acked += it->second.packet->GetSize();
+        it = m_inFlight.erase(it);
+    }
+
+    if (acked > 0)
+    {
+        m_inFlightSize -= acked;
+        NotifySend(GetTxAvailable());
+    }
+}
+
+void
+MpTcpSocketBase::SubflowTimeout(MpTcpSubflow* subflow)
+{
+    NS_LOG_FUNCTION(this << subflow);
+
+    bool alternative = false;
+    for (const auto& other : m_subflows)
+    {
+        alternative |= (PeekPointer(other) != subflow && other->IsEstablished());
+    }
+    if (!alternative)
+    {
+        return;
+    }
+
+    for (auto& [dataSeq, inFlight] : m_inFlight)
+    {
+        if (inFlight.subflow == subflow && !inFlight.reinjected)
+        {
+            inFlight.reinjected = true;
+            m_reinject.push_back(dataSeq);
+        }
+    }
+    SendPendingData();
+}
+
+void
+MpTcpSocketBase::ReceivedData(uint64_t dataSeq, Ptr<Packet> p)
+{
+    NS_LOG_FUNCTION(this << dataSeq << p);
+
+    uint64_t end = dataSeq + p->GetSize();
+    if (end <= m_rxNextDataSeq)
+    {
+        NS_LOG_LOGIC("Duplicate data at " << dataSeq);
+        return;
+    }
+    if (dataSeq > m_rxNextDataSeq)
+    {
+        auto it = m_rxOutOfOrder.find(dataSeq);
+        if (it == m_rxOutOfOrder.end() || it->second->GetSize() < p->GetSize())
+        {
+            m_rxOutOfOrder[dataSeq] = p;
+        }
+        return;
+    }
+
+    while (p)
+    {
+        if (dataSeq < m_rxNextDataSeq)
+        {
+            p->RemoveAtStart(m_rxNextDataSeq - dataSeq);
+        }
+        m_rxNextDataSeq += p->GetSize();
+        if (!m_shutdownRecv)
+        {
+            m_rxReady.push_back(p);
+            m_rxReadySize += p->GetSize();
+        }
+
+        p = nullptr;
+        while (!m_rxOutOfOrder.empty() && m_rxOutOfOrder.begin()->first <= m_rxNextDataSeq)
+        {
+            auto it = m_rxOutOfOrder.begin();
+            if (it->first + it->second->GetSize() > m_rxNextDataSeq)
+            {
+                dataSeq = it->first;
+                p = it->second;
+                m_rxOutOfOrder.erase(it);
+                break;
+            }
+            m_rxOutOfOrder.erase(it);
+        }
+    }
+}
+
+// Callbacks of the subflows
+
+void
+MpTcpSocketBase::SubflowConnected(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    Ptr<MpTcpSubflow> subflow = DynamicCast<MpTcpSubflow>(socket);
+    if (!m_connected)
+    {
+        m_connected = true;
+        m_fallback = !subflow->IsMpTcpCapable();
+        if (!m_fallback)
+        {
+            m_peerKey = subflow->GetPeerKey();
+            SetupDataSequence();
+            Address name;
+            if (subflow->GetSockName(name) == 0 && InetSocketAddress::IsMatchingType(name) &&
+                !m_peerAddresses.empty())
+            {
+                m_usedPairs.insert({InetSocketAddress::ConvertFrom(name).GetIpv4(),
+                                    m_peerAddresses.front().first});
+            }
+        }
+        NS_LOG_LOGIC("Connection established" << (m_fallback ? " (fallback to TCP)" : ""));
+        NotifyConnectionSucceeded();
+        if (!m_fallback)
+        {
+            CreateJoinSubflows();
+        }
+    }
+    else if (!subflow->IsMpTcpCapable() || m_subflowsClosing)
+    {
+        subflow->Close();
+    }
+    SendPendingData();
+}
+
+void
+MpTcpSocketBase::SubflowConnectionFailed(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    m_closedSubflows.insert(PeekPointer(DynamicCast<MpTcpSubflow>(socket)));
+    if (!m_connected && socket == m_subflows.front())
+    {
+        NotifyConnectionFailed();
+    }
+}
+
+bool
+MpTcpSocketBase::SubflowConnectionRequest(Ptr<Socket> socket, const Address& from)
+{
+    NS_LOG_FUNCTION(this << socket << from);
+
+    Ptr<MpTcpSubflow> subflow = DynamicCast<MpTcpSubflow>(socket);
+    if (subflow->IsJoin())
+    {
+        auto it = m_tokens.find(subflow->GetJoinToken());
+        return it != m_tokens.end() && it->second->m_subflows.size() < m_maxSubflows;
+    }
+    return NotifyConnectionRequest(from);
+}
+
+void
+MpTcpSocketBase::SubflowAccepted(Ptr<Socket> socket, const Address& from)
+{
+    NS_LOG_FUNCTION(this << socket << from);
+
+    Ptr<MpTcpSubflow> subflow = DynamicCast<MpTcpSubflow>(socket);
+    if (subflow->IsJoin())
+    {
+        auto it = m_tokens.find(subflow->GetJoinToken());
+        if (it == m_tokens.end())
+        {
+            subflow->Detach();
+            subflow->Close();
+            return;
+        }
+        it->second->AttachSubflow(subflow);
+        it->second->SendPendingData();
+        return;
+    }
+
+    Ptr<MpTcpSocketBase> connection = CopyObject<MpTcpSocketBase>(this);
+    connection->m_connected = true;
+    connection->m_fallback = !subflow->IsMpTcpCapable();
+    connection->AttachSubflow(subflow);
+    if (!connection->m_fallback)
+    {
+        connection->m_localKey = subflow->GetLocalKey();
+        connection->m_peerKey = subflow->GetPeerKey();
+        connection->SetupDataSequence();
+        connection->AnnounceAddresses(subflow);
+        m_tokens[GetToken(connection->m_localKey)] = connection;
+        connection->m_listener = this;
+    }
+    NotifyNewConnectionCreated(connection, from);
+}
+
+void
+MpTcpSocketBase::SubflowRecv(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    Ptr<MpTcpSubflow> subflow = DynamicCast<MpTcpSubflow>(socket);
+    uint32_t ready = m_rxReadySize;
+    Ptr<Packet> p;
+    if (m_fallback)
+    {
+        while ((p = subflow->Recv(std::numeric_limits<uint32_t>::max(), 0)) && p->GetSize() > 0)
+        {
+            ReceivedData(m_rxNextDataSeq, p);
+        }
+    }
+    else
+    {
+        uint64_t dataSeq;
+        while ((p = subflow->RecvMapped(dataSeq)))
+        {
+            ReceivedData(dataSeq, p);
+        }
+    }
+
+    if (m_rxReadySize > ready)
+    {
+        NotifyDataRecv();
+    }
+}
+
+void
+MpTcpSocketBase::SubflowSend(Ptr<Socket> socket, uint32_t available)
+{
+    NS_LOG_FUNCTION(this << socket << available);
+    SendPendingData();
+    if (m_fallback && GetTxAvailable() > 0)
+    {
+        // there are no data ACKs after a fallback: the buffer space is
+        // released as soon as the subflow accepts the data
+        NotifySend(GetTxAvailable());
+    }
+}
+
+void
+MpTcpSocketBase::SubflowNormalClose(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    m_closedSubflows.insert(PeekPointer(DynamicCast<MpTcpSubflow>(socket)));
+    if (m_closedSubflows.size() == m_subflows.size() && !m_closeNotified)
+    {
+        m_closeNotified = true;
+        ReleaseToken();
+        NotifyNormalClose();
+    }
+}
+
+void
+MpTcpSocketBase::SubflowErrorClose(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+
+    const MpTcpSubflow* subflow = PeekPointer(DynamicCast<MpTcpSubflow>(socket));
+    m_closedSubflows.insert(subflow);
+    for (auto& [dataSeq, inFlight] : m_inFlight)
+    {
+        if (inFlight.subflow == subflow)
+        {
+            m_reinject.push_back(dataSeq);
+        }
+    }
+    SendPendingData();
+
+    if (m_closedSubflows.size() == m_subflows.size() && !m_closeNotified)
+    {
+        m_closeNotified = true;
+        ReleaseToken();
+        NotifyErrorClose();
+    }
+}
+
+void
+MpTcpSocketBase::ReleaseToken()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_listener)
+    {
+        // erased later, as the listening socket may hold the last reference
+        Simulator::ScheduleNow(&MpTcpSocketBase::EraseToken,
+                               Ptr<MpTcpSocketBase>(m_listener),
+                               GetToken(m_localKey));
+        m_listener = nullptr;
+    }
+}
+
+void
+MpTcpSocketBase::EraseToken(uint32_t token)
+{
+    NS_LOG_FUNCTION(this << token);
+    m_tokens.erase(token);
+}
+
+// TcpSocket attributes
+
+void
+MpTcpSocketBase::SetSndBufSize(uint32_t size)
+{
+    m_sndBufSize = size;
+}
+
+uint32_t
+MpTcpSocketBase::GetSndBufSize() const
+{
+    return m_sndBufSize;
+}
+
+void
+MpTcpSocketBase::SetRcvBufSize(uint32_t size)
+{
+    m_rcvBufSize = size;
+}
+
+uint32_t
+MpTcpSocketBase::GetRcvBufSize() const
+{
+    return m_rcvBufSize;
+}
+
+void
+MpTcpSocketBase::SetSegSize(uint32_t size)
+{
+    m_segmentSize = size;
+}
+
+uint32_t
+MpTcpSocketBase::GetSegSize() const
+{
+    return m_segmentSize;
+}
+
+void
+MpTcpSocketBase::SetInitialSSThresh(uint32_t threshold)
+{
+    m_initialSsThresh = threshold;
+}
+
+uint32_t
+MpTcpSocketBase::GetInitialSSThresh() const
+{
+    return m_initialSsThresh;
+}
+
+void
+MpTcpSocketBase::SetInitialCwnd(uint32_t cwnd)
+{
+    m_initialCwnd = cwnd;
+}
+
+uint32_t
+MpTcpSocketBase::GetInitialCwnd() const
+{
+    return m_initialCwnd;
+}
+
+void
+MpTcpSocketBase::SetConnTimeout(Time timeout)
+{
+    m_cnTimeout = timeout;
+}
+
+Time
+MpTcpSocketBase::GetConnTimeout() const
+{
+    return m_cnTimeout;
+}
+
+void
+MpTcpSocketBase::SetSynRetries(uint32_t count)
+{
+    m_synRetries = count;
+}
+
+uint32_t
+MpTcpSocketBase::GetSynRetries() const
+{
+    return m_synRetries;
+}
+
+void
+MpTcpSocketBase::SetDataRetries(uint32_t retries)
+{
+    m_dataRetries = retries;
+}
+
+uint32_t
+MpTcpSocketBase::GetDataRetries() const
+{
+    return m_dataRetries;
+}
+
+void
+MpTcpSocketBase::SetDelAckTimeout(Time timeout)
+{
+    m_delAckTimeout = timeout;
+}
+
+Time
+MpTcpSocketBase::GetDelAckTimeout() const
+{
+    return m_delAckTimeout;
+}
+
+void
+MpTcpSocketBase::SetDelAckMaxCount(uint32_t count)
+{
+    m_delAckMaxCount = count;
+}
+
+uint32_t
+MpTcpSocketBase::GetDelAckMaxCount() const
+{
+    return m_delAckMaxCount;
+}
+
+void
+MpTcpSocketBase::SetTcpNoDelay(bool noDelay)
+{
+    m_noDelay = noDelay;
+}
+
+bool
+MpTcpSocketBase::GetTcpNoDelay() const
+{
+    return m_noDelay;
+}
+
+void
+MpTcpSocketBase::SetPersistTimeout(Time timeout)
+{
+    m_persistTimeout = timeout;
+}
+
+Time
+MpTcpSocketBase::GetPersistTimeout() const
+{
+    return m_persistTimeout;
+}
+
+} // namespace ns3
@@ -0,0 +1,413 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MPTCP_SOCKET_BASE_H
+#define MPTCP_SOCKET_BASE_H
+
+#include "tcp-socket.h"
+
+#include "ns3/ipv4-address.h"
+
+#include <deque>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace ns3
+{
+
+class MpTcpSubflow;
+class Node;
+class Packet;
+class TcpL4Protocol;
+class UniformRandomVariable;
+
+/**
+ * \ingroup tcp
+ *
+ * \brief A Multipath TCP connection (\RFC{8684})
+ *
+ * This class is the socket seen by the application (the "meta" socket). It
+ * owns the data of the connection and spreads it over a set of subflows,
+ * each one being an MpTcpSubflow, i.e., a TcpSocketBase carrying the MPTCP
+ * options. Sockets of this type are created through the MpTcpSocketFactory,
+ * so that the usual applications can use MPTCP:
+ *
+ * \code
+ *   BulkSendHelper source("ns3::MpTcpSocketFactory", InetSocketAddress(serverAddress, port));
+ *   PacketSinkHelper sink("ns3::MpTcpSocketFactory", InetSocketAddress(Ipv4Address::GetAny(),
+ *                                                                      port));
+ * \endcode
+ *
+ * Connection management: the first subflow is opened with the MP_CAPABLE
+ * option, which exchanges the keys of the two ends. If the peer does not
+ * answer with MP_CAPABLE, the connection falls back to regular TCP over the
+ * first subflow. The passive opener announces its other IPv4 addresses with
+ * ADD_ADDR; the active opener then opens additional subflows with MP_JOIN,
+ * from each of its IPv4 addresses to each known address of the peer that is
+ * on the same network (or to all of them, if the FullMesh attribute is set).
+ *
+ * Data transfer: the data written by the application is cut in chunks, each
+ * one mapped to a range of the data sequence space and handed to the subflow
+ * with the lowest RTT that has room in its congestion window. The data is kept
+ * until it is acknowledged at the data level (DSS data ACK): when a subflow
+ * experiences a retransmission timeout, its unacknowledged data is reinjected
+ * on the other subflows. The receiver reorders the data received on all the
+ * subflows according to the data sequence numbers.
+ *
+ * The subflows use the congestion control set by the CongestionOps attribute;
+ * when it is a MpTcpCongestionOps (LIA, OLIA or BALIA), the controls of the
+ * subflows of a connection are coupled.
+ *
+ * Limitations: the keys and the ADD_ADDR option follow \RFC{6824} (no HMAC is
+ * computed or verified), DATA_FIN is not used (the connection is closed by
+ * closing all the subflows), there is no data-level receive window, and the
+ * path manager only handles IPv4 addresses.
+ */
+class MpTcpSocketBase : public TcpSocket
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    MpTcpSocketBase();
+
+    /**
+     * \brief Clone the configuration of a listening socket
+     * \param sock the socket to copy
+     */
+    MpTcpSocketBase(const MpTcpSocketBase& sock);
+    ~MpTcpSocketBase() override;
+
+    /**
+     * \brief Set the associated node.
+     * \param node the node
+     */
+    void SetNode(Ptr<Node> node);
+
+    /**
+     * \brief Set the associated TCP L4 protocol.
+     * \param tcp the TCP L4 protocol
+     */
+    void SetTcp(Ptr<TcpL4Protocol> tcp);
+
+    /**
+     * \brief Set the source of the keys and nonces of the connection
+     *
+     * The MpTcpSocketFactory shares its random variable, whose stream is
+     * assigned by MpTcpSocketFactory::AssignStreams, among its sockets.
+     * Otherwise, a random variable is created with the first subflow.
+     *
+     * \param rng the random variable
+     */
+    void SetRandomVariable(Ptr<UniformRandomVariable> rng);
+
+    /**
+     * \brief Get the number of subflows of the connection
+     * \return the number of subflows, including the ones that are closed
+     */
+    uint32_t GetNSubflows() const;
+
+    /**
+     * \brief Get a subflow of the connection
+     * \param index the index of the subflow, the first one being the initial subflow
+     * \return the subflow
+     */
+    Ptr<MpTcpSubflow> GetSubflow(uint32_t index) const;
+
+    /**
+     * \brief Check if the connection fell back to regular TCP
+     * \return true if the peer does not support MPTCP
+     */
+    bool IsFallback() const;
+
+    // Interface of the subflows
+
+    /**
+     * \brief Check if the data ACK of the connection can be sent
+     * \return true once the data sequence numbers are known
+     */
+    bool HasDataAck() const;
+
+    /**
+     * \brief Get the data ACK of the connection
+     * \return the next data sequence number expected
+     */
+    uint64_t GetDataAck() const;
+
+    /**
+     * \brief Process a data ACK received on a subflow
+     * \param dataAck the next data sequence number expected by the peer
+     */
+    void ReceivedDataAck(uint64_t dataAck);
+
+    /**
+     * \brief Process an address announced by the peer with ADD_ADDR
+     * \param address the address of the peer
+     * \param addressId the identifier of the address
+     */
+    void AddRemoteAddress(const Address& address, uint8_t addressId);
+
+    /**
+     * \brief Reinject the unacknowledged data of a subflow on the other subflows
+     * \param subflow the subflow that experienced a retransmission timeout
+     */
+    void SubflowTimeout(MpTcpSubflow* subflow);
+
+    // Implementation of ns3::Socket
+    SocketErrno GetErrno() const override;
+    SocketType GetSocketType() const override;
+    Ptr<Node> GetNode() const override;
+    int Bind() override;
+    int Bind6() override;
+    int Bind(const Address& address) override;
+    int Connect(const Address& address) override;
+    int Listen() override;
+    int Close() override;
+    int ShutdownSend() override;
+    int ShutdownRecv() override;
+    int Send(Ptr<Packet> p, uint32_t flags) override;
+    int SendTo(Ptr<Packet> p, uint32_t flags, const Address& toAddress) override;
+    Ptr<Packet> Recv(uint32_t maxSize, uint32_t flags) override;
+    Ptr<Packet> RecvFrom(uint32_t maxSize, uint32_t flags, Address& fromAddress) override;
+    uint32_t GetTxAvailable() const override;
+    uint32_t GetRxAvailable() const override;
+    int GetSockName(Address& address) const override;
+    int GetPeerName(Address& address) const override;
+    void BindToNetDevice(Ptr<NetDevice> netdevice) override;
+    bool SetAllowBroadcast(bool allowBroadcast) override;
+    bool GetAllowBroadcast() const override;
+
+  protected:
+    // Implementation of ns3::TcpSocket attributes, applied to the subflows
+    void SetSndBufSize(uint32_t size) override;
+    uint32_t GetSndBufSize() const override;
+    void SetRcvBufSize(uint32_t size) override;
+    uint32_t GetRcvBufSize() const override;
+    void SetSegSize(uint32_t size) override;
+    uint32_t GetSegSize() const override;
+    void SetInitialSSThresh(uint32_t threshold) override;
+    uint32_t GetInitialSSThresh() const override;
+    void SetInitialCwnd(uint32_t cwnd) override;
+    uint32_t GetInitialCwnd() const override;
+    void SetConnTimeout(Time timeout) override;
+    Time GetConnTimeout() const override;
+    void SetSynRetries(uint32_t count) override;
+    uint32_t GetSynRetries() const override;
+    void SetDataRetries(uint32_t retries) override;
+    uint32_t GetDataRetries() const override;
+    void SetDelAckTimeout(Time timeout) override;
+    Time GetDelAckTimeout() const override;
+    void SetDelAckMaxCount(uint32_t count) override;
+    uint32_t GetDelAckMaxCount() const override;
+    void SetTcpNoDelay(bool noDelay) override;
+    bool GetTcpNoDelay() const override;
+    void SetPersistTimeout(Time timeout) override;
+    Time GetPersistTimeout() const override;
+
+  private:
+    /**
+     * \brief Create a subflow, configured with the attributes of this socket
+     * \return the new subflow
+     */
+    Ptr<MpTcpSubflow> CreateSubflow();
+
+    /**
+     * \brief Make a subflow part of this connection
+     * \param subflow the subflow
+     */
+    void AttachSubflow(Ptr<MpTcpSubflow> subflow);
+
+    /**
+     * \brief Initialize the data sequence numbers once the keys are known
+     */
+    void SetupDataSequence();
+
+    /**
+     * \brief Open the subflows between the pairs of addresses not yet used
+     */
+    void CreateJoinSubflows();
+
+    /**
+     * \brief Announce the local IPv4 addresses not used by a subflow
+     * \param subflow the subflow carrying the ADD_ADDR options
+     */
+    void AnnounceAddresses(Ptr<MpTcpSubflow> subflow);
+
+    /**
+     * \brief Hand the pending data to the subflows that have room for it
+     */
+    void SendPendingData();
+
+    /**
+     * \brief Select the subflow to send data on
+     * \param exclude a subflow to avoid, if there is another choice
+     * \return the established subflow with free space and the lowest RTT, or nullptr
+     */
+    Ptr<MpTcpSubflow> SelectSubflow(const MpTcpSubflow* exclude) const;
+
+    /**
+     * \brief Close the subflows, once all the data has been given to them
+     */
+    void CloseSubflows();
+
+    /**
+     * \brief Store data received on a subflow
+     * \param dataSeq the data sequence number of the first byte
+     * \param p the data
+     */
+    void ReceivedData(uint64_t dataSeq, Ptr<Packet> p);
+
+    /**
+     * \brief Remove the connection from the ones of its listening socket,
+     * once all its subflows are closed
+     */
+    void ReleaseToken();
+
+    /**
+     * \brief Forget an accepted connection
+     * \param token the token of the connection
+     */
+    void EraseToken(uint32_t token);
+
+    // Callbacks of the subflows
+    /**
+     * \brief A subflow completed its handshake
+     * \param socket the subflow
+     */
+    void SubflowConnected(Ptr<Socket> socket);
+
+    /**
+     * \brief A subflow failed to complete its handshake
+     * \param socket the subflow
+     */
+    void SubflowConnectionFailed(Ptr<Socket> socket);
+
+    /**
+     * \brief A listening subflow received a SYN
+     * \param socket the listening subflow
+     * \param from the address of the peer
+     * \return true if the connection is accepted
+     */
+    bool SubflowConnectionRequest(Ptr<Socket> socket, const Address& from);
+
+    /**
+     * \brief A listening subflow accepted a new subflow
+     * \param socket the new subflow
+     * \param from the address of the peer
+     */
+    void SubflowAccepted(Ptr<Socket> socket, const Address& from);
+
+    /**
+     * \brief Data was received on a subflow
+     * \param socket the subflow
+     */
+    void SubflowRecv(Ptr<Socket> socket);
+
+    /**
+     * \brief Room was made in the buffer of a subflow
+     * \param socket the subflow
+     * \param available the free space of the buffer
+     */
+    void SubflowSend(Ptr<Socket> socket, uint32_t available);
+
+    /**
+     * \brief A subflow was closed (or the peer closed it)
+     * \param socket the subflow
+     */
+    void SubflowNormalClose(Ptr<Socket> socket);
+
+    /**
+     * \brief A subflow was closed because of an error
+     * \param socket the subflow
+     */
+    void SubflowErrorClose(Ptr<Socket> socket);
+
+    /**
+     * \brief Data handed to a subflow and not yet acknowledged at the data level
+     */
+    struct InFlight
+    {
+        Ptr<Packet> packet;    //!< The data
+        MpTcpSubflow* subflow; //!< The subflow that carries it
+        bool reinjected;       //!< True if the data was already reinjected
+    };
+
+    // Connection
+    Ptr<Node> m_node;                                  //!< The associated node
+    Ptr<TcpL4Protocol> m_tcp;                          //!< The associated TCP L4 protocol
+    std::vector<Ptr<MpTcpSubflow>> m_subflows;         //!< The subflows of the connection
+    std::set<const MpTcpSubflow*> m_closedSubflows;    //!< Subflows closed
+    Ptr<MpTcpSubflow> m_initial;                       //!< Subflow bound, not yet connected
+    std::map<uint32_t, Ptr<MpTcpSocketBase>> m_tokens; //!< Connections accepted, by token
+    MpTcpSocketBase* m_listener{nullptr};              //!< Socket that accepted the connection
+    mutable SocketErrno m_errno{ERROR_NOTERROR};       //!< Socket error code
+    bool m_connected{false};                           //!< The first subflow is established
+    bool m_fallback{false};                            //!< The peer does not support MPTCP
+    bool m_isClient{false};                            //!< This end opened the connection
+    bool m_closeOnEmpty{false};                        //!< Close the subflows once data is sent
+    bool m_shutdownSend{false};                        //!< Send no longer allowed
+    bool m_shutdownRecv{false};                        //!< Receive no longer allowed
+    bool m_closeNotified{false};                       //!< The application was told of the close
+    bool m_subflowsClosing{false};                     //!< The subflows were asked to close
+    uint64_t m_localKey{0};                            //!< Key of the local end
+    uint64_t m_peerKey{0};                             //!< Key of the remote end
+    Ptr<NetDevice> m_boundDevice;                      //!< Device the first subflow is bound to
+    Ptr<UniformRandomVariable> m_rng;                  //!< Source of the keys and nonces
+
+    // Path manager
+    uint16_t m_peerPort{0};                                       //!< Port of the peer
+    std::vector<std::pair<Ipv4Address, uint8_t>> m_peerAddresses; //!< Known peer addresses
+    std::set<std::pair<Ipv4Address, Ipv4Address>> m_usedPairs;    //!< (local, peer) pairs used
+
+    // Transmission
+    std::deque<Ptr<Packet>> m_unsent;        //!< Data written by the application, not yet sent
+    uint32_t m_unsentSize{0};                //!< Size of the data not yet sent
+    uint64_t m_txNextDataSeq{0};             //!< Next data sequence number to send
+    std::map<uint64_t, InFlight> m_inFlight; //!< Data not acknowledged, by sequence number
+    uint32_t m_inFlightSize{0};              //!< Size of the data not acknowledged
+    std::deque<uint64_t> m_reinject;         //!< Data to reinject, by sequence number
+
+    // Reception
+    bool m_rxStarted{false};                        //!< The receive data sequence is known
+    uint64_t m_rxNextDataSeq{0};                    //!< Next data sequence number expected
+    std::map<uint64_t, Ptr<Packet>> m_rxOutOfOrder; //!< Data received out of order
+    std::deque<Ptr<Packet>> m_rxReady;              //!< Data ready for the application
+    uint32_t m_rxReadySize{0};                      //!< Size of the data ready
+
+    // Attributes
+    TypeId m_congestionTypeId;  //!< Congestion control of the subflows
+    uint32_t m_maxSubflows;     //!< Maximum number of subflows of a connection
+    bool m_fullMesh;            //!< Open subflows between all pairs of addresses
+    uint32_t m_sndBufSize;      //!< Send buffer size
+    uint32_t m_rcvBufSize;      //!< Receive buffer size of the subflows
+    uint32_t m_segmentSize;     //!< Segment size
+    uint32_t m_initialSsThresh; //!< Initial slow start threshold
+    uint32_t m_initialCwnd;     //!< Initial congestion window, in segments
+    Time m_cnTimeout;           //!< Timeout for connection retry
+    uint32_t m_synRetries;      //!< Number of connection attempts
+    uint32_t m_dataRetries;     //!< Number of data retransmission attempts
+    Time m_delAckTimeout;       //!< Time to delay an ACK
+    uint32_t m_delAckMaxCount;  //!< Number of packets to fire an ACK before delay timeout
+    bool m_noDelay;             //!< Disable Nagle's algorithm
+    Time m_persistTimeout;      //!< Time between sending 1-byte probes
+};
+
+} // namespace ns3
+
+#endif /* MPTCP_SOCKET_BASE_H */
@@ -0,0 +1,93 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "mptcp-socket-factory.h"
+
+#include "mptcp-socket-base.h"
+#include "tcp-l4-protocol.h"
+
+#include "ns3/assert.h"
+#include "ns3/integer.h"
+#include "ns3/node.h"
+#include "ns3/object-factory.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/socket.h"
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(MpTcpSocketFactory);
+
+TypeId
+MpTcpSocketFactory::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MpTcpSocketFactory").SetParent<SocketFactory>().SetGroupName("Internet");
+    return tid;
+}
+
+MpTcpSocketFactory::MpTcpSocketFactory()
+    : m_tcp(nullptr)
+{
+}
+
+MpTcpSocketFactory::~MpTcpSocketFactory()
+{
+    NS_ASSERT(!m_tcp);
+}
+
+void
+MpTcpSocketFactory::SetTcp(Ptr<TcpL4Protocol> tcp)
+{
+    m_tcp = tcp;
+}
+
+Ptr<Socket>
+MpTcpSocketFactory::CreateSocket()
+{
+    if (!m_rng)
+    {
+        m_rng = CreateObject<UniformRandomVariable>();
+    }
+    Ptr<MpTcpSocketBase> socket = CreateObject<MpTcpSocketBase>();
+    socket->SetNode(m_tcp->GetObject<Node>());
+    socket->SetTcp(m_tcp);
+    socket->SetRandomVariable(m_rng);
+    return socket;
+}
+
+int64_t
+MpTcpSocketFactory::AssignStreams(int64_t stream)
+{
+    if (m_rng)
+    {
+        m_rng->SetStream(stream);
+    }
+    else
+    {
+        // setting the stream at construction does not consume an automatic stream
+        m_rng = CreateObjectWithAttributes<UniformRandomVariable>("Stream", IntegerValue(stream));
+    }
+    return 1;
+}
+
+void
+MpTcpSocketFactory::DoDispose()
+{
+    m_tcp = nullptr;
+    m_rng = nullptr;
+    SocketFactory::DoDispose();
+}
+
+} // namespace ns3
@@ -0,0 +1,78 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef MPTCP_SOCKET_FACTORY_H
+#define MPTCP_SOCKET_FACTORY_H
+
+#include "ns3/ptr.h"
+#include "ns3/socket-factory.h"
+
+namespace ns3
+{
+
+class TcpL4Protocol;
+class UniformRandomVariable;
+
+/**
+ * \ingroup socket
+ * \ingroup tcp
+ *
+ * \brief socket factory for Multipath TCP
+ *
+ * This class serves to create sockets of the MpTcpSocketBase type. It is
+ * aggregated to the node together with the TcpL4Protocol, so that the
+ * applications can use "ns3::MpTcpSocketFactory" as their protocol.
+ */
+class MpTcpSocketFactory : public SocketFactory
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    MpTcpSocketFactory();
+    ~MpTcpSocketFactory() override;
+
+    /**
+     * \brief Set the associated TCP L4 protocol.
+     * \param tcp the TCP L4 protocol
+     */
+    void SetTcp(Ptr<TcpL4Protocol> tcp);
+
+    Ptr<Socket> CreateSocket() override;
+
+    /**
+     * Assign a fixed random variable stream number to the random variable
+     * used by the sockets created by this factory to generate their keys
+     * and nonces.  Return the number of streams (possibly zero) that have
+     * been assigned.
+     *
+     * \param stream first stream index to use
+     * \return the number of stream indices assigned by this factory
+     */
+    int64_t AssignStreams(int64_t stream);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    Ptr<TcpL4Protocol> m_tcp;          //!< the associated TCP L4 protocol
+    Ptr<UniformRandomVariable> m_rng; //!< Source of the keys and nonces of the sockets
+};
+
+} // namespace ns3
+
+#endif /* MPTCP_SOCKET_FACTORY_H */
@@ -0,0 +1,535 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mptcp-subflow.h"
+
+#include "mptcp-socket-base.h"
+#include "rtt-estimator.h"
+#include "tcp-congestion-ops.h"
+#include "tcp-header.h"
+#include "tcp-option-mptcp.h"
+#include "tcp-tx-buffer.h"
+
+#include "ns3/abort.h"
+#include "ns3/hash.h"
+#include "ns3/log.h"
+#include "ns3/random-variable-stream.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MpTcpSubflow");
+
+NS_OBJECT_ENSURE_REGISTERED(MpTcpSubflow);
+
+TypeId
+MpTcpSubflow::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::MpTcpSubflow")
+                            .SetParent<TcpSocketBase>()
+                            .SetGroupName("Internet")
+                            .AddConstructor<MpTcpSubflow>();
+    return tid;
+}
+
+MpTcpSubflow::MpTcpSubflow()
+    : TcpSocketBase()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MpTcpSubflow::MpTcpSubflow(const MpTcpSubflow& sock)
+    : TcpSocketBase(sock),
+      m_meta(sock.m_meta),
+      m_rng(sock.m_rng),
+      m_localKey(sock.m_localKey),
+      m_peerKey(sock.m_peerKey),
+      m_mpCapable(sock.m_mpCapable),
+      m_isJoin(sock.m_isJoin),
+      m_joinToken(sock.m_joinToken),
+      m_addressId(sock.m_addressId),
+      m_localNonce(sock.m_localNonce),
+      m_peerNonce(sock.m_peerNonce),
+      m_txIsn(sock.m_txIsn),
+      m_rxIsn(sock.m_rxIsn)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MpTcpSubflow::~MpTcpSubflow()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MpTcpSubflow::SetMeta(MpTcpSocketBase* meta)
+{
+    NS_LOG_FUNCTION(this << meta);
+    m_meta = meta;
+}
+
+void
+MpTcpSubflow::SetRandomVariable(Ptr<UniformRandomVariable> rng)
+{
+    NS_LOG_FUNCTION(this << rng);
+    m_rng = rng;
+}
+
+void
+MpTcpSubflow::Detach()
+{
+    NS_LOG_FUNCTION(this);
+    m_meta = nullptr;
+    SetConnectCallback(MakeNullCallback<void, Ptr<Socket>>(),
+                       MakeNullCallback<void, Ptr<Socket>>());
+    SetCloseCallbacks(MakeNullCallback<void, Ptr<Socket>>(),
+                      MakeNullCallback<void, Ptr<Socket>>());
+    SetAcceptCallback(MakeNullCallback<bool, Ptr<Socket>, const Address&>(),
+                      MakeNullCallback<void, Ptr<Socket>, const Address&>());
+    SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
+    SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+}
+
+void
+MpTcpSubflow::SetLocalKey(uint64_t key)
+{
+    NS_LOG_FUNCTION(this << key);
+    m_localKey = key;
+}
+
+uint64_t
+MpTcpSubflow::GetLocalKey() const
+{
+    return m_localKey;
+}
+
+uint64_t
+MpTcpSubflow::GetPeerKey() const
+{
+    return m_peerKey;
+}
+
+bool
+MpTcpSubflow::IsMpTcpCapable() const
+{
+    return m_mpCapable;
+}
+
+void
+MpTcpSubflow::SetJoin(uint32_t token, uint8_t addressId)
+{
+    NS_LOG_FUNCTION(this << token << +addressId);
+    m_isJoin = true;
+    m_joinToken = token;
+    m_addressId = addressId;
+    m_localNonce = m_rng->GetInteger(0, std::numeric_limits<uint32_t>::max());
+}
+
+bool
+MpTcpSubflow::IsJoin() const
+{
+    return m_isJoin;
+}
+
+uint32_t
+MpTcpSubflow::GetJoinToken() const
+{
+    return m_joinToken;
+}
+
+void
+MpTcpSubflow::AnnounceAddress(const Address& address, uint8_t addressId)
+{
+    NS_LOG_FUNCTION(this << address << +addressId);
+    Ptr<TcpOptionMpTcpAddAddress> option = CreateObject<TcpOptionMpTcpAddAddress>();
+    option->SetAddress(address, addressId);
+    m_pendingAddAddr.push_back(option);
+}
+
+bool
+MpTcpSubflow::IsEstablished() const
+{
+    return (m_state == ESTABLISHED || m_state == CLOSE_WAIT) && !m_closeOnEmpty &&
+           !m_shutdownSend;
+}
+
+bool
+MpTcpSubflow::IsClosed() const
+{
+    return m_state == CLOSED || m_state == TIME_WAIT || m_state == LAST_ACK ||
+           m_state == FIN_WAIT_2 || m_state == CLOSING;
+}
+
+uint32_t
+MpTcpSubflow::GetSendSpace() const
+{
+    if (!IsEstablished())
+    {
+        return 0;
+    }
+    uint32_t window = AvailableWindow();
+    uint32_t queued = m_txBuffer->SizeFromSequence(m_tcb->m_nextTxSequence);
+    uint32_t space = window > queued ? window - queued : 0;
+    return std::min(space, GetTxAvailable());
+}
+
+Time
+MpTcpSubflow::GetRttEstimate() const
+{
+    return m_rtt->GetEstimate();
+}
+
+Ptr<TcpCongestionOps>
+MpTcpSubflow::GetCongestionControl() const
+{
+    return m_congestionControl;
+}
+
+int
+MpTcpSubflow::SendMapping(Ptr<Packet> chunk, uint64_t dataSeq)
+{
+    NS_LOG_FUNCTION(this << chunk << dataSeq);
+    NS_ASSERT(chunk->GetSize() <= std::numeric_limits<uint16_t>::max());
+
+    uint32_t ssn = m_txNextSsn;
+    int sent = Send(chunk, 0);
+    if (sent > 0)
+    {
+        m_txMappings[ssn] = {dataSeq, static_cast<uint16_t>(sent)};
+        m_txNextSsn += sent;
+    }
+    return sent;
+}
+
+Ptr<Packet>
+MpTcpSubflow::RecvMapped(uint64_t& dataSeq)
+{
+    NS_LOG_FUNCTION(this);
+
+    auto it = m_rxMappings.upper_bound(m_rxNextSsn);
+    if (it == m_rxMappings.begin())
+    {
+        return nullptr;
+    }
+    --it;
+    uint32_t offset = m_rxNextSsn - it->first;
+    if (offset >= it->second.length)
+    {
+        return nullptr;
+    }
+
+    Ptr<Packet> p = Recv(it->second.length - offset, 0);
+    if (!p || p->GetSize() == 0)
+    {
+        return nullptr;
+    }
+    dataSeq = it->second.dataSeq + offset;
+    m_rxNextSsn += p->GetSize();
+    if (p->GetSize() + offset == it->second.length)
+    {
+        m_rxMappings.erase(m_rxMappings.begin(), ++it);
+    }
+    return p;
+}
+
+int
+MpTcpSubflow::Connect(const Address& address)
+{
+    NS_LOG_FUNCTION(this << address);
+    m_activeOpen = true;
+    return TcpSocketBase::Connect(address);
+}
+
+Ptr<TcpSocketBase>
+MpTcpSubflow::Fork()
+{
+    return CopyObject<MpTcpSubflow>(this);
+}
+
+void
+MpTcpSubflow::DoForwardUp(Ptr<Packet> packet, const Address& fromAddress, const Address& toAddress)
+{
+    NS_LOG_FUNCTION(this << packet << fromAddress << toAddress);
+
+    TcpHeader tcpHeader;
+    packet->PeekHeader(tcpHeader);
+    ProcessMpTcpOptions(tcpHeader);
+
+    TcpSocketBase::DoForwardUp(packet, fromAddress, toAddress);
+
+    if (m_meta == nullptr || !m_mpCapable || m_state == LISTEN)
+    {
+        return;
+    }
+
+    // The data ACK and the new addresses are given to the connection once
+    // the segment has been processed by the subflow
+    for (const auto& option : tcpHeader.GetOptionList())
+    {
+        if (option->GetKind() != TcpOption::MPTCP)
+        {
+            continue;
+        }
+        Ptr<const TcpOptionMpTcpDss> dss = DynamicCast<const TcpOptionMpTcpDss>(option);
+        if (dss && dss->HasDataAck())
+        {
+            m_meta->ReceivedDataAck(dss->GetDataAck());
+            continue;
+        }
+        Ptr<const TcpOptionMpTcpAddAddress> addAddr =
+            DynamicCast<const TcpOptionMpTcpAddAddress>(option);
+        if (addAddr)
+        {
+            m_meta->AddRemoteAddress(addAddr->GetAddress(), addAddr->GetAddressId());
+        }
+    }
+}
+
+void
+MpTcpSubflow::ProcessMpTcpOptions(const TcpHeader& tcpHeader)
+{
+    NS_LOG_FUNCTION(this << tcpHeader);
+
+    bool isSyn = tcpHeader.GetFlags() & TcpHeader::SYN;
+    bool isAck = tcpHeader.GetFlags() & TcpHeader::ACK;
+
+    if (isSyn)
+    {
+        m_rxIsn = tcpHeader.GetSequenceNumber();
+        if (!isAck)
+        {
+            // A listening subflow: the options of each SYN are copied to its fork
+            m_mpCapable = false;
+            m_isJoin = false;
+        }
+    }
+
+    for (const auto& option : tcpHeader.GetOptionList())
+    {
+        if (option->GetKind() != TcpOption::MPTCP)
+        {
+            continue;
+        }
+
+        Ptr<const TcpOptionMpTcp> mptcp = DynamicCast<const TcpOptionMpTcp>(option);
+        if (!mptcp)
+        {
+            continue;
+        }
+
+        switch (mptcp->GetSubType())
+        {
+        case TcpOptionMpTcp::MP_CAPABLE:
+            if (isSyn && !m_isJoin)
+            {
+                Ptr<const TcpOptionMpTcpCapable> capable =
+                    DynamicCast<const TcpOptionMpTcpCapable>(option);
+                m_peerKey = capable->GetSenderKey();
+                m_mpCapable = true;
+                if (!isAck)
+                {
+                    m_localKey = m_rng->GetInteger(0, std::numeric_limits<uint32_t>::max());
+                    m_localKey = (m_localKey << 32) |
+                                 m_rng->GetInteger(0, std::numeric_limits<uint32_t>::max());
+                }
+                NS_LOG_LOGIC("MP_CAPABLE received, peer key " << m_peerKey);
+            }
+            break;
+        case TcpOptionMpTcp::MP_JOIN: {
+            Ptr<const TcpOptionMpTcpJoin> join = DynamicCast<const TcpOptionMpTcpJoin>(option);
+            if (isSyn && !isAck && join->GetMode() == TcpOptionMpTcpJoin::SYN)
+            {
+                m_isJoin = true;
+                m_mpCapable = true;
+                m_joinToken = join->GetToken();
+                m_peerNonce = join->GetNonce();
+                m_localNonce = m_rng->GetInteger(0, std::numeric_limits<uint32_t>::max());
+                NS_LOG_LOGIC("MP_JOIN received for token " << m_joinToken);
+            }
+            else if (isSyn && isAck && m_isJoin && join->GetMode() == TcpOptionMpTcpJoin::SYN_ACK)
+            {
+                // The HMAC is not verified
+                m_mpCapable = true;
+                m_peerNonce = join->GetNonce();
+            }
+            break;
+        }
+        case TcpOptionMpTcp::DSS: {
+            Ptr<const TcpOptionMpTcpDss> dss = DynamicCast<const TcpOptionMpTcpDss>(option);
+            if (m_mpCapable && dss->HasMapping())
+            {
+                uint32_t ssn = dss->GetSubflowSequenceNumber();
+                if (ssn + dss->GetDataLevelLength() > m_rxNextSsn)
+                {
+                    m_rxMappings[ssn] = {dss->GetDataSequenceNumber(), dss->GetDataLevelLength()};
+                }
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+uint32_t
+MpTcpSubflow::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withAck)
+{
+    NS_LOG_FUNCTION(this << seq << maxSize << withAck);
+
+    // A segment never spans two mappings, so that it carries the mapping of all its bytes
+    uint32_t ssn = seq.GetValue() - m_txIsn.GetValue();
+    auto it = m_txMappings.upper_bound(ssn);
+    if (m_mpCapable && it != m_txMappings.begin())
+    {
+        --it;
+        uint32_t end = it->first + it->second.length;
+        if (ssn < end)
+        {
+            maxSize = std::min(maxSize, end - ssn);
+            m_txMapping = &it->second;
+            m_txMappingSsn = it->first;
+        }
+    }
+
+    uint32_t sz = TcpSocketBase::SendDataPacket(seq, maxSize, withAck);
+    m_txMapping = nullptr;
+
+    // Forget the mappings acknowledged at the subflow level
+    uint32_t acked = m_txBuffer->HeadSequence().GetValue() - m_txIsn.GetValue();
+    while (!m_txMappings.empty() &&
+           m_txMappings.begin()->first + m_txMappings.begin()->second.length <= acked)
+    {
+        m_txMappings.erase(m_txMappings.begin());
+    }
+    return sz;
+}
+
+void
+MpTcpSubflow::AddOptions(TcpHeader& tcpHeader)
+{
+    NS_LOG_FUNCTION(this << tcpHeader);
+
+    uint8_t flags = tcpHeader.GetFlags();
+    bool handshake = (flags & TcpHeader::SYN) || (m_activeOpen && !m_handshakeAcked);
+    if (m_mpCapable && !handshake)
+    {
+        // The DSS goes first: the timestamp and the SACK blocks only take the
+        // space left, so that the data ACK and the mapping are never dropped
+        Ptr<TcpOptionMpTcpDss> dss = CreateObject<TcpOptionMpTcpDss>();
+        if (m_meta != nullptr && m_meta->HasDataAck())
+        {
+            dss->SetDataAck(m_meta->GetDataAck());
+        }
+        if (m_txMapping != nullptr)
+        {
+            dss->SetMapping(m_txMapping->dataSeq, m_txMappingSsn, m_txMapping->length);
+        }
+        if (dss->HasDataAck() || dss->HasMapping())
+        {
+            bool appended = tcpHeader.AppendOption(dss);
+            NS_ABORT_MSG_UNLESS(appended, "No space left for the DSS option");
+        }
+    }
+
+    TcpSocketBase::AddOptions(tcpHeader);
+
+    if (flags & TcpHeader::SYN)
+    {
+        m_txIsn = tcpHeader.GetSequenceNumber();
+        if (m_isJoin && !(flags & TcpHeader::ACK))
+        {
+            Ptr<TcpOptionMpTcpJoin> join = CreateObject<TcpOptionMpTcpJoin>();
+            join->SetMode(TcpOptionMpTcpJoin::SYN);
+            join->SetToken(m_joinToken);
+            join->SetNonce(m_localNonce);
+            join->SetAddressId(m_addressId);
+            tcpHeader.AppendOption(join);
+        }
+        else if (m_isJoin && m_mpCapable)
+        {
+            Ptr<TcpOptionMpTcpJoin> join = CreateObject<TcpOptionMpTcpJoin>();
+            join->SetMode(TcpOptionMpTcpJoin::SYN_ACK);
+            join->SetTruncatedHmac(ComputeHmac(m_localNonce, m_peerNonce));
+            join->SetNonce(m_localNonce);
+            join->SetAddressId(m_addressId);
+            tcpHeader.AppendOption(join);
+        }
+        else if (m_activeOpen || m_mpCapable)
+        {
+            Ptr<TcpOptionMpTcpCapable> capable = CreateObject<TcpOptionMpTcpCapable>();
+            capable->SetSenderKey(m_localKey);
+            tcpHeader.AppendOption(capable);
+        }
+        return;
+    }
+
+    if (!m_mpCapable)
+    {
+        return;
+    }
+
+    if (m_activeOpen && !m_handshakeAcked)
+    {
+        // Third ACK of the handshake
+        m_handshakeAcked = true;
+        if (m_isJoin)
+        {
+            Ptr<TcpOptionMpTcpJoin> join = CreateObject<TcpOptionMpTcpJoin>();
+            join->SetMode(TcpOptionMpTcpJoin::ACK);
+            join->SetTruncatedHmac(ComputeHmac(m_localNonce, m_peerNonce));
+            tcpHeader.AppendOption(join);
+        }
+        else
+        {
+            Ptr<TcpOptionMpTcpCapable> capable = CreateObject<TcpOptionMpTcpCapable>();
+            capable->SetSenderKey(m_localKey);
+            capable->SetPeerKey(m_peerKey);
+            tcpHeader.AppendOption(capable);
+        }
+        return;
+    }
+
+    while (!m_pendingAddAddr.empty() && tcpHeader.AppendOption(m_pendingAddAddr.front()))
+    {
+        m_pendingAddAddr.pop_front();
+    }
+}
+
+void
+MpTcpSubflow::ReTxTimeout()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_meta != nullptr && IsEstablished() && m_txBuffer->Size() > 0)
+    {
+        m_meta->SubflowTimeout(this);
+    }
+    TcpSocketBase::ReTxTimeout();
+}
+
+uint64_t
+MpTcpSubflow::ComputeHmac(uint32_t localNonce, uint32_t peerNonce) const
+{
+    uint64_t data[3] = {m_localKey,
+                        m_peerKey,
+                        (static_cast<uint64_t>(localNonce) << 32) | peerNonce};
+    return Hash64(reinterpret_cast<const char*>(data), sizeof(data));
+}
+
+} // namespace ns3
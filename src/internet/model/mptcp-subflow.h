@@ -0,0 +1,248 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MPTCP_SUBFLOW_H
+#define MPTCP_SUBFLOW_H
+
+#include "tcp-socket-base.h"
+
+#include <deque>
+#include <map>
+
+namespace ns3
+{
+
+class MpTcpSocketBase;
+class TcpOption;
+class UniformRandomVariable;
+
+/**
+ * \ingroup tcp
+ *
+ * \brief A subflow of a Multipath TCP connection
+ *
+ * A subflow is a regular TCP connection, which carries the MPTCP options
+ * on its segments: MP_CAPABLE or MP_JOIN during the handshake, and DSS
+ * (with the data ACK of the connection and the mapping of the payload in
+ * the data sequence space) and ADD_ADDR afterwards.
+ *
+ * The subflow does not own the data of the connection: the MpTcpSocketBase
+ * it belongs to (the "meta" socket) hands it chunks of data, each one with
+ * its data sequence number, and reads the data received in order on the
+ * subflow together with their data sequence number.
+ */
+class MpTcpSubflow : public TcpSocketBase
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    MpTcpSubflow();
+
+    /**
+     * \brief Clone a subflow (used when a listening subflow accepts a connection)
+     * \param sock the subflow to copy
+     */
+    MpTcpSubflow(const MpTcpSubflow& sock);
+    ~MpTcpSubflow() override;
+
+    /**
+     * \brief Set the connection this subflow belongs to
+     *
+     * The meta socket owns its subflows; the subflow only keeps a plain
+     * pointer, which is reset by Detach().
+     *
+     * \param meta the meta socket
+     */
+    void SetMeta(MpTcpSocketBase* meta);
+
+    /**
+     * \brief Set the source of the keys and nonces (shared with the connection)
+     * \param rng the random variable
+     */
+    void SetRandomVariable(Ptr<UniformRandomVariable> rng);
+
+    /**
+     * \brief Detach the subflow from its connection and clear its callbacks
+     */
+    void Detach();
+
+    /**
+     * \brief Set the key of the local end of the connection (first subflow)
+     * \param key the 64-bit key
+     */
+    void SetLocalKey(uint64_t key);
+
+    /**
+     * \brief Get the key of the local end of the connection
+     * \return the 64-bit key
+     */
+    uint64_t GetLocalKey() const;
+
+    /**
+     * \brief Get the key of the remote end of the connection
+     * \return the 64-bit key received in the MP_CAPABLE option
+     */
+    uint64_t GetPeerKey() const;
+
+    /**
+     * \brief Check if the peer agreed to use MPTCP on this subflow
+     * \return true if the handshake carried the MP_CAPABLE or MP_JOIN options
+     */
+    bool IsMpTcpCapable() const;
+
+    /**
+     * \brief Make this subflow join an existing connection
+     * \param token the token of the connection at the peer
+     * \param addressId the identifier of the local address of the subflow
+     */
+    void SetJoin(uint32_t token, uint8_t addressId);
+
+    /**
+     * \brief Check if this subflow joined an existing connection
+     * \return true if the subflow was opened with MP_JOIN
+     */
+    bool IsJoin() const;
+
+    /**
+     * \brief Get the token of the connection joined by this subflow
+     * \return the token carried by the MP_JOIN option of the SYN
+     */
+    uint32_t GetJoinToken() const;
+
+    /**
+     * \brief Announce an address of this host to the peer with ADD_ADDR
+     * \param address the Ipv4Address or Ipv6Address to announce
+     * \param addressId the identifier of the address
+     */
+    void AnnounceAddress(const Address& address, uint8_t addressId);
+
+    /**
+     * \brief Check if the subflow is in the ESTABLISHED or CLOSE_WAIT states
+     * \return true if the subflow can send data
+     */
+    bool IsEstablished() const;
+
+    /**
+     * \brief Check if the subflow is closed or closing
+     * \return true if no more data can be sent on the subflow
+     */
+    bool IsClosed() const;
+
+    /**
+     * \brief Get the number of bytes that the congestion and receiver windows
+     * would let the subflow transmit, excluding the data already queued
+     * \return the free space, in bytes
+     */
+    uint32_t GetSendSpace() const;
+
+    /**
+     * \brief Get the smoothed RTT of the subflow
+     * \return the RTT estimation
+     */
+    Time GetRttEstimate() const;
+
+    /**
+     * \brief Get the congestion control of the subflow
+     * \return the congestion control
+     */
+    Ptr<TcpCongestionOps> GetCongestionControl() const;
+
+    /**
+     * \brief Queue a chunk of data of the connection for transmission
+     * \param chunk the data (at most 65535 bytes)
+     * \param dataSeq the data sequence number of the first byte of the chunk
+     * \return the number of bytes queued, or -1 on error
+     */
+    int SendMapping(Ptr<Packet> chunk, uint64_t dataSeq);
+
+    /**
+     * \brief Read the data received in order on the subflow
+     *
+     * The returned packet never spans two mappings.
+     *
+     * \param dataSeq the data sequence number of the first byte returned
+     * \return the data, or nullptr if no mapped data is available
+     */
+    Ptr<Packet> RecvMapped(uint64_t& dataSeq);
+
+    int Connect(const Address& address) override;
+
+  protected:
+    Ptr<TcpSocketBase> Fork() override;
+    void DoForwardUp(Ptr<Packet> packet,
+                     const Address& fromAddress,
+                     const Address& toAddress) override;
+    uint32_t SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withAck) override;
+    void AddOptions(TcpHeader& tcpHeader) override;
+    void ReTxTimeout() override;
+
+  private:
+    /**
+     * \brief Process the MPTCP options of a received segment
+     * \param tcpHeader the TCP header of the segment
+     */
+    void ProcessMpTcpOptions(const TcpHeader& tcpHeader);
+
+    /**
+     * \brief Compute the (truncated) HMAC exchanged by MP_JOIN
+     * \param localNonce the nonce of the sender of the HMAC
+     * \param peerNonce the nonce of the receiver of the HMAC
+     * \return the leftmost 64 bits of the HMAC
+     */
+    uint64_t ComputeHmac(uint32_t localNonce, uint32_t peerNonce) const;
+
+    /**
+     * \brief A mapping between the subflow and data sequence spaces
+     */
+    struct Mapping
+    {
+        uint64_t dataSeq; //!< Data sequence number of the first byte
+        uint16_t length;  //!< Length of the mapping
+    };
+
+    /// Mappings, indexed by the relative subflow sequence number of their first byte
+    typedef std::map<uint32_t, Mapping> MappingMap_t;
+
+    MpTcpSocketBase* m_meta{nullptr}; //!< The connection this subflow belongs to
+    Ptr<UniformRandomVariable> m_rng; //!< Source of keys and nonces
+
+    uint64_t m_localKey{0};        //!< Key of the local end of the connection
+    uint64_t m_peerKey{0};         //!< Key of the remote end of the connection
+    bool m_mpCapable{false};       //!< The peer agreed to use MPTCP
+    bool m_activeOpen{false};      //!< This end sent the SYN
+    bool m_isJoin{false};          //!< The subflow joins an existing connection
+    bool m_handshakeAcked{false};  //!< The third ACK of the handshake was sent
+    uint32_t m_joinToken{0};       //!< Token of the joined connection
+    uint8_t m_addressId{0};        //!< Identifier of the local address
+    uint32_t m_localNonce{0};      //!< Local nonce of MP_JOIN
+    uint32_t m_peerNonce{0};       //!< Remote nonce of MP_JOIN
+    SequenceNumber32 m_txIsn{0};   //!< Initial sequence number of this end
+    SequenceNumber32 m_rxIsn{0};   //!< Initial sequence number of the peer
+    uint32_t m_txNextSsn{1};       //!< Relative sequence number of the next byte queued
+    uint32_t m_rxNextSsn{1};       //!< Relative sequence number of the next byte to read
+    MappingMap_t m_txMappings;     //!< Mappings of the data queued for transmission
+    MappingMap_t m_rxMappings;     //!< Mappings of the data received
+    const Mapping* m_txMapping{nullptr}; //!< Mapping of the segment being sent
+    uint32_t m_txMappingSsn{0};          //!< Relative sequence number of m_txMapping
+    std::deque<Ptr<TcpOption>> m_pendingAddAddr; //!< ADD_ADDR options to send
+};
+
+} // namespace ns3
+
+#endif /* MPTCP_SUBFLOW_H */
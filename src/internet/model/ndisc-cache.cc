@@ -101,9 +101,10 @@ NdiscCache::Lookup(Ipv6Address dst)
 {
     NS_LOG_FUNCTION(this << dst);
 
-    if (m_ndCache.find(dst) != m_ndCache.end())
+    CacheI it = m_ndCache.find(dst);
+    if (it != m_ndCache.end())
     {
-        NdiscCache::Entry* entry = m_ndCache[dst];
+        NdiscCache::Entry* entry = it->second;
         NS_LOG_LOGIC("Found an entry: " << *entry);
 
         return entry;
@@ -118,14 +119,11 @@ NdiscCache::LookupInverse(Address dst)
     NS_LOG_FUNCTION(this << dst);
 
     std::list<NdiscCache::Entry*> entryList;
-    for (CacheI i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    auto range = m_macIndex.equal_range(dst);
+    for (auto i = range.first; i != range.second; i++)
     {
-        NdiscCache::Entry* entry = (*i).second;
-        if (entry->GetMacAddress() == dst)
-        {
-            NS_LOG_LOGIC("Found an entry:" << (*entry));
-            entryList.push_back(entry);
-        }
+        NS_LOG_LOGIC("Found an entry:" << *(i->second));
+        entryList.push_back(i->second);
     }
     return entryList;
 }
@@ -147,18 +145,112 @@ NdiscCache::Remove(NdiscCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (CacheI i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    CacheI i = m_ndCache.find(entry->GetIpv6Address());
+    if (i != m_ndCache.end() && i->second == entry)
+    {
+        m_ndCache.erase(i);
+        Unlink(entry);
+        delete entry;
+    }
+}
+
+void
+NdiscCache::UpdateMacIndex(NdiscCache::Entry* entry, const Address& oldMac)
+{
+    NS_LOG_FUNCTION(this << entry << oldMac);
+    const Address& newMac = entry->GetMacAddress();
+    if (!oldMac.IsInvalid())
+    {
+        if (oldMac == newMac)
+        {
+            return;
+        }
+        auto range = m_macIndex.equal_range(oldMac);
+        for (auto i = range.first; i != range.second; i++)
+        {
+            if (i->second == entry)
+            {
+                m_macIndex.erase(i);
+                break;
+            }
+        }
+    }
+    if (!newMac.IsInvalid())
+    {
+        m_macIndex.emplace(newMac, entry);
+    }
+}
+
+void
+NdiscCache::Unlink(NdiscCache::Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    Address mac = entry->GetMacAddress();
+    entry->m_macAddress = Address();
+    UpdateMacIndex(entry, mac);
+    CancelNudTimer(entry);
+    entry->ClearWaitingPacket();
+}
+
+void
+NdiscCache::ScheduleNudTimer(NdiscCache::Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry << entry->m_nudExpiry);
+    auto it = m_nudTimers.emplace(entry->m_nudExpiry, entry);
+    if (it == m_nudTimers.begin())
+    {
+        // the entry expires first, move the processing event earlier
+        m_nudEvent.Cancel();
+        m_nudEvent = Simulator::Schedule(entry->m_nudExpiry - Simulator::Now(),
+                                         &NdiscCache::HandleNudTimers,
+                                         this);
+    }
+}
+
+void
+NdiscCache::CancelNudTimer(NdiscCache::Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    if (!entry->m_nudRunning)
+    {
+        return;
+    }
+    entry->m_nudRunning = false;
+    auto range = m_nudTimers.equal_range(entry->m_nudExpiry);
+    for (auto i = range.first; i != range.second; i++)
     {
-        if ((*i).second == entry)
+        if (i->second == entry)
         {
-            m_ndCache.erase(i);
-            entry->ClearWaitingPacket();
-            delete entry;
+            // the processing event is left in place, it reschedules itself
+            m_nudTimers.erase(i);
             return;
         }
     }
 }
 
+void
+NdiscCache::HandleNudTimers()
+{
+    NS_LOG_FUNCTION(this);
+    Time now = Simulator::Now();
+    while (!m_nudTimers.empty() && m_nudTimers.begin()->first <= now)
+    {
+        NdiscCache::Entry* entry = m_nudTimers.begin()->second;
+        m_nudTimers.erase(m_nudTimers.begin());
+        entry->m_nudRunning = false;
+        // the entry may remove itself (or others) from the cache
+        (entry->*(entry->m_nudFunction))();
+    }
+    // the callbacks may have re-armed timers, keep a single pending event
+    m_nudEvent.Cancel();
+    if (!m_nudTimers.empty())
+    {
+        m_nudEvent = Simulator::Schedule(m_nudTimers.begin()->first - now,
+                                         &NdiscCache::HandleNudTimers,
+                                         this);
+    }
+}
+
 void
 NdiscCache::Flush()
 {
@@ -169,7 +261,11 @@ NdiscCache::Flush()
         delete (*i).second; /* delete the pointer NdiscCache::Entry */
     }
 
-    m_ndCache.erase(m_ndCache.begin(), m_ndCache.end());
+    m_ndCache.clear();
+    m_macIndex.clear();
+    m_nudTimers.clear();
+    m_waitingPool.clear();
+    m_nudEvent.Cancel();
 }
 
 void
@@ -192,7 +288,9 @@ NdiscCache::PrintNdiscCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (CacheI i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    // the entries are printed sorted by IPv6 address
+    std::map<Ipv6Address, NdiscCache::Entry*> sortedCache(m_ndCache.begin(), m_ndCache.end());
+    for (auto i = sortedCache.begin(); i != sortedCache.end(); i++)
     {
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
@@ -247,7 +345,8 @@ NdiscCache::Entry::Entry(NdiscCache* nd)
     : m_ndCache(nd),
       m_waiting(),
       m_router(false),
-      m_nudTimer(Timer::CANCEL_ON_DESTROY),
+      m_nudFunction(nullptr),
+      m_nudRunning(false),
       m_lastReachabilityConfirmation(Seconds(0.0)),
       m_nsRetransmit(0)
 {
@@ -277,9 +376,19 @@ NdiscCache::Entry::AddWaitingPacket(Ipv6PayloadHeaderPair p)
     {
         /* we store only m_unresQlen packet => first packet in first packet remove */
         /** \todo report packet as 'dropped' */
-        m_waiting.pop_front();
+        m_waiting.front().first = nullptr;
+        m_ndCache->m_waitingPool.splice(m_ndCache->m_waitingPool.end(),
+                                        m_waiting,
+                                        m_waiting.begin());
+    }
+    if (m_ndCache->m_waitingPool.empty())
+    {
+        m_waiting.push_back(p);
+        return;
     }
-    m_waiting.push_back(p);
+    // reuse a list node released by a previous resolution
+    m_waiting.splice(m_waiting.end(), m_ndCache->m_waitingPool, m_ndCache->m_waitingPool.begin());
+    m_waiting.back() = p;
 }
 
 void
@@ -287,7 +396,11 @@ NdiscCache::Entry::ClearWaitingPacket()
 {
     NS_LOG_FUNCTION(this);
     /** \todo report packets as 'dropped' */
-    m_waiting.clear();
+    for (auto& waiting : m_waiting)
+    {
+        waiting.first = nullptr;
+    }
+    m_ndCache->m_waitingPool.splice(m_ndCache->m_waitingPool.end(), m_waiting);
 }
 
 void
@@ -465,19 +578,25 @@ NdiscCache::Entry::GetLastReachabilityConfirmation() const
     return m_lastReachabilityConfirmation;
 }
 
+void
+NdiscCache::Entry::StartNudTimer(void (NdiscCache::Entry::*function)(), Time delay)
+{
+    NS_LOG_FUNCTION(this << delay);
+    m_ndCache->CancelNudTimer(this);
+    m_nudFunction = function;
+    m_nudDelay = delay;
+    m_nudExpiry = Simulator::Now() + delay;
+    m_nudRunning = true;
+    m_ndCache->ScheduleNudTimer(this);
+}
+
 void
 NdiscCache::Entry::StartReachableTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
     m_lastReachabilityConfirmation = Simulator::Now();
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionReachableTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetReachableTime());
-    m_nudTimer.Schedule();
+    StartNudTimer(&NdiscCache::Entry::FunctionReachableTimeout,
+                  m_ndCache->m_icmpv6->GetReachableTime());
 }
 
 void
@@ -488,11 +607,10 @@ NdiscCache::Entry::UpdateReachableTimer()
     if (m_state == REACHABLE)
     {
         m_lastReachabilityConfirmation = Simulator::Now();
-        if (m_nudTimer.IsRunning())
+        if (m_nudFunction != nullptr)
         {
-            m_nudTimer.Cancel();
+            StartNudTimer(m_nudFunction, m_nudDelay);
         }
-        m_nudTimer.Schedule();
     }
 }
 
@@ -500,49 +618,31 @@ void
 NdiscCache::Entry::StartProbeTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionProbeTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetRetransmissionTime());
-    m_nudTimer.Schedule();
+    StartNudTimer(&NdiscCache::Entry::FunctionProbeTimeout,
+                  m_ndCache->m_icmpv6->GetRetransmissionTime());
 }
 
 void
 NdiscCache::Entry::StartDelayTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionDelayTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetDelayFirstProbe());
-    m_nudTimer.Schedule();
+    StartNudTimer(&NdiscCache::Entry::FunctionDelayTimeout,
+                  m_ndCache->m_icmpv6->GetDelayFirstProbe());
 }
 
 void
 NdiscCache::Entry::StartRetransmitTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionRetransmitTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetRetransmissionTime());
-    m_nudTimer.Schedule();
+    StartNudTimer(&NdiscCache::Entry::FunctionRetransmitTimeout,
+                  m_ndCache->m_icmpv6->GetRetransmissionTime());
 }
 
 void
 NdiscCache::Entry::StopNudTimer()
 {
     NS_LOG_FUNCTION(this);
-    m_nudTimer.Cancel();
+    m_ndCache->CancelNudTimer(this);
     m_nsRetransmit = 0;
 }
 
@@ -563,7 +663,7 @@ NdiscCache::Entry::MarkReachable(Address mac)
 {
     NS_LOG_FUNCTION(this << mac);
     m_state = REACHABLE;
-    m_macAddress = mac;
+    SetMacAddress(mac);
     return m_waiting;
 }
 
@@ -593,7 +693,7 @@ NdiscCache::Entry::MarkStale(Address mac)
 {
     NS_LOG_FUNCTION(this << mac);
     m_state = STALE;
-    m_macAddress = mac;
+    SetMacAddress(mac);
     return m_waiting;
 }
 
@@ -669,6 +769,13 @@ NdiscCache::Entry::IsAutoGenerated() const
     return (m_state == STATIC_AUTOGENERATED);
 }
 
+NdiscCache::Entry::NdiscCacheEntryState_e
+NdiscCache::Entry::GetEntryState() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_state;
+}
+
 Address
 NdiscCache::Entry::GetMacAddress() const
 {
@@ -680,7 +787,9 @@ void
 NdiscCache::Entry::SetMacAddress(Address mac)
 {
     NS_LOG_FUNCTION(this << mac << int(m_state));
+    Address oldMac = m_macAddress;
     m_macAddress = mac;
+    m_ndCache->UpdateMacIndex(this, oldMac);
 }
 
 void
@@ -721,9 +830,9 @@ NdiscCache::RemoveAutoGeneratedEntries()
     {
         if (i->second->IsAutoGenerated())
         {
-            i->second->ClearWaitingPacket();
+            Unlink(i->second);
             delete i->second;
-            m_ndCache.erase(i++);
+            i = m_ndCache.erase(i);
             continue;
         }
         i++;
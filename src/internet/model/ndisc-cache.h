@@ -26,11 +26,12 @@
 #include "ns3/output-stream-wrapper.h"
 #include "ns3/packet.h"
 #include "ns3/ptr.h"
-#include "ns3/timer.h"
+#include "ns3/simulator.h"
 
 #include <list>
 #include <map>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -412,6 +413,16 @@ class NdiscCache : public Object
         NdiscCache* m_ndCache;
 
       private:
+        /// The cache runs the NUD timers of its entries
+        friend class NdiscCache;
+
+        /**
+         * \brief Arm the NUD timer.
+         * \param function the function to call when the timer expires
+         * \param delay the timer delay
+         */
+        void StartNudTimer(void (NdiscCache::Entry::*function)(), Time delay);
+
         /**
          * \brief The IPv6 address.
          */
@@ -433,9 +444,24 @@ class NdiscCache : public Object
         bool m_router;
 
         /**
-         * \brief Timer (used for NUD).
+         * \brief Function called when the NUD timer expires.
          */
-        Timer m_nudTimer;
+        void (NdiscCache::Entry::*m_nudFunction)();
+
+        /**
+         * \brief Delay of the NUD timer.
+         */
+        Time m_nudDelay;
+
+        /**
+         * \brief Expiration time of the NUD timer, if running.
+         */
+        Time m_nudExpiry;
+
+        /**
+         * \brief Whether the NUD timer is running.
+         */
+        bool m_nudRunning;
 
         /**
          * \brief Last time we see a reachability confirmation.
@@ -457,11 +483,11 @@ class NdiscCache : public Object
     /**
      * \brief Neighbor Discovery Cache container
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*> Cache;
+    typedef std::unordered_map<Ipv6Address, NdiscCache::Entry*, Ipv6AddressHash> Cache;
     /**
      * \brief Neighbor Discovery Cache container iterator
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*>::iterator CacheI;
+    typedef Cache::iterator CacheI;
 
     /**
      * \brief A list of Entry.
@@ -469,6 +495,60 @@ class NdiscCache : public Object
     Cache m_ndCache;
 
   private:
+    /**
+     * \brief Update the reverse index after the MAC address of an entry changed.
+     * \param entry the entry
+     * \param oldMac the MAC address previously associated with the entry
+     */
+    void UpdateMacIndex(NdiscCache::Entry* entry, const Address& oldMac);
+
+    /**
+     * \brief Remove an entry from the indexes and from the NUD timer queue,
+     * and release its waiting packets, before the entry is deleted.
+     * \param entry the entry
+     */
+    void Unlink(NdiscCache::Entry* entry);
+
+    /**
+     * \brief Insert an entry in the NUD timer queue, at its expiration time.
+     * \param entry the entry
+     */
+    void ScheduleNudTimer(NdiscCache::Entry* entry);
+
+    /**
+     * \brief Remove an entry from the NUD timer queue.
+     * \param entry the entry
+     */
+    void CancelNudTimer(NdiscCache::Entry* entry);
+
+    /**
+     * \brief Run the NUD timers of all the entries that expired.
+     *
+     * A single event per cache is scheduled, at the earliest expiration time,
+     * instead of an event per entry.
+     */
+    void HandleNudTimers();
+
+    /**
+     * \brief Reverse index from MAC address to the entries resolved to it.
+     */
+    std::unordered_multimap<Address, NdiscCache::Entry*, AddressHash> m_macIndex;
+
+    /**
+     * \brief NUD timers of the entries, ordered by expiration time.
+     */
+    std::multimap<Time, NdiscCache::Entry*> m_nudTimers;
+
+    /**
+     * \brief The event processing the expired NUD timers.
+     */
+    EventId m_nudEvent;
+
+    /**
+     * \brief Recycled list nodes for the queues of packets waiting for resolution.
+     */
+    std::list<Ipv6PayloadHeaderPair> m_waitingPool;
+
     /**
      * \brief The NetDevice.
      */
@@ -19,6 +19,7 @@
 
 #include "tcp-header.h"
 
+#include "tcp-option-mptcp.h"
 #include "tcp-option.h"
 
 #include "ns3/address-utils.h"
@@ -376,7 +377,14 @@ TcpHeader::Deserialize(Buffer::Iterator start)
         uint8_t kind = i.PeekU8();
         Ptr<TcpOption> op;
         uint32_t optionSize;
-        if (TcpOption::IsKindKnown(kind))
+        if (kind == TcpOption::MPTCP && optionLen >= 3)
+        {
+            // MPTCP options share the same kind, the subtype selects the option
+            Buffer::Iterator subtype = i;
+            subtype.Next(2);
+            op = TcpOptionMpTcp::CreateMpTcpOption(subtype.PeekU8() >> 4);
+        }
+        else if (TcpOption::IsKindKnown(kind))
         {
             op = TcpOption::CreateOption(kind);
         }
@@ -26,6 +26,7 @@
 #include "ipv6-end-point.h"
 #include "ipv6-l3-protocol.h"
 #include "ipv6-routing-protocol.h"
+#include "mptcp-socket-factory.h"
 #include "rtt-estimator.h"
 #include "tcp-congestion-ops.h"
 #include "tcp-cubic.h"
@@ -44,8 +45,10 @@
 #include "ns3/nstime.h"
 #include "ns3/object-vector.h"
 #include "ns3/packet.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 #include <vector>
@@ -134,6 +137,9 @@ TcpL4Protocol::NotifyNewAggregate()
             Ptr<TcpSocketFactoryImpl> tcpFactory = CreateObject<TcpSocketFactoryImpl>();
             tcpFactory->SetTcp(this);
             node->AggregateObject(tcpFactory);
+            Ptr<MpTcpSocketFactory> mpTcpFactory = CreateObject<MpTcpSocketFactory>();
+            mpTcpFactory->SetTcp(this);
+            node->AggregateObject(mpTcpFactory);
         }
     }
 
@@ -194,16 +200,24 @@ TcpL4Protocol::CreateSocket(TypeId congestionTypeId)
 Ptr<Socket>
 TcpL4Protocol::CreateSocket(TypeId congestionTypeId, TypeId recoveryTypeId)
 {
-    NS_LOG_FUNCTION(this << congestionTypeId.GetName());
+    return CreateSocket(congestionTypeId, recoveryTypeId, TcpSocketBase::GetTypeId());
+}
+
+Ptr<Socket>
+TcpL4Protocol::CreateSocket(TypeId congestionTypeId, TypeId recoveryTypeId, TypeId socketTypeId)
+{
+    NS_LOG_FUNCTION(this << congestionTypeId.GetName() << socketTypeId.GetName());
     ObjectFactory rttFactory;
     ObjectFactory congestionAlgorithmFactory;
     ObjectFactory recoveryAlgorithmFactory;
+    ObjectFactory socketFactory;
     rttFactory.SetTypeId(m_rttTypeId);
     congestionAlgorithmFactory.SetTypeId(congestionTypeId);
     recoveryAlgorithmFactory.SetTypeId(recoveryTypeId);
+    socketFactory.SetTypeId(socketTypeId);
 
     Ptr<RttEstimator> rtt = rttFactory.Create<RttEstimator>();
-    Ptr<TcpSocketBase> socket = CreateObject<TcpSocketBase>();
+    Ptr<TcpSocketBase> socket = socketFactory.Create<TcpSocketBase>();
     Ptr<TcpCongestionOps> algo = congestionAlgorithmFactory.Create<TcpCongestionOps>();
     Ptr<TcpRecoveryOps> recovery = recoveryAlgorithmFactory.Create<TcpRecoveryOps>();
 
@@ -697,6 +711,39 @@ TcpL4Protocol::SendPacket(Ptr<Packet> pkt,
                           Ptr<NetDevice> oif) const
 {
     NS_LOG_FUNCTION(this << pkt << outgoing << saddr << daddr << oif);
+
+    SegmentationOffloadTag tsoTag;
+    if (pkt->PeekPacketTag(tsoTag) && tsoTag.GetSegmentCount() > 1)
+    {
+        // Segmentation offload: the super-segment is split here into regular
+        // segments, each one with a copy of the header, so that the network
+        // layer, the devices and the routers never see it
+        pkt->RemovePacketTag(tsoTag);
+        uint32_t segmentSize = tsoTag.GetSegmentSize();
+        uint32_t size = pkt->GetSize();
+        NS_LOG_LOGIC("Splitting a super-segment of " << size << " bytes");
+        for (uint32_t offset = 0; offset < size; offset += segmentSize)
+        {
+            uint32_t length = std::min(segmentSize, size - offset);
+            TcpHeader header = outgoing;
+            header.SetSequenceNumber(outgoing.GetSequenceNumber() + SequenceNumber32(offset));
+            uint8_t flags = outgoing.GetFlags();
+            if (offset > 0)
+            {
+                // the congestion window reduction is signalled once
+                flags &= ~TcpHeader::CWR;
+            }
+            if (offset + length < size)
+            {
+                // the FIN belongs to the last byte
+                flags &= ~TcpHeader::FIN;
+            }
+            header.SetFlags(flags);
+            SendPacket(pkt->CreateFragment(offset, length), header, saddr, daddr, oif);
+        }
+        return;
+    }
+
     if (Ipv4Address::IsMatchingType(saddr))
     {
         NS_ASSERT(Ipv4Address::IsMatchingType(daddr));
@@ -132,6 +132,22 @@ class TcpL4Protocol : public IpL4Protocol
      */
     Ptr<Socket> CreateSocket(TypeId congestionTypeId);
 
+    /**
+     * \brief Create a TCP socket of the specified type
+     *
+     * Used to create the subclasses of TcpSocketBase, e.g., the subflows of
+     * Multipath TCP. The RTT estimator is the one set by the RttEstimatorType
+     * attribute.
+     *
+     * \return A smart Socket pointer to a TcpSocketBase allocated by this instance
+     * of the TCP protocol
+     *
+     * \param congestionTypeId the congestion control algorithm TypeId
+     * \param recoveryTypeId the recovery algorithm TypeId
+     * \param socketTypeId the socket TypeId, a subclass of TcpSocketBase
+     */
+    Ptr<Socket> CreateSocket(TypeId congestionTypeId, TypeId recoveryTypeId, TypeId socketTypeId);
+
     /**
      * \brief Allocate an IPv4 Endpoint
      * \return the Endpoint
@@ -216,6 +232,9 @@ class TcpL4Protocol : public IpL4Protocol
     /**
      * \brief Send a packet via TCP (IP-agnostic)
      *
+     * A packet carrying a SegmentationOffloadTag is split into segments,
+     * which are sent one after the other.
+     *
      * \param pkt The packet to send
      * \param outgoing The packet header
      * \param saddr The source Ipv4Address
@@ -0,0 +1,722 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "tcp-option-mptcp.h"
+
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv6-address.h"
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TcpOptionMpTcp");
+
+NS_OBJECT_ENSURE_REGISTERED(TcpOptionMpTcp);
+
+TypeId
+TcpOptionMpTcp::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::TcpOptionMpTcp").SetParent<TcpOption>().SetGroupName("Internet");
+    return tid;
+}
+
+TcpOptionMpTcp::TcpOptionMpTcp()
+    : TcpOption()
+{
+}
+
+TcpOptionMpTcp::~TcpOptionMpTcp()
+{
+}
+
+uint8_t
+TcpOptionMpTcp::GetKind() const
+{
+    return TcpOption::MPTCP;
+}
+
+Ptr<TcpOption>
+TcpOptionMpTcp::CreateMpTcpOption(uint8_t subtype)
+{
+    switch (subtype)
+    {
+    case MP_CAPABLE:
+        return CreateObject<TcpOptionMpTcpCapable>();
+    case MP_JOIN:
+        return CreateObject<TcpOptionMpTcpJoin>();
+    case DSS:
+        return CreateObject<TcpOptionMpTcpDss>();
+    case ADD_ADDR:
+        return CreateObject<TcpOptionMpTcpAddAddress>();
+    }
+
+    NS_LOG_WARN("MPTCP option subtype " << static_cast<int>(subtype) << " unknown, skipping.");
+    return CreateObject<TcpOptionUnknown>();
+}
+
+NS_OBJECT_ENSURE_REGISTERED(TcpOptionMpTcpCapable);
+
+TypeId
+TcpOptionMpTcpCapable::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::TcpOptionMpTcpCapable")
+                            .SetParent<TcpOptionMpTcp>()
+                            .SetGroupName("Internet")
+                            .AddConstructor<TcpOptionMpTcpCapable>();
+    return tid;
+}
+
+TypeId
+TcpOptionMpTcpCapable::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+TcpOptionMpTcpCapable::TcpOptionMpTcpCapable()
+    : TcpOptionMpTcp(),
+      m_senderKey(0),
+      m_peerKey(0),
+      m_hasPeerKey(false)
+{
+}
+
+TcpOptionMpTcpCapable::~TcpOptionMpTcpCapable()
+{
+}
+
+void
+TcpOptionMpTcpCapable::Print(std::ostream& os) const
+{
+    os << "MP_CAPABLE sender key " << m_senderKey;
+    if (m_hasPeerKey)
+    {
+        os << " peer key " << m_peerKey;
+    }
+}
+
+uint32_t
+TcpOptionMpTcpCapable::GetSerializedSize() const
+{
+    return m_hasPeerKey ? 20 : 12;
+}
+
+TcpOptionMpTcp::SubType
+TcpOptionMpTcpCapable::GetSubType() const
+{
+    return MP_CAPABLE;
+}
+
+void
+TcpOptionMpTcpCapable::Serialize(Buffer::Iterator start) const
+{
+    Buffer::Iterator i = start;
+    i.WriteU8(GetKind());
+    i.WriteU8(GetSerializedSize());
+    i.WriteU8(GetSubType() << 4); // version 0
+    i.WriteU8(0x01);              // flags: H (HMAC-SHA1)
+    i.WriteHtonU64(m_senderKey);
+    if (m_hasPeerKey)
+    {
+        i.WriteHtonU64(m_peerKey);
+    }
+}
+
+uint32_t
+TcpOptionMpTcpCapable::Deserialize(Buffer::Iterator start)
+{
+    Buffer::Iterator i = start;
+
+    uint8_t readKind = i.ReadU8();
+    if (readKind != GetKind())
+    {
+        NS_LOG_WARN("Malformed MP_CAPABLE option");
+        return 0;
+    }
+    uint8_t size = i.ReadU8();
+    if (size != 12 && size != 20)
+    {
+        NS_LOG_WARN("Malformed MP_CAPABLE option");
+        return 0;
+    }
+    i.ReadU8(); // subtype and version
+    i.ReadU8(); // flags
+    m_senderKey = i.ReadNtohU64();
+    m_hasPeerKey = (size == 20);
+    if (m_hasPeerKey)
+    {
+        m_peerKey = i.ReadNtohU64();
+    }
+    return GetSerializedSize();
+}
+
+void
+TcpOptionMpTcpCapable::SetSenderKey(uint64_t key)
+{
+    m_senderKey = key;
+}
+
+uint64_t
+TcpOptionMpTcpCapable::GetSenderKey() const
+{
+    return m_senderKey;
+}
+
+void
+TcpOptionMpTcpCapable::SetPeerKey(uint64_t key)
+{
+    m_peerKey = key;
+    m_hasPeerKey = true;
+}
+
+uint64_t
+TcpOptionMpTcpCapable::GetPeerKey() const
+{
+    return m_peerKey;
+}
+
+bool
+TcpOptionMpTcpCapable::HasPeerKey() const
+{
+    return m_hasPeerKey;
+}
+
+NS_OBJECT_ENSURE_REGISTERED(TcpOptionMpTcpJoin);
+
+TypeId
+TcpOptionMpTcpJoin::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::TcpOptionMpTcpJoin")
+                            .SetParent<TcpOptionMpTcp>()
+                            .SetGroupName("Internet")
+                            .AddConstructor<TcpOptionMpTcpJoin>();
+    return tid;
+}
+
+TypeId
+TcpOptionMpTcpJoin::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+TcpOptionMpTcpJoin::TcpOptionMpTcpJoin()
+    : TcpOptionMpTcp(),
+      m_mode(SYN),
+      m_addressId(0),
+      m_token(0),
+      m_nonce(0),
+      m_hmac(0)
+{
+}
+
+TcpOptionMpTcpJoin::~TcpOptionMpTcpJoin()
+{
+}
+
+void
+TcpOptionMpTcpJoin::Print(std::ostream& os) const
+{
+    os << "MP_JOIN";
+    switch (m_mode)
+    {
+    case SYN:
+        os << " address id " << static_cast<int>(m_addressId) << " token " << m_token
+           << " nonce " << m_nonce;
+        break;
+    case SYN_ACK:
+        os << " address id " << static_cast<int>(m_addressId) << " hmac " << m_hmac << " nonce "
+           << m_nonce;
+        break;
+    case ACK:
+        os << " hmac " << m_hmac;
+        break;
+    }
+}
+
+uint32_t
+TcpOptionMpTcpJoin::GetSerializedSize() const
+{
+    switch (m_mode)
+    {
+    case SYN:
+        return 12;
+    case SYN_ACK:
+        return 16;
+    case ACK:
+        return 24;
+    }
+    return 0;
+}
+
+TcpOptionMpTcp::SubType
+TcpOptionMpTcpJoin::GetSubType() const
+{
+    return MP_JOIN;
+}
+
+void
+TcpOptionMpTcpJoin::Serialize(Buffer::Iterator start) const
+{
+    Buffer::Iterator i = start;
+    i.WriteU8(GetKind());
+    i.WriteU8(GetSerializedSize());
+    i.WriteU8(GetSubType() << 4);
+    switch (m_mode)
+    {
+    case SYN:
+        i.WriteU8(m_addressId);
+        i.WriteHtonU32(m_token);
+        i.WriteHtonU32(m_nonce);
+        break;
+    case SYN_ACK:
+        i.WriteU8(m_addressId);
+        i.WriteHtonU64(m_hmac);
+        i.WriteHtonU32(m_nonce);
+        break;
+    case ACK:
+        i.WriteU8(0); // reserved
+        i.WriteHtonU64(m_hmac);
+        i.WriteU8(0, 12); // the rest of the 160-bit HMAC is not modelled
+        break;
+    }
+}
+
+uint32_t
+TcpOptionMpTcpJoin::Deserialize(Buffer::Iterator start)
+{
+    Buffer::Iterator i = start;
+
+    uint8_t readKind = i.ReadU8();
+    if (readKind != GetKind())
+    {
+        NS_LOG_WARN("Malformed MP_JOIN option");
+        return 0;
+    }
+    uint8_t size = i.ReadU8();
+    i.ReadU8(); // subtype and flags
+    switch (size)
+    {
+    case 12:
+        m_mode = SYN;
+        m_addressId = i.ReadU8();
+        m_token = i.ReadNtohU32();
+        m_nonce = i.ReadNtohU32();
+        break;
+    case 16:
+        m_mode = SYN_ACK;
+        m_addressId = i.ReadU8();
+        m_hmac = i.ReadNtohU64();
+        m_nonce = i.ReadNtohU32();
+        break;
+    case 24:
+        m_mode = ACK;
+        i.ReadU8();
+        m_hmac = i.ReadNtohU64();
+        i.Next(12);
+        break;
+    default:
+        NS_LOG_WARN("Malformed MP_JOIN option");
+        return 0;
+    }
+    return GetSerializedSize();
+}
+
+void
+TcpOptionMpTcpJoin::SetMode(Mode mode)
+{
+    m_mode = mode;
+}
+
+TcpOptionMpTcpJoin::Mode
+TcpOptionMpTcpJoin::GetMode() const
+{
+    return m_mode;
+}
+
+void
+TcpOptionMpTcpJoin::SetAddressId(uint8_t addressId)
+{
+    m_addressId = addressId;
+}
+
+uint8_t
+TcpOptionMpTcpJoin::GetAddressId() const
+{
+    return m_addressId;
+}
+
+void
+TcpOptionMpTcpJoin::SetToken(uint32_t token)
+{
+    m_token = token;
+}
+
+uint32_t
+TcpOptionMpTcpJoin::GetToken() const
+{
+    return m_token;
+}
+
+void
+TcpOptionMpTcpJoin::SetNonce(uint32_t nonce)
+{
+    m_nonce = nonce;
+}
+
+uint32_t
+TcpOptionMpTcpJoin::GetNonce() const
+{
+    return m_nonce;
+}
+
+void
+TcpOptionMpTcpJoin::SetTruncatedHmac(uint64_t hmac)
+{
+    m_hmac = hmac;
+}
+
+uint64_t
+TcpOptionMpTcpJoin::GetTruncatedHmac() const
+{
+    return m_hmac;
+}
+
+NS_OBJECT_ENSURE_REGISTERED(TcpOptionMpTcpDss);
+
+TypeId
+TcpOptionMpTcpDss::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::TcpOptionMpTcpDss")
+                            .SetParent<TcpOptionMpTcp>()
+                            .SetGroupName("Internet")
+                            .AddConstructor<TcpOptionMpTcpDss>();
+    return tid;
+}
+
+TypeId
+TcpOptionMpTcpDss::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+TcpOptionMpTcpDss::TcpOptionMpTcpDss()
+    : TcpOptionMpTcp(),
+      m_flags(0),
+      m_dataAck(0),
+      m_dataSeq(0),
+      m_subflowSeq(0),
+      m_length(0)
+{
+}
+
+TcpOptionMpTcpDss::~TcpOptionMpTcpDss()
+{
+}
+
+void
+TcpOptionMpTcpDss::Print(std::ostream& os) const
+{
+    os << "DSS";
+    if (HasDataAck())
+    {
+        os << " data ack " << m_dataAck;
+    }
+    if (HasMapping())
+    {
+        os << " dsn " << m_dataSeq << " ssn " << m_subflowSeq << " length " << m_length;
+    }
+    if (IsDataFin())
+    {
+        os << " DATA_FIN";
+    }
+}
+
+uint32_t
+TcpOptionMpTcpDss::GetSerializedSize() const
+{
+    uint32_t size = 4;
+    if (HasDataAck())
+    {
+        size += 8;
+    }
+    if (HasMapping())
+    {
+        size += 14;
+    }
+    return size;
+}
+
+TcpOptionMpTcp::SubType
+TcpOptionMpTcpDss::GetSubType() const
+{
+    return DSS;
+}
+
+void
+TcpOptionMpTcpDss::Serialize(Buffer::Iterator start) const
+{
+    Buffer::Iterator i = start;
+    i.WriteU8(GetKind());
+    i.WriteU8(GetSerializedSize());
+    i.WriteU8(GetSubType() << 4);
+    i.WriteU8(m_flags);
+    if (HasDataAck())
+    {
+        i.WriteHtonU64(m_dataAck);
+    }
+    if (HasMapping())
+    {
+        i.WriteHtonU64(m_dataSeq);
+        i.WriteHtonU32(m_subflowSeq);
+        i.WriteHtonU16(m_length);
+    }
+}
+
+uint32_t
+TcpOptionMpTcpDss::Deserialize(Buffer::Iterator start)
+{
+    Buffer::Iterator i = start;
+
+    uint8_t readKind = i.ReadU8();
+    if (readKind != GetKind())
+    {
+        NS_LOG_WARN("Malformed DSS option");
+        return 0;
+    }
+    uint8_t size = i.ReadU8();
+    i.ReadU8(); // subtype
+    m_flags = i.ReadU8();
+    if ((HasDataAck() && !(m_flags & DATA_ACK_8_BYTES)) ||
+        (HasMapping() && !(m_flags & DSN_8_BYTES)) || size != GetSerializedSize())
+    {
+        // only the 8-byte form without checksum is supported
+        NS_LOG_WARN("Unsupported DSS option format");
+        return 0;
+    }
+    if (HasDataAck())
+    {
+        m_dataAck = i.ReadNtohU64();
+    }
+    if (HasMapping())
+    {
+        m_dataSeq = i.ReadNtohU64();
+        m_subflowSeq = i.ReadNtohU32();
+        m_length = i.ReadNtohU16();
+    }
+    return GetSerializedSize();
+}
+
+void
+TcpOptionMpTcpDss::SetDataAck(uint64_t dataAck)
+{
+    m_flags |= DATA_ACK_PRESENT | DATA_ACK_8_BYTES;
+    m_dataAck = dataAck;
+}
+
+bool
+TcpOptionMpTcpDss::HasDataAck() const
+{
+    return m_flags & DATA_ACK_PRESENT;
+}
+
+uint64_t
+TcpOptionMpTcpDss::GetDataAck() const
+{
+    return m_dataAck;
+}
+
+void
+TcpOptionMpTcpDss::SetMapping(uint64_t dataSeq, uint32_t subflowSeq, uint16_t length)
+{
+    m_flags |= MAPPING_PRESENT | DSN_8_BYTES;
+    m_dataSeq = dataSeq;
+    m_subflowSeq = subflowSeq;
+    m_length = length;
+}
+
+bool
+TcpOptionMpTcpDss::HasMapping() const
+{
+    return m_flags & MAPPING_PRESENT;
+}
+
+uint64_t
+TcpOptionMpTcpDss::GetDataSequenceNumber() const
+{
+    return m_dataSeq;
+}
+
+uint32_t
+TcpOptionMpTcpDss::GetSubflowSequenceNumber() const
+{
+    return m_subflowSeq;
+}
+
+uint16_t
+TcpOptionMpTcpDss::GetDataLevelLength() const
+{
+    return m_length;
+}
+
+void
+TcpOptionMpTcpDss::SetDataFin(bool dataFin)
+{
+    if (dataFin)
+    {
+        m_flags |= DATA_FIN;
+    }
+    else
+    {
+        m_flags &= ~DATA_FIN;
+    }
+}
+
+bool
+TcpOptionMpTcpDss::IsDataFin() const
+{
+    return m_flags & DATA_FIN;
+}
+
+NS_OBJECT_ENSURE_REGISTERED(TcpOptionMpTcpAddAddress);
+
+TypeId
+TcpOptionMpTcpAddAddress::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::TcpOptionMpTcpAddAddress")
+                            .SetParent<TcpOptionMpTcp>()
+                            .SetGroupName("Internet")
+                            .AddConstructor<TcpOptionMpTcpAddAddress>();
+    return tid;
+}
+
+TypeId
+TcpOptionMpTcpAddAddress::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+TcpOptionMpTcpAddAddress::TcpOptionMpTcpAddAddress()
+    : TcpOptionMpTcp(),
+      m_address(Ipv4Address()),
+      m_addressId(0)
+{
+}
+
+TcpOptionMpTcpAddAddress::~TcpOptionMpTcpAddAddress()
+{
+}
+
+void
+TcpOptionMpTcpAddAddress::Print(std::ostream& os) const
+{
+    os << "ADD_ADDR id " << static_cast<int>(m_addressId) << " ";
+    if (Ipv4Address::IsMatchingType(m_address))
+    {
+        os << Ipv4Address::ConvertFrom(m_address);
+    }
+    else
+    {
+        os << Ipv6Address::ConvertFrom(m_address);
+    }
+}
+
+uint32_t
+TcpOptionMpTcpAddAddress::GetSerializedSize() const
+{
+    return Ipv4Address::IsMatchingType(m_address) ? 8 : 20;
+}
+
+TcpOptionMpTcp::SubType
+TcpOptionMpTcpAddAddress::GetSubType() const
+{
+    return ADD_ADDR;
+}
+
+void
+TcpOptionMpTcpAddAddress::Serialize(Buffer::Iterator start) const
+{
+    Buffer::Iterator i = start;
+    i.WriteU8(GetKind());
+    i.WriteU8(GetSerializedSize());
+    if (Ipv4Address::IsMatchingType(m_address))
+    {
+        i.WriteU8(GetSubType() << 4 | 4);
+        i.WriteU8(m_addressId);
+        i.WriteHtonU32(Ipv4Address::ConvertFrom(m_address).Get());
+    }
+    else
+    {
+        i.WriteU8(GetSubType() << 4 | 6);
+        i.WriteU8(m_addressId);
+        uint8_t buf[16];
+        Ipv6Address::ConvertFrom(m_address).GetBytes(buf);
+        i.Write(buf, 16);
+    }
+}
+
+uint32_t
+TcpOptionMpTcpAddAddress::Deserialize(Buffer::Iterator start)
+{
+    Buffer::Iterator i = start;
+
+    uint8_t readKind = i.ReadU8();
+    if (readKind != GetKind())
+    {
+        NS_LOG_WARN("Malformed ADD_ADDR option");
+        return 0;
+    }
+    uint8_t size = i.ReadU8();
+    uint8_t ipVersion = i.ReadU8() & 0x0f;
+    m_addressId = i.ReadU8();
+    if (ipVersion == 4 && size == 8)
+    {
+        m_address = Ipv4Address(i.ReadNtohU32());
+    }
+    else if (ipVersion == 6 && size == 20)
+    {
+        uint8_t buf[16];
+        i.Read(buf, 16);
+        m_address = Ipv6Address(buf);
+    }
+    else
+    {
+        NS_LOG_WARN("Malformed ADD_ADDR option");
+        return 0;
+    }
+    return GetSerializedSize();
+}
+
+void
+TcpOptionMpTcpAddAddress::SetAddress(const Address& address, uint8_t addressId)
+{
+    NS_ASSERT(Ipv4Address::IsMatchingType(address) || Ipv6Address::IsMatchingType(address));
+    m_address = address;
+    m_addressId = addressId;
+}
+
+Address
+TcpOptionMpTcpAddAddress::GetAddress() const
+{
+    return m_address;
+}
+
+uint8_t
+TcpOptionMpTcpAddAddress::GetAddressId() const
+{
+    return m_addressId;
+}
+
+} // namespace ns3
@@ -0,0 +1,406 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef TCP_OPTION_MPTCP_H
+#define TCP_OPTION_MPTCP_H
+
+#include "ns3/address.h"
+#include "ns3/tcp-option.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup tcp
+ *
+ * \brief Base class of the Multipath TCP options (option kind 30, \RFC{8684})
+ *
+ * All the MPTCP options share the same kind, and are distinguished by the
+ * subtype carried in the first four bits of their third byte.
+ */
+class TcpOptionMpTcp : public TcpOption
+{
+  public:
+    /**
+     * \brief MPTCP option subtypes
+     */
+    enum SubType
+    {
+        MP_CAPABLE = 0, //!< Multipath Capable
+        MP_JOIN = 1,    //!< Join Connection
+        DSS = 2,        //!< Data Sequence Signal
+        ADD_ADDR = 3    //!< Add Address
+    };
+
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    TcpOptionMpTcp();
+    ~TcpOptionMpTcp() override;
+
+    uint8_t GetKind() const override;
+
+    /**
+     * \brief Get the subtype of the option
+     * \return the MPTCP subtype
+     */
+    virtual SubType GetSubType() const = 0;
+
+    /**
+     * \brief Creates an MPTCP option
+     * \param subtype the MPTCP subtype
+     * \return the requested option or an ns3::TcpOptionUnknown if the subtype is not supported
+     */
+    static Ptr<TcpOption> CreateMpTcpOption(uint8_t subtype);
+};
+
+/**
+ * \ingroup tcp
+ *
+ * \brief The MP_CAPABLE option, exchanged during the handshake of the first subflow
+ *
+ * The SYN and SYN+ACK carry the key of their sender; the third ACK carries
+ * both keys. As in \RFC{6824}, the keys are exchanged in clear; the HMAC
+ * based authentication of \RFC{8684} is not modelled.
+ */
+class TcpOptionMpTcpCapable : public TcpOptionMpTcp
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+
+    TcpOptionMpTcpCapable();
+    ~TcpOptionMpTcpCapable() override;
+
+    void Print(std::ostream& os) const override;
+    void Serialize(Buffer::Iterator start) const override;
+    uint32_t Deserialize(Buffer::Iterator start) override;
+    uint32_t GetSerializedSize() const override;
+    SubType GetSubType() const override;
+
+    /**
+     * \brief Set the key of the sender of the option
+     * \param key the 64-bit key
+     */
+    void SetSenderKey(uint64_t key);
+
+    /**
+     * \brief Get the key of the sender of the option
+     * \return the 64-bit key
+     */
+    uint64_t GetSenderKey() const;
+
+    /**
+     * \brief Set the key of the receiver of the option (third ACK only)
+     * \param key the 64-bit key
+     */
+    void SetPeerKey(uint64_t key);
+
+    /**
+     * \brief Get the key of the receiver of the option
+     * \return the 64-bit key
+     */
+    uint64_t GetPeerKey() const;
+
+    /**
+     * \brief Check if the option carries the key of its receiver
+     * \return true for the option of the third ACK
+     */
+    bool HasPeerKey() const;
+
+  private:
+    uint64_t m_senderKey; //!< Key of the sender
+    uint64_t m_peerKey;   //!< Key of the receiver
+    bool m_hasPeerKey;    //!< True if the receiver key is present
+};
+
+/**
+ * \ingroup tcp
+ *
+ * \brief The MP_JOIN option, used to add a subflow to an existing connection
+ *
+ * The three forms of \RFC{8684} are supported: the SYN carries the token of
+ * the connection and a random nonce, the SYN+ACK a truncated HMAC and a nonce,
+ * and the third ACK the full HMAC. Only the first 64 bits of the HMAC are
+ * modelled, the remaining bytes of the third ACK form are set to zero.
+ */
+class TcpOptionMpTcpJoin : public TcpOptionMpTcp
+{
+  public:
+    /**
+     * \brief The form of the option, which depends on the handshake segment
+     */
+    enum Mode
+    {
+        SYN = 0,     //!< Option in the SYN (12 bytes)
+        SYN_ACK = 1, //!< Option in the SYN+ACK (16 bytes)
+        ACK = 2      //!< Option in the third ACK (24 bytes)
+    };
+
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+
+    TcpOptionMpTcpJoin();
+    ~TcpOptionMpTcpJoin() override;
+
+    void Print(std::ostream& os) const override;
+    void Serialize(Buffer::Iterator start) const override;
+    uint32_t Deserialize(Buffer::Iterator start) override;
+    uint32_t GetSerializedSize() const override;
+    SubType GetSubType() const override;
+
+    /**
+     * \brief Set the form of the option
+     * \param mode the form of the option
+     */
+    void SetMode(Mode mode);
+
+    /**
+     * \brief Get the form of the option
+     * \return the form of the option
+     */
+    Mode GetMode() const;
+
+    /**
+     * \brief Set the identifier of the address of the sender (SYN and SYN+ACK)
+     * \param addressId the address identifier
+     */
+    void SetAddressId(uint8_t addressId);
+
+    /**
+     * \brief Get the identifier of the address of the sender
+     * \return the address identifier
+     */
+    uint8_t GetAddressId() const;
+
+    /**
+     * \brief Set the token of the connection being joined (SYN)
+     * \param token the token of the receiver
+     */
+    void SetToken(uint32_t token);
+
+    /**
+     * \brief Get the token of the connection being joined
+     * \return the token
+     */
+    uint32_t GetToken() const;
+
+    /**
+     * \brief Set the random nonce of the sender (SYN and SYN+ACK)
+     * \param nonce the nonce
+     */
+    void SetNonce(uint32_t nonce);
+
+    /**
+     * \brief Get the random nonce of the sender
+     * \return the nonce
+     */
+    uint32_t GetNonce() const;
+
+    /**
+     * \brief Set the (truncated) HMAC of the sender (SYN+ACK and ACK)
+     * \param hmac the leftmost 64 bits of the HMAC
+     */
+    void SetTruncatedHmac(uint64_t hmac);
+
+    /**
+     * \brief Get the (truncated) HMAC of the sender
+     * \return the leftmost 64 bits of the HMAC
+     */
+    uint64_t GetTruncatedHmac() const;
+
+  private:
+    Mode m_mode;         //!< Form of the option
+    uint8_t m_addressId; //!< Address identifier
+    uint32_t m_token;    //!< Token of the connection
+    uint32_t m_nonce;    //!< Random nonce
+    uint64_t m_hmac;     //!< Leftmost 64 bits of the HMAC
+};
+
+/**
+ * \ingroup tcp
+ *
+ * \brief The DSS (Data Sequence Signal) option
+ *
+ * The option carries the cumulative data-level acknowledgment and/or the
+ * mapping between a range of the subflow sequence space and the data
+ * sequence space. Data sequence numbers and data ACKs are always sent in
+ * their 8-byte form, and the DSS checksum is not used.
+ */
+class TcpOptionMpTcpDss : public TcpOptionMpTcp
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+
+    TcpOptionMpTcpDss();
+    ~TcpOptionMpTcpDss() override;
+
+    void Print(std::ostream& os) const override;
+    void Serialize(Buffer::Iterator start) const override;
+    uint32_t Deserialize(Buffer::Iterator start) override;
+    uint32_t GetSerializedSize() const override;
+    SubType GetSubType() const override;
+
+    /**
+     * \brief Set the data ACK
+     * \param dataAck the next data sequence number expected
+     */
+    void SetDataAck(uint64_t dataAck);
+
+    /**
+     * \brief Check if the option carries a data ACK
+     * \return true if the data ACK is present
+     */
+    bool HasDataAck() const;
+
+    /**
+     * \brief Get the data ACK
+     * \return the next data sequence number expected
+     */
+    uint64_t GetDataAck() const;
+
+    /**
+     * \brief Set the mapping carried by the option
+     * \param dataSeq the data sequence number of the first byte of the mapping
+     * \param subflowSeq the subflow sequence number of the first byte, relative to the ISN
+     * \param length the length of the mapping, in bytes
+     */
+    void SetMapping(uint64_t dataSeq, uint32_t subflowSeq, uint16_t length);
+
+    /**
+     * \brief Check if the option carries a mapping
+     * \return true if the mapping is present
+     */
+    bool HasMapping() const;
+
+    /**
+     * \brief Get the data sequence number of the first byte of the mapping
+     * \return the data sequence number
+     */
+    uint64_t GetDataSequenceNumber() const;
+
+    /**
+     * \brief Get the relative subflow sequence number of the first byte of the mapping
+     * \return the subflow sequence number
+     */
+    uint32_t GetSubflowSequenceNumber() const;
+
+    /**
+     * \brief Get the length of the mapping
+     * \return the data-level length, in bytes
+     */
+    uint16_t GetDataLevelLength() const;
+
+    /**
+     * \brief Set the DATA_FIN flag
+     * \param dataFin true if the mapping ends with a DATA_FIN
+     */
+    void SetDataFin(bool dataFin);
+
+    /**
+     * \brief Check the DATA_FIN flag
+     * \return true if the mapping ends with a DATA_FIN
+     */
+    bool IsDataFin() const;
+
+  private:
+    /**
+     * \brief DSS flags
+     */
+    enum Flags
+    {
+        DATA_ACK_PRESENT = 0x01, //!< A: data ACK present
+        DATA_ACK_8_BYTES = 0x02, //!< a: data ACK is 8 bytes
+        MAPPING_PRESENT = 0x04,  //!< M: mapping present
+        DSN_8_BYTES = 0x08,      //!< m: data sequence number is 8 bytes
+        DATA_FIN = 0x10          //!< F: DATA_FIN
+    };
+
+    uint8_t m_flags;       //!< DSS flags
+    uint64_t m_dataAck;    //!< Data ACK
+    uint64_t m_dataSeq;    //!< Data sequence number of the mapping
+    uint32_t m_subflowSeq; //!< Relative subflow sequence number of the mapping
+    uint16_t m_length;     //!< Data-level length of the mapping
+};
+
+/**
+ * \ingroup tcp
+ *
+ * \brief The ADD_ADDR option, used to announce an additional address of the host
+ *
+ * The \RFC{6824} format is used: the option carries the address identifier
+ * and the IPv4 or IPv6 address, without port and HMAC.
+ */
+class TcpOptionMpTcpAddAddress : public TcpOptionMpTcp
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+
+    TcpOptionMpTcpAddAddress();
+    ~TcpOptionMpTcpAddAddress() override;
+
+    void Print(std::ostream& os) const override;
+    void Serialize(Buffer::Iterator start) const override;
+    uint32_t Deserialize(Buffer::Iterator start) override;
+    uint32_t GetSerializedSize() const override;
+    SubType GetSubType() const override;
+
+    /**
+     * \brief Set the announced address
+     * \param address an Ipv4Address or an Ipv6Address
+     * \param addressId the identifier of the address
+     */
+    void SetAddress(const Address& address, uint8_t addressId);
+
+    /**
+     * \brief Get the announced address
+     * \return an Ipv4Address or an Ipv6Address
+     */
+    Address GetAddress() const;
+
+    /**
+     * \brief Get the identifier of the announced address
+     * \return the address identifier
+     */
+    uint8_t GetAddressId() const;
+
+  private:
+    Address m_address;   //!< Announced address
+    uint8_t m_addressId; //!< Identifier of the address
+};
+
+} // namespace ns3
+
+#endif /* TCP_OPTION_MPTCP_H */
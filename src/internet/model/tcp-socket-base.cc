@@ -58,6 +58,7 @@
 #include "ns3/object.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/simulation-singleton.h"
 #include "ns3/simulator.h"
 #include "ns3/tcp-rate-ops.h"
@@ -74,6 +75,10 @@ NS_LOG_COMPONENT_DEFINE("TcpSocketBase");
 
 NS_OBJECT_ENSURE_REGISTERED(TcpSocketBase);
 
+/// Largest super-segment payload that keeps the IP length field in range with
+/// maximum-size IP and TCP headers
+static const uint32_t TSO_MAX_SIZE = 65535 - 60 - 60;
+
 TypeId
 TcpSocketBase::GetTypeId()
 {
@@ -163,6 +168,13 @@ TcpSocketBase::GetTypeId()
                           BooleanValue(true),
                           MakeBooleanAccessor(&TcpSocketBase::m_limitedTx),
                           MakeBooleanChecker())
+            .AddAttribute("TsoMaxSegments",
+                          "Maximum number of segments of new data sent as a single "
+                          "super-segment, which is split into segments right before the "
+                          "IP layer (1 disables it)",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&TcpSocketBase::m_tsoMaxSegments),
+                          MakeUintegerChecker<uint32_t>(1))
             .AddAttribute("UseEcn",
                           "Parameter to set ECN functionality",
                           EnumValue(TcpSocketState::Off),
@@ -370,6 +382,7 @@ TcpSocketBase::TcpSocketBase(const TcpSocketBase& sock)
       m_recoverActive(sock.m_recoverActive),
       m_retxThresh(sock.m_retxThresh),
       m_limitedTx(sock.m_limitedTx),
+      m_tsoMaxSegments(sock.m_tsoMaxSegments),
       m_isFirstPartialAck(sock.m_isFirstPartialAck),
       m_txTrace(sock.m_txTrace),
       m_rxTrace(sock.m_rxTrace),
@@ -3174,6 +3187,12 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
 
     AddSocketTags(p);
 
+    if (sz > m_tcb->m_segmentSize)
+    {
+        SegmentationOffloadTag tsoTag(m_tcb->m_segmentSize, sz);
+        p->ReplacePacketTag(tsoTag);
+    }
+
     if (m_closeOnEmpty && (remainingData == 0))
     {
         flags |= TcpHeader::FIN;
@@ -3269,7 +3288,15 @@ TcpSocketBase::UpdateRttHistory(const SequenceNumber32& seq, uint32_t sz, bool i
     // update the history of sequence numbers used to calculate the RTT
     if (isRetransmission == false)
     { // This is the next expected one, just log at end
-        m_history.emplace_back(seq, sz, Simulator::Now());
+        // A super-segment is logged as the segments it is split into, so that
+        // an ACK covering only some of them still gives an RTT sample
+        uint32_t offset = 0;
+        do
+        {
+            uint32_t count = std::min(sz - offset, m_tcb->m_segmentSize);
+            m_history.emplace_back(seq + SequenceNumber32(offset), count, Simulator::Now());
+            offset += count;
+        } while (offset < sz);
     }
     else
     { // This is a retransmit, find in list and mark as re-tx
@@ -3374,6 +3401,26 @@ TcpSocketBase::SendPendingData(bool withAck)
             uint32_t maxSizeToSend = static_cast<uint32_t>(nextHigh - next);
             s = std::min(s, maxSizeToSend);
 
+            // With segmentation offload, new data is sent as a super-segment of
+            // up to m_tsoMaxSegments full-sized segments, still bounded by the
+            // available and the receiver windows
+            if (m_tsoMaxSegments > 1 && s == m_tcb->m_segmentSize &&
+                next >= m_tcb->m_highTxMark.Get())
+            {
+                uint32_t tsoSize = std::min(m_tsoMaxSegments * m_tcb->m_segmentSize,
+                                            TSO_MAX_SIZE - TSO_MAX_SIZE % m_tcb->m_segmentSize);
+                uint32_t rWndLeft =
+                    static_cast<uint32_t>(m_highRxAckMark + SequenceNumber32(m_rWnd) - next);
+                tsoSize = std::min({tsoSize, availableWindow, rWndLeft, availableData});
+                if (tsoSize > m_tcb->m_segmentSize)
+                {
+                    // Only the last segment of the train may be smaller than a MSS
+                    s = tsoSize == availableData
+                            ? tsoSize
+                            : tsoSize - tsoSize % m_tcb->m_segmentSize;
+                }
+            }
+
             // (C.2) If any of the data octets sent in (C.1) are below HighData,
             //       HighRxt MUST be set to the highest sequence number of the
             //       retransmitted segment unless NextSeg () rule (4) was
@@ -1124,7 +1124,7 @@ class TcpSocketBase : public TcpSocket
      *
      * \param tcpHeader TcpHeader to add options to
      */
-    void AddOptions(TcpHeader& tcpHeader);
+    virtual void AddOptions(TcpHeader& tcpHeader);
 
     /**
      * \brief Read TCP options before Ack processing
@@ -1360,6 +1360,9 @@ class TcpSocketBase : public TcpSocket
     uint32_t m_retxThresh{3};    //!< Fast Retransmit threshold
     bool m_limitedTx{true};      //!< perform limited transmit
 
+    // Segmentation offload
+    uint32_t m_tsoMaxSegments{1}; //!< Max number of segments in a super-segment (1 disables TSO)
+
     // Transmission Control Block
     Ptr<TcpSocketState> m_tcb;                 //!< Congestion control information
     Ptr<TcpCongestionOps> m_congestionControl; //!< Congestion control
@@ -39,6 +39,7 @@
 #include "ns3/socket-factory.h"
 #include "ns3/socket.h"
 #include "ns3/test.h"
+#include "ns3/udp-header.h"
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/udp-socket-factory.h"
 #include "ns3/udp-socket.h"
@@ -52,6 +53,7 @@
 
 #include <limits>
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -577,6 +579,192 @@ Ipv4FragmentationTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 reassembly test: fragments received out of order, duplicated,
+ * overlapping or missing.
+ */
+class Ipv4ReassemblyTest : public TestCase
+{
+    /// A fragment, as its offset and size in the datagram
+    using Fragment = std::pair<uint16_t, uint16_t>;
+
+    Ptr<Node> m_node;                    //!< Receiving node.
+    Ptr<NetDevice> m_device;             //!< Receiving device.
+    Ptr<Socket> m_socket;                //!< Receiving socket.
+    Ptr<Packet> m_datagram;              //!< UDP datagram to fragment.
+    std::vector<Ptr<Packet>> m_received; //!< Packets received by the socket.
+    uint16_t m_identification;           //!< Identification of the last datagram.
+
+  public:
+    void DoRun() override;
+    Ipv4ReassemblyTest();
+
+    /**
+     * \brief Handle incoming packets.
+     * \param socket The receiving socket.
+     */
+    void HandleRead(Ptr<Socket> socket);
+
+    /**
+     * \brief Hand the fragments of a new datagram to the IPv4 layer of the node.
+     * \param fragments The fragments, in the order they are received.
+     */
+    void ReceiveFragments(std::vector<Fragment> fragments);
+
+    /**
+     * \brief Check the packets received by the socket.
+     * \param nPackets The expected number of packets.
+     */
+    void CheckReceived(std::size_t nPackets);
+};
+
+Ipv4ReassemblyTest::Ipv4ReassemblyTest()
+    : TestCase("Verify the IPv4 reassembly of fragments received out of order, duplicated, "
+               "overlapping or missing")
+{
+    m_identification = 0;
+}
+
+void
+Ipv4ReassemblyTest::HandleRead(Ptr<Socket> socket)
+{
+    Ptr<Packet> packet;
+    while ((packet = socket->Recv()))
+    {
+        m_received.push_back(packet);
+    }
+}
+
+void
+Ipv4ReassemblyTest::ReceiveFragments(std::vector<Fragment> fragments)
+{
+    m_identification++;
+    Ptr<Ipv4L3Protocol> ipv4 = m_node->GetObject<Ipv4L3Protocol>();
+    for (const auto& fragment : fragments)
+    {
+        Ptr<Packet> packet = m_datagram->CreateFragment(fragment.first, fragment.second);
+        Ipv4Header header;
+        header.SetSource(Ipv4Address("10.0.0.2"));
+        header.SetDestination(Ipv4Address("10.0.0.1"));
+        header.SetProtocol(UdpL4Protocol::PROT_NUMBER);
+        header.SetPayloadSize(fragment.second);
+        header.SetTtl(64);
+        header.SetIdentification(m_identification);
+        header.SetMayFragment();
+        header.SetFragmentOffset(fragment.first);
+        if (fragment.first + fragment.second < m_datagram->GetSize())
+        {
+            header.SetMoreFragments();
+        }
+        else
+        {
+            header.SetLastFragment();
+        }
+        packet->AddHeader(header);
+        ipv4->Receive(m_device,
+                      packet,
+                      Ipv4L3Protocol::PROT_NUMBER,
+                      Mac48Address("00:00:00:00:00:02"),
+                      m_device->GetAddress(),
+                      NetDevice::PACKET_HOST);
+    }
+}
+
+void
+Ipv4ReassemblyTest::CheckReceived(std::size_t nPackets)
+{
+    NS_TEST_ASSERT_MSG_EQ(m_received.size(), nPackets, "Unexpected number of packets received");
+    Ptr<Packet> datagram = m_datagram->Copy();
+    UdpHeader udpHeader;
+    datagram->RemoveHeader(udpHeader);
+    std::vector<uint8_t> expected(datagram->GetSize());
+    datagram->CopyData(expected.data(), expected.size());
+    for (const auto& packet : m_received)
+    {
+        NS_TEST_ASSERT_MSG_EQ(packet->GetSize(), expected.size(), "Wrong size of packet");
+        std::vector<uint8_t> data(packet->GetSize());
+        packet->CopyData(data.data(), data.size());
+        NS_TEST_EXPECT_MSG_EQ((data == expected), true, "Wrong content of packet");
+    }
+}
+
+void
+Ipv4ReassemblyTest::DoRun()
+{
+    m_node = CreateObject<Node>();
+    SimpleNetDeviceHelper helperChannel;
+    m_device = helperChannel.Install(m_node).Get(0);
+    InternetStackHelper internet;
+    internet.Install(m_node);
+
+    Ptr<Ipv4> ipv4 = m_node->GetObject<Ipv4>();
+    uint32_t netdev_idx = ipv4->AddInterface(m_device);
+    ipv4->AddAddress(netdev_idx,
+                     Ipv4InterfaceAddress(Ipv4Address("10.0.0.1"), Ipv4Mask(0xffff0000U)));
+    ipv4->SetUp(netdev_idx);
+
+    m_socket = Socket::CreateSocket(m_node, UdpSocketFactory::GetTypeId());
+    m_socket->Bind(InetSocketAddress(Ipv4Address::GetAny(), 9));
+    m_socket->SetRecvCallback(MakeCallback(&Ipv4ReassemblyTest::HandleRead, this));
+
+    // a 1008 bytes UDP datagram, cut in six fragments of 168 bytes
+    std::vector<uint8_t> payload(1000);
+    for (std::size_t i = 0; i < payload.size(); i++)
+    {
+        payload[i] = i % 251;
+    }
+    m_datagram = Create<Packet>(payload.data(), payload.size());
+    UdpHeader udpHeader;
+    udpHeader.SetSourcePort(1234);
+    udpHeader.SetDestinationPort(9);
+    m_datagram->AddHeader(udpHeader);
+    std::vector<Fragment> f;
+    for (uint16_t offset = 0; offset < m_datagram->GetSize(); offset += 168)
+    {
+        f.emplace_back(offset, 168);
+    }
+
+    // in order
+    Simulator::Schedule(Seconds(1), &Ipv4ReassemblyTest::ReceiveFragments, this, f);
+    Simulator::Schedule(Seconds(1.5), &Ipv4ReassemblyTest::CheckReceived, this, 1);
+    // in reverse order, the last fragment first
+    Simulator::Schedule(Seconds(2),
+                        &Ipv4ReassemblyTest::ReceiveFragments,
+                        this,
+                        std::vector<Fragment>{f[5], f[4], f[3], f[2], f[1], f[0]});
+    Simulator::Schedule(Seconds(2.5), &Ipv4ReassemblyTest::CheckReceived, this, 2);
+    // out of order, with duplicates
+    Simulator::Schedule(Seconds(3),
+                        &Ipv4ReassemblyTest::ReceiveFragments,
+                        this,
+                        std::vector<Fragment>{f[3], f[0], f[3], f[5], f[1], f[5], f[4], f[2]});
+    Simulator::Schedule(Seconds(3.5), &Ipv4ReassemblyTest::CheckReceived, this, 3);
+    // overlapping fragments, which IPv4 accepts
+    Simulator::Schedule(Seconds(4),
+                        &Ipv4ReassemblyTest::ReceiveFragments,
+                        this,
+                        std::vector<Fragment>{{0, 336}, {504, 504}, {168, 504}});
+    Simulator::Schedule(Seconds(4.5), &Ipv4ReassemblyTest::CheckReceived, this, 4);
+    // a missing fragment
+    Simulator::Schedule(Seconds(5),
+                        &Ipv4ReassemblyTest::ReceiveFragments,
+                        this,
+                        std::vector<Fragment>{f[0], f[1], f[3], f[4], f[5]});
+    Simulator::Schedule(Seconds(5.5), &Ipv4ReassemblyTest::CheckReceived, this, 4);
+
+    Simulator::Run();
+    CheckReceived(4);
+
+    m_socket->Close();
+    m_socket = nullptr;
+    m_device = nullptr;
+    m_node = nullptr;
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -594,6 +782,7 @@ Ipv4FragmentationTestSuite::Ipv4FragmentationTestSuite()
 {
     AddTestCase(new Ipv4FragmentationTest(false), TestCase::QUICK);
     AddTestCase(new Ipv4FragmentationTest(true), TestCase::QUICK);
+    AddTestCase(new Ipv4ReassemblyTest, TestCase::QUICK);
 }
 
 static Ipv4FragmentationTestSuite
@@ -16,6 +16,7 @@
 #include "ns3/boolean.h"
 #include "ns3/bridge-helper.h"
 #include "ns3/config.h"
+#include "ns3/enum.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
@@ -37,10 +38,13 @@
 #include "ns3/simulator.h"
 #include "ns3/socket-factory.h"
 #include "ns3/string.h"
+#include "ns3/tcp-header.h"
 #include "ns3/test.h"
+#include "ns3/udp-header.h"
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <set>
 #include <vector>
 
 using namespace ns3;
@@ -1321,6 +1325,244 @@ Ipv4GlobalRoutingSlash32TestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 GlobalRouting ECMP, WCMP and flowlet test
+ *
+ * Node 0 reaches the LAN of node 3 through two equal-cost paths, via
+ * node 1 and via node 2:
+ *
+ * \verbatim
+       10.1.1.0/30    10.1.3.0/30
+     +---------- n1 ----------+
+     |                        |
+    n0                        n3 ===== n4    10.1.5.0/24
+     |                        |
+     +---------- n2 ----------+
+       10.1.2.0/30    10.1.4.0/30
+   \endverbatim
+ */
+class EcmpTest : public TestCase
+{
+  public:
+    void DoSetup() override;
+    void DoRun() override;
+    EcmpTest();
+
+  private:
+    /**
+     * \brief Let node 0 forward a UDP packet to the LAN of node 3
+     * \param srcPort the source port of the packet
+     * \return the gateway selected by node 0
+     */
+    Ipv4Address Forward(uint16_t srcPort);
+
+    /**
+     * \brief Let node 0 route a TCP segment that it sends to the LAN of node 3
+     * \param srcPort the source port of the segment
+     * \return the gateway selected by node 0
+     */
+    Ipv4Address Send(uint16_t srcPort);
+
+    /**
+     * \brief Record the route selected for a forwarded packet
+     * \param route the route
+     * \param p the packet
+     * \param header the IPv4 header of the packet
+     */
+    void Forwarded(Ptr<Ipv4Route> route, Ptr<const Packet> p, const Ipv4Header& header);
+
+    /**
+     * \brief Send a burst of packets of the same flow and check that they take the same path
+     * \param gateways the gateways used by the bursts sent so far
+     */
+    void SendFlowlet(std::set<Ipv4Address>* gateways);
+
+    NodeContainer m_nodes;            //!< Nodes used in the test.
+    Ptr<Ipv4GlobalRouting> m_routing; //!< Global routing of node 0.
+    Ipv4Address m_gateway;            //!< Gateway of the last forwarded packet.
+};
+
+EcmpTest::EcmpTest()
+    : TestCase("Global routing ECMP, WCMP and flowlet switching")
+{
+}
+
+void
+EcmpTest::DoSetup()
+{
+    m_nodes.Create(5);
+
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetNetDevicePointToPointMode(true);
+    std::pair<uint32_t, uint32_t> links[] = {{0, 1}, {0, 2}, {1, 3}, {2, 3}};
+    NetDeviceContainer nets[4];
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+        nets[i] = simpleHelper.Install(m_nodes.Get(links[i].first), channel);
+        nets[i].Add(simpleHelper.Install(m_nodes.Get(links[i].second), channel));
+    }
+    SimpleNetDeviceHelper lanHelper;
+    Ptr<SimpleChannel> lanChannel = CreateObject<SimpleChannel>();
+    NetDeviceContainer lan = lanHelper.Install(NodeContainer(m_nodes.Get(3), m_nodes.Get(4)),
+                                               lanChannel);
+
+    InternetStackHelper internet;
+    Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+    internet.SetRoutingHelper(ipv4RoutingHelper);
+    internet.Install(m_nodes);
+
+    Ipv4AddressHelper ipv4;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        std::string network = "10.1." + std::to_string(i + 1) + ".0";
+        ipv4.SetBase(network.c_str(), "255.255.255.252");
+        ipv4.Assign(nets[i]);
+    }
+    ipv4.SetBase("10.1.5.0", "255.255.255.0");
+    ipv4.Assign(lan);
+}
+
+void
+EcmpTest::Forwarded(Ptr<Ipv4Route> route, Ptr<const Packet> p, const Ipv4Header& header)
+{
+    m_gateway = route->GetGateway();
+}
+
+Ipv4Address
+EcmpTest::Forward(uint16_t srcPort)
+{
+    Ptr<Packet> p = Create<Packet>(100);
+    UdpHeader udp;
+    udp.SetSourcePort(srcPort);
+    udp.SetDestinationPort(9);
+    p->AddHeader(udp);
+    Ipv4Header header;
+    header.SetSource(Ipv4Address("10.2.0.1"));
+    header.SetDestination(Ipv4Address("10.1.5.2"));
+    header.SetProtocol(17);
+    header.SetPayloadSize(p->GetSize());
+
+    m_gateway = Ipv4Address();
+    m_routing->RouteInput(p,
+                          header,
+                          m_nodes.Get(0)->GetDevice(0),
+                          MakeCallback(&EcmpTest::Forwarded, this),
+                          Ipv4RoutingProtocol::MulticastForwardCallback(),
+                          Ipv4RoutingProtocol::LocalDeliverCallback(),
+                          Ipv4RoutingProtocol::ErrorCallback());
+    return m_gateway;
+}
+
+Ipv4Address
+EcmpTest::Send(uint16_t srcPort)
+{
+    Ptr<Packet> p = Create<Packet>(100);
+    TcpHeader tcp;
+    tcp.SetSourcePort(srcPort);
+    tcp.SetDestinationPort(9);
+    p->AddHeader(tcp);
+    Ipv4Header header;
+    header.SetSource(Ipv4Address("10.1.1.1"));
+    header.SetDestination(Ipv4Address("10.1.5.2"));
+    header.SetProtocol(6);
+
+    Socket::SocketErrno sockerr;
+    Ptr<Ipv4Route> route = m_routing->RouteOutput(p, header, nullptr, sockerr);
+    return route ? route->GetGateway() : Ipv4Address();
+}
+
+void
+EcmpTest::SendFlowlet(std::set<Ipv4Address>* gateways)
+{
+    Ipv4Address first = Forward(1000);
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(Forward(1000), first, "A flowlet changed path");
+    }
+    gateways->insert(first);
+}
+
+void
+EcmpTest::DoRun()
+{
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    Ptr<Ipv4RoutingProtocol> routing = m_nodes.Get(0)->GetObject<Ipv4>()->GetRoutingProtocol();
+    m_routing = routing->GetObject<Ipv4GlobalRouting>();
+    NS_TEST_ASSERT_MSG_NE(m_routing, nullptr, "Error-- no Ipv4GlobalRouting object");
+    m_routing->AssignStreams(1);
+
+    // Both equal-cost paths to the LAN are recorded
+    std::set<Ipv4Address> lanGateways;
+    for (uint32_t i = 0; i < m_routing->GetNRoutes(); ++i)
+    {
+        Ipv4RoutingTableEntry* route = m_routing->GetRoute(i);
+        if (route->IsNetwork() && route->GetDestNetwork() == Ipv4Address("10.1.5.0"))
+        {
+            lanGateways.insert(route->GetGateway());
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(lanGateways.size(), 2, "Error-- equal-cost path not recorded");
+    NS_TEST_ASSERT_MSG_EQ(lanGateways.count(Ipv4Address("10.1.1.2")), 1, "Error-- no path via n1");
+    NS_TEST_ASSERT_MSG_EQ(lanGateways.count(Ipv4Address("10.1.2.2")), 1, "Error-- no path via n2");
+
+    // Without ECMP, the first route is always used
+    Ipv4Address first = Forward(1);
+    for (uint16_t port = 2; port < 64; ++port)
+    {
+        NS_TEST_EXPECT_MSG_EQ(Forward(port), first, "Error-- ECMP used while disabled");
+    }
+
+    // Per-flow ECMP: a flow always uses the same path, and flows use both paths
+    m_routing->SetAttribute("EcmpMode", EnumValue(Ipv4GlobalRouting::ECMP_FLOW_HASH));
+    std::set<Ipv4Address> used;
+    for (uint16_t port = 1; port < 64; ++port)
+    {
+        Ipv4Address gateway = Forward(port);
+        NS_TEST_EXPECT_MSG_EQ(Forward(port), gateway, "Error-- a flow changed path");
+        used.insert(gateway);
+    }
+    NS_TEST_EXPECT_MSG_EQ(used.size(), 2, "Error-- flows not spread among the paths");
+
+    // The TCP flows of the node itself are also hashed on their ports
+    used.clear();
+    for (uint16_t port = 1; port < 64; ++port)
+    {
+        Ipv4Address gateway = Send(port);
+        NS_TEST_EXPECT_MSG_EQ(Send(port), gateway, "Error-- a local flow changed path");
+        used.insert(gateway);
+    }
+    NS_TEST_EXPECT_MSG_EQ(used.size(), 2, "Error-- local flows not spread among the paths");
+
+    // WCMP: an interface with a zero weight is not used
+    uint32_t viaN2 = m_nodes.Get(0)->GetObject<Ipv4>()->GetInterfaceForAddress(
+        Ipv4Address("10.1.2.1"));
+    m_routing->SetInterfaceWeight(viaN2, 0);
+    for (uint16_t port = 1; port < 64; ++port)
+    {
+        NS_TEST_EXPECT_MSG_EQ(Forward(port),
+                              Ipv4Address("10.1.1.2"),
+                              "Error-- route with a zero weight used");
+    }
+    m_routing->SetInterfaceWeight(viaN2, 1);
+
+    // Flowlets: the packets of a burst follow the same path, the bursts use both paths
+    m_routing->SetAttribute("EcmpMode", EnumValue(Ipv4GlobalRouting::ECMP_FLOWLET));
+    m_routing->SetAttribute("FlowletGap", TimeValue(MilliSeconds(1)));
+    used.clear();
+    for (uint32_t i = 0; i < 32; ++i)
+    {
+        Simulator::Schedule(MilliSeconds(10 * i), &EcmpTest::SendFlowlet, this, &used);
+    }
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(used.size(), 2, "Error-- flowlets not spread among the paths");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -1344,6 +1586,7 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite()
     AddTestCase(new TwoBridgeTest, TestCase::QUICK);
     AddTestCase(new Ipv4DynamicGlobalRoutingTestCase, TestCase::QUICK);
     AddTestCase(new Ipv4GlobalRoutingSlash32TestCase, TestCase::QUICK);
+    AddTestCase(new EcmpTest, TestCase::QUICK);
 }
 
 static Ipv4GlobalRoutingTestSuite
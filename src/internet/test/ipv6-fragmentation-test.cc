@@ -35,18 +35,21 @@
 #include "ns3/ipv4-list-routing.h"
 #include "ns3/ipv4-raw-socket-factory.h"
 #include "ns3/ipv4-static-routing.h"
+#include "ns3/ipv6-extension-header.h"
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/ipv6-list-routing.h"
 #include "ns3/ipv6-raw-socket-factory.h"
 #include "ns3/ipv6-static-routing.h"
 #include "ns3/log.h"
 #include "ns3/node.h"
+#include "ns3/simple-net-device-helper.h"
 #include "ns3/simple-net-device.h"
 #include "ns3/simulator.h"
 #include "ns3/socket-factory.h"
 #include "ns3/socket.h"
 #include "ns3/test.h"
 #include "ns3/traffic-control-layer.h"
+#include "ns3/udp-header.h"
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/udp-socket-factory.h"
 #include "ns3/udp-socket.h"
@@ -60,6 +63,7 @@
 
 #include <limits>
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -616,6 +620,194 @@ Ipv6FragmentationTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv6 reassembly test: fragments received out of order, duplicated,
+ * overlapping or missing.
+ */
+class Ipv6ReassemblyTest : public TestCase
+{
+    /// A fragment, as its offset and size in the datagram
+    using Fragment = std::pair<uint16_t, uint16_t>;
+
+    Ptr<Node> m_node;                      //!< Receiving node.
+    Ptr<NetDevice> m_device;               //!< Receiving device.
+    Ptr<Socket> m_socket;                  //!< Receiving socket.
+    Ptr<Packet> m_datagram;                //!< UDP datagram to fragment.
+    std::vector<Ptr<Packet>> m_received;   //!< Packets received by the socket.
+    uint16_t m_identification;             //!< Identification of the last datagram sent.
+
+  public:
+    void DoRun() override;
+    Ipv6ReassemblyTest();
+
+    /**
+     * \brief Handle incoming packets.
+     * \param socket The receiving socket.
+     */
+    void HandleRead(Ptr<Socket> socket);
+
+    /**
+     * \brief Hand the fragments of a new datagram to the IPv6 layer of the node.
+     * \param fragments The fragments, in the order they are received.
+     */
+    void ReceiveFragments(std::vector<Fragment> fragments);
+
+    /**
+     * \brief Check the packets received by the socket.
+     * \param nPackets The expected number of packets.
+     */
+    void CheckReceived(std::size_t nPackets);
+};
+
+Ipv6ReassemblyTest::Ipv6ReassemblyTest()
+    : TestCase("Verify the IPv6 reassembly of fragments received out of order, duplicated, "
+               "overlapping or missing")
+{
+    m_identification = 0;
+}
+
+void
+Ipv6ReassemblyTest::HandleRead(Ptr<Socket> socket)
+{
+    Ptr<Packet> packet;
+    while ((packet = socket->Recv()))
+    {
+        m_received.push_back(packet);
+    }
+}
+
+void
+Ipv6ReassemblyTest::ReceiveFragments(std::vector<Fragment> fragments)
+{
+    m_identification++;
+    Ptr<Ipv6L3Protocol> ipv6 = m_node->GetObject<Ipv6L3Protocol>();
+    for (const auto& fragment : fragments)
+    {
+        Ptr<Packet> packet = m_datagram->CreateFragment(fragment.first, fragment.second);
+        Ipv6ExtensionFragmentHeader fragmentHeader;
+        fragmentHeader.SetNextHeader(UdpL4Protocol::PROT_NUMBER);
+        fragmentHeader.SetIdentification(m_identification);
+        fragmentHeader.SetOffset(fragment.first);
+        fragmentHeader.SetMoreFragment(fragment.first + fragment.second < m_datagram->GetSize());
+        packet->AddHeader(fragmentHeader);
+        Ipv6Header header;
+        header.SetSource(Ipv6Address("2001::2"));
+        header.SetDestination(Ipv6Address("2001::1"));
+        header.SetNextHeader(Ipv6Header::IPV6_EXT_FRAGMENTATION);
+        header.SetPayloadLength(packet->GetSize());
+        header.SetHopLimit(64);
+        packet->AddHeader(header);
+        ipv6->Receive(m_device,
+                      packet,
+                      Ipv6L3Protocol::PROT_NUMBER,
+                      Mac48Address("00:00:00:00:00:02"),
+                      m_device->GetAddress(),
+                      NetDevice::PACKET_HOST);
+    }
+}
+
+void
+Ipv6ReassemblyTest::CheckReceived(std::size_t nPackets)
+{
+    NS_TEST_ASSERT_MSG_EQ(m_received.size(), nPackets, "Unexpected number of packets received");
+    Ptr<Packet> datagram = m_datagram->Copy();
+    UdpHeader udpHeader;
+    datagram->RemoveHeader(udpHeader);
+    std::vector<uint8_t> expected(datagram->GetSize());
+    datagram->CopyData(expected.data(), expected.size());
+    for (const auto& packet : m_received)
+    {
+        NS_TEST_ASSERT_MSG_EQ(packet->GetSize(), expected.size(), "Wrong size of packet");
+        std::vector<uint8_t> data(packet->GetSize());
+        packet->CopyData(data.data(), data.size());
+        NS_TEST_EXPECT_MSG_EQ((data == expected), true, "Wrong content of packet");
+    }
+}
+
+void
+Ipv6ReassemblyTest::DoRun()
+{
+    m_node = CreateObject<Node>();
+    SimpleNetDeviceHelper helperChannel;
+    m_device = helperChannel.Install(m_node).Get(0);
+    InternetStackHelper internet;
+    internet.SetIpv4StackInstall(false);
+    internet.Install(m_node);
+    m_node->GetObject<Icmpv6L4Protocol>()->SetAttribute("DAD", BooleanValue(false));
+
+    Ptr<Ipv6> ipv6 = m_node->GetObject<Ipv6>();
+    uint32_t netdev_idx = ipv6->AddInterface(m_device);
+    ipv6->AddAddress(netdev_idx, Ipv6InterfaceAddress(Ipv6Address("2001::1"), Ipv6Prefix(32)));
+    ipv6->SetUp(netdev_idx);
+
+    m_socket = Socket::CreateSocket(m_node, UdpSocketFactory::GetTypeId());
+    m_socket->Bind(Inet6SocketAddress(Ipv6Address::GetAny(), 9));
+    m_socket->SetRecvCallback(MakeCallback(&Ipv6ReassemblyTest::HandleRead, this));
+
+    // a 1008 bytes UDP datagram, cut in six fragments of 168 bytes
+    std::vector<uint8_t> payload(1000);
+    for (std::size_t i = 0; i < payload.size(); i++)
+    {
+        payload[i] = i % 251;
+    }
+    m_datagram = Create<Packet>(payload.data(), payload.size());
+    UdpHeader udpHeader;
+    udpHeader.SetSourcePort(1234);
+    udpHeader.SetDestinationPort(9);
+    m_datagram->AddHeader(udpHeader);
+    std::vector<Fragment> f;
+    for (uint16_t offset = 0; offset < m_datagram->GetSize(); offset += 168)
+    {
+        f.emplace_back(offset, 168);
+    }
+
+    // in order
+    Simulator::Schedule(Seconds(1), &Ipv6ReassemblyTest::ReceiveFragments, this, f);
+    Simulator::Schedule(Seconds(1.5), &Ipv6ReassemblyTest::CheckReceived, this, 1);
+    // in reverse order, the last fragment first
+    Simulator::Schedule(Seconds(2),
+                        &Ipv6ReassemblyTest::ReceiveFragments,
+                        this,
+                        std::vector<Fragment>{f[5], f[4], f[3], f[2], f[1], f[0]});
+    Simulator::Schedule(Seconds(2.5), &Ipv6ReassemblyTest::CheckReceived, this, 2);
+    // out of order
+    Simulator::Schedule(Seconds(3),
+                        &Ipv6ReassemblyTest::ReceiveFragments,
+                        this,
+                        std::vector<Fragment>{f[3], f[0], f[5], f[1], f[4], f[2]});
+    Simulator::Schedule(Seconds(3.5), &Ipv6ReassemblyTest::CheckReceived, this, 3);
+    // a duplicate fragment, which IPv6 handles as overlapping (RFC 5722)
+    Simulator::Schedule(Seconds(4),
+                        &Ipv6ReassemblyTest::ReceiveFragments,
+                        this,
+                        std::vector<Fragment>{f[0], f[1], f[1], f[2], f[3], f[4], f[5]});
+    Simulator::Schedule(Seconds(4.5), &Ipv6ReassemblyTest::CheckReceived, this, 3);
+    // overlapping fragments, which IPv6 drops (RFC 5722)
+    Simulator::Schedule(Seconds(5),
+                        &Ipv6ReassemblyTest::ReceiveFragments,
+                        this,
+                        std::vector<Fragment>{{0, 336}, {504, 504}, {168, 504}});
+    Simulator::Schedule(Seconds(5.5), &Ipv6ReassemblyTest::CheckReceived, this, 3);
+    // a missing fragment
+    Simulator::Schedule(Seconds(6),
+                        &Ipv6ReassemblyTest::ReceiveFragments,
+                        this,
+                        std::vector<Fragment>{f[0], f[1], f[3], f[4], f[5]});
+    Simulator::Schedule(Seconds(6.5), &Ipv6ReassemblyTest::CheckReceived, this, 3);
+
+    Simulator::Run();
+    CheckReceived(3);
+
+    m_socket->Close();
+    m_socket = nullptr;
+    m_device = nullptr;
+    m_node = nullptr;
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -629,6 +821,7 @@ class Ipv6FragmentationTestSuite : public TestSuite
         : TestSuite("ipv6-fragmentation", UNIT)
     {
         AddTestCase(new Ipv6FragmentationTest, TestCase::QUICK);
+        AddTestCase(new Ipv6ReassemblyTest, TestCase::QUICK);
     }
 };
 
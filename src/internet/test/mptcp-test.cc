@@ -0,0 +1,438 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/data-rate.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/log.h"
+#include "ns3/mptcp-congestion-ops.h"
+#include "ns3/mptcp-socket-base.h"
+#include "ns3/mptcp-socket-factory.h"
+#include "ns3/node.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/tcp-header.h"
+#include "ns3/tcp-option-mptcp.h"
+#include "ns3/tcp-socket-factory.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("MpTcpTestSuite");
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check that the MPTCP options survive a round trip through a TCP header
+ */
+class MpTcpOptionTestCase : public TestCase
+{
+  public:
+    MpTcpOptionTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Serialize a header carrying an option and deserialize it
+     * \param option the option to carry
+     * \return the option found in the deserialized header, or nullptr
+     */
+    Ptr<const TcpOption> RoundTrip(Ptr<const TcpOption> option);
+};
+
+MpTcpOptionTestCase::MpTcpOptionTestCase()
+    : TestCase("Serialization of the MPTCP options")
+{
+}
+
+Ptr<const TcpOption>
+MpTcpOptionTestCase::RoundTrip(Ptr<const TcpOption> option)
+{
+    TcpHeader header;
+    header.SetFlags(TcpHeader::ACK);
+    NS_TEST_EXPECT_MSG_EQ(header.AppendOption(option), true, "Option does not fit the header");
+
+    Buffer buffer;
+    buffer.AddAtStart(header.GetSerializedSize());
+    header.Serialize(buffer.Begin());
+
+    TcpHeader copy;
+    NS_TEST_EXPECT_MSG_EQ(copy.Deserialize(buffer.Begin()),
+                          header.GetSerializedSize(),
+                          "Wrong deserialized size");
+    // the options whose size is not a multiple of 4 bytes are followed by padding
+    Ptr<const TcpOption> received;
+    for (const auto& op : copy.GetOptionList())
+    {
+        if (op->GetKind() == TcpOption::END || op->GetKind() == TcpOption::NOP)
+        {
+            continue;
+        }
+        if (received)
+        {
+            return nullptr;
+        }
+        received = op;
+    }
+    if (!received)
+    {
+        return nullptr;
+    }
+    NS_TEST_EXPECT_MSG_EQ(received->GetSerializedSize(),
+                          option->GetSerializedSize(),
+                          "Wrong option size");
+    return received;
+}
+
+void
+MpTcpOptionTestCase::DoRun()
+{
+    Ptr<TcpOptionMpTcpCapable> capable = CreateObject<TcpOptionMpTcpCapable>();
+    capable->SetSenderKey(0x0123456789abcdefULL);
+    capable->SetPeerKey(0xfedcba9876543210ULL);
+    Ptr<const TcpOptionMpTcpCapable> capableRx =
+        DynamicCast<const TcpOptionMpTcpCapable>(RoundTrip(capable));
+    NS_TEST_ASSERT_MSG_NE(capableRx, nullptr, "MP_CAPABLE not recognized");
+    NS_TEST_EXPECT_MSG_EQ(capableRx->GetSenderKey(), 0x0123456789abcdefULL, "Wrong sender key");
+    NS_TEST_EXPECT_MSG_EQ(capableRx->HasPeerKey(), true, "Peer key lost");
+    NS_TEST_EXPECT_MSG_EQ(capableRx->GetPeerKey(), 0xfedcba9876543210ULL, "Wrong peer key");
+
+    for (auto mode :
+         {TcpOptionMpTcpJoin::SYN, TcpOptionMpTcpJoin::SYN_ACK, TcpOptionMpTcpJoin::ACK})
+    {
+        Ptr<TcpOptionMpTcpJoin> join = CreateObject<TcpOptionMpTcpJoin>();
+        join->SetMode(mode);
+        join->SetAddressId(3);
+        join->SetToken(0xdeadbeef);
+        join->SetNonce(0x12345678);
+        join->SetTruncatedHmac(0x1122334455667788ULL);
+        Ptr<const TcpOptionMpTcpJoin> joinRx =
+            DynamicCast<const TcpOptionMpTcpJoin>(RoundTrip(join));
+        NS_TEST_ASSERT_MSG_NE(joinRx, nullptr, "MP_JOIN not recognized");
+        NS_TEST_EXPECT_MSG_EQ(joinRx->GetMode(), mode, "Wrong MP_JOIN form");
+        if (mode == TcpOptionMpTcpJoin::SYN)
+        {
+            NS_TEST_EXPECT_MSG_EQ(joinRx->GetToken(), 0xdeadbeef, "Wrong token");
+        }
+        if (mode != TcpOptionMpTcpJoin::ACK)
+        {
+            NS_TEST_EXPECT_MSG_EQ(joinRx->GetAddressId(), 3, "Wrong address id");
+            NS_TEST_EXPECT_MSG_EQ(joinRx->GetNonce(), 0x12345678, "Wrong nonce");
+        }
+        if (mode != TcpOptionMpTcpJoin::SYN)
+        {
+            NS_TEST_EXPECT_MSG_EQ(joinRx->GetTruncatedHmac(), 0x1122334455667788ULL, "Wrong HMAC");
+        }
+    }
+
+    Ptr<TcpOptionMpTcpDss> dss = CreateObject<TcpOptionMpTcpDss>();
+    dss->SetDataAck(0x100000000ULL + 7);
+    dss->SetMapping(0x200000000ULL + 11, 1461, 2920);
+    dss->SetDataFin(true);
+    Ptr<const TcpOptionMpTcpDss> dssRx = DynamicCast<const TcpOptionMpTcpDss>(RoundTrip(dss));
+    NS_TEST_ASSERT_MSG_NE(dssRx, nullptr, "DSS not recognized");
+    NS_TEST_EXPECT_MSG_EQ(dssRx->HasDataAck(), true, "Data ACK lost");
+    NS_TEST_EXPECT_MSG_EQ(dssRx->GetDataAck(), 0x100000000ULL + 7, "Wrong data ACK");
+    NS_TEST_EXPECT_MSG_EQ(dssRx->HasMapping(), true, "Mapping lost");
+    NS_TEST_EXPECT_MSG_EQ(dssRx->GetDataSequenceNumber(), 0x200000000ULL + 11, "Wrong DSN");
+    NS_TEST_EXPECT_MSG_EQ(dssRx->GetSubflowSequenceNumber(), 1461, "Wrong subflow seq");
+    NS_TEST_EXPECT_MSG_EQ(dssRx->GetDataLevelLength(), 2920, "Wrong length");
+    NS_TEST_EXPECT_MSG_EQ(dssRx->IsDataFin(), true, "DATA_FIN lost");
+
+    Ptr<TcpOptionMpTcpDss> ackOnly = CreateObject<TcpOptionMpTcpDss>();
+    ackOnly->SetDataAck(42);
+    dssRx = DynamicCast<const TcpOptionMpTcpDss>(RoundTrip(ackOnly));
+    NS_TEST_ASSERT_MSG_NE(dssRx, nullptr, "DSS not recognized");
+    NS_TEST_EXPECT_MSG_EQ(dssRx->HasMapping(), false, "Spurious mapping");
+    NS_TEST_EXPECT_MSG_EQ(dssRx->GetDataAck(), 42, "Wrong data ACK");
+
+    Ptr<TcpOptionMpTcpAddAddress> addAddr = CreateObject<TcpOptionMpTcpAddAddress>();
+    addAddr->SetAddress(Ipv4Address("10.1.2.1"), 5);
+    Ptr<const TcpOptionMpTcpAddAddress> addAddrRx =
+        DynamicCast<const TcpOptionMpTcpAddAddress>(RoundTrip(addAddr));
+    NS_TEST_ASSERT_MSG_NE(addAddrRx, nullptr, "ADD_ADDR not recognized");
+    NS_TEST_EXPECT_MSG_EQ(addAddrRx->GetAddressId(), 5, "Wrong address id");
+    NS_TEST_EXPECT_MSG_EQ(Ipv4Address::ConvertFrom(addAddrRx->GetAddress()),
+                          Ipv4Address("10.1.2.1"),
+                          "Wrong address");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Transfer data over an MPTCP connection between two hosts
+ *
+ * The hosts are connected by two links, each one with its own IPv4 network.
+ * The client writes a stream of bytes and closes the connection; the test
+ * checks that the server receives the stream intact and, when both ends use
+ * MPTCP, that a second subflow is opened and carries data.
+ */
+class MpTcpTransferTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param congestion the congestion control of the subflows
+     * \param serverMpTcp false if the server uses regular TCP (fallback)
+     */
+    MpTcpTransferTestCase(TypeId congestion, bool serverMpTcp);
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * \brief Create a link between the hosts
+     * \param client the client node
+     * \param server the server node
+     * \param network the IPv4 network of the link, as "a.b.c."
+     */
+    void AddLink(Ptr<Node> client, Ptr<Node> server, std::string network);
+
+    /**
+     * \brief Write data to the client socket
+     * \param socket the client socket
+     * \param available the free space of the send buffer
+     */
+    void ClientSend(Ptr<Socket> socket, uint32_t available);
+
+    /**
+     * \brief The client connected
+     * \param socket the client socket
+     */
+    void ClientConnected(Ptr<Socket> socket);
+
+    /**
+     * \brief The server accepted a connection
+     * \param socket the new socket
+     * \param from the address of the client
+     */
+    void ServerAccept(Ptr<Socket> socket, const Address& from);
+
+    /**
+     * \brief Read the data received by the server
+     * \param socket the server socket
+     */
+    void ServerRecv(Ptr<Socket> socket);
+
+    /**
+     * \brief Count the bytes received by the server on each interface
+     * \param packet the packet
+     * \param ipv4 the IPv4 protocol
+     * \param interface the receiving interface
+     */
+    void ServerIpRx(Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface);
+
+    TypeId m_congestion;                //!< Congestion control of the subflows
+    bool m_serverMpTcp;                 //!< The server uses MPTCP
+    uint32_t m_totalBytes{300000};      //!< Size of the stream
+    uint32_t m_sent{0};                 //!< Bytes written by the client
+    uint32_t m_received{0};             //!< Bytes read by the server
+    bool m_corrupted{false};            //!< The server read unexpected data
+    Ptr<Socket> m_client;               //!< The client socket
+    Ptr<Socket> m_accepted;             //!< The socket accepted by the server
+    std::vector<uint32_t> m_ifRxBytes;  //!< Bytes received by the server per interface
+};
+
+MpTcpTransferTestCase::MpTcpTransferTestCase(TypeId congestion, bool serverMpTcp)
+    : TestCase("MPTCP transfer with " + congestion.GetName() +
+               (serverMpTcp ? "" : ", fallback to TCP")),
+      m_congestion(congestion),
+      m_serverMpTcp(serverMpTcp)
+{
+}
+
+void
+MpTcpTransferTestCase::AddLink(Ptr<Node> client, Ptr<Node> server, std::string network)
+{
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    channel->SetAttribute("Delay", TimeValue(MilliSeconds(5)));
+    Ptr<Node> nodes[] = {client, server};
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice>();
+        dev->SetAddress(Mac48Address::Allocate());
+        dev->SetAttribute("DataRate", DataRateValue(DataRate("5Mbps")));
+        dev->SetChannel(channel);
+        nodes[i]->AddDevice(dev);
+        Ptr<Ipv4> ipv4 = nodes[i]->GetObject<Ipv4>();
+        uint32_t ifIndex = ipv4->AddInterface(dev);
+        std::string address = network + std::to_string(i + 1);
+        ipv4->AddAddress(ifIndex,
+                         Ipv4InterfaceAddress(Ipv4Address(address.c_str()),
+                                              Ipv4Mask("255.255.255.0")));
+        ipv4->SetUp(ifIndex);
+    }
+}
+
+void
+MpTcpTransferTestCase::ClientSend(Ptr<Socket> socket, uint32_t available)
+{
+    while (m_sent < m_totalBytes && socket->GetTxAvailable() > 0)
+    {
+        uint32_t size = std::min({socket->GetTxAvailable(), m_totalBytes - m_sent, 1000U});
+        std::vector<uint8_t> data(size);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            data[i] = static_cast<uint8_t>((m_sent + i) % 251);
+        }
+        int ret = socket->Send(Create<Packet>(data.data(), size));
+        NS_TEST_ASSERT_MSG_EQ(ret, static_cast<int>(size), "Send failed");
+        m_sent += size;
+    }
+    if (m_sent == m_totalBytes)
+    {
+        socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
+        socket->Close();
+    }
+}
+
+void
+MpTcpTransferTestCase::ClientConnected(Ptr<Socket> socket)
+{
+    ClientSend(socket, socket->GetTxAvailable());
+}
+
+void
+MpTcpTransferTestCase::ServerAccept(Ptr<Socket> socket, const Address& from)
+{
+    m_accepted = socket;
+    socket->SetRecvCallback(MakeCallback(&MpTcpTransferTestCase::ServerRecv, this));
+}
+
+void
+MpTcpTransferTestCase::ServerRecv(Ptr<Socket> socket)
+{
+    Ptr<Packet> p;
+    while ((p = socket->Recv()) && p->GetSize() > 0)
+    {
+        std::vector<uint8_t> data(p->GetSize());
+        p->CopyData(data.data(), data.size());
+        for (uint32_t i = 0; i < data.size(); ++i)
+        {
+            m_corrupted |= (data[i] != static_cast<uint8_t>((m_received + i) % 251));
+        }
+        m_received += p->GetSize();
+    }
+}
+
+void
+MpTcpTransferTestCase::ServerIpRx(Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+    if (interface >= m_ifRxBytes.size())
+    {
+        m_ifRxBytes.resize(interface + 1, 0);
+    }
+    m_ifRxBytes[interface] += packet->GetSize();
+}
+
+void
+MpTcpTransferTestCase::DoRun()
+{
+    Ptr<Node> client = CreateObject<Node>();
+    Ptr<Node> server = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(client);
+    internet.Install(server);
+    AddLink(client, server, "10.1.1.");
+    AddLink(client, server, "10.1.2.");
+
+    server->GetObject<Ipv4L3Protocol>()->TraceConnectWithoutContext(
+        "Rx",
+        MakeCallback(&MpTcpTransferTestCase::ServerIpRx, this));
+
+    uint16_t port = 50000;
+    TypeId serverFactory =
+        m_serverMpTcp ? MpTcpSocketFactory::GetTypeId() : TcpSocketFactory::GetTypeId();
+    Ptr<Socket> listener = Socket::CreateSocket(server, serverFactory);
+    if (m_serverMpTcp)
+    {
+        listener->SetAttribute("CongestionOps", TypeIdValue(m_congestion));
+    }
+    listener->Bind(InetSocketAddress(Ipv4Address::GetAny(), port));
+    listener->Listen();
+    listener->SetAcceptCallback(MakeNullCallback<bool, Ptr<Socket>, const Address&>(),
+                                MakeCallback(&MpTcpTransferTestCase::ServerAccept, this));
+
+    m_client = Socket::CreateSocket(client, MpTcpSocketFactory::GetTypeId());
+    m_client->SetAttribute("CongestionOps", TypeIdValue(m_congestion));
+    m_client->SetConnectCallback(MakeCallback(&MpTcpTransferTestCase::ClientConnected, this),
+                                 MakeNullCallback<void, Ptr<Socket>>());
+    m_client->SetSendCallback(MakeCallback(&MpTcpTransferTestCase::ClientSend, this));
+    m_client->Connect(InetSocketAddress(Ipv4Address("10.1.1.2"), port));
+
+    Simulator::Stop(Seconds(30));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_sent, m_totalBytes, "Client did not write all the data");
+    NS_TEST_EXPECT_MSG_EQ(m_received, m_totalBytes, "Server did not receive all the data");
+    NS_TEST_EXPECT_MSG_EQ(m_corrupted, false, "Server received corrupted data");
+
+    Ptr<MpTcpSocketBase> meta = DynamicCast<MpTcpSocketBase>(m_client);
+    NS_TEST_EXPECT_MSG_EQ(meta->IsFallback(), !m_serverMpTcp, "Wrong fallback status");
+    m_ifRxBytes.resize(3, 0);
+    if (m_serverMpTcp)
+    {
+        NS_TEST_EXPECT_MSG_EQ(meta->GetNSubflows(), 2, "The second subflow was not opened");
+        NS_TEST_EXPECT_MSG_GT(m_ifRxBytes[1], m_totalBytes / 10, "First path barely used");
+        NS_TEST_EXPECT_MSG_GT(m_ifRxBytes[2], m_totalBytes / 10, "Second path barely used");
+    }
+    else
+    {
+        NS_TEST_EXPECT_MSG_EQ(meta->GetNSubflows(), 1, "Subflow opened without MPTCP");
+        NS_TEST_EXPECT_MSG_EQ(m_ifRxBytes[2], 0, "Second path used without MPTCP");
+    }
+}
+
+void
+MpTcpTransferTestCase::DoTeardown()
+{
+    m_client = nullptr;
+    m_accepted = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Multipath TCP TestSuite
+ */
+class MpTcpTestSuite : public TestSuite
+{
+  public:
+    MpTcpTestSuite()
+        : TestSuite("mptcp", UNIT)
+    {
+        AddTestCase(new MpTcpOptionTestCase(), TestCase::QUICK);
+        for (TypeId congestion : {MpTcpLia::GetTypeId(),
+                                  MpTcpOlia::GetTypeId(),
+                                  MpTcpBalia::GetTypeId(),
+                                  TcpNewReno::GetTypeId()})
+        {
+            AddTestCase(new MpTcpTransferTestCase(congestion, true), TestCase::QUICK);
+        }
+        AddTestCase(new MpTcpTransferTestCase(MpTcpLia::GetTypeId(), false), TestCase::QUICK);
+    }
+};
+
+static MpTcpTestSuite g_mpTcpTestSuite; //!< Static variable for test initialization
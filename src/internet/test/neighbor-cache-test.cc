@@ -17,6 +17,7 @@
  * Author: Zhiheng Dong <dzh2077@gmail.com>
  */
 
+#include "ns3/arp-cache.h"
 #include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/icmpv6-l4-protocol.h"
 #include "ns3/internet-stack-helper.h"
@@ -26,6 +27,8 @@
 #include "ns3/ipv6-address-helper.h"
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/ipv6-routing-helper.h"
+#include "ns3/mac48-address.h"
+#include "ns3/ndisc-cache.h"
 #include "ns3/neighbor-cache-helper.h"
 #include "ns3/simple-channel.h"
 #include "ns3/simple-net-device-helper.h"
@@ -37,6 +40,8 @@
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/udp-socket-factory.h"
 
+#include <algorithm>
+
 using namespace ns3;
 
 /**
@@ -1228,6 +1233,297 @@ DynamicPartialTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check that the reverse MAC index of the ARP and NDISC caches
+ * follows the changes of the entries
+ */
+class MacIndexTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    MacIndexTest();
+
+  private:
+    /**
+     * \brief Get the IPv4 addresses of the ARP entries resolved to a MAC address.
+     * \param arpCache The ARP cache.
+     * \param mac The MAC address.
+     * \return The sorted IPv4 addresses.
+     */
+    std::vector<Ipv4Address> LookupInverse(Ptr<ArpCache> arpCache, Address mac);
+
+    /**
+     * \brief Get the IPv6 addresses of the NDISC entries resolved to a MAC address.
+     * \param ndiscCache The NDISC cache.
+     * \param mac The MAC address.
+     * \return The sorted IPv6 addresses.
+     */
+    std::vector<Ipv6Address> LookupInverse(Ptr<NdiscCache> ndiscCache, Address mac);
+};
+
+MacIndexTest::MacIndexTest()
+    : TestCase("The MacIndexTest checks that LookupInverse() returns the entries "
+               "resolved to a MAC address after their MAC addresses change.")
+{
+}
+
+std::vector<Ipv4Address>
+MacIndexTest::LookupInverse(Ptr<ArpCache> arpCache, Address mac)
+{
+    std::vector<Ipv4Address> addresses;
+    for (auto entry : arpCache->LookupInverse(mac))
+    {
+        addresses.push_back(entry->GetIpv4Address());
+    }
+    std::sort(addresses.begin(), addresses.end());
+    return addresses;
+}
+
+std::vector<Ipv6Address>
+MacIndexTest::LookupInverse(Ptr<NdiscCache> ndiscCache, Address mac)
+{
+    std::vector<Ipv6Address> addresses;
+    for (auto entry : ndiscCache->LookupInverse(mac))
+    {
+        addresses.push_back(entry->GetIpv6Address());
+    }
+    std::sort(addresses.begin(), addresses.end());
+    return addresses;
+}
+
+void
+MacIndexTest::DoRun()
+{
+    Address mac1 = Mac48Address("00:00:00:00:00:01");
+    Address mac2 = Mac48Address("00:00:00:00:00:02");
+
+    Ipv4Address a4("10.1.1.1");
+    Ipv4Address b4("10.1.1.2");
+    Ipv4Address c4("10.1.1.3");
+    Ptr<ArpCache> arpCache = CreateObject<ArpCache>();
+    ArpCache::Entry* a4Entry = arpCache->Add(a4);
+    ArpCache::Entry* b4Entry = arpCache->Add(b4);
+    ArpCache::Entry* c4Entry = arpCache->Add(c4);
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(Address()).empty(),
+                          true,
+                          "Unresolved ARP entries must not be indexed");
+
+    a4Entry->SetMacAddress(mac1);
+    a4Entry->MarkPermanent();
+    b4Entry->SetMacAddress(mac1);
+    b4Entry->MarkAutoGenerated();
+    c4Entry->SetMacAddress(mac2);
+    NS_TEST_EXPECT_MSG_EQ((LookupInverse(arpCache, mac1) == std::vector<Ipv4Address>{a4, b4}),
+                          true,
+                          "Wrong ARP entries for the first MAC address");
+    NS_TEST_EXPECT_MSG_EQ((LookupInverse(arpCache, mac2) == std::vector<Ipv4Address>{c4}),
+                          true,
+                          "Wrong ARP entries for the second MAC address");
+
+    b4Entry->SetMacAddress(mac2);
+    NS_TEST_EXPECT_MSG_EQ((LookupInverse(arpCache, mac1) == std::vector<Ipv4Address>{a4}),
+                          true,
+                          "ARP entry not removed from the index after a MAC address change");
+    NS_TEST_EXPECT_MSG_EQ((LookupInverse(arpCache, mac2) == std::vector<Ipv4Address>{b4, c4}),
+                          true,
+                          "ARP entry not added to the index after a MAC address change");
+
+    arpCache->Remove(c4Entry);
+    NS_TEST_EXPECT_MSG_EQ((LookupInverse(arpCache, mac2) == std::vector<Ipv4Address>{b4}),
+                          true,
+                          "Removed ARP entry still in the index");
+    c4Entry = arpCache->Add(c4);
+    NS_TEST_EXPECT_MSG_EQ((LookupInverse(arpCache, mac2) == std::vector<Ipv4Address>{b4}),
+                          true,
+                          "Added ARP entry indexed before being resolved");
+
+    arpCache->Flush();
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(mac1).empty(),
+                          true,
+                          "ARP entries still indexed after a flush");
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(mac2).empty(),
+                          true,
+                          "ARP entries still indexed after a flush");
+    arpCache->Dispose();
+
+    Ipv6Address a6("2001::1");
+    Ipv6Address b6("2001::2");
+    Ipv6Address c6("2001::3");
+    Ptr<NdiscCache> ndiscCache = CreateObject<NdiscCache>();
+    NdiscCache::Entry* a6Entry = ndiscCache->Add(a6);
+    NdiscCache::Entry* b6Entry = ndiscCache->Add(b6);
+    NdiscCache::Entry* c6Entry = ndiscCache->Add(c6);
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(Address()).empty(),
+                          true,
+                          "Unresolved NDISC entries must not be indexed");
+
+    a6Entry->MarkReachable(mac1);
+    b6Entry->MarkStale(mac1);
+    c6Entry->SetMacAddress(mac2);
+    c6Entry->MarkPermanent();
+    NS_TEST_EXPECT_MSG_EQ((LookupInverse(ndiscCache, mac1) == std::vector<Ipv6Address>{a6, b6}),
+                          true,
+                          "Wrong NDISC entries for the first MAC address");
+    NS_TEST_EXPECT_MSG_EQ((LookupInverse(ndiscCache, mac2) == std::vector<Ipv6Address>{c6}),
+                          true,
+                          "Wrong NDISC entries for the second MAC address");
+
+    b6Entry->MarkStale(mac2);
+    NS_TEST_EXPECT_MSG_EQ((LookupInverse(ndiscCache, mac1) == std::vector<Ipv6Address>{a6}),
+                          true,
+                          "NDISC entry not removed from the index after a MAC address change");
+    NS_TEST_EXPECT_MSG_EQ((LookupInverse(ndiscCache, mac2) == std::vector<Ipv6Address>{b6, c6}),
+                          true,
+                          "NDISC entry not added to the index after a MAC address change");
+
+    ndiscCache->Remove(c6Entry);
+    NS_TEST_EXPECT_MSG_EQ((LookupInverse(ndiscCache, mac2) == std::vector<Ipv6Address>{b6}),
+                          true,
+                          "Removed NDISC entry still in the index");
+    c6Entry = ndiscCache->Add(c6);
+    NS_TEST_EXPECT_MSG_EQ((LookupInverse(ndiscCache, mac2) == std::vector<Ipv6Address>{b6}),
+                          true,
+                          "Added NDISC entry indexed before being resolved");
+
+    ndiscCache->Flush();
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(mac1).empty(),
+                          true,
+                          "NDISC entries still indexed after a flush");
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(mac2).empty(),
+                          true,
+                          "NDISC entries still indexed after a flush");
+    ndiscCache->Dispose();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check that the NUD timers of the NDISC entries, which are run by
+ * the cache from a single event, expire at the right times
+ */
+class NudTimersTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    NudTimersTest();
+
+  private:
+    /**
+     * \brief Mark entries as reachable and start their reachable timers.
+     * \param first The index of the first entry.
+     * \param last The index following the last entry.
+     */
+    void StartReachable(std::size_t first, std::size_t last);
+
+    /// Restart, stop and cancel the timers of some entries.
+    void ChangeTimers();
+
+    /**
+     * \brief Check the states of the entries.
+     * \param expected The expected state of each entry, entry 2 being removed at 5 s.
+     */
+    void CheckStates(std::vector<NdiscCache::Entry::NdiscCacheEntryState_e> expected);
+
+    Ptr<NdiscCache> m_ndiscCache;       //!< The NDISC cache.
+    std::vector<Ipv6Address> m_entries; //!< The IPv6 addresses of the entries.
+};
+
+NudTimersTest::NudTimersTest()
+    : TestCase("The NudTimersTest checks that the reachable timers of the NDISC entries "
+               "expire at the right times, after being started, restarted and stopped.")
+{
+}
+
+void
+NudTimersTest::StartReachable(std::size_t first, std::size_t last)
+{
+    for (std::size_t i = first; i < last; i++)
+    {
+        NdiscCache::Entry* entry = m_ndiscCache->Lookup(m_entries[i]);
+        entry->MarkReachable(Mac48Address::Allocate());
+        entry->StartReachableTimer();
+    }
+}
+
+void
+NudTimersTest::ChangeTimers()
+{
+    m_ndiscCache->Lookup(m_entries[0])->UpdateReachableTimer();
+    m_ndiscCache->Lookup(m_entries[1])->StopNudTimer();
+    m_ndiscCache->Remove(m_ndiscCache->Lookup(m_entries[2]));
+    m_ndiscCache->Lookup(m_entries[3])->MarkPermanent();
+}
+
+void
+NudTimersTest::CheckStates(std::vector<NdiscCache::Entry::NdiscCacheEntryState_e> expected)
+{
+    for (std::size_t i = 0; i < m_entries.size(); i++)
+    {
+        NdiscCache::Entry* entry = m_ndiscCache->Lookup(m_entries[i]);
+        if (i == 2)
+        {
+            NS_TEST_EXPECT_MSG_EQ(entry, nullptr, "Entry " << i << " not removed");
+            continue;
+        }
+        NS_TEST_ASSERT_MSG_NE(entry, nullptr, "Entry " << i << " not found");
+        NS_TEST_EXPECT_MSG_EQ(entry->GetEntryState(),
+                              expected[i],
+                              "Wrong state of entry " << i << " at "
+                                                      << Simulator::Now().As(Time::S));
+    }
+}
+
+void
+NudTimersTest::DoRun()
+{
+    Ptr<Icmpv6L4Protocol> icmpv6 = CreateObject<Icmpv6L4Protocol>();
+    icmpv6->SetAttribute("ReachableTime", TimeValue(Seconds(10)));
+    m_ndiscCache = CreateObject<NdiscCache>();
+    m_ndiscCache->SetDevice(nullptr, nullptr, icmpv6);
+
+    const std::size_t nEntries = 20;
+    for (std::size_t i = 0; i < nEntries; i++)
+    {
+        m_entries.emplace_back(Ipv6Address::MakeAutoconfiguredAddress(Mac48Address::Allocate(),
+                                                                      Ipv6Address("2001::")));
+        m_ndiscCache->Add(m_entries.back());
+    }
+
+    // Entries 0-9 expire at 10 s, entries 10-19 at 12 s. At 5 s, the timer of
+    // entry 0 is restarted (expiring at 15 s), the timer of entry 1 is stopped,
+    // entry 2 is removed and entry 3 becomes permanent.
+    StartReachable(0, 10);
+    Simulator::Schedule(Seconds(2), &NudTimersTest::StartReachable, this, 10, nEntries);
+    Simulator::Schedule(Seconds(5), &NudTimersTest::ChangeTimers, this);
+
+    using State = NdiscCache::Entry::NdiscCacheEntryState_e;
+    std::vector<State> expected(nEntries, NdiscCache::Entry::REACHABLE);
+    expected[3] = NdiscCache::Entry::PERMANENT;
+    Simulator::Schedule(Seconds(9.5), &NudTimersTest::CheckStates, this, expected);
+    std::fill(expected.begin() + 4, expected.begin() + 10, NdiscCache::Entry::STALE);
+    Simulator::Schedule(Seconds(10.5), &NudTimersTest::CheckStates, this, expected);
+    std::fill(expected.begin() + 10, expected.end(), NdiscCache::Entry::STALE);
+    Simulator::Schedule(Seconds(12.5), &NudTimersTest::CheckStates, this, expected);
+    expected[0] = NdiscCache::Entry::STALE;
+    Simulator::Schedule(Seconds(15.5), &NudTimersTest::CheckStates, this, expected);
+    const uint64_t nTestEvents = 6;
+
+    Simulator::Run();
+
+    // The entries expiring at the same time share the same event
+    NS_TEST_EXPECT_MSG_LT(Simulator::GetEventCount() - nTestEvents,
+                          nEntries / 2,
+                          "The NUD timers are not run from a single event");
+
+    m_ndiscCache->Dispose();
+    m_ndiscCache = nullptr;
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -1247,6 +1543,8 @@ class NeighborCacheTestSuite : public TestSuite
         AddTestCase(new FlushTest, TestCase::QUICK);
         AddTestCase(new DuplicateTest, TestCase::QUICK);
         AddTestCase(new DynamicPartialTest, TestCase::QUICK);
+        AddTestCase(new MacIndexTest, TestCase::QUICK);
+        AddTestCase(new NudTimersTest, TestCase::QUICK);
     }
 };
 
@@ -33,11 +33,14 @@
 #include "ns3/ipv6-static-routing.h"
 #include "ns3/log.h"
 #include "ns3/node.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/simple-channel.h"
 #include "ns3/simple-net-device.h"
 #include "ns3/simulator.h"
 #include "ns3/socket-factory.h"
+#include "ns3/tcp-header.h"
 #include "ns3/tcp-l4-protocol.h"
+#include "ns3/tcp-socket-base.h"
 #include "ns3/tcp-socket-factory.h"
 #include "ns3/test.h"
 #include "ns3/traffic-control-layer.h"
@@ -67,13 +70,15 @@ class TcpTestCase : public TestCase
      * \param serverWriteSize Server data size when sending.
      * \param serverReadSize Server data size when receiving.
      * \param useIpv6 Use IPv6 instead of IPv4.
+     * \param tsoMaxSegments Max number of segments in a TSO super-segment.
      */
     TcpTestCase(uint32_t totalStreamSize,
                 uint32_t sourceWriteSize,
                 uint32_t sourceReadSize,
                 uint32_t serverWriteSize,
                 uint32_t serverReadSize,
-                bool useIpv6);
+                bool useIpv6,
+                uint32_t tsoMaxSegments = 1);
 
   private:
     void DoRun() override;
@@ -146,6 +151,30 @@ class TcpTestCase : public TestCase
      * \param sock The socket.
      */
     void SourceHandleRecv(Ptr<Socket> sock);
+    /**
+     * \brief Check a packet sent by a socket, which may be a super-segment.
+     * \param packet The packet.
+     * \param header The TCP header.
+     * \param socket The sending socket.
+     */
+    void SocketTx(Ptr<const Packet> packet,
+                  const TcpHeader& header,
+                  Ptr<const TcpSocketBase> socket);
+    /**
+     * \brief Check that a packet received by a device is a regular segment.
+     * \param device The receiving device.
+     * \param packet The packet.
+     * \param protocol The protocol number.
+     * \param from The sender address.
+     * \param to The destination address.
+     * \param packetType The packet type.
+     */
+    void DeviceRx(Ptr<NetDevice> device,
+                  Ptr<const Packet> packet,
+                  uint16_t protocol,
+                  const Address& from,
+                  const Address& to,
+                  NetDevice::PacketType packetType);
 
     uint32_t m_totalBytes;           //!< Total stream size (in bytes).
     uint32_t m_sourceWriteSize;      //!< Client data size when sending.
@@ -160,7 +189,10 @@ class TcpTestCase : public TestCase
     uint8_t* m_sourceRxPayload;      //!< Client Rx payload.
     uint8_t* m_serverRxPayload;      //!< Server Rx payload.
 
-    bool m_useIpv6; //!< Use IPv6 instead of IPv4.
+    bool m_useIpv6;            //!< Use IPv6 instead of IPv4.
+    uint32_t m_tsoMaxSegments; //!< Max number of segments in a TSO super-segment.
+    uint32_t m_segmentSize;    //!< TCP segment size (MSS) of the sockets.
+    uint32_t m_superSegments;  //!< Super-segments sent by the sockets.
 };
 
 static std::string
@@ -170,12 +202,17 @@ Name(std::string str,
      uint32_t serverReadSize,
      uint32_t serverWriteSize,
      uint32_t sourceReadSize,
-     bool useIpv6)
+     bool useIpv6,
+     uint32_t tsoMaxSegments)
 {
     std::ostringstream oss;
     oss << str << " total=" << totalStreamSize << " sourceWrite=" << sourceWriteSize
         << " sourceRead=" << sourceReadSize << " serverRead=" << serverReadSize
         << " serverWrite=" << serverWriteSize << " useIpv6=" << useIpv6;
+    if (tsoMaxSegments > 1)
+    {
+        oss << " tsoMaxSegments=" << tsoMaxSegments;
+    }
     return oss.str();
 }
 
@@ -192,20 +229,23 @@ TcpTestCase::TcpTestCase(uint32_t totalStreamSize,
                          uint32_t sourceReadSize,
                          uint32_t serverWriteSize,
                          uint32_t serverReadSize,
-                         bool useIpv6)
+                         bool useIpv6,
+                         uint32_t tsoMaxSegments)
     : TestCase(Name("Send string data from client to server and back",
                     totalStreamSize,
                     sourceWriteSize,
                     serverReadSize,
                     serverWriteSize,
                     sourceReadSize,
-                    useIpv6)),
+                    useIpv6,
+                    tsoMaxSegments)),
       m_totalBytes(totalStreamSize),
       m_sourceWriteSize(sourceWriteSize),
       m_sourceReadSize(sourceReadSize),
       m_serverWriteSize(serverWriteSize),
       m_serverReadSize(serverReadSize),
-      m_useIpv6(useIpv6)
+      m_useIpv6(useIpv6),
+      m_tsoMaxSegments(tsoMaxSegments)
 {
 }
 
@@ -226,6 +266,7 @@ TcpTestCase::DoRun()
     }
     memset(m_sourceRxPayload, 0, m_totalBytes);
     memset(m_serverRxPayload, 0, m_totalBytes);
+    m_superSegments = 0;
 
     if (m_useIpv6 == true)
     {
@@ -247,6 +288,50 @@ TcpTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(memcmp(m_sourceTxPayload, m_sourceRxPayload, m_totalBytes),
                           0,
                           "Source received back expected data buffers");
+    if (m_tsoMaxSegments > 1)
+    {
+        NS_TEST_EXPECT_MSG_GT(m_superSegments, 0, "No super-segment was sent");
+    }
+    else
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_superSegments, 0, "Super-segments sent without TSO");
+    }
+}
+
+void
+TcpTestCase::SocketTx(Ptr<const Packet> packet,
+                      const TcpHeader& header,
+                      Ptr<const TcpSocketBase> socket)
+{
+    SegmentationOffloadTag tsoTag;
+    if (!packet->PeekPacketTag(tsoTag))
+    {
+        return;
+    }
+    m_superSegments++;
+    NS_TEST_EXPECT_MSG_EQ(tsoTag.GetPayloadSize(), packet->GetSize(), "Unexpected payload size");
+    NS_TEST_EXPECT_MSG_EQ(tsoTag.GetSegmentSize(), m_segmentSize, "Segments must have the MSS");
+    NS_TEST_EXPECT_MSG_GT(tsoTag.GetSegmentCount(), 1, "Super-segment of a single segment");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(tsoTag.GetSegmentCount(),
+                                m_tsoMaxSegments,
+                                "Super-segment of too many segments");
+}
+
+void
+TcpTestCase::DeviceRx(Ptr<NetDevice> device,
+                      Ptr<const Packet> packet,
+                      uint16_t protocol,
+                      const Address& from,
+                      const Address& to,
+                      NetDevice::PacketType packetType)
+{
+    // IP and TCP headers, TCP options included
+    const uint32_t maxHeaderSize = (m_useIpv6 ? 40 : 20) + 60;
+    SegmentationOffloadTag tsoTag;
+    NS_TEST_EXPECT_MSG_EQ(packet->PeekPacketTag(tsoTag), false, "Super-segment sent to a device");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(packet->GetSize(),
+                                maxHeaderSize + m_segmentSize,
+                                "Segment larger than the MSS");
 }
 
 void
@@ -406,11 +491,28 @@ TcpTestCase::SetupDefaultSim()
     dev0->SetChannel(channel);
     dev1->SetChannel(channel);
 
+    for (auto& dev : {dev0, dev1})
+    {
+        dev->GetNode()->RegisterProtocolHandler(MakeCallback(&TcpTestCase::DeviceRx, this),
+                                                0,
+                                                dev,
+                                                true);
+    }
+
     Ptr<SocketFactory> sockFactory0 = node0->GetObject<TcpSocketFactory>();
     Ptr<SocketFactory> sockFactory1 = node1->GetObject<TcpSocketFactory>();
 
     Ptr<Socket> server = sockFactory0->CreateSocket();
     Ptr<Socket> source = sockFactory1->CreateSocket();
+    server->SetAttribute("TsoMaxSegments", UintegerValue(m_tsoMaxSegments));
+    source->SetAttribute("TsoMaxSegments", UintegerValue(m_tsoMaxSegments));
+    UintegerValue segmentSize;
+    source->GetAttribute("SegmentSize", segmentSize);
+    m_segmentSize = segmentSize.Get();
+    for (auto& socket : {server, source})
+    {
+        socket->TraceConnectWithoutContext("Tx", MakeCallback(&TcpTestCase::SocketTx, this));
+    }
 
     uint16_t port = 50000;
     InetSocketAddress serverlocaladdr(Ipv4Address::GetAny(), port);
@@ -456,11 +558,28 @@ TcpTestCase::SetupDefaultSim6()
     dev0->SetChannel(channel);
     dev1->SetChannel(channel);
 
+    for (auto& dev : {dev0, dev1})
+    {
+        dev->GetNode()->RegisterProtocolHandler(MakeCallback(&TcpTestCase::DeviceRx, this),
+                                                0,
+                                                dev,
+                                                true);
+    }
+
     Ptr<SocketFactory> sockFactory0 = node0->GetObject<TcpSocketFactory>();
     Ptr<SocketFactory> sockFactory1 = node1->GetObject<TcpSocketFactory>();
 
     Ptr<Socket> server = sockFactory0->CreateSocket();
     Ptr<Socket> source = sockFactory1->CreateSocket();
+    server->SetAttribute("TsoMaxSegments", UintegerValue(m_tsoMaxSegments));
+    source->SetAttribute("TsoMaxSegments", UintegerValue(m_tsoMaxSegments));
+    UintegerValue segmentSize;
+    source->GetAttribute("SegmentSize", segmentSize);
+    m_segmentSize = segmentSize.Get();
+    for (auto& socket : {server, source})
+    {
+        socket->TraceConnectWithoutContext("Tx", MakeCallback(&TcpTestCase::SocketTx, this));
+    }
 
     uint16_t port = 50000;
     Inet6SocketAddress serverlocaladdr(Ipv6Address::GetAny(), port);
@@ -558,6 +677,10 @@ class TcpTestSuite : public TestSuite
         AddTestCase(new TcpTestCase(13, 200, 200, 200, 200, true), TestCase::QUICK);
         AddTestCase(new TcpTestCase(13, 1, 1, 1, 1, true), TestCase::QUICK);
         AddTestCase(new TcpTestCase(100000, 100, 50, 100, 20, true), TestCase::QUICK);
+
+        // Same transfers with TCP segmentation offload enabled
+        AddTestCase(new TcpTestCase(100000, 100, 50, 100, 20, false, 8), TestCase::QUICK);
+        AddTestCase(new TcpTestCase(100000, 100, 50, 100, 20, true, 8), TestCase::QUICK);
     }
 };
 
@@ -20,25 +20,37 @@
 #include "radio-environment-map-helper.h"
 
 #include <ns3/abort.h>
+#include <ns3/angles.h>
+#include <ns3/antenna-model.h>
 #include <ns3/boolean.h>
+#include <ns3/building-list.h>
 #include <ns3/buildings-helper.h>
 #include <ns3/config.h>
 #include <ns3/constant-position-mobility-model.h>
 #include <ns3/double.h>
 #include <ns3/integer.h>
 #include <ns3/log.h>
+#include <ns3/lte-spectrum-signal-parameters.h>
 #include <ns3/lte-spectrum-value-helper.h>
 #include <ns3/mobility-building-info.h>
 #include <ns3/node.h>
+#include <ns3/phased-array-spectrum-propagation-loss-model.h>
 #include <ns3/pointer.h>
+#include <ns3/propagation-loss-model.h>
 #include <ns3/rem-spectrum-phy.h>
 #include <ns3/simulator.h>
 #include <ns3/spectrum-channel.h>
+#include <ns3/spectrum-converter.h>
+#include <ns3/spectrum-propagation-loss-model.h>
 #include <ns3/string.h>
 #include <ns3/uinteger.h>
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <limits>
+#include <set>
+#include <thread>
 
 namespace ns3
 {
@@ -47,6 +59,40 @@ NS_LOG_COMPONENT_DEFINE("RadioEnvironmentMapHelper");
 
 NS_OBJECT_ENSURE_REGISTERED(RadioEnvironmentMapHelper);
 
+/**
+ * \param model the first propagation loss model of a chain
+ * \return true if all the models of the chain can be called by several threads
+ *         at once, i.e., if they are known to neither draw random variables nor
+ *         cache any state
+ */
+static bool
+IsThreadSafe(Ptr<PropagationLossModel> model)
+{
+    static const std::set<std::string> threadSafeModels{
+        "ns3::Cost231PropagationLossModel",
+        "ns3::FixedRssLossModel",
+        "ns3::FriisPropagationLossModel",
+        "ns3::ItuR1411LosPropagationLossModel",
+        "ns3::ItuR1411NlosOverRooftopPropagationLossModel",
+        "ns3::Kun2600MhzPropagationLossModel",
+        "ns3::LogDistancePropagationLossModel",
+        "ns3::MatrixPropagationLossModel",
+        "ns3::OkumuraHataPropagationLossModel",
+        "ns3::RangePropagationLossModel",
+        "ns3::ThreeLogDistancePropagationLossModel",
+        "ns3::TwoRayGroundPropagationLossModel",
+    };
+    for (; model; model = model->GetNext())
+    {
+        if (threadSafeModels.count(model->GetInstanceTypeId().GetName()) == 0)
+        {
+            NS_LOG_LOGIC(model->GetInstanceTypeId().GetName() << " is not known to be thread-safe");
+            return false;
+        }
+    }
+    return true;
+}
+
 RadioEnvironmentMapHelper::RadioEnvironmentMapHelper()
 {
 }
@@ -169,7 +215,26 @@ RadioEnvironmentMapHelper::GetTypeId()
                           "default value is -1, what means REM will be averaged from all RBs",
                           IntegerValue(-1),
                           MakeIntegerAccessor(&RadioEnvironmentMapHelper::m_rbId),
-                          MakeIntegerChecker<int32_t>());
+                          MakeIntegerChecker<int32_t>())
+            .AddAttribute("DirectEvaluation",
+                          "If true, the signals transmitted on the channel during one TTI are "
+                          "collected and the SINR of each point is computed from them by calling "
+                          "the loss models of the channel, instead of being measured by listeners "
+                          "attached to the channel. The map is evaluated by tiles of at most "
+                          "MaxPointsPerIteration points, without scheduling any event.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RadioEnvironmentMapHelper::m_directEvaluation),
+                          MakeBooleanChecker())
+            .AddAttribute("NumThreads",
+                          "The number of threads computing the SINR of the points of a tile if "
+                          "DirectEvaluation is true. A single thread is used if there are "
+                          "buildings, if the channel has a spectrum propagation loss model or if "
+                          "one of its propagation loss models may draw random variables or cache "
+                          "any state, i.e., is not one of the deterministic models (e.g., Friis, "
+                          "log-distance or Okumura-Hata models).",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&RadioEnvironmentMapHelper::m_numThreads),
+                          MakeUintegerChecker<uint32_t>(1, 1024));
     return tid;
 }
 
@@ -245,6 +310,15 @@ RadioEnvironmentMapHelper::DelayedInstall()
     m_xStep = (m_xMax - m_xMin) / (m_xRes - 1);
     m_yStep = (m_yMax - m_yMin) / (m_yRes - 1);
 
+    if (m_directEvaluation)
+    {
+        // collect the signals received by the listeners in the first iteration,
+        // which starts after 0.1 ms and ends 0.5 ms later
+        Simulator::Schedule(Seconds(0.0001), &RadioEnvironmentMapHelper::StartCollecting, this);
+        Simulator::Schedule(Seconds(0.0006), &RadioEnvironmentMapHelper::EvaluateDirectly, this);
+        return;
+    }
+
     if ((double)m_xRes * (double)m_yRes < (double)m_maxPointsPerIteration)
     {
         m_maxPointsPerIteration = m_xRes * m_yRes;
@@ -370,4 +444,240 @@ RadioEnvironmentMapHelper::Finalize()
     }
 }
 
+void
+RadioEnvironmentMapHelper::StartCollecting()
+{
+    NS_LOG_FUNCTION(this);
+    m_channel->TraceConnectWithoutContext(
+        "TxSigParams",
+        MakeCallback(&RadioEnvironmentMapHelper::CollectTxSignal, this));
+}
+
+void
+RadioEnvironmentMapHelper::CollectTxSignal(Ptr<SpectrumSignalParameters> params)
+{
+    NS_LOG_FUNCTION(this << params);
+    // same filter as RemSpectrumPhy::StartRx
+    bool collect = m_useDataChannel
+                       ? bool(DynamicCast<LteSpectrumSignalParametersDataFrame>(params))
+                       : bool(DynamicCast<LteSpectrumSignalParametersDlCtrlFrame>(params));
+    if (collect)
+    {
+        RemSignal signal;
+        signal.params = params; // the trace source passes a copy of the parameters
+        signal.power = 0;
+        m_remSignals.push_back(signal);
+    }
+}
+
+void
+RadioEnvironmentMapHelper::EvaluateDirectly()
+{
+    NS_LOG_FUNCTION(this);
+    m_channel->TraceDisconnectWithoutContext(
+        "TxSigParams",
+        MakeCallback(&RadioEnvironmentMapHelper::CollectTxSignal, this));
+
+    NS_ABORT_MSG_IF(m_channel->GetPhasedArraySpectrumPropagationLossModel(),
+                    "The direct evaluation of the REM does not support a phased array spectrum "
+                    "propagation loss model");
+    m_propagationLoss = m_channel->GetPropagationLossModel();
+    m_spectrumPropagationLoss = m_channel->GetSpectrumPropagationLossModel();
+    DoubleValue doubleValue;
+    m_channel->GetAttribute("MaxRange", doubleValue);
+    m_maxRange = doubleValue.Get();
+    m_channel->GetAttribute("MaxLossDb", doubleValue);
+    m_maxLossDb = doubleValue.Get();
+
+    // ns-3 objects are not thread-safe, hence the threads only share the loss
+    // models, provided that they are stateless: each thread has its own mobility models
+    bool hasBuildings = BuildingList::GetNBuildings() > 0;
+    uint32_t numThreads = m_numThreads;
+    if (numThreads > 1 &&
+        (hasBuildings || m_spectrumPropagationLoss || !IsThreadSafe(m_propagationLoss)))
+    {
+        NS_LOG_WARN("Evaluating the REM with a single thread because of the buildings or of the "
+                    "loss models of the channel");
+        numThreads = 1;
+    }
+
+    Ptr<const SpectrumModel> rxSpectrumModel =
+        LteSpectrumValueHelper::GetSpectrumModel(m_earfcn, m_bandwidth);
+    std::vector<RemSignal> signals;
+    for (auto& signal : m_remSignals)
+    {
+        Ptr<const SpectrumModel> txSpectrumModel = signal.params->psd->GetSpectrumModel();
+        if (txSpectrumModel->GetUid() != rxSpectrumModel->GetUid())
+        {
+            if (txSpectrumModel->IsOrthogonal(*rxSpectrumModel))
+            {
+                continue;
+            }
+            SpectrumConverter converter(txSpectrumModel, rxSpectrumModel);
+            signal.params->psd = converter.Convert(signal.params->psd);
+        }
+        if (m_rbId >= 0)
+        {
+            signal.power = (*(signal.params->psd))[m_rbId] * 180000;
+        }
+        else
+        {
+            signal.power = Integral(*(signal.params->psd));
+        }
+
+        Ptr<MobilityModel> txMobility = signal.params->txPhy->GetMobility();
+        if (txMobility)
+        {
+            signal.txPosition = txMobility->GetPosition();
+            signal.txMobility.push_back(txMobility);
+            for (uint32_t i = 1; i < numThreads; ++i)
+            {
+                Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+                mobility->SetPosition(signal.txPosition);
+                signal.txMobility.push_back(mobility);
+            }
+        }
+        signals.push_back(signal);
+    }
+    m_remSignals.swap(signals);
+    NS_LOG_LOGIC(m_remSignals.size() << " signals collected");
+
+    for (uint32_t i = 0; i < numThreads; ++i)
+    {
+        Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+        if (numThreads == 1)
+        {
+            // operation usually done by BuildingsHelper::Install
+            mobility->AggregateObject(CreateObject<MobilityBuildingInfo>());
+        }
+        m_remRxMobility.push_back(mobility);
+    }
+
+    // same points, in the same order, as the iterations of the listeners
+    std::vector<Vector> points;
+    points.reserve(std::min<uint64_t>(m_maxPointsPerIteration, uint64_t(m_xRes) * m_yRes));
+    std::vector<double> sinr;
+    for (double x = m_xMin; x < m_xMax + 0.5 * m_xStep; x += m_xStep)
+    {
+        for (double y = m_yMin; y < m_yMax + 0.5 * m_yStep; y += m_yStep)
+        {
+            points.emplace_back(x, y, m_z);
+            if ((points.size() == m_maxPointsPerIteration) ||
+                ((x > m_xMax - 0.5 * m_xStep) && (y > m_yMax - 0.5 * m_yStep)))
+            {
+                EvaluateTile(points, numThreads, hasBuildings, sinr);
+                for (std::size_t i = 0; i < points.size(); ++i)
+                {
+                    m_outFile << points[i].x << "\t" << points[i].y << "\t" << points[i].z << "\t"
+                              << sinr[i] << "\n";
+                }
+                m_outFile.flush();
+                points.clear();
+            }
+        }
+    }
+
+    m_remSignals.clear();
+    m_remRxMobility.clear();
+    Finalize();
+}
+
+void
+RadioEnvironmentMapHelper::EvaluateTile(const std::vector<Vector>& points,
+                                        uint32_t numThreads,
+                                        bool makeConsistent,
+                                        std::vector<double>& sinr) const
+{
+    NS_LOG_FUNCTION(this << points.size() << numThreads);
+    sinr.resize(points.size());
+    auto evaluate = [this, &points, makeConsistent, &sinr](uint32_t thread,
+                                                           std::size_t begin,
+                                                           std::size_t end) {
+        const Ptr<MobilityModel>& rxMobility = m_remRxMobility[thread];
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            rxMobility->SetPosition(points[i]);
+            if (makeConsistent)
+            {
+                rxMobility->GetObject<MobilityBuildingInfo>()->MakeConsistent(rxMobility);
+            }
+            sinr[i] = ComputeSinr(rxMobility, thread);
+        }
+    };
+
+    std::size_t pointsPerThread = (points.size() + numThreads - 1) / numThreads;
+    std::vector<std::thread> workers;
+    for (uint32_t thread = 1; thread < numThreads; ++thread)
+    {
+        std::size_t begin = std::min(thread * pointsPerThread, points.size());
+        std::size_t end = std::min(begin + pointsPerThread, points.size());
+        workers.emplace_back(evaluate, thread, begin, end);
+    }
+    evaluate(0, 0, std::min(pointsPerThread, points.size()));
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+double
+RadioEnvironmentMapHelper::ComputeSinr(Ptr<MobilityModel> rxMobility, uint32_t thread) const
+{
+    // same computations as SpectrumChannel::PropagateToReceiver, as the
+    // listeners have neither a NetDevice nor an antenna
+    Vector rxPosition = rxMobility->GetPosition();
+    double sumPower = 0;
+    double referenceSignalPower = 0;
+    for (const auto& signal : m_remSignals)
+    {
+        double power = signal.power;
+        if (!signal.txMobility.empty())
+        {
+            const Ptr<MobilityModel>& txMobility = signal.txMobility[thread];
+            if (m_maxRange > 0 && CalculateDistance(signal.txPosition, rxPosition) > m_maxRange)
+            {
+                continue;
+            }
+            double pathLossDb = 0;
+            if (signal.params->txAntenna)
+            {
+                Angles txAngles(rxPosition, signal.txPosition);
+                pathLossDb -= signal.params->txAntenna->GetGainDb(txAngles);
+            }
+            if (m_propagationLoss)
+            {
+                pathLossDb -= m_propagationLoss->CalcRxPower(0, txMobility, rxMobility);
+            }
+            if (pathLossDb > m_maxLossDb)
+            {
+                continue;
+            }
+            double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
+
+            if (m_spectrumPropagationLoss)
+            {
+                // evaluated by a single thread, see EvaluateDirectly
+                Ptr<SpectrumSignalParameters> rxParams = signal.params->Copy();
+                *(rxParams->psd) *= pathGainLinear;
+                rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity(rxParams,
+                                                                                      txMobility,
+                                                                                      rxMobility);
+                power = (m_rbId >= 0) ? (*(rxParams->psd))[m_rbId] * 180000
+                                      : Integral(*(rxParams->psd));
+            }
+            else
+            {
+                power *= pathGainLinear;
+            }
+        }
+
+        sumPower += power;
+        if (power > referenceSignalPower)
+        {
+            referenceSignalPower = power;
+        }
+    }
+    return referenceSignalPower / (sumPower - referenceSignalPower + m_noisePower);
+}
+
 } // namespace ns3
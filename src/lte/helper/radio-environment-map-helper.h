@@ -21,8 +21,10 @@
 #define RADIO_ENVIRONMENT_MAP_HELPER_H
 
 #include <ns3/object.h>
+#include <ns3/vector.h>
 
 #include <fstream>
+#include <vector>
 
 namespace ns3
 {
@@ -33,6 +35,9 @@ class NetDevice;
 class SpectrumChannel;
 // class BuildingsMobilityModel;
 class MobilityModel;
+class PropagationLossModel;
+class SpectrumPropagationLossModel;
+class SpectrumSignalParameters;
 
 /**
  * \ingroup lte
@@ -40,6 +45,16 @@ class MobilityModel;
  * Generates a 2D map of the SINR from the strongest transmitter in the
  * downlink of an LTE FDD system. For instructions on usage, please refer to
  * the User Documentation.
+ *
+ * By default, the SINR is measured by RemSpectrumPhy listeners attached to
+ * the channel, which are moved across the map by successive iterations of
+ * the simulation. If the `DirectEvaluation` attribute is true, the signals
+ * transmitted on the channel during one TTI are collected instead, and the
+ * SINR of each point is computed from them by calling the loss models of the
+ * channel, without scheduling any event. The map is then evaluated by tiles
+ * of at most `MaxPointsPerIteration` points, whose points are shared among
+ * `NumThreads` threads, and each tile is written to the output file as soon
+ * as it is completed.
  */
 class RadioEnvironmentMapHelper : public Object
 {
@@ -104,6 +119,54 @@ class RadioEnvironmentMapHelper : public Object
     /// Called when the map generation procedure has been completed.
     void Finalize();
 
+    /**
+     * Scheduled by DelayedInstall() in the direct evaluation mode, when the
+     * listeners would start their first iteration. Connect CollectTxSignal()
+     * to the channel.
+     */
+    void StartCollecting();
+
+    /**
+     * Connected to the `TxSigParams` trace source of the channel in the direct
+     * evaluation mode, to collect the signals transmitted in the DL.
+     *
+     * \param params the parameters of the transmitted signal
+     */
+    void CollectTxSignal(Ptr<SpectrumSignalParameters> params);
+
+    /**
+     * Scheduled by DelayedInstall() in the direct evaluation mode, after the
+     * signals of one TTI have been collected. Compute the SINR of all the
+     * points of the map tile by tile, write each tile to the output file and
+     * then call Finalize().
+     */
+    void EvaluateDirectly();
+
+    /**
+     * Compute the SINR of the points of a tile in the direct evaluation mode.
+     * The points are split into contiguous ranges, one per thread.
+     *
+     * \param points the points of the tile
+     * \param numThreads the number of threads
+     * \param makeConsistent whether the building info of the listening points has
+     *        to be updated
+     * \param sinr the SINR of each point of the tile (output)
+     */
+    void EvaluateTile(const std::vector<Vector>& points,
+                      uint32_t numThreads,
+                      bool makeConsistent,
+                      std::vector<double>& sinr) const;
+
+    /**
+     * Compute the SINR at the position of a listening point in the direct
+     * evaluation mode, as RemSpectrumPhy would do with the collected signals.
+     *
+     * \param rxMobility the mobility model of the listening point
+     * \param thread the index of the calling thread
+     * \return the SINR w.r.t. the strongest signal, in linear units
+     */
+    double ComputeSinr(Ptr<MobilityModel> rxMobility, uint32_t thread) const;
+
     /// A complete Radio Environment Map is composed of many of this structure.
     struct RemPoint
     {
@@ -116,6 +179,31 @@ class RadioEnvironmentMapHelper : public Object
     /// List of listeners in the environment.
     std::list<RemPoint> m_rem;
 
+    /// A DL signal collected in the direct evaluation mode.
+    struct RemSignal
+    {
+        /// The parameters of the signal, whose PSD is expressed in the spectrum model of the REM.
+        Ptr<SpectrumSignalParameters> params;
+        /// The power of the signal over the bandwidth (or the RB) of the REM, in W.
+        double power;
+        /// The position of the transmitter.
+        Vector txPosition;
+        /// The mobility model of the transmitter used by each thread, if any.
+        std::vector<Ptr<MobilityModel>> txMobility;
+    };
+
+    /// The DL signals collected in the direct evaluation mode.
+    std::vector<RemSignal> m_remSignals;
+
+    /// The mobility model of the listening point of each thread in the direct evaluation mode.
+    std::vector<Ptr<MobilityModel>> m_remRxMobility;
+
+    Ptr<PropagationLossModel> m_propagationLoss; ///< The propagation loss model of the channel.
+    /// The spectrum propagation loss model of the channel.
+    Ptr<SpectrumPropagationLossModel> m_spectrumPropagationLoss;
+    double m_maxRange;  ///< The `MaxRange` attribute of the channel.
+    double m_maxLossDb; ///< The `MaxLossDb` attribute of the channel.
+
     double m_xMin;   ///< The `XMin` attribute.
     double m_xMax;   ///< The `XMax` attribute.
     uint16_t m_xRes; ///< The `XRes` attribute.
@@ -156,8 +244,10 @@ class RadioEnvironmentMapHelper : public Object
 
     std::ofstream m_outFile; ///< Stream the output to a file.
 
-    bool m_useDataChannel; ///< The `UseDataChannel` attribute.
-    int32_t m_rbId;        ///< The `RbId` attribute.
+    bool m_useDataChannel;   ///< The `UseDataChannel` attribute.
+    int32_t m_rbId;          ///< The `RbId` attribute.
+    bool m_directEvaluation; ///< The `DirectEvaluation` attribute.
+    uint32_t m_numThreads;   ///< The `NumThreads` attribute.
 
 }; // end of `class RadioEnvironmentMapHelper`
 
@@ -590,6 +590,8 @@ LteAmc::CreateCqiFeedbacks(const SpectrumValue& sinr, uint8_t rbgSize)
     {
         NS_LOG_DEBUG(this << " AMC-VIENNA RBG size " << (uint16_t)rbgSize);
         NS_ASSERT_MSG(rbgSize > 0, " LteAmc-Vienna: RBG size must be greater than 0");
+        // map the SINR of the RBs to the MI at most once for all the RBGs and MCSs evaluated below
+        MiPerRb_t miPerRb = LteMiErrorModel::GetMiPerRb(sinr);
         std::vector<int> rbgMap;
         int rbId = 0;
         for (it = sinr.ConstValuesBegin(); it != sinr.ConstValuesEnd(); it++)
@@ -603,7 +605,7 @@ LteAmc::CreateCqiFeedbacks(const SpectrumValue& sinr, uint8_t rbgSize)
                 {
                     HarqProcessInfoList_t harqInfoList;
                     tbStats = LteMiErrorModel::GetTbDecodificationStats(
-                        sinr,
+                        miPerRb,
                         rbgMap,
                         (uint16_t)GetDlTbSizeFromMcs(mcs, rbgSize) / 8,
                         mcs,
@@ -34,7 +34,10 @@
 #include <ns3/lte-mi-error-model.h>
 #include <ns3/pointer.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <limits>
 #include <list>
 #include <stdint.h>
 #include <vector>
@@ -903,85 +906,108 @@ static const double cEcrTable [9][38] = {
 
 // clang-format on
 
-double
-LteMiErrorModel::Mib(const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
+/// Lookup table of the MI of a modulation as a function of the sinr
+struct MiMap
 {
-    NS_LOG_FUNCTION(sinr << &map << (uint32_t)mcs);
+    const double* mi;    ///< the MI values
+    const double* axis;  ///< the sinr values (linear), which are uniformly spaced
+    uint16_t size;       ///< the number of values
+    double scalingCoeff; ///< the number of values per unit of sinr
+};
 
-    double MI;
-    double MIsum = 0.0;
+/**
+ * MI lookup tables of QPSK, 16-QAM and 64-QAM. Since the sinr values of each table are
+ * uniformly spaced, we have
+ * index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
+ * and the scaling coefficient is computed once for all.
+ */
+static const MiMap g_miMaps[3] = {
+    {MI_map_qpsk,
+     MI_map_qpsk_axis,
+     MI_MAP_QPSK_SIZE,
+     (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1] - MI_map_qpsk_axis[0])},
+    {MI_map_16qam,
+     MI_map_16qam_axis,
+     MI_MAP_16QAM_SIZE,
+     (MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MI_MAP_16QAM_SIZE - 1] - MI_map_16qam_axis[0])},
+    {MI_map_64qam,
+     MI_map_64qam_axis,
+     MI_MAP_64QAM_SIZE,
+     (MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MI_MAP_64QAM_SIZE - 1] - MI_map_64qam_axis[0])},
+};
 
-    for (uint32_t i = 0; i < map.size(); i++)
-    {
-        double sinrLin = sinr[map.at(i)];
-        if (mcs <= MI_QPSK_MAX_ID) // QPSK
-        {
-            if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1])
-            {
-                MI = 1;
-            }
-            else
-            {
-                // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-                // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                // the scaling coefficient is always the same, so we use a static const
-                // to speed up the calculation
-                static const double scalingCoeffQpsk =
-                    (MI_MAP_QPSK_SIZE - 1) /
-                    (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1] - MI_map_qpsk_axis[0]);
-                double sinrIndexDouble = (sinrLin - MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-                uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-                NS_ASSERT_MSG(sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-                MI = MI_map_qpsk[sinrIndex];
-            }
-        }
-        else
+/// Parameters of a BLER curve (see IEEE802.16m EMD formula 55 of section 4.3.2.1)
+struct BlerCurve
+{
+    double b; ///< the value of bEcrTable
+    double c; ///< the value of cEcrTable
+};
+
+/// BLER curves for each CB size of cbMiSizeTable (first index) and ECR (second index)
+typedef std::array<std::array<BlerCurve, MI_64QAM_BLER_MAX_ID + 1>, 9> BlerCurves_t;
+
+/**
+ * Get the BLER curves of bEcrTable and cEcrTable, where the curves that are not available
+ * for a CB size are replaced by the ones of the lowest larger CB size having them (for
+ * removing CB size quantization errors). The curves are computed at the first call only.
+ *
+ * \return the BLER curves
+ */
+static const BlerCurves_t&
+GetBlerCurves()
+{
+    static const BlerCurves_t curves = []() {
+        BlerCurves_t ret;
+        for (int cbIndex = 0; cbIndex < 9; cbIndex++)
         {
-            if (mcs > MI_QPSK_MAX_ID && mcs <= MI_16QAM_MAX_ID) // 16-QAM
-            {
-                if (sinrLin > MI_map_16qam_axis[MI_MAP_16QAM_SIZE - 1])
-                {
-                    MI = 1;
-                }
-                else
-                {
-                    // since the values in MI_map_16QAM_axis are uniformly spaced, we have
-                    // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                    // the scaling coefficient is always the same, so we use a static const
-                    // to speed up the calculation
-                    static const double scalingCoeff16qam =
-                        (MI_MAP_16QAM_SIZE - 1) /
-                        (MI_map_16qam_axis[MI_MAP_16QAM_SIZE - 1] - MI_map_16qam_axis[0]);
-                    double sinrIndexDouble =
-                        (sinrLin - MI_map_16qam_axis[0]) * scalingCoeff16qam + 1;
-                    uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-                    NS_ASSERT_MSG(sinrIndex < MI_MAP_16QAM_SIZE, "MI map out of data");
-                    MI = MI_map_16qam[sinrIndex];
-                }
-            }
-            else // 64-QAM
+            for (int ecrId = 0; ecrId <= MI_64QAM_BLER_MAX_ID; ecrId++)
             {
-                if (sinrLin > MI_map_64qam_axis[MI_MAP_64QAM_SIZE - 1])
+                int i = cbIndex;
+                while ((i < 8) && (bEcrTable[i][ecrId] < 0))
                 {
-                    MI = 1;
+                    i++;
                 }
-                else
+                ret[cbIndex][ecrId].b = bEcrTable[i][ecrId];
+                i = cbIndex;
+                while ((i < 8) && (cEcrTable[i][ecrId] < 0))
                 {
-                    // since the values in MI_map_64QAM_axis are uniformly spaced, we have
-                    // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                    // the scaling coefficient is always the same, so we use a static const
-                    // to speed up the calculation
-                    static const double scalingCoeff64qam =
-                        (MI_MAP_64QAM_SIZE - 1) /
-                        (MI_map_64qam_axis[MI_MAP_64QAM_SIZE - 1] - MI_map_64qam_axis[0]);
-                    double sinrIndexDouble =
-                        (sinrLin - MI_map_64qam_axis[0]) * scalingCoeff64qam + 1;
-                    uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-                    NS_ASSERT_MSG(sinrIndex < MI_MAP_64QAM_SIZE, "MI map out of data");
-                    MI = MI_map_64qam[sinrIndex];
+                    i++;
                 }
+                ret[cbIndex][ecrId].c = cEcrTable[i][ecrId];
             }
         }
+        return ret;
+    }();
+    return curves;
+}
+
+double
+LteMiErrorModel::MappingSinrMi(double sinrLin, uint8_t mcs)
+{
+    const MiMap& miMap =
+        g_miMaps[(mcs <= MI_QPSK_MAX_ID) ? 0 : ((mcs <= MI_16QAM_MAX_ID) ? 1 : 2)];
+    if (sinrLin > miMap.axis[miMap.size - 1])
+    {
+        return 1;
+    }
+    double sinrIndexDouble = (sinrLin - miMap.axis[0]) * miMap.scalingCoeff + 1;
+    uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
+    NS_ASSERT_MSG(sinrIndex < miMap.size, "MI map out of data");
+    return miMap.mi[sinrIndex];
+}
+
+double
+LteMiErrorModel::Mib(const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
+{
+    NS_LOG_FUNCTION(sinr << &map << (uint32_t)mcs);
+
+    double MI;
+    double MIsum = 0.0;
+
+    for (uint32_t i = 0; i < map.size(); i++)
+    {
+        double sinrLin = sinr[map.at(i)];
+        MI = MappingSinrMi(sinrLin, mcs);
         NS_LOG_LOGIC(" RB " << map.at(i) << "Minimum SNR = " << 10 * std::log10(sinrLin) << " dB, "
                             << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
         MIsum += MI;
@@ -991,45 +1017,57 @@ LteMiErrorModel::Mib(const SpectrumValue& sinr, const std::vector<int>& map, uin
     return MI;
 }
 
+MiPerRb_t
+LteMiErrorModel::GetMiPerRb(const SpectrumValue& sinr)
+{
+    NS_LOG_FUNCTION(sinr);
+    MiPerRb_t miPerRb;
+    miPerRb.m_sinr.assign(sinr.ConstValuesBegin(), sinr.ConstValuesEnd());
+    return miPerRb;
+}
+
+double
+LteMiErrorModel::Mib(const MiPerRb_t& miPerRb, const std::vector<int>& map, uint8_t mcs)
+{
+    NS_LOG_FUNCTION(&miPerRb << &map << (uint32_t)mcs);
+
+    // the MI only depends on the modulation, hence on the range the MCS belongs to
+    std::size_t modulation = (mcs <= MI_QPSK_MAX_ID) ? 0 : ((mcs <= MI_16QAM_MAX_ID) ? 1 : 2);
+    std::vector<double>& mi = miPerRb.m_mi[modulation];
+    if (mi.empty())
+    {
+        mi.assign(miPerRb.m_sinr.size(), std::numeric_limits<double>::quiet_NaN());
+    }
+    double MIsum = 0.0;
+    for (std::size_t i = 0; i < map.size(); i++)
+    {
+        double& rbMi = mi.at(map[i]);
+        if (std::isnan(rbMi))
+        {
+            rbMi = MappingSinrMi(miPerRb.m_sinr[map[i]], mcs);
+        }
+        MIsum += rbMi;
+    }
+    double MI = MIsum / map.size();
+    NS_LOG_LOGIC(" MI = " << MI);
+    return MI;
+}
+
 double
 LteMiErrorModel::MappingMiBler(double mib, uint8_t ecrId, uint16_t cbSize)
 {
     NS_LOG_FUNCTION(mib << (uint32_t)ecrId << (uint32_t)cbSize);
-    double b = 0;
-    double c = 0;
 
     NS_ASSERT_MSG(ecrId <= MI_64QAM_BLER_MAX_ID, "ECR out of range [0..37]: " << (uint16_t)ecrId);
-    int cbIndex = 1;
-    while ((cbIndex < 9) && (cbMiSizeTable[cbIndex] <= cbSize))
-    {
-        cbIndex++;
-    }
+    // largest CB size of the curves not exceeding cbSize (or the lowest one)
+    int cbIndex = std::upper_bound(cbMiSizeTable + 1, cbMiSizeTable + 9, cbSize) - cbMiSizeTable;
     cbIndex--;
     NS_LOG_LOGIC(" ECRid " << (uint16_t)ecrId << " ECR " << BlerCurvesEcrMap[ecrId] << " CB size "
                            << cbSize << " CB size curve " << cbMiSizeTable[cbIndex]);
 
-    b = bEcrTable[cbIndex][ecrId];
-    if (b < 0.0)
-    {
-        // take the lowest CB size including this CB for removing CB size
-        // quatization errors
-        int i = cbIndex;
-        while ((i < 9) && (b < 0))
-        {
-            b = bEcrTable[i++][ecrId];
-        }
-    }
-    c = cEcrTable[cbIndex][ecrId];
-    if (c < 0.0)
-    {
-        // take the lowest CB size including this CB for removing CB size
-        // quatization errors
-        int i = cbIndex;
-        while ((i < 9) && (c < 0))
-        {
-            c = cEcrTable[i++][ecrId];
-        }
-    }
+    const BlerCurve& curve = GetBlerCurves()[cbIndex][ecrId];
+    double b = curve.b;
+    double c = curve.c;
     // see IEEE802.16m EMD formula 55 of section 4.3.2.1
     double bler = 0.5 * (1 - erf((mib - b) / (sqrt(2) * c)));
     NS_LOG_LOGIC("MIB: " << mib << " BLER:" << bler << " b:" << b << " c:" << c);
@@ -1047,37 +1085,17 @@ LteMiErrorModel::GetPcfichPdcchError(const SpectrumValue& sinr)
     NS_ASSERT(sinrIt != sinr.ConstValuesEnd());
     while (sinrIt != sinr.ConstValuesEnd())
     {
-        double sinrLin = *sinrIt;
-        if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1])
-        {
-            MI = 1;
-        }
-        else
-        {
-            // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-            // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-            // the scaling coefficient is always the same, so we use a static const
-            // to speed up the calculation
-            static const double scalingCoeffQpsk =
-                (MI_MAP_QPSK_SIZE - 1) /
-                (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1] - MI_map_qpsk_axis[0]);
-            double sinrIndexDouble = (sinrLin - MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-            uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-            NS_ASSERT_MSG(sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-            MI = MI_map_qpsk[sinrIndex];
-        }
+        // PCFICH and PDCCH are QPSK modulated
+        MI = MappingSinrMi(*sinrIt, 0);
         MIsum += MI;
         sinrIt++;
         rb++;
     }
     MI = MIsum / rb;
     // return to the effective SINR value
-    int j = 0;
+    // the MI values are sorted in increasing order
+    int j = std::lower_bound(MI_map_qpsk, MI_map_qpsk + MI_MAP_QPSK_SIZE, MI) - MI_map_qpsk;
     double esinr = 0.0;
-    while ((j < MI_MAP_QPSK_SIZE) && (MI_map_qpsk[j] < MI))
-    {
-        j++;
-    }
     if (MI > MI_map_qpsk[MI_MAP_QPSK_SIZE - 1])
     {
         esinr = MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1];
@@ -1106,12 +1124,11 @@ LteMiErrorModel::GetPcfichPdcchError(const SpectrumValue& sinr)
     double esirnDb = 10 * log10(esinr);
     //   NS_LOG_DEBUG ("Effective SINR " << esirnDb << " max " << 10*log10 (MI_map_qpsk
     //   [MI_MAP_QPSK_SIZE-1]));
-    uint16_t i = 0;
+    uint16_t i = std::lower_bound(PdcchPcfichBlerCurveXaxis,
+                                  PdcchPcfichBlerCurveXaxis + PDCCH_PCFICH_CURVE_SIZE,
+                                  esirnDb) -
+                 PdcchPcfichBlerCurveXaxis;
     double errorRate = 0.0;
-    while ((i < PDCCH_PCFICH_CURVE_SIZE) && (PdcchPcfichBlerCurveXaxis[i] < esirnDb))
-    {
-        i++;
-    }
     if (esirnDb > PdcchPcfichBlerCurveXaxis[PDCCH_PCFICH_CURVE_SIZE - 1])
     {
         errorRate = 0.0;
@@ -1130,11 +1147,29 @@ LteMiErrorModel::GetTbDecodificationStats(const SpectrumValue& sinr,
                                           const std::vector<int>& map,
                                           uint16_t size,
                                           uint8_t mcs,
-                                          HarqProcessInfoList_t miHistory)
+                                          const HarqProcessInfoList_t& miHistory)
 {
     NS_LOG_FUNCTION(sinr << &map << (uint32_t)size << (uint32_t)mcs);
+    return GetTbDecodificationStats(Mib(sinr, map, mcs), size, mcs, miHistory);
+}
+
+TbStats_t
+LteMiErrorModel::GetTbDecodificationStats(const MiPerRb_t& miPerRb,
+                                          const std::vector<int>& map,
+                                          uint16_t size,
+                                          uint8_t mcs,
+                                          const HarqProcessInfoList_t& miHistory)
+{
+    NS_LOG_FUNCTION(&miPerRb << &map << (uint32_t)size << (uint32_t)mcs);
+    return GetTbDecodificationStats(Mib(miPerRb, map, mcs), size, mcs, miHistory);
+}
 
-    double tbMi = Mib(sinr, map, mcs);
+TbStats_t
+LteMiErrorModel::GetTbDecodificationStats(double tbMi,
+                                          uint16_t size,
+                                          uint8_t mcs,
+                                          const HarqProcessInfoList_t& miHistory)
+{
     double MI = 0.0;
     double Reff = 0.0;
     NS_ASSERT(mcs < 29);
@@ -1143,16 +1178,16 @@ LteMiErrorModel::GetTbDecodificationStats(const SpectrumValue& sinr,
         // evaluate R_eff and MI_eff
         uint16_t codeBitsSum = 0;
         double miSum = 0.0;
-        for (std::size_t i = 0; i < miHistory.size(); i++)
+        for (const auto& harqInfo : miHistory)
         {
-            NS_LOG_DEBUG(" Sum MI " << miHistory.at(i).m_mi << " Ci "
-                                    << miHistory.at(i).m_codeBits);
-            codeBitsSum += miHistory.at(i).m_codeBits;
-            miSum += (miHistory.at(i).m_mi * miHistory.at(i).m_codeBits);
+            NS_LOG_DEBUG(" Sum MI " << harqInfo.m_mi << " Ci " << harqInfo.m_codeBits);
+            codeBitsSum += harqInfo.m_codeBits;
+            miSum += (harqInfo.m_mi * harqInfo.m_codeBits);
         }
-        codeBitsSum += (((double)size * 8.0) / McsEcrTable[mcs]);
-        miSum += (tbMi * (((double)size * 8.0) / McsEcrTable[mcs]));
-        Reff = miHistory.at(0).m_infoBits /
+        double codeBits = ((double)size * 8.0) / McsEcrTable[mcs];
+        codeBitsSum += codeBits;
+        miSum += (tbMi * codeBits);
+        Reff = miHistory.front().m_infoBits /
                (double)codeBitsSum; // information bits are the size of the first TB
         MI = miSum / (double)codeBitsSum;
     }
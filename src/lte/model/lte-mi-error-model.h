@@ -35,6 +35,7 @@
 #include <ns3/ptr.h>
 #include <ns3/spectrum-value.h>
 
+#include <array>
 #include <list>
 #include <stdint.h>
 #include <vector>
@@ -70,6 +71,40 @@ struct TbStats_t
     double mi;    ///< Mutual information
 };
 
+/**
+ * Mutual information of each RB for QPSK, 16-QAM and 64-QAM, as computed from the SINR
+ * perceived on the RB. The MI of a RB for a modulation is only computed the first time
+ * it is needed by LteMiErrorModel, hence only for the RBs and the modulations actually
+ * used by the TBs (or the MCSs) evaluated on the same SINR values.
+ */
+class MiPerRb_t
+{
+  public:
+    /**
+     * \return the number of RBs
+     */
+    std::size_t size() const
+    {
+        return m_sinr.size();
+    }
+
+    /**
+     * \return true if there is no RB, e.g., if the object was default-constructed
+     */
+    bool empty() const
+    {
+        return m_sinr.empty();
+    }
+
+  private:
+    friend class LteMiErrorModel;
+
+    std::vector<double> m_sinr; ///< the sinr of each RB, in linear units
+    /// the MI of each RB for each modulation, NaN until computed; the column of a
+    /// modulation is only allocated when the modulation is first used
+    mutable std::array<std::vector<double>, 3> m_mi;
+};
+
 /**
  * This class provides the BLER estimation based on mutual information metrics
  */
@@ -85,6 +120,25 @@ class LteMiErrorModel
      * \return the mmib
      */
     static double Mib(const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs);
+
+    /**
+     * \brief prepare the mapping of the sinr of every RB to the mutual information for
+     * each modulation, so that several TBs (or several MCSs) evaluated on the same sinr
+     * values do not map them again. The MI values are computed on demand.
+     * \param sinr the perceived sinr values in the whole bandwidth in Watt
+     * \return the MI of each RB for each modulation
+     */
+    static MiPerRb_t GetMiPerRb(const SpectrumValue& sinr);
+
+    /**
+     * \brief find the mmib (mean mutual information per bit) of the specified TB from the MI
+     * of every RB
+     * \param miPerRb the MI of each RB for each modulation, as returned by GetMiPerRb
+     * \param map the active RBs for the TB
+     * \param mcs the MCS of the TB
+     * \return the mmib, which is identical to the one returned by Mib for the same sinr values
+     */
+    static double Mib(const MiPerRb_t& miPerRb, const std::vector<int>& map, uint8_t mcs);
     /**
      * \brief map the mmib (mean mutual information per bit) for different MCS
      * \param mib mean mutual information per bit of a code-block
@@ -107,7 +161,23 @@ class LteMiErrorModel
                                               const std::vector<int>& map,
                                               uint16_t size,
                                               uint8_t mcs,
-                                              HarqProcessInfoList_t miHistory);
+                                              const HarqProcessInfoList_t& miHistory);
+
+    /**
+     * \brief run the error-model algorithm for the specified TB from the MI of every RB
+     * \param miPerRb the MI of each RB for each modulation, as returned by GetMiPerRb
+     * \param map the active RBs for the TB
+     * \param size the size in bytes of the TB
+     * \param mcs the MCS of the TB
+     * \param miHistory MI of past transmissions (in case of retx)
+     * \return the TB error rate and MI, which are identical to the ones returned for the
+     * same sinr values
+     */
+    static TbStats_t GetTbDecodificationStats(const MiPerRb_t& miPerRb,
+                                              const std::vector<int>& map,
+                                              uint16_t size,
+                                              uint8_t mcs,
+                                              const HarqProcessInfoList_t& miHistory);
 
     /**
      * \brief run the error-model algorithm for the specified PCFICH+PDCCH channels
@@ -116,7 +186,27 @@ class LteMiErrorModel
      */
     static double GetPcfichPdcchError(const SpectrumValue& sinr);
 
-    // private:
+  private:
+    /**
+     * \brief map the sinr perceived on a RB to the mutual information
+     * \param sinrLin the sinr in linear units
+     * \param mcs the MCS, which determines the modulation
+     * \return the mutual information
+     */
+    static double MappingSinrMi(double sinrLin, uint8_t mcs);
+
+    /**
+     * \brief run the error-model algorithm for the specified TB given its MI
+     * \param tbMi the mmib of the TB
+     * \param size the size in bytes of the TB
+     * \param mcs the MCS of the TB
+     * \param miHistory MI of past transmissions (in case of retx)
+     * \return the TB error rate and MI
+     */
+    static TbStats_t GetTbDecodificationStats(double tbMi,
+                                              uint16_t size,
+                                              uint8_t mcs,
+                                              const HarqProcessInfoList_t& miHistory);
 };
 
 } // namespace ns3
@@ -971,6 +971,8 @@ LteSpectrumPhy::EndRxData()
     NS_ASSERT(m_transmissionMode < m_txModeGain.size());
     m_sinrPerceived *= m_txModeGain.at(m_transmissionMode);
 
+    // MI of the RBs, mapped at most once for all the TBs received in this TTI
+    MiPerRb_t miPerRb;
     while (itTb != m_expectedTbs.end())
     {
         if ((m_dataErrorModelEnabled) &&
@@ -995,7 +997,11 @@ LteSpectrumPhy::EndRxData()
                         m_harqPhyModule->GetHarqProcessInfoUl((*itTb).first.m_rnti, ulHarqId);
                 }
             }
-            TbStats_t tbStats = LteMiErrorModel::GetTbDecodificationStats(m_sinrPerceived,
+            if (miPerRb.empty())
+            {
+                miPerRb = LteMiErrorModel::GetMiPerRb(m_sinrPerceived);
+            }
+            TbStats_t tbStats = LteMiErrorModel::GetTbDecodificationStats(miPerRb,
                                                                           (*itTb).second.rbBitmap,
                                                                           (*itTb).second.size,
                                                                           (*itTb).second.mcs,
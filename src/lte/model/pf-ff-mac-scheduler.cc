@@ -26,6 +26,7 @@
 #include <ns3/pointer.h>
 #include <ns3/simulator.h>
 
+#include <array>
 #include <cfloat>
 #include <set>
 
@@ -355,7 +356,8 @@ PfFfMacScheduler::LcActivePerFlow(uint16_t rnti)
 {
     std::map<LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator it;
     unsigned int lcActive = 0;
-    for (it = m_rlcBufferReq.begin(); it != m_rlcBufferReq.end(); it++)
+    // the flows are sorted by RNTI, hence skip the ones of the lower RNTIs
+    for (it = m_rlcBufferReq.lower_bound(LteFlowId_t(rnti, 0)); it != m_rlcBufferReq.end(); it++)
     {
         if (((*it).first.m_rnti == rnti) && (((*it).second.m_rlcTransmissionQueueSize > 0) ||
                                              ((*it).second.m_rlcRetransmissionQueueSize > 0) ||
@@ -945,56 +947,86 @@ PfFfMacScheduler::DoSchedDlTriggerReq(
         return;
     }
 
+    // achievable rate of a layer on a RBG for each CQI, since the TB size only depends on the
+    // MCS and on the number of RBs (CQI == 0 means "out of range", see table 7.2.3-1 of 36.213)
+    std::array<int, 16> mcsPerCqi;
+    std::array<double, 16> ratePerCqi;
+    for (uint8_t cqi = 0; cqi < 16; cqi++)
+    {
+        mcsPerCqi[cqi] = m_amc->GetMcsFromCqi(cqi);
+        ratePerCqi[cqi] =
+            ((m_amc->GetDlTbSizeFromMcs(mcsPerCqi[cqi], rbgSize) / 8) / 0.001); // = TB size / TTI
+    }
+    // no info on a subband -> worst MCS
+    double rateNoCqi = ((m_amc->GetDlTbSizeFromMcs(0, rbgSize) / 8) / 0.001);
+
+    // select the UEs that can be allocated in this TTI once for all the RBGs, since only their
+    // CQIs and the availability of the RBGs depend on the RBG
+    std::vector<DlCandidate> candidates;
+    std::map<uint16_t, pfsFlowPerf_t>::iterator it;
+    for (it = m_flowStatsDl.begin(); it != m_flowStatsDl.end(); it++)
+    {
+        std::set<uint16_t>::iterator itRnti = rntiAllocated.find((*it).first);
+        if ((itRnti != rntiAllocated.end()) || (!HarqProcessAvailability((*it).first)))
+        {
+            // UE already allocated for HARQ or without HARQ process available -> drop it
+            if (itRnti != rntiAllocated.end())
+            {
+                NS_LOG_DEBUG(this << " RNTI discared for HARQ tx" << (uint16_t)(*it).first);
+            }
+            if (!HarqProcessAvailability((*it).first))
+            {
+                NS_LOG_DEBUG(this << " RNTI discared for HARQ id" << (uint16_t)(*it).first);
+            }
+            continue;
+        }
+        std::map<uint16_t, uint8_t>::iterator itTxMode;
+        itTxMode = m_uesTxMode.find((*it).first);
+        if (itTxMode == m_uesTxMode.end())
+        {
+            NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
+        }
+        if (LcActivePerFlow((*it).first) == 0)
+        {
+            // this UE has no data to transmit
+            continue;
+        }
+        DlCandidate candidate;
+        candidate.flowStats = it;
+        candidate.nLayer = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
+        std::map<uint16_t, SbMeasResult_s>::iterator itCqi;
+        itCqi = m_a30CqiRxed.find((*it).first);
+        if (itCqi == m_a30CqiRxed.end())
+        {
+            candidate.sbMeasResult = nullptr;
+            candidate.defaultSbCqi.assign(candidate.nLayer, 1); // start with lowest value
+        }
+        else
+        {
+            candidate.sbMeasResult = &(*itCqi).second;
+        }
+        candidates.push_back(candidate);
+    }
+
     for (int i = 0; i < rbgNum; i++)
     {
         NS_LOG_INFO(this << " ALLOCATION for RBG " << i << " of " << rbgNum);
         if (rbgMap.at(i) == false)
         {
-            std::map<uint16_t, pfsFlowPerf_t>::iterator it;
             std::map<uint16_t, pfsFlowPerf_t>::iterator itMax = m_flowStatsDl.end();
             double rcqiMax = 0.0;
-            for (it = m_flowStatsDl.begin(); it != m_flowStatsDl.end(); it++)
+            for (const auto& candidate : candidates)
             {
+                it = candidate.flowStats;
                 if ((m_ffrSapProvider->IsDlRbgAvailableForUe(i, (*it).first)) == false)
                 {
                     continue;
                 }
 
-                std::set<uint16_t>::iterator itRnti = rntiAllocated.find((*it).first);
-                if ((itRnti != rntiAllocated.end()) || (!HarqProcessAvailability((*it).first)))
-                {
-                    // UE already allocated for HARQ or without HARQ process available -> drop it
-                    if (itRnti != rntiAllocated.end())
-                    {
-                        NS_LOG_DEBUG(this << " RNTI discared for HARQ tx" << (uint16_t)(*it).first);
-                    }
-                    if (!HarqProcessAvailability((*it).first))
-                    {
-                        NS_LOG_DEBUG(this << " RNTI discared for HARQ id" << (uint16_t)(*it).first);
-                    }
-                    continue;
-                }
-                std::map<uint16_t, SbMeasResult_s>::iterator itCqi;
-                itCqi = m_a30CqiRxed.find((*it).first);
-                std::map<uint16_t, uint8_t>::iterator itTxMode;
-                itTxMode = m_uesTxMode.find((*it).first);
-                if (itTxMode == m_uesTxMode.end())
-                {
-                    NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
-                }
-                auto nLayer = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
-                std::vector<uint8_t> sbCqi;
-                if (itCqi == m_a30CqiRxed.end())
-                {
-                    for (uint8_t k = 0; k < nLayer; k++)
-                    {
-                        sbCqi.push_back(1); // start with lowest value
-                    }
-                }
-                else
-                {
-                    sbCqi = (*itCqi).second.m_higherLayerSelected.at(i).m_sbCqi;
-                }
+                const std::vector<uint8_t>& sbCqi =
+                    (candidate.sbMeasResult == nullptr)
+                        ? candidate.defaultSbCqi
+                        : candidate.sbMeasResult->m_higherLayerSelected.at(i).m_sbCqi;
                 uint8_t cqi1 = sbCqi.at(0);
                 uint8_t cqi2 = 0;
                 if (sbCqi.size() > 1)
@@ -1005,40 +1037,35 @@ PfFfMacScheduler::DoSchedDlTriggerReq(
                 if ((cqi1 > 0) ||
                     (cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
                 {
-                    if (LcActivePerFlow((*it).first) > 0)
+                    double achievableRate = 0.0;
+                    int mcs = 0;
+                    for (uint8_t k = 0; k < candidate.nLayer; k++)
                     {
-                        // this UE has data to transmit
-                        double achievableRate = 0.0;
-                        uint8_t mcs = 0;
-                        for (uint8_t k = 0; k < nLayer; k++)
+                        if (sbCqi.size() > k)
                         {
-                            if (sbCqi.size() > k)
-                            {
-                                mcs = m_amc->GetMcsFromCqi(sbCqi.at(k));
-                            }
-                            else
-                            {
-                                // no info on this subband -> worst MCS
-                                mcs = 0;
-                            }
-                            achievableRate += ((m_amc->GetDlTbSizeFromMcs(mcs, rbgSize) / 8) /
-                                               0.001); // = TB size / TTI
+                            mcs = mcsPerCqi.at(sbCqi.at(k));
+                            achievableRate += ratePerCqi.at(sbCqi.at(k));
                         }
-
-                        double rcqi = achievableRate / (*it).second.lastAveragedThroughput;
-                        NS_LOG_INFO(this << " RNTI " << (*it).first << " MCS " << (uint32_t)mcs
-                                         << " achievableRate " << achievableRate << " avgThr "
-                                         << (*it).second.lastAveragedThroughput << " RCQI "
-                                         << rcqi);
-
-                        if (rcqi > rcqiMax)
+                        else
                         {
-                            rcqiMax = rcqi;
-                            itMax = it;
+                            // no info on this subband -> worst MCS
+                            mcs = 0;
+                            achievableRate += rateNoCqi;
                         }
                     }
+
+                    double rcqi = achievableRate / (*it).second.lastAveragedThroughput;
+                    NS_LOG_INFO(this << " RNTI " << (*it).first << " MCS " << (uint32_t)mcs
+                                     << " achievableRate " << achievableRate << " avgThr "
+                                     << (*it).second.lastAveragedThroughput << " RCQI " << rcqi);
+
+                    if (rcqi > rcqiMax)
+                    {
+                        rcqiMax = rcqi;
+                        itMax = it;
+                    }
                 } // end if cqi
-            }     // end for m_rlcBufferReq
+            }     // end for candidates
 
             if (itMax == m_flowStatsDl.end())
             {
@@ -1185,7 +1212,9 @@ PfFfMacScheduler::DoSchedDlTriggerReq(
         // create the rlc PDUs -> equally divide resources among actives LCs
         std::map<LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator
             itBufReq;
-        for (itBufReq = m_rlcBufferReq.begin(); itBufReq != m_rlcBufferReq.end(); itBufReq++)
+        for (itBufReq = m_rlcBufferReq.lower_bound(LteFlowId_t((*itMap).first, 0));
+             itBufReq != m_rlcBufferReq.end();
+             itBufReq++)
         {
             if (((*itBufReq).first.m_rnti == (*itMap).first) &&
                 (((*itBufReq).second.m_rlcTransmissionQueueSize > 0) ||
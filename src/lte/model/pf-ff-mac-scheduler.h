@@ -114,6 +114,15 @@ class PfFfMacScheduler : public FfMacScheduler
     void TransmissionModeConfigurationUpdate(uint16_t rnti, uint8_t txMode);
 
   private:
+    /// UE with data to transmit that can be allocated in the current DL TTI
+    struct DlCandidate
+    {
+        std::map<uint16_t, pfsFlowPerf_t>::iterator flowStats; ///< the DL stats of the UE
+        const SbMeasResult_s* sbMeasResult; ///< the subband CQIs (nullptr if not received)
+        std::vector<uint8_t> defaultSbCqi;  ///< the CQIs to use if no subband CQI is received
+        uint8_t nLayer;                     ///< the number of layers
+    };
+
     //
     // Implementation of the CSCHED API primitives
     // (See 4.1 for description of the primitives)
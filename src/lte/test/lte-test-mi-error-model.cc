@@ -0,0 +1,293 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/lte-mi-error-model.h"
+#include "ns3/spectrum-model.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/test.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("LteTestMiErrorModel");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case checking that the error model returns the same MI and TB error
+ * rate when the sinr values are mapped to the MI of every RB beforehand
+ * (LteMiErrorModel::GetMiPerRb) as when they are mapped for each TB.
+ */
+class LteMiErrorModelMiPerRbTestCase : public TestCase
+{
+  public:
+    LteMiErrorModelMiPerRbTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+LteMiErrorModelMiPerRbTestCase::LteMiErrorModelMiPerRbTestCase()
+    : TestCase("MI of the TBs computed from the MI of every RB")
+{
+}
+
+void
+LteMiErrorModelMiPerRbTestCase::DoRun()
+{
+    const uint32_t nRbs = 50;
+    Bands bands;
+    for (uint32_t i = 0; i < nRbs; i++)
+    {
+        BandInfo bi;
+        bi.fc = 2.12e9 + i * 180e3;
+        bi.fl = bi.fc - 90e3;
+        bi.fh = bi.fc + 90e3;
+        bands.push_back(bi);
+    }
+    SpectrumValue sinr(Create<SpectrumModel>(bands));
+    // sinr values from -15 dB to about 34 dB, which cover the whole range of the tables
+    for (uint32_t i = 0; i < nRbs; i++)
+    {
+        sinr[i] = std::pow(10.0, (-15.0 + i) / 10);
+    }
+    MiPerRb_t miPerRb = LteMiErrorModel::GetMiPerRb(sinr);
+    NS_TEST_ASSERT_MSG_EQ(miPerRb.size(), nRbs, "Unexpected number of RBs");
+
+    std::vector<std::vector<int>> maps;
+    maps.emplace_back(1, 0);
+    maps.emplace_back(1, nRbs - 1);
+    std::vector<int> all;
+    std::vector<int> even;
+    std::vector<int> reversed;
+    for (uint32_t i = 0; i < nRbs; i++)
+    {
+        all.push_back(i);
+        reversed.push_back(nRbs - 1 - i);
+        if (i % 2 == 0)
+        {
+            even.push_back(i);
+        }
+    }
+    maps.push_back(all);
+    maps.push_back(even);
+    maps.push_back(reversed);
+
+    HarqProcessInfoList_t noHistory;
+    HarqProcessInfoList_t history;
+    HarqProcessInfoElement_t el;
+    el.m_mi = 0.3;
+    el.m_rv = 0;
+    el.m_infoBits = 1000;
+    el.m_codeBits = 2000;
+    history.push_back(el);
+
+    for (const auto& map : maps)
+    {
+        for (uint8_t mcs = 0; mcs <= 28; mcs++)
+        {
+            // the values must be identical, not only close
+            NS_TEST_ASSERT_MSG_EQ(LteMiErrorModel::Mib(miPerRb, map, mcs),
+                                  LteMiErrorModel::Mib(sinr, map, mcs),
+                                  "Different MI for MCS " << +mcs << " on " << map.size()
+                                                          << " RBs");
+            for (const auto& miHistory : {noHistory, history})
+            {
+                TbStats_t expected =
+                    LteMiErrorModel::GetTbDecodificationStats(sinr, map, 500, mcs, miHistory);
+                TbStats_t tbStats =
+                    LteMiErrorModel::GetTbDecodificationStats(miPerRb, map, 500, mcs, miHistory);
+                NS_TEST_ASSERT_MSG_EQ(tbStats.mi,
+                                      expected.mi,
+                                      "Different TB MI for MCS " << +mcs << " on " << map.size()
+                                                                 << " RBs");
+                NS_TEST_ASSERT_MSG_EQ(tbStats.tbler,
+                                      expected.tbler,
+                                      "Different TB error rate for MCS " << +mcs << " on "
+                                                                         << map.size() << " RBs");
+            }
+        }
+    }
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case checking the TB error rate and MI, and the PCFICH-PDCCH error rate,
+ * returned by the error model against reference values, which were obtained with the
+ * linear searches of the tables previously used by the model.
+ */
+class LteMiErrorModelReferenceTestCase : public TestCase
+{
+  public:
+    LteMiErrorModelReferenceTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Create the sinr values of the test, which vary around the given value
+     * \param sinrDb the mean sinr (dB)
+     * \return the sinr values of 25 RBs
+     */
+    static SpectrumValue CreateSinr(double sinrDb);
+};
+
+LteMiErrorModelReferenceTestCase::LteMiErrorModelReferenceTestCase()
+    : TestCase("TB and PCFICH-PDCCH error rates against reference values")
+{
+}
+
+SpectrumValue
+LteMiErrorModelReferenceTestCase::CreateSinr(double sinrDb)
+{
+    Bands bands;
+    for (uint32_t i = 0; i < 25; i++)
+    {
+        BandInfo bi;
+        bi.fc = 2.12e9 + i * 180e3;
+        bi.fl = bi.fc - 90e3;
+        bi.fh = bi.fc + 90e3;
+        bands.push_back(bi);
+    }
+    SpectrumValue sinr(Create<SpectrumModel>(bands));
+    for (uint32_t i = 0; i < 25; i++)
+    {
+        sinr[i] = std::pow(10.0, (sinrDb + 0.5 * (static_cast<int>(i % 5) - 2)) / 10);
+    }
+    return sinr;
+}
+
+void
+LteMiErrorModelReferenceTestCase::DoRun()
+{
+    /// Reference TB decodification stats
+    struct TbReference
+    {
+        double sinrDb; ///< the mean sinr (dB)
+        uint8_t mcs;   ///< the MCS
+        uint16_t size; ///< the TB size (bytes)
+        uint8_t nRetx; ///< the number of previous transmissions
+        double tbler;  ///< the expected TB error rate
+        double mi;     ///< the expected MI
+    };
+
+    // clang-format off
+    const TbReference tbReferences[] = {
+        {-6,  0,  10,   0, 0.656998992461,    0.1638734},
+        {-3,  4,  80,   0, 0.0708021811722,   0.2941632},
+        {1,   9,  400,  0, 0.979457276649,    0.5638496},
+        {-5,  9,  1500, 1, 0.74669126357,     0.2004452},
+        {4,   10, 80,   0, 0.035051272297,    0.4148872},
+        {8,   16, 1500, 0, 0.951984290272,    0.6455686},
+        {-4,  16, 400,  1, 0.711027540806,    0.1094988},
+        {10,  17, 80,   0, 0.258205963351,    0.517398},
+        {12,  20, 400,  0, 0.420296657937,    0.6076918},
+        {4,   22, 80,   1, 0.549289705431,    0.2621096},
+        {16,  24, 1500, 0, 0.116778992994,    0.8022096},
+        {2,   26, 400,  1, 0.770732072957,    0.1939344},
+        {20,  28, 1500, 0, 0.0179630747016,   0.9506894},
+        {-7,  6,  400,  1, 0.460773024695,    0.1337756},
+        {-10, 0,  10,   2, 0.000371476471563, 0.0711364},
+        {-9,  0,  10,   2, 3.80364508472e-05, 0.0881324},
+    };
+    // clang-format on
+
+    std::vector<int> map;
+    for (int i = 0; i < 25; i++)
+    {
+        map.push_back(i);
+    }
+    for (const auto& ref : tbReferences)
+    {
+        HarqProcessInfoList_t miHistory;
+        for (uint8_t k = 0; k < ref.nRetx; k++)
+        {
+            HarqProcessInfoElement_t el;
+            el.m_mi = 0.3 + 0.1 * k;
+            el.m_rv = k;
+            el.m_infoBits = ref.size * 8;
+            el.m_codeBits = ref.size * 8 * 3;
+            miHistory.push_back(el);
+        }
+        TbStats_t tbStats = LteMiErrorModel::GetTbDecodificationStats(CreateSinr(ref.sinrDb),
+                                                                      map,
+                                                                      ref.size,
+                                                                      ref.mcs,
+                                                                      miHistory);
+        NS_TEST_ASSERT_MSG_EQ_TOL(tbStats.tbler,
+                                  ref.tbler,
+                                  1e-10,
+                                  "Wrong TB error rate for MCS " << +ref.mcs << " at "
+                                                                 << ref.sinrDb << " dB");
+        NS_TEST_ASSERT_MSG_EQ_TOL(tbStats.mi,
+                                  ref.mi,
+                                  1e-10,
+                                  "Wrong MI for MCS " << +ref.mcs << " at " << ref.sinrDb
+                                                      << " dB");
+    }
+
+    /// Reference PCFICH-PDCCH error rates
+    struct PdcchReference
+    {
+        double sinrDb;    ///< the mean sinr (dB)
+        double errorRate; ///< the expected error rate
+    };
+
+    const PdcchReference pdcchReferences[] = {
+        {-12, 0.922602},
+        {-10, 0.82334},
+        {-8, 0.479229},
+        {-6, 0.181449},
+        {-4, 0.037584},
+        {-2, 0.00532283},
+        {-1, 0},
+        {3, 0},
+    };
+
+    for (const auto& ref : pdcchReferences)
+    {
+        NS_TEST_ASSERT_MSG_EQ_TOL(LteMiErrorModel::GetPcfichPdcchError(CreateSinr(ref.sinrDb)),
+                                  ref.errorRate,
+                                  1e-10,
+                                  "Wrong PCFICH-PDCCH error rate at " << ref.sinrDb << " dB");
+    }
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite for the LteMiErrorModel class.
+ */
+class LteMiErrorModelTestSuite : public TestSuite
+{
+  public:
+    LteMiErrorModelTestSuite();
+};
+
+static LteMiErrorModelTestSuite g_lteMiErrorModelTestSuite; ///< the test suite
+
+LteMiErrorModelTestSuite::LteMiErrorModelTestSuite()
+    : TestSuite("lte-mi-error-model", UNIT)
+{
+    AddTestCase(new LteMiErrorModelMiPerRbTestCase, TestCase::QUICK);
+    AddTestCase(new LteMiErrorModelReferenceTestCase, TestCase::QUICK);
+}
@@ -0,0 +1,189 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/integer.h"
+#include "ns3/log.h"
+#include "ns3/lte-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/pointer.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/radio-environment-map-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <fstream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("LteTestRadioEnvironmentMap");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case checking that the REM computed directly from the loss
+ * models of the channel, by tiles and possibly by several threads, is the
+ * same as the REM measured by the RemSpectrumPhy listeners.
+ */
+class LteRadioEnvironmentMapTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param numThreads the number of threads of the direct evaluation
+     * \param rbId the RB for which the REM is generated (-1 for all the RBs)
+     * \param cachedPathloss whether the path loss is computed by a
+     *        CachedPropagationLossModel, which must not be called by several threads
+     */
+    LteRadioEnvironmentMapTestCase(uint32_t numThreads, int32_t rbId, bool cachedPathloss);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Generate a REM of a deployment of three eNBs
+     *
+     * \param directEvaluation the `DirectEvaluation` attribute of the REM helper
+     * \param fileName the name of the output file
+     * \return the points of the REM, each made of the x, y and z coordinates and the SINR
+     */
+    std::vector<std::vector<double>> GenerateRem(bool directEvaluation,
+                                                 const std::string& fileName);
+
+    uint32_t m_numThreads; ///< the number of threads of the direct evaluation
+    int32_t m_rbId;        ///< the RB for which the REM is generated
+    bool m_cachedPathloss; ///< whether the path loss is computed by a CachedPropagationLossModel
+};
+
+LteRadioEnvironmentMapTestCase::LteRadioEnvironmentMapTestCase(uint32_t numThreads,
+                                                               int32_t rbId,
+                                                               bool cachedPathloss)
+    : TestCase("Direct REM evaluation with " + std::to_string(numThreads) + " threads, RbId " +
+               std::to_string(rbId) + (cachedPathloss ? ", cached path loss" : "")),
+      m_numThreads(numThreads),
+      m_rbId(rbId),
+      m_cachedPathloss(cachedPathloss)
+{
+}
+
+std::vector<std::vector<double>>
+LteRadioEnvironmentMapTestCase::GenerateRem(bool directEvaluation, const std::string& fileName)
+{
+    Ptr<LteHelper> lteHelper = CreateObject<LteHelper>();
+    lteHelper->SetEnbAntennaModelType("ns3::CosineAntennaModel");
+    lteHelper->SetEnbAntennaModelAttribute("HorizontalBeamwidth", DoubleValue(120));
+    if (m_cachedPathloss)
+    {
+        Ptr<PropagationLossModel> friis = CreateObject<FriisPropagationLossModel>();
+        lteHelper->SetPathlossModelType(CachedPropagationLossModel::GetTypeId());
+        lteHelper->SetPathlossModelAttribute("LossModel", PointerValue(friis));
+    }
+
+    NodeContainer enbNodes;
+    enbNodes.Create(3);
+    Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
+    positionAlloc->Add(Vector(0, 0, 30));
+    positionAlloc->Add(Vector(300, 0, 30));
+    positionAlloc->Add(Vector(150, 250, 30));
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.Install(enbNodes);
+    lteHelper->InstallEnbDevice(enbNodes);
+
+    // the tiles (or iterations) do not cover the map exactly
+    Ptr<RadioEnvironmentMapHelper> remHelper = CreateObject<RadioEnvironmentMapHelper>();
+    remHelper->SetAttribute("Channel", PointerValue(lteHelper->GetDownlinkSpectrumChannel()));
+    remHelper->SetAttribute("OutputFile", StringValue(fileName));
+    remHelper->SetAttribute("XMin", DoubleValue(-100.0));
+    remHelper->SetAttribute("XMax", DoubleValue(400.0));
+    remHelper->SetAttribute("XRes", UintegerValue(11));
+    remHelper->SetAttribute("YMin", DoubleValue(-100.0));
+    remHelper->SetAttribute("YMax", DoubleValue(350.0));
+    remHelper->SetAttribute("YRes", UintegerValue(7));
+    remHelper->SetAttribute("Z", DoubleValue(1.5));
+    remHelper->SetAttribute("MaxPointsPerIteration", UintegerValue(20));
+    remHelper->SetAttribute("RbId", IntegerValue(m_rbId));
+    remHelper->SetAttribute("DirectEvaluation", BooleanValue(directEvaluation));
+    remHelper->SetAttribute("NumThreads", UintegerValue(m_numThreads));
+    remHelper->Install();
+
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    std::vector<std::vector<double>> points;
+    std::ifstream file(fileName);
+    std::vector<double> point(4);
+    while (file >> point[0] >> point[1] >> point[2] >> point[3])
+    {
+        points.push_back(point);
+    }
+    return points;
+}
+
+void
+LteRadioEnvironmentMapTestCase::DoRun()
+{
+    std::vector<std::vector<double>> rem = GenerateRem(false, CreateTempDirFilename("rem.out"));
+    std::vector<std::vector<double>> directRem =
+        GenerateRem(true, CreateTempDirFilename("direct-rem.out"));
+
+    NS_TEST_ASSERT_MSG_EQ(rem.size(), 11 * 7, "Unexpected number of points in the REM");
+    NS_TEST_ASSERT_MSG_EQ(directRem.size(), rem.size(), "Unexpected number of points");
+    for (std::size_t i = 0; i < rem.size(); ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(directRem[i][0], rem[i][0], "Unexpected x of point " << i);
+        NS_TEST_ASSERT_MSG_EQ(directRem[i][1], rem[i][1], "Unexpected y of point " << i);
+        NS_TEST_ASSERT_MSG_EQ(directRem[i][2], rem[i][2], "Unexpected z of point " << i);
+        NS_TEST_ASSERT_MSG_GT(rem[i][3], 0, "No signal received at point " << i);
+        // the SINR is written with 6 significant digits
+        NS_TEST_ASSERT_MSG_EQ_TOL(directRem[i][3],
+                                  rem[i][3],
+                                  rem[i][3] * 1e-5,
+                                  "Unexpected SINR of point " << i);
+    }
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite for the RadioEnvironmentMapHelper class.
+ */
+class LteRadioEnvironmentMapTestSuite : public TestSuite
+{
+  public:
+    LteRadioEnvironmentMapTestSuite();
+};
+
+static LteRadioEnvironmentMapTestSuite g_lteRadioEnvironmentMapTestSuite; ///< the test suite
+
+LteRadioEnvironmentMapTestSuite::LteRadioEnvironmentMapTestSuite()
+    : TestSuite("lte-radio-environment-map", SYSTEM)
+{
+    AddTestCase(new LteRadioEnvironmentMapTestCase(1, -1, false), TestCase::QUICK);
+    AddTestCase(new LteRadioEnvironmentMapTestCase(3, -1, false), TestCase::QUICK);
+    AddTestCase(new LteRadioEnvironmentMapTestCase(2, 10, false), TestCase::QUICK);
+    AddTestCase(new LteRadioEnvironmentMapTestCase(3, -1, true), TestCase::QUICK);
+}
@@ -0,0 +1,252 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "spatial-grid-index.h"
+
+#include "mobility-model.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SpatialGridIndex");
+
+SpatialGridIndex::SpatialGridIndex()
+    : m_cellSize(100),
+      m_maxSpeed(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+SpatialGridIndex::~SpatialGridIndex()
+{
+    NS_LOG_FUNCTION(this);
+    Clear();
+}
+
+void
+SpatialGridIndex::SetCellSize(double size)
+{
+    NS_LOG_FUNCTION(this << size);
+    NS_ASSERT_MSG(size > 0, "The cells of the grid must have a positive size");
+    Clear();
+    m_cellSize = size;
+}
+
+double
+SpatialGridIndex::GetCellSize() const
+{
+    return m_cellSize;
+}
+
+std::size_t
+SpatialGridIndex::Add(Ptr<MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    NS_ASSERT(mobility);
+    if (m_items.empty())
+    {
+        m_maxSpeed = 0;
+        m_lastRefresh = Simulator::Now();
+    }
+    std::size_t id = m_items.size();
+    m_items.push_back({mobility, 0, false, Vector(), Vector(), Time()});
+    auto& items = m_itemsByMobility[PeekPointer(mobility)];
+    if (items.empty())
+    {
+        mobility->TraceConnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&SpatialGridIndex::CourseChanged, this));
+    }
+    items.push_back(id);
+    Bin(id, true);
+    return id;
+}
+
+void
+SpatialGridIndex::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& mobilityItems : m_itemsByMobility)
+    {
+        m_items[mobilityItems.second.front()].mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&SpatialGridIndex::CourseChanged, this));
+    }
+    m_itemsByMobility.clear();
+    m_items.clear();
+    m_cells.clear();
+    m_maxSpeed = 0;
+}
+
+std::size_t
+SpatialGridIndex::GetNItems() const
+{
+    return m_items.size();
+}
+
+SpatialGridIndex::CellId
+SpatialGridIndex::MakeCellId(int32_t x, int32_t y)
+{
+    return (static_cast<CellId>(x) << 32) | static_cast<uint32_t>(y);
+}
+
+int32_t
+SpatialGridIndex::GetCellCoordinate(double value) const
+{
+    double cell = std::floor(value / m_cellSize);
+    cell = std::max(cell, static_cast<double>(std::numeric_limits<int32_t>::min()));
+    cell = std::min(cell, static_cast<double>(std::numeric_limits<int32_t>::max()));
+    return static_cast<int32_t>(cell);
+}
+
+void
+SpatialGridIndex::Bin(std::size_t id, bool insert)
+{
+    Item& item = m_items[id];
+    item.position = item.mobility->GetPosition();
+    item.velocity = item.mobility->GetVelocity();
+    item.time = Simulator::Now();
+    double speed = item.velocity.GetLength();
+    item.moving = (speed > 0);
+    m_maxSpeed = std::max(m_maxSpeed, speed);
+    Move(id, item.position, insert);
+}
+
+void
+SpatialGridIndex::Move(std::size_t id, const Vector& position, bool insert)
+{
+    Item& item = m_items[id];
+    CellId cell = MakeCellId(GetCellCoordinate(position.x), GetCellCoordinate(position.y));
+    if (!insert)
+    {
+        if (cell == item.cell)
+        {
+            return;
+        }
+        auto& oldCell = m_cells[item.cell];
+        auto it = std::find(oldCell.begin(), oldCell.end(), id);
+        NS_ASSERT(it != oldCell.end());
+        *it = oldCell.back();
+        oldCell.pop_back();
+        if (oldCell.empty())
+        {
+            m_cells.erase(item.cell);
+        }
+    }
+    item.cell = cell;
+    m_cells[cell].push_back(id);
+}
+
+void
+SpatialGridIndex::Refresh()
+{
+    if (m_maxSpeed == 0)
+    {
+        return;
+    }
+    Time now = Simulator::Now();
+    if (m_maxSpeed * (now - m_lastRefresh).GetSeconds() <= m_cellSize / 2)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+    m_maxSpeed = 0;
+    m_lastRefresh = now;
+    for (std::size_t id = 0; id < m_items.size(); ++id)
+    {
+        const Item& item = m_items[id];
+        if (item.moving)
+        {
+            double elapsed = (now - item.time).GetSeconds();
+            Vector position(item.position.x + item.velocity.x * elapsed,
+                            item.position.y + item.velocity.y * elapsed,
+                            item.position.z + item.velocity.z * elapsed);
+            m_maxSpeed = std::max(m_maxSpeed, item.velocity.GetLength());
+            Move(id, position, false);
+        }
+    }
+}
+
+void
+SpatialGridIndex::CourseChanged(Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    auto it = m_itemsByMobility.find(PeekPointer(mobility));
+    if (it == m_itemsByMobility.end())
+    {
+        return;
+    }
+    for (auto id : it->second)
+    {
+        Bin(id, false);
+    }
+}
+
+void
+SpatialGridIndex::GetCandidates(const Vector& position,
+                                double range,
+                                std::vector<std::size_t>& candidates)
+{
+    NS_LOG_FUNCTION(this << position << range);
+    Refresh();
+    // items binned before the last refresh may have moved since then
+    double reach = range + m_maxSpeed * (Simulator::Now() - m_lastRefresh).GetSeconds();
+    int32_t xMin = GetCellCoordinate(position.x - reach);
+    int32_t xMax = GetCellCoordinate(position.x + reach);
+    int32_t yMin = GetCellCoordinate(position.y - reach);
+    int32_t yMax = GetCellCoordinate(position.y + reach);
+
+    std::size_t first = candidates.size();
+    double nCells = (static_cast<double>(xMax) - xMin + 1) * (static_cast<double>(yMax) - yMin + 1);
+    if (nCells < m_cells.size())
+    {
+        for (int32_t x = xMin; x <= xMax; ++x)
+        {
+            for (int32_t y = yMin; y <= yMax; ++y)
+            {
+                auto it = m_cells.find(MakeCellId(x, y));
+                if (it != m_cells.end())
+                {
+                    candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+                }
+            }
+        }
+    }
+    else
+    {
+        // the query covers more cells than are occupied: scan the occupied ones
+        for (const auto& cell : m_cells)
+        {
+            auto x = static_cast<int32_t>(cell.first >> 32);
+            auto y = static_cast<int32_t>(static_cast<uint32_t>(cell.first));
+            if (x >= xMin && x <= xMax && y >= yMin && y <= yMax)
+            {
+                candidates.insert(candidates.end(), cell.second.begin(), cell.second.end());
+            }
+        }
+    }
+    std::sort(candidates.begin() + first, candidates.end());
+    NS_LOG_DEBUG(candidates.size() - first << " candidates out of " << m_items.size());
+}
+
+} // namespace ns3
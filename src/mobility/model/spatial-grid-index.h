@@ -0,0 +1,185 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef SPATIAL_GRID_INDEX_H
+#define SPATIAL_GRID_INDEX_H
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+class MobilityModel;
+
+/**
+ * \ingroup mobility
+ *
+ * \brief Uniform grid over the x-y plane, used to find the objects that
+ * may be located within a given distance of a point.
+ *
+ * Each item is an integer identifier (assigned by Add(), starting from 0)
+ * associated with a MobilityModel. Items are binned in square cells
+ * according to their position, and GetCandidates() returns the items of
+ * the cells overlapping the square enclosing the queried disc: the result
+ * is a superset of the items within range, which the caller is expected to
+ * filter with the exact distance (or whatever metric it is interested in).
+ * The z coordinate is ignored.
+ *
+ * The index does not poll the positions of the items. It follows the
+ * CourseChange trace of their mobility models, and relies on the contract
+ * of MobilityModel: between two course changes, an object moves at most
+ * at the velocity reported by the model at the last course change. Items
+ * with a non-zero velocity drift away from the cell in which they were
+ * binned; the index accounts for this by widening the queries by the
+ * largest distance an item may have travelled since the last time the
+ * moving items were binned again, and bins them again once this margin
+ * exceeds half a cell. The moving items are binned again at the position
+ * extrapolated from their last course change: the mobility models are only
+ * queried when the items are added and when they change course, since
+ * querying some models (e.g., ConstantVelocityMobilityModel) updates their
+ * position, which would change the rounding errors of the simulation.
+ */
+class SpatialGridIndex
+{
+  public:
+    SpatialGridIndex();
+    ~SpatialGridIndex();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    SpatialGridIndex(const SpatialGridIndex&) = delete;
+    SpatialGridIndex& operator=(const SpatialGridIndex&) = delete;
+
+    /**
+     * \brief Set the side of the cells of the grid
+     *
+     * The index is cleared. The best performance is usually obtained with
+     * cells roughly as large as the range of the queries.
+     *
+     * \param size the side of the cells, in meters (strictly positive)
+     */
+    void SetCellSize(double size);
+
+    /**
+     * \return the side of the cells of the grid, in meters
+     */
+    double GetCellSize() const;
+
+    /**
+     * \brief Add an item to the index
+     *
+     * Several items may share the same mobility model.
+     *
+     * \param mobility the mobility model of the item
+     * \return the identifier of the item (the number of items already in the index)
+     */
+    std::size_t Add(Ptr<MobilityModel> mobility);
+
+    /**
+     * \brief Remove all the items and stop following their mobility models
+     */
+    void Clear();
+
+    /**
+     * \return the number of items in the index
+     */
+    std::size_t GetNItems() const;
+
+    /**
+     * \brief Get the items that may be located within a distance of a point
+     *
+     * The identifiers are appended to the candidates in increasing order.
+     *
+     * \param position the center of the query
+     * \param range the distance, in meters
+     * \param candidates the vector to which the identifiers are appended
+     */
+    void GetCandidates(const Vector& position,
+                       double range,
+                       std::vector<std::size_t>& candidates);
+
+  private:
+    /// Identifier of a cell, packing its two integer coordinates
+    using CellId = int64_t;
+
+    /**
+     * \brief An item of the index
+     */
+    struct Item
+    {
+        Ptr<MobilityModel> mobility; //!< Mobility model of the item
+        CellId cell;                 //!< Cell in which the item is binned
+        bool moving;                 //!< The item had a non-zero velocity when binned
+        Vector position;             //!< Position at the last course change
+        Vector velocity;             //!< Velocity at the last course change
+        Time time;                   //!< Time of the last course change
+    };
+
+    /**
+     * \param x the x coordinate of the cell
+     * \param y the y coordinate of the cell
+     * \return the identifier of the cell
+     */
+    static CellId MakeCellId(int32_t x, int32_t y);
+
+    /**
+     * \param value a coordinate, in meters
+     * \return the coordinate of the cell containing it
+     */
+    int32_t GetCellCoordinate(double value) const;
+
+    /**
+     * \brief Bin an item according to the current state of its mobility model
+     * \param id the identifier of the item
+     * \param insert true if the item is not binned yet
+     */
+    void Bin(std::size_t id, bool insert);
+
+    /**
+     * \brief Bin an item in the cell containing a position
+     * \param id the identifier of the item
+     * \param position the position of the item
+     * \param insert true if the item is not binned yet
+     */
+    void Move(std::size_t id, const Vector& position, bool insert);
+
+    /**
+     * \brief Bin again the moving items, if they may have drifted too far
+     */
+    void Refresh();
+
+    /**
+     * \brief Callback invoked on the course change of a mobility model
+     * \param mobility the mobility model
+     */
+    void CourseChanged(Ptr<const MobilityModel> mobility);
+
+    double m_cellSize;                                   //!< Side of the cells
+    std::vector<Item> m_items;                           //!< Items, by identifier
+    std::unordered_map<CellId, std::vector<std::size_t>> m_cells; //!< Items, by cell
+    std::unordered_map<const MobilityModel*, std::vector<std::size_t>>
+        m_itemsByMobility; //!< Items, by mobility model
+    double m_maxSpeed;     //!< Largest speed of an item since the last refresh
+    Time m_lastRefresh;    //!< Time the moving items were last binned
+    bool m_moving;         //!< At least one item moved since the last refresh
+};
+
+} // namespace ns3
+
+#endif /* SPATIAL_GRID_INDEX_H */
@@ -0,0 +1,357 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/double.h"
+#include "ns3/mobility-model.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/spatial-grid-index.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace ns3;
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Mobility model moving at a constant velocity, which counts the
+ * queries of its position
+ */
+class CountingMobilityModel : public MobilityModel
+{
+  public:
+    /**
+     * Register this type.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    CountingMobilityModel();
+
+    /**
+     * Change the velocity, notifying a course change
+     * \param velocity the new velocity
+     */
+    void SetVelocity(const Vector& velocity);
+
+    /**
+     * \return the current position, without counting the query
+     */
+    Vector GetActualPosition() const;
+
+    /**
+     * \return the number of queries of the position
+     */
+    uint32_t GetNQueries() const;
+
+  private:
+    Vector DoGetPosition() const override;
+    void DoSetPosition(const Vector& position) override;
+    Vector DoGetVelocity() const override;
+
+    Vector m_position;           ///< position at the last course change
+    Vector m_velocity;           ///< velocity
+    Time m_time;                 ///< time of the last course change
+    mutable uint32_t m_nQueries; ///< number of queries of the position
+};
+
+TypeId
+CountingMobilityModel::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::CountingMobilityModel")
+                            .SetParent<MobilityModel>()
+                            .SetGroupName("Mobility")
+                            .AddConstructor<CountingMobilityModel>();
+    return tid;
+}
+
+CountingMobilityModel::CountingMobilityModel()
+    : m_nQueries(0)
+{
+}
+
+void
+CountingMobilityModel::SetVelocity(const Vector& velocity)
+{
+    m_position = GetActualPosition();
+    m_velocity = velocity;
+    m_time = Simulator::Now();
+    NotifyCourseChange();
+}
+
+Vector
+CountingMobilityModel::GetActualPosition() const
+{
+    double elapsed = (Simulator::Now() - m_time).GetSeconds();
+    return Vector(m_position.x + m_velocity.x * elapsed,
+                  m_position.y + m_velocity.y * elapsed,
+                  m_position.z + m_velocity.z * elapsed);
+}
+
+uint32_t
+CountingMobilityModel::GetNQueries() const
+{
+    return m_nQueries;
+}
+
+Vector
+CountingMobilityModel::DoGetPosition() const
+{
+    ++m_nQueries;
+    return GetActualPosition();
+}
+
+void
+CountingMobilityModel::DoSetPosition(const Vector& position)
+{
+    m_position = position;
+    m_time = Simulator::Now();
+    NotifyCourseChange();
+}
+
+Vector
+CountingMobilityModel::DoGetVelocity() const
+{
+    return m_velocity;
+}
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Check that the candidates returned by SpatialGridIndex include all
+ * the items within range, and only items of the cells close to the query
+ */
+class SpatialGridIndexStaticTestCase : public TestCase
+{
+  public:
+    SpatialGridIndexStaticTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+SpatialGridIndexStaticTestCase::SpatialGridIndexStaticTestCase()
+    : TestCase("Check the candidates of a SpatialGridIndex with static items")
+{
+}
+
+void
+SpatialGridIndexStaticTestCase::DoRun()
+{
+    const double cellSize = 10;
+    auto coordinate = CreateObject<UniformRandomVariable>();
+    coordinate->SetAttribute("Min", DoubleValue(-100));
+    coordinate->SetAttribute("Max", DoubleValue(100));
+    coordinate->SetStream(1);
+
+    SpatialGridIndex index;
+    index.SetCellSize(cellSize);
+    std::vector<Ptr<CountingMobilityModel>> models;
+    for (std::size_t i = 0; i < 200; ++i)
+    {
+        auto mobility = CreateObject<CountingMobilityModel>();
+        mobility->SetPosition(Vector(coordinate->GetValue(), coordinate->GetValue(), 0));
+        NS_TEST_ASSERT_MSG_EQ(index.Add(mobility), i, "Unexpected identifier");
+        models.push_back(mobility);
+    }
+    NS_TEST_ASSERT_MSG_EQ(index.GetNItems(), models.size(), "Unexpected number of items");
+
+    for (std::size_t query = 0; query < 50; ++query)
+    {
+        Vector center(coordinate->GetValue(), coordinate->GetValue(), 0);
+        for (double range : {5.0, 15.0, 40.0, 500.0})
+        {
+            // the candidates are appended to the vector
+            std::vector<std::size_t> candidates{models.size()};
+            index.GetCandidates(center, range, candidates);
+            NS_TEST_ASSERT_MSG_EQ(candidates.front(), models.size(), "Vector not appended to");
+            NS_TEST_ASSERT_MSG_EQ(std::is_sorted(candidates.begin() + 1, candidates.end()),
+                                  true,
+                                  "Candidates not in increasing order");
+            for (std::size_t id = 0; id < models.size(); ++id)
+            {
+                Vector position = models[id]->GetActualPosition();
+                bool isCandidate =
+                    std::binary_search(candidates.begin() + 1, candidates.end(), id);
+                if (CalculateDistance(position, center) <= range)
+                {
+                    NS_TEST_ASSERT_MSG_EQ(isCandidate, true, "Item " << id << " within range");
+                }
+                if (isCandidate)
+                {
+                    // the cell of a candidate overlaps the square enclosing the disc
+                    NS_TEST_ASSERT_MSG_LT_OR_EQ(std::abs(position.x - center.x),
+                                                range + cellSize,
+                                                "Item " << id << " too far");
+                    NS_TEST_ASSERT_MSG_LT_OR_EQ(std::abs(position.y - center.y),
+                                                range + cellSize,
+                                                "Item " << id << " too far");
+                }
+            }
+        }
+    }
+
+    // the positions are only queried when the items are added
+    for (const auto& mobility : models)
+    {
+        NS_TEST_ASSERT_MSG_EQ(mobility->GetNQueries(), 1, "Unexpected queries of the position");
+    }
+    index.Clear();
+    NS_TEST_ASSERT_MSG_EQ(index.GetNItems(), 0, "Index not cleared");
+}
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Check that SpatialGridIndex follows moving items and their course
+ * changes, without querying their positions besides the course changes
+ */
+class SpatialGridIndexMovingTestCase : public TestCase
+{
+  public:
+    SpatialGridIndexMovingTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// Check the candidates of a few queries against the actual positions
+    void Check();
+
+    /// Change the course of some items: new velocities and jumps
+    void ChangeCourses();
+
+    SpatialGridIndex m_index;                         ///< index under test
+    std::vector<Ptr<CountingMobilityModel>> m_models; ///< models of the items
+    std::vector<uint32_t> m_nCourseChanges;           ///< course changes, by item
+    Ptr<UniformRandomVariable> m_random;              ///< random variable
+};
+
+SpatialGridIndexMovingTestCase::SpatialGridIndexMovingTestCase()
+    : TestCase("Check the candidates of a SpatialGridIndex with moving items")
+{
+}
+
+void
+SpatialGridIndexMovingTestCase::Check()
+{
+    for (std::size_t query = 0; query < 10; ++query)
+    {
+        Vector center(m_random->GetValue(-100, 100), m_random->GetValue(-100, 100), 0);
+        double range = m_random->GetValue(1, 50);
+        std::vector<std::size_t> candidates;
+        m_index.GetCandidates(center, range, candidates);
+        for (std::size_t id = 0; id < m_models.size(); ++id)
+        {
+            if (CalculateDistance(m_models[id]->GetActualPosition(), center) <= range)
+            {
+                NS_TEST_ASSERT_MSG_EQ(std::binary_search(candidates.begin(), candidates.end(), id),
+                                      true,
+                                      "Item " << id << " within range at "
+                                              << Simulator::Now().As(Time::S));
+            }
+        }
+    }
+}
+
+void
+SpatialGridIndexMovingTestCase::ChangeCourses()
+{
+    for (std::size_t id = 0; id < m_models.size(); id += 3)
+    {
+        if (id % 2)
+        {
+            m_models[id]->SetVelocity(
+                Vector(m_random->GetValue(-20, 20), m_random->GetValue(-20, 20), 0));
+        }
+        else
+        {
+            m_models[id]->SetPosition(
+                Vector(m_random->GetValue(-100, 100), m_random->GetValue(-100, 100), 0));
+        }
+        ++m_nCourseChanges[id];
+    }
+}
+
+void
+SpatialGridIndexMovingTestCase::DoRun()
+{
+    m_random = CreateObject<UniformRandomVariable>();
+    m_random->SetStream(2);
+    m_index.SetCellSize(10);
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        auto mobility = CreateObject<CountingMobilityModel>();
+        mobility->SetPosition(
+            Vector(m_random->GetValue(-100, 100), m_random->GetValue(-100, 100), 0));
+        if (i % 4)
+        {
+            mobility->SetVelocity(
+                Vector(m_random->GetValue(-10, 10), m_random->GetValue(-10, 10), 0));
+        }
+        m_index.Add(mobility);
+        m_models.push_back(mobility);
+        m_nCourseChanges.push_back(0);
+    }
+
+    for (int64_t ms = 0; ms <= 20000; ms += 250)
+    {
+        Simulator::Schedule(MilliSeconds(ms), &SpatialGridIndexMovingTestCase::Check, this);
+    }
+    for (int64_t ms = 3100; ms <= 20000; ms += 3100)
+    {
+        Simulator::Schedule(MilliSeconds(ms),
+                            &SpatialGridIndexMovingTestCase::ChangeCourses,
+                            this);
+    }
+    Simulator::Run();
+
+    // the positions are only queried when the items are added and change course
+    for (std::size_t id = 0; id < m_models.size(); ++id)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_models[id]->GetNQueries(),
+                              1 + m_nCourseChanges[id],
+                              "Unexpected queries of the position of item " << id);
+    }
+
+    m_index.Clear();
+    m_models.clear();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief SpatialGridIndex TestSuite
+ */
+class SpatialGridIndexTestSuite : public TestSuite
+{
+  public:
+    SpatialGridIndexTestSuite();
+};
+
+SpatialGridIndexTestSuite::SpatialGridIndexTestSuite()
+    : TestSuite("spatial-grid-index", UNIT)
+{
+    AddTestCase(new SpatialGridIndexStaticTestCase, TestCase::QUICK);
+    AddTestCase(new SpatialGridIndexMovingTestCase, TestCase::QUICK);
+}
+
+static SpatialGridIndexTestSuite g_spatialGridIndexTestSuite; ///< the test suite
@@ -242,6 +242,20 @@ operator<(const Address& a, const Address& b)
     return false;
 }
 
+size_t
+AddressHash::operator()(const Address& x) const
+{
+    uint8_t buffer[Address::MAX_SIZE];
+    uint32_t len = x.CopyTo(buffer);
+    // FNV-1a, fast enough for short link-layer addresses
+    size_t hash = 2166136261U;
+    for (uint32_t i = 0; i < len; i++)
+    {
+        hash = (hash ^ buffer[i]) * 16777619U;
+    }
+    return hash;
+}
+
 std::ostream&
 operator<<(std::ostream& os, const Address& address)
 {
@@ -287,6 +287,26 @@ class Address
 
 ATTRIBUTE_HELPER_HEADER(Address);
 
+/**
+ * \ingroup address
+ *
+ * \brief Class providing an hash for generic addresses
+ *
+ * The address type is not hashed, consistently with operator== which
+ * considers equal two addresses of different types if one of them has
+ * type zero.
+ */
+class AddressHash
+{
+  public:
+    /**
+     * \brief Returns the hash of an address.
+     * \param x the address
+     * \return the hash
+     */
+    size_t operator()(const Address& x) const;
+};
+
 bool operator==(const Address& a, const Address& b);
 bool operator!=(const Address& a, const Address& b);
 bool operator<(const Address& a, const Address& b);
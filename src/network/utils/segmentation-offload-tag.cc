@@ -0,0 +1,116 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "segmentation-offload-tag.h"
+
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SegmentationOffloadTag");
+
+NS_OBJECT_ENSURE_REGISTERED(SegmentationOffloadTag);
+
+TypeId
+SegmentationOffloadTag::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::SegmentationOffloadTag")
+                            .SetParent<Tag>()
+                            .SetGroupName("Network")
+                            .AddConstructor<SegmentationOffloadTag>();
+    return tid;
+}
+
+TypeId
+SegmentationOffloadTag::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+uint32_t
+SegmentationOffloadTag::GetSerializedSize() const
+{
+    return 8;
+}
+
+void
+SegmentationOffloadTag::Serialize(TagBuffer buf) const
+{
+    buf.WriteU32(m_segmentSize);
+    buf.WriteU32(m_payloadSize);
+}
+
+void
+SegmentationOffloadTag::Deserialize(TagBuffer buf)
+{
+    m_segmentSize = buf.ReadU32();
+    m_payloadSize = buf.ReadU32();
+}
+
+void
+SegmentationOffloadTag::Print(std::ostream& os) const
+{
+    os << "SegmentSize=" << m_segmentSize << " PayloadSize=" << m_payloadSize;
+}
+
+SegmentationOffloadTag::SegmentationOffloadTag()
+    : Tag(),
+      m_segmentSize(0),
+      m_payloadSize(0)
+{
+}
+
+SegmentationOffloadTag::SegmentationOffloadTag(uint32_t segmentSize, uint32_t payloadSize)
+    : Tag(),
+      m_segmentSize(segmentSize),
+      m_payloadSize(payloadSize)
+{
+}
+
+void
+SegmentationOffloadTag::SetSegmentSize(uint32_t segmentSize)
+{
+    m_segmentSize = segmentSize;
+}
+
+uint32_t
+SegmentationOffloadTag::GetSegmentSize() const
+{
+    return m_segmentSize;
+}
+
+void
+SegmentationOffloadTag::SetPayloadSize(uint32_t payloadSize)
+{
+    m_payloadSize = payloadSize;
+}
+
+uint32_t
+SegmentationOffloadTag::GetPayloadSize() const
+{
+    return m_payloadSize;
+}
+
+uint32_t
+SegmentationOffloadTag::GetSegmentCount() const
+{
+    if (m_segmentSize == 0 || m_payloadSize == 0)
+    {
+        return 1;
+    }
+    return (m_payloadSize + m_segmentSize - 1) / m_segmentSize;
+}
+
+} // namespace ns3
@@ -0,0 +1,86 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef SEGMENTATION_OFFLOAD_TAG_H
+#define SEGMENTATION_OFFLOAD_TAG_H
+
+#include "ns3/tag.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup network
+ *
+ * \brief Marks a packet as a super-segment carrying several MSS-sized
+ * transport segments (segmentation offload).
+ *
+ * The tag is attached by the transport layer to a packet whose payload
+ * spans more than one segment, so that the costs of the transport layer
+ * are paid once for the whole packet. The packet is split into
+ * GetSegmentCount () segments, each carrying a copy of the transport
+ * header, before being handed to the network layer, hence the network
+ * layer, the devices and the routers only see regular segments.
+ */
+class SegmentationOffloadTag : public Tag
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    uint32_t GetSerializedSize() const override;
+    void Serialize(TagBuffer buf) const override;
+    void Deserialize(TagBuffer buf) override;
+    void Print(std::ostream& os) const override;
+    SegmentationOffloadTag();
+
+    /**
+     * Constructs a SegmentationOffloadTag
+     *
+     * \param segmentSize the maximum payload size of each segment
+     * \param payloadSize the total payload size of the super-segment
+     */
+    SegmentationOffloadTag(uint32_t segmentSize, uint32_t payloadSize);
+    /**
+     * \param segmentSize the maximum payload size of each segment
+     */
+    void SetSegmentSize(uint32_t segmentSize);
+    /**
+     * \returns the maximum payload size of each segment
+     */
+    uint32_t GetSegmentSize() const;
+    /**
+     * \param payloadSize the total payload size of the super-segment
+     */
+    void SetPayloadSize(uint32_t payloadSize);
+    /**
+     * \returns the total payload size of the super-segment
+     */
+    uint32_t GetPayloadSize() const;
+    /**
+     * \returns the number of segments the payload is split into
+     */
+    uint32_t GetSegmentCount() const;
+
+  private:
+    uint32_t m_segmentSize; //!< maximum payload size of each segment
+    uint32_t m_payloadSize; //!< total payload size of the super-segment
+};
+
+} // namespace ns3
+
+#endif /* SEGMENTATION_OFFLOAD_TAG_H */
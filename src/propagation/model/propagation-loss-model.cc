@@ -26,6 +26,7 @@
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
+#include "ns3/node.h"
 #include "ns3/pointer.h"
 #include "ns3/string.h"
 
@@ -956,4 +957,167 @@ RangePropagationLossModel::DoAssignStreams(int64_t stream)
 
 // ------------------------------------------------------------------------- //
 
+NS_OBJECT_ENSURE_REGISTERED(CachedPropagationLossModel);
+
+TypeId
+CachedPropagationLossModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CachedPropagationLossModel")
+            .SetParent<PropagationLossModel>()
+            .SetGroupName("Propagation")
+            .AddConstructor<CachedPropagationLossModel>()
+            .AddAttribute("LossModel",
+                          "The propagation loss model whose losses are cached.",
+                          PointerValue(),
+                          MakePointerAccessor(&CachedPropagationLossModel::SetLossModel,
+                                              &CachedPropagationLossModel::GetLossModel),
+                          MakePointerChecker<PropagationLossModel>());
+    return tid;
+}
+
+CachedPropagationLossModel::CachedPropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+CachedPropagationLossModel::~CachedPropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+CachedPropagationLossModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    Clear();
+    m_lossModel = nullptr;
+    PropagationLossModel::DoDispose();
+}
+
+void
+CachedPropagationLossModel::SetLossModel(Ptr<PropagationLossModel> lossModel)
+{
+    NS_LOG_FUNCTION(this << lossModel);
+    m_lossModel = lossModel;
+    m_cache.clear();
+}
+
+Ptr<PropagationLossModel>
+CachedPropagationLossModel::GetLossModel() const
+{
+    return m_lossModel;
+}
+
+void
+CachedPropagationLossModel::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& mobility : m_tracked)
+    {
+        if (mobility)
+        {
+            mobility->TraceDisconnectWithoutContext(
+                "CourseChange",
+                MakeCallback(&CachedPropagationLossModel::CourseChanged, this));
+        }
+    }
+    m_tracked.clear();
+    m_generations.clear();
+    m_cache.clear();
+}
+
+uint64_t
+CachedPropagationLossModel::GetCacheHits() const
+{
+    return m_hits;
+}
+
+uint64_t
+CachedPropagationLossModel::GetCacheMisses() const
+{
+    return m_misses;
+}
+
+void
+CachedPropagationLossModel::Track(Ptr<MobilityModel> mobility, uint32_t nodeId) const
+{
+    if (nodeId >= m_tracked.size())
+    {
+        m_tracked.resize(nodeId + 1);
+        m_generations.resize(nodeId + 1, 0);
+    }
+    if (m_tracked[nodeId] == mobility)
+    {
+        return;
+    }
+    NS_LOG_DEBUG("Tracking the position of node " << nodeId);
+    if (m_tracked[nodeId])
+    {
+        // a different mobility model has been aggregated to the node
+        m_tracked[nodeId]->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&CachedPropagationLossModel::CourseChanged, this));
+        m_generations[nodeId]++;
+    }
+    mobility->TraceConnectWithoutContext(
+        "CourseChange",
+        MakeCallback(&CachedPropagationLossModel::CourseChanged, this));
+    m_tracked[nodeId] = mobility;
+}
+
+void
+CachedPropagationLossModel::CourseChanged(Ptr<const MobilityModel> mobility) const
+{
+    auto node = mobility->GetObject<Node>();
+    NS_ASSERT(node);
+    NS_LOG_DEBUG("Invalidating the losses of node " << node->GetId());
+    NS_ASSERT(node->GetId() < m_generations.size());
+    m_generations[node->GetId()]++;
+}
+
+double
+CachedPropagationLossModel::DoCalcRxPower(double txPowerDbm,
+                                          Ptr<MobilityModel> a,
+                                          Ptr<MobilityModel> b) const
+{
+    NS_ASSERT_MSG(m_lossModel, "The LossModel attribute has not been set");
+
+    auto nodeA = a->GetObject<Node>();
+    auto nodeB = b->GetObject<Node>();
+    if (!nodeA || !nodeB || a->GetVelocity() != Vector() || b->GetVelocity() != Vector())
+    {
+        // the position of the nodes may change without notification, do not cache
+        return m_lossModel->CalcRxPower(txPowerDbm, a, b);
+    }
+
+    uint32_t idA = nodeA->GetId();
+    uint32_t idB = nodeB->GetId();
+    Track(a, idA);
+    Track(b, idB);
+
+    uint64_t key = (static_cast<uint64_t>(idA) << 32) | idB;
+    auto it = m_cache.find(key);
+    if (it != m_cache.end() && it->second.genA == m_generations[idA] &&
+        it->second.genB == m_generations[idB])
+    {
+        m_hits++;
+        return txPowerDbm - it->second.loss;
+    }
+
+    m_misses++;
+    double loss = txPowerDbm - m_lossModel->CalcRxPower(txPowerDbm, a, b);
+    NS_LOG_DEBUG("Caching loss " << loss << " dB from node " << idA << " to node " << idB);
+    m_cache[key] = {loss, m_generations[idA], m_generations[idB]};
+    return txPowerDbm - loss;
+}
+
+int64_t
+CachedPropagationLossModel::DoAssignStreams(int64_t stream)
+{
+    return m_lossModel ? m_lossModel->AssignStreams(stream) : 0;
+}
+
+// ------------------------------------------------------------------------- //
+
 } // namespace ns3
@@ -28,6 +28,8 @@
 #include "ns3/random-variable-stream.h"
 
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -782,6 +784,113 @@ class RangePropagationLossModel : public PropagationLossModel
     double m_range; //!< Maximum Transmission Range (meters)
 };
 
+/**
+ * \ingroup propagation
+ *
+ * \brief Cache the propagation loss computed by another model between static nodes.
+ *
+ * This model wraps a chain of propagation loss models (set through the LossModel
+ * attribute) and stores the loss it returns for each ordered pair of nodes, keyed
+ * by node id. As long as neither node moves, subsequent calls return the cached
+ * loss without invoking the wrapped models, which saves the repeated evaluation of
+ * the same path loss for every transmission in topologies where most nodes are
+ * static.
+ *
+ * The cached losses involving a node are invalidated when the CourseChange trace
+ * source of its mobility model fires. The loss is never cached for nodes having a
+ * non-zero velocity (whose position changes without notification) nor for mobility
+ * models that are not aggregated to a node.
+ *
+ * The wrapped models must be deterministic (e.g., no fading or random shadowing
+ * drawn at every call) and the loss they introduce must not depend on the transmit
+ * power. The same instance can be installed on several channels to share the cache.
+ */
+class CachedPropagationLossModel : public PropagationLossModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    CachedPropagationLossModel();
+    ~CachedPropagationLossModel() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    CachedPropagationLossModel(const CachedPropagationLossModel&) = delete;
+    CachedPropagationLossModel& operator=(const CachedPropagationLossModel&) = delete;
+
+    /**
+     * \param lossModel the propagation loss model whose losses are cached
+     */
+    void SetLossModel(Ptr<PropagationLossModel> lossModel);
+
+    /**
+     * \return the propagation loss model whose losses are cached
+     */
+    Ptr<PropagationLossModel> GetLossModel() const;
+
+    /**
+     * Remove all the cached losses.
+     */
+    void Clear();
+
+    /**
+     * \return the number of losses that have been returned from the cache
+     */
+    uint64_t GetCacheHits() const;
+
+    /**
+     * \return the number of losses that have been computed by the wrapped model
+     */
+    uint64_t GetCacheMisses() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override;
+
+    int64_t DoAssignStreams(int64_t stream) override;
+
+    /**
+     * Start tracking the position of the node the given mobility model is aggregated to,
+     * if not done yet.
+     *
+     * \param mobility the mobility model
+     * \param nodeId the id of the node
+     */
+    void Track(Ptr<MobilityModel> mobility, uint32_t nodeId) const;
+
+    /**
+     * Invalidate the cached losses involving the node whose position changed.
+     *
+     * \param mobility the mobility model of the node
+     */
+    void CourseChanged(Ptr<const MobilityModel> mobility) const;
+
+    /// A cached propagation loss
+    struct Entry
+    {
+        double loss;   //!< the propagation loss (dB)
+        uint32_t genA; //!< the generation of the transmitter when the loss was computed
+        uint32_t genB; //!< the generation of the receiver when the loss was computed
+    };
+
+    Ptr<PropagationLossModel> m_lossModel; //!< the model whose losses are cached
+    /// the cached losses, indexed by transmitter id (32 MSBs) and receiver id (32 LSBs)
+    mutable std::unordered_map<uint64_t, Entry> m_cache;
+    /// the generation of each node, incremented every time the node moves
+    mutable std::vector<uint32_t> m_generations;
+    /// the mobility models whose position is tracked, indexed by node id
+    mutable std::vector<Ptr<MobilityModel>> m_tracked;
+    mutable uint64_t m_hits{0};   //!< number of cache hits
+    mutable uint64_t m_misses{0}; //!< number of cache misses
+};
+
 } // namespace ns3
 
 #endif /* PROPAGATION_LOSS_MODEL_H */
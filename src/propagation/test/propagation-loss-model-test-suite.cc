@@ -20,6 +20,8 @@
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/pointer.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
@@ -489,6 +491,89 @@ RangePropagationLossModelTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief CachedPropagationLossModel Test
+ */
+class CachedPropagationLossModelTestCase : public TestCase
+{
+  public:
+    CachedPropagationLossModelTestCase();
+    ~CachedPropagationLossModelTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+CachedPropagationLossModelTestCase::CachedPropagationLossModelTestCase()
+    : TestCase("Test CachedPropagationLossModel")
+{
+}
+
+CachedPropagationLossModelTestCase::~CachedPropagationLossModelTestCase()
+{
+}
+
+void
+CachedPropagationLossModelTestCase::DoRun()
+{
+    Ptr<Node> nodeA = CreateObject<Node>();
+    Ptr<Node> nodeB = CreateObject<Node>();
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0, 0, 0));
+    nodeA->AggregateObject(a);
+    Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+    b->SetPosition(Vector(100, 0, 0));
+    nodeB->AggregateObject(b);
+
+    Ptr<LogDistancePropagationLossModel> logDistance =
+        CreateObject<LogDistancePropagationLossModel>();
+    logDistance->SetAttribute("Exponent", DoubleValue(3));
+    Ptr<CachedPropagationLossModel> lossModel = CreateObjectWithAttributes<
+        CachedPropagationLossModel>("LossModel", PointerValue(logDistance));
+
+    double txPwrdBm = 20.0;
+    double tolerance = 1e-9;
+    double expected = logDistance->CalcRxPower(txPwrdBm, a, b);
+    double resultdBm = lossModel->CalcRxPower(txPwrdBm, a, b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(resultdBm, expected, tolerance, "Got unexpected rcv power");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetCacheMisses(), 1, "Unexpected number of misses");
+
+    // the cached loss is returned (for any tx power) even if the wrapped model changes
+    logDistance->SetAttribute("Exponent", DoubleValue(2));
+    resultdBm = lossModel->CalcRxPower(txPwrdBm - 10, a, b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(resultdBm, expected - 10, tolerance, "Got unexpected rcv power");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetCacheHits(), 1, "Unexpected number of hits");
+
+    // the loss in the reverse direction is cached separately
+    resultdBm = lossModel->CalcRxPower(txPwrdBm, b, a);
+    expected = logDistance->CalcRxPower(txPwrdBm, b, a);
+    NS_TEST_EXPECT_MSG_EQ_TOL(resultdBm, expected, tolerance, "Got unexpected rcv power");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetCacheMisses(), 2, "Unexpected number of misses");
+
+    // moving a node invalidates the cached losses
+    b->SetPosition(Vector(50, 0, 0));
+    expected = logDistance->CalcRxPower(txPwrdBm, a, b);
+    resultdBm = lossModel->CalcRxPower(txPwrdBm, a, b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(resultdBm, expected, tolerance, "Got unexpected rcv power");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetCacheMisses(), 3, "Unexpected number of misses");
+    resultdBm = lossModel->CalcRxPower(txPwrdBm, a, b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(resultdBm, expected, tolerance, "Got unexpected rcv power");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetCacheHits(), 2, "Unexpected number of hits");
+
+    // the losses of mobility models not aggregated to a node are not cached
+    Ptr<MobilityModel> c = CreateObject<ConstantPositionMobilityModel>();
+    c->SetPosition(Vector(0, 10, 0));
+    lossModel->CalcRxPower(txPwrdBm, a, c);
+    lossModel->CalcRxPower(txPwrdBm, a, c);
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetCacheMisses(), 3, "Unexpected number of misses");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetCacheHits(), 2, "Unexpected number of hits");
+
+    lossModel->Dispose();
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup propagation-tests
  *
@@ -500,6 +585,7 @@ RangePropagationLossModelTestCase::DoRun()
  *   - LogDistancePropagationLossModel
  *   - MatrixPropagationLossModel
  *   - RangePropagationLossModel
+ *   - CachedPropagationLossModel
  */
 class PropagationLossModelsTestSuite : public TestSuite
 {
@@ -515,6 +601,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite()
     AddTestCase(new LogDistancePropagationLossModelTestCase, TestCase::QUICK);
     AddTestCase(new MatrixPropagationLossModelTestCase, TestCase::QUICK);
     AddTestCase(new RangePropagationLossModelTestCase, TestCase::QUICK);
+    AddTestCase(new CachedPropagationLossModelTestCase, TestCase::QUICK);
 }
 
 /// Static variable for test initialization
@@ -25,6 +25,7 @@
 #include <ns3/nstime.h>
 #include <ns3/object.h>
 #include <ns3/phased-array-model.h>
+#include <ns3/val-array.h>
 #include <ns3/vector.h>
 
 #include <tuple>
@@ -55,15 +56,15 @@ class MatrixBasedChannelModel : public Object
         Double3DVector; //!< type definition for 3D matrices of doubles
     typedef std::vector<PhasedArrayModel::ComplexVector>
         Complex2DVector; //!< type definition for complex matrices
-    typedef std::vector<Complex2DVector>
-        Complex3DVector; //!< type definition for complex 3D matrices
+    typedef ComplexValArray
+        Complex3DVector; //!< type definition for complex 3D matrices (contiguous, column-major)
 
     /**
      * Data structure that stores a channel realization
      */
     struct ChannelMatrix : public SimpleRefCount<ChannelMatrix>
     {
-        Complex3DVector m_channel; //!< channel matrix H[u][s][n].
+        Complex3DVector m_channel; //!< channel matrix H(u, s, n).
         Time m_generatedTime;      //!< generation time
         std::pair<uint32_t, uint32_t>
             m_antennaPair; //!< the first element is the ID of the antenna of the s-node (the
@@ -80,7 +80,8 @@ RxSpectrumModelInfo::RxSpectrumModelInfo(Ptr<const SpectrumModel> rxSpectrumMode
 }
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel()
-    : m_numDevices{0}
+    : m_numDevices{0},
+      m_rxPhyListValid{false}
 {
     NS_LOG_FUNCTION(this);
 }
@@ -91,6 +92,8 @@ MultiModelSpectrumChannel::DoDispose()
     NS_LOG_FUNCTION(this);
     m_txSpectrumModelInfoMap.clear();
     m_rxSpectrumModelInfoMap.clear();
+    m_rxPhyList.clear();
+    m_rxPhyListValid = false;
     SpectrumChannel::DoDispose();
 }
 
@@ -126,6 +129,8 @@ MultiModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
         {
             rxInfoIterator->second.m_rxPhys.erase(phyIt);
             --m_numDevices;
+            m_rxPhyListValid = false;
+            InvalidateRxIndex();
             break; // there should be at most one entry
         }
     }
@@ -154,6 +159,8 @@ MultiModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
     // rxInfoIterator points either to the newly inserted element or to the element that
     // prevented insertion. In both cases, add the phy to the element pointed to by rxInfoIterator
     rxInfoIterator->second.m_rxPhys.push_back(phy);
+    m_rxPhyListValid = false;
+    InvalidateRxIndex();
 
     if (inserted)
     {
@@ -256,6 +263,49 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     NS_LOG_LOGIC("converter map first element: "
                  << txInfoIteratorerator->second.m_spectrumConverterMap.begin()->first);
 
+    if (m_maxRange > 0 && txMobility)
+    {
+        if (!m_rxPhyListValid)
+        {
+            // list the receivers in the same order as the loop below
+            m_rxPhyList.clear();
+            m_rxPhyModelUids.clear();
+            for (const auto& rxInfo : m_rxSpectrumModelInfoMap)
+            {
+                for (const auto& rxPhy : rxInfo.second.m_rxPhys)
+                {
+                    m_rxPhyList.push_back(rxPhy);
+                    m_rxPhyModelUids.push_back(rxInfo.first);
+                }
+            }
+            m_rxPhyListValid = true;
+        }
+
+        // the candidates are sorted, hence grouped by RX SpectrumModel
+        bool first = true;
+        SpectrumModelUid_t rxSpectrumModelUid = 0;
+        Ptr<const SpectrumValue> convertedTxPowerSpectrum;
+        for (auto i : GetRxCandidates(txMobility, m_rxPhyList))
+        {
+            if (first || m_rxPhyModelUids[i] != rxSpectrumModelUid)
+            {
+                first = false;
+                rxSpectrumModelUid = m_rxPhyModelUids[i];
+                convertedTxPowerSpectrum =
+                    ConvertTxPowerSpectrum(txParams->psd, txInfoIteratorerator, rxSpectrumModelUid);
+            }
+            if (convertedTxPowerSpectrum)
+            {
+                NS_ASSERT_MSG(m_rxPhyList[i]->GetRxSpectrumModel()->GetUid() == rxSpectrumModelUid,
+                              "SpectrumModel change was not notified to MultiModelSpectrumChannel "
+                              "(i.e., AddRx should be called again after model is changed)");
+                PropagateToReceiver(txParams, convertedTxPowerSpectrum, txMobility, m_rxPhyList[i]);
+            }
+        }
+        FlushStartRx();
+        return;
+    }
+
     for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
          rxInfoIterator != m_rxSpectrumModelInfoMap.end();
          ++rxInfoIterator)
@@ -263,24 +313,12 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
         SpectrumModelUid_t rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid();
         NS_LOG_LOGIC("rxSpectrumModelUids " << rxSpectrumModelUid);
 
-        Ptr<SpectrumValue> convertedTxPowerSpectrum;
-        if (txSpectrumModelUid == rxSpectrumModelUid)
+        Ptr<const SpectrumValue> convertedTxPowerSpectrum =
+            ConvertTxPowerSpectrum(txParams->psd, txInfoIteratorerator, rxSpectrumModelUid);
+        if (!convertedTxPowerSpectrum)
         {
-            NS_LOG_LOGIC("no spectrum conversion needed");
-            convertedTxPowerSpectrum = txParams->psd;
-        }
-        else
-        {
-            NS_LOG_LOGIC("converting txPowerSpectrum SpectrumModelUids "
-                         << txSpectrumModelUid << " --> " << rxSpectrumModelUid);
-            SpectrumConverterMap_t::const_iterator rxConverterIterator =
-                txInfoIteratorerator->second.m_spectrumConverterMap.find(rxSpectrumModelUid);
-            if (rxConverterIterator == txInfoIteratorerator->second.m_spectrumConverterMap.end())
-            {
-                // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
-                continue;
-            }
-            convertedTxPowerSpectrum = rxConverterIterator->second.Convert(txParams->psd);
+            // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
+            continue;
         }
 
         for (auto rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin();
@@ -291,107 +329,33 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                           "SpectrumModel change was not notified to MultiModelSpectrumChannel "
                           "(i.e., AddRx should be called again after model is changed)");
 
-            if ((*rxPhyIterator) != txParams->txPhy)
-            {
-                Ptr<NetDevice> rxNetDevice = (*rxPhyIterator)->GetDevice();
-                Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
-
-                if (rxNetDevice && txNetDevice)
-                {
-                    // we assume that devices are attached to a node
-                    if (rxNetDevice->GetNode()->GetId() == txNetDevice->GetNode()->GetId())
-                    {
-                        NS_LOG_DEBUG(
-                            "Skipping the pathloss calculation among different antennas of the "
-                            "same node, not supported yet by any pathloss model in ns-3.");
-                        continue;
-                    }
-                }
-
-                NS_LOG_LOGIC("copying signal parameters " << txParams);
-                Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
-                rxParams->psd = Copy<SpectrumValue>(convertedTxPowerSpectrum);
-                Time delay = MicroSeconds(0);
-
-                Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility();
-
-                if (txMobility && receiverMobility)
-                {
-                    double txAntennaGain = 0;
-                    double rxAntennaGain = 0;
-                    double propagationGainDb = 0;
-                    double pathLossDb = 0;
-                    if (rxParams->txAntenna)
-                    {
-                        Angles txAngles(receiverMobility->GetPosition(), txMobility->GetPosition());
-                        txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
-                        NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
-                        pathLossDb -= txAntennaGain;
-                    }
-                    Ptr<AntennaModel> rxAntenna =
-                        DynamicCast<AntennaModel>((*rxPhyIterator)->GetAntenna());
-                    if (rxAntenna)
-                    {
-                        Angles rxAngles(txMobility->GetPosition(), receiverMobility->GetPosition());
-                        rxAntennaGain = rxAntenna->GetGainDb(rxAngles);
-                        NS_LOG_LOGIC("rxAntennaGain = " << rxAntennaGain << " dB");
-                        pathLossDb -= rxAntennaGain;
-                    }
-                    if (m_propagationLoss)
-                    {
-                        propagationGainDb =
-                            m_propagationLoss->CalcRxPower(0, txMobility, receiverMobility);
-                        NS_LOG_LOGIC("propagationGainDb = " << propagationGainDb << " dB");
-                        pathLossDb -= propagationGainDb;
-                    }
-                    NS_LOG_LOGIC("total pathLoss = " << pathLossDb << " dB");
-                    // Gain trace
-                    m_gainTrace(txMobility,
-                                receiverMobility,
-                                txAntennaGain,
-                                rxAntennaGain,
-                                propagationGainDb,
-                                pathLossDb);
-                    // Pathloss trace
-                    m_pathLossTrace(txParams->txPhy, *rxPhyIterator, pathLossDb);
-                    if (pathLossDb > m_maxLossDb)
-                    {
-                        // beyond range
-                        continue;
-                    }
-                    double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
-                    *(rxParams->psd) *= pathGainLinear;
-
-                    if (m_propagationDelay)
-                    {
-                        delay = m_propagationDelay->GetDelay(txMobility, receiverMobility);
-                    }
-                }
-
-                if (rxNetDevice)
-                {
-                    // the receiver has a NetDevice, so we expect that it is attached to a Node
-                    uint32_t dstNode = rxNetDevice->GetNode()->GetId();
-                    Simulator::ScheduleWithContext(dstNode,
-                                                   delay,
-                                                   &MultiModelSpectrumChannel::StartRx,
-                                                   this,
-                                                   rxParams,
-                                                   *rxPhyIterator);
-                }
-                else
-                {
-                    // the receiver is not attached to a NetDevice, so we cannot assume that it is
-                    // attached to a node
-                    Simulator::Schedule(delay,
-                                        &MultiModelSpectrumChannel::StartRx,
-                                        this,
-                                        rxParams,
-                                        *rxPhyIterator);
-                }
-            }
+            PropagateToReceiver(txParams, convertedTxPowerSpectrum, txMobility, *rxPhyIterator);
         }
     }
+    FlushStartRx();
+}
+
+Ptr<const SpectrumValue>
+MultiModelSpectrumChannel::ConvertTxPowerSpectrum(
+    Ptr<const SpectrumValue> txPsd,
+    TxSpectrumModelInfoMap_t::const_iterator txInfoIterator,
+    SpectrumModelUid_t rxSpectrumModelUid) const
+{
+    SpectrumModelUid_t txSpectrumModelUid = txPsd->GetSpectrumModelUid();
+    if (txSpectrumModelUid == rxSpectrumModelUid)
+    {
+        NS_LOG_LOGIC("no spectrum conversion needed");
+        return txPsd;
+    }
+    NS_LOG_LOGIC("converting txPowerSpectrum SpectrumModelUids " << txSpectrumModelUid << " --> "
+                                                                 << rxSpectrumModelUid);
+    SpectrumConverterMap_t::const_iterator rxConverterIterator =
+        txInfoIterator->second.m_spectrumConverterMap.find(rxSpectrumModelUid);
+    if (rxConverterIterator == txInfoIterator->second.m_spectrumConverterMap.end())
+    {
+        return nullptr;
+    }
+    return rxConverterIterator->second.Convert(txPsd);
 }
 
 void
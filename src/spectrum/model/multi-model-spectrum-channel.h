@@ -136,13 +136,28 @@ class MultiModelSpectrumChannel : public SpectrumChannel
     TxSpectrumModelInfoMap_t::const_iterator FindAndEventuallyAddTxSpectrumModel(
         Ptr<const SpectrumModel> txSpectrumModel);
 
+    /**
+     * Convert a TX PSD to a RX SpectrumModel.
+     *
+     * \param txPsd the TX PSD
+     * \param txInfoIterator the entry of m_txSpectrumModelInfoMap for the SpectrumModel of txPsd
+     * \param rxSpectrumModelUid the UID of the RX SpectrumModel
+     *
+     * \return the converted PSD (txPsd itself if both SpectrumModels are the same), or
+     * a null pointer if the SpectrumModels are orthogonal
+     */
+    Ptr<const SpectrumValue> ConvertTxPowerSpectrum(
+        Ptr<const SpectrumValue> txPsd,
+        TxSpectrumModelInfoMap_t::const_iterator txInfoIterator,
+        SpectrumModelUid_t rxSpectrumModelUid) const;
+
     /**
      * Used internally to reschedule transmission after the propagation delay.
      *
      * \param params The signal parameters.
      * \param receiver A pointer to the receiver SpectrumPhy.
      */
-    virtual void StartRx(Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
+    void StartRx(Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver) override;
 
     /**
      * Data structure holding, for each TX SpectrumModel,  all the
@@ -162,6 +177,21 @@ class MultiModelSpectrumChannel : public SpectrumChannel
      * Number of devices connected to the channel.
      */
     std::size_t m_numDevices;
+
+    /**
+     * All the receivers, ordered by RX SpectrumModel (used if MaxRange is set).
+     */
+    std::vector<Ptr<SpectrumPhy>> m_rxPhyList;
+
+    /**
+     * The UID of the RX SpectrumModel of each receiver of m_rxPhyList.
+     */
+    std::vector<SpectrumModelUid_t> m_rxPhyModelUids;
+
+    /**
+     * Whether m_rxPhyList matches m_rxSpectrumModelInfoMap.
+     */
+    bool m_rxPhyListValid;
 };
 
 } // namespace ns3
@@ -66,7 +66,7 @@ class SingleModelSpectrumChannel : public SpectrumChannel
      * \param params
      * \param receiver
      */
-    void StartRx(Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
+    void StartRx(Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver) override;
 
     /**
      * List of SpectrumPhy instances attached to the channel.
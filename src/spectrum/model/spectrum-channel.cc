@@ -19,9 +19,17 @@
 
 #include "spectrum-channel.h"
 
+#include <ns3/angles.h>
+#include <ns3/antenna-model.h>
 #include <ns3/double.h>
 #include <ns3/log.h>
+#include <ns3/net-device.h>
+#include <ns3/node.h>
 #include <ns3/pointer.h>
+#include <ns3/simulator.h>
+
+#include <algorithm>
+#include <cmath>
 
 namespace ns3
 {
@@ -31,6 +39,8 @@ NS_LOG_COMPONENT_DEFINE("SpectrumChannel");
 NS_OBJECT_ENSURE_REGISTERED(SpectrumChannel);
 
 SpectrumChannel::SpectrumChannel()
+    : m_maxRange(0),
+      m_rxIndexValid(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -46,6 +56,8 @@ SpectrumChannel::DoDispose()
     m_propagationLoss = nullptr;
     m_propagationDelay = nullptr;
     m_spectrumPropagationLoss = nullptr;
+    m_rxIndex.Clear();
+    m_rxIndexValid = false;
 }
 
 TypeId
@@ -70,6 +82,18 @@ SpectrumChannel::GetTypeId()
                           MakeDoubleAccessor(&SpectrumChannel::m_maxLossDb),
                           MakeDoubleChecker<double>())
 
+            .AddAttribute("MaxRange",
+                          "The distance (m) beyond which receivers are considered out of "
+                          "range: no loss is computed for them and transmissions are not "
+                          "passed to them. If non-zero, the receivers are indexed by their "
+                          "position, so that the cost of a transmission depends on the number "
+                          "of receivers in range rather than on the total number of receivers. "
+                          "Receivers without a mobility model are never out of range. Zero "
+                          "means no limit.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&SpectrumChannel::m_maxRange),
+                          MakeDoubleChecker<double>(0))
+
             .AddAttribute("PropagationLossModel",
                           "A pointer to the propagation loss model attached to this channel.",
                           PointerValue(nullptr),
@@ -173,4 +197,210 @@ SpectrumChannel::GetPropagationLossModel()
     return m_propagationLoss;
 }
 
+void
+SpectrumChannel::InvalidateRxIndex()
+{
+    NS_LOG_FUNCTION(this);
+    m_rxIndexValid = false;
+}
+
+const std::vector<std::size_t>&
+SpectrumChannel::GetRxCandidates(Ptr<MobilityModel> txMobility,
+                                 const std::vector<Ptr<SpectrumPhy>>& rxPhys)
+{
+    NS_LOG_FUNCTION(this << txMobility);
+    NS_ASSERT(m_maxRange > 0);
+    if (!m_rxIndexValid || m_rxIndex.GetCellSize() != m_maxRange)
+    {
+        // the receivers are indexed lazily, as their mobility model is usually
+        // installed after they are attached to the channel
+        m_rxIndex.SetCellSize(m_maxRange);
+        m_indexedRx.clear();
+        m_unindexedRx.clear();
+        for (std::size_t i = 0; i < rxPhys.size(); ++i)
+        {
+            Ptr<MobilityModel> mobility = rxPhys[i]->GetMobility();
+            if (mobility)
+            {
+                m_rxIndex.Add(mobility);
+                m_indexedRx.push_back(i);
+            }
+            else
+            {
+                m_unindexedRx.push_back(i);
+            }
+        }
+        m_rxIndexValid = true;
+    }
+
+    m_indexQuery.clear();
+    m_rxIndex.GetCandidates(txMobility->GetPosition(), m_maxRange, m_indexQuery);
+    m_rxCandidates = m_unindexedRx;
+    for (auto id : m_indexQuery)
+    {
+        std::size_t i = m_indexedRx[id];
+        if (txMobility->GetDistanceFrom(rxPhys[i]->GetMobility()) <= m_maxRange)
+        {
+            m_rxCandidates.push_back(i);
+        }
+    }
+    std::sort(m_rxCandidates.begin(), m_rxCandidates.end());
+    return m_rxCandidates;
+}
+
+void
+SpectrumChannel::PropagateToReceiver(Ptr<const SpectrumSignalParameters> txParams,
+                                     Ptr<const SpectrumValue> txPsd,
+                                     Ptr<MobilityModel> txMobility,
+                                     Ptr<SpectrumPhy> receiver)
+{
+    if (receiver == txParams->txPhy)
+    {
+        return;
+    }
+
+    Ptr<NetDevice> rxNetDevice = receiver->GetDevice();
+    Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
+
+    if (rxNetDevice && txNetDevice)
+    {
+        // we assume that devices are attached to a node
+        if (rxNetDevice->GetNode()->GetId() == txNetDevice->GetNode()->GetId())
+        {
+            NS_LOG_DEBUG("Skipping the pathloss calculation among different antennas of the "
+                         "same node, not supported yet by any pathloss model in ns-3.");
+            return;
+        }
+    }
+
+    Time delay = MicroSeconds(0);
+    double pathGainLinear = 1;
+
+    Ptr<MobilityModel> receiverMobility = receiver->GetMobility();
+
+    if (txMobility && receiverMobility)
+    {
+        double txAntennaGain = 0;
+        double rxAntennaGain = 0;
+        double propagationGainDb = 0;
+        double pathLossDb = 0;
+        if (txParams->txAntenna)
+        {
+            Angles txAngles(receiverMobility->GetPosition(), txMobility->GetPosition());
+            txAntennaGain = txParams->txAntenna->GetGainDb(txAngles);
+            NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
+            pathLossDb -= txAntennaGain;
+        }
+        Ptr<AntennaModel> rxAntenna = DynamicCast<AntennaModel>(receiver->GetAntenna());
+        if (rxAntenna)
+        {
+            Angles rxAngles(txMobility->GetPosition(), receiverMobility->GetPosition());
+            rxAntennaGain = rxAntenna->GetGainDb(rxAngles);
+            NS_LOG_LOGIC("rxAntennaGain = " << rxAntennaGain << " dB");
+            pathLossDb -= rxAntennaGain;
+        }
+        if (m_propagationLoss)
+        {
+            propagationGainDb = m_propagationLoss->CalcRxPower(0, txMobility, receiverMobility);
+            NS_LOG_LOGIC("propagationGainDb = " << propagationGainDb << " dB");
+            pathLossDb -= propagationGainDb;
+        }
+        NS_LOG_LOGIC("total pathLoss = " << pathLossDb << " dB");
+        // Gain trace
+        m_gainTrace(txMobility,
+                    receiverMobility,
+                    txAntennaGain,
+                    rxAntennaGain,
+                    propagationGainDb,
+                    pathLossDb);
+        // Pathloss trace
+        m_pathLossTrace(txParams->txPhy, receiver, pathLossDb);
+        if (pathLossDb > m_maxLossDb)
+        {
+            // beyond range
+            return;
+        }
+        pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
+
+        if (m_propagationDelay)
+        {
+            delay = m_propagationDelay->GetDelay(txMobility, receiverMobility);
+        }
+    }
+
+    // the signal parameters are copied only for the receivers in range
+    NS_LOG_LOGIC("copying signal parameters " << txParams);
+    Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
+    if (txPsd != txParams->psd)
+    {
+        rxParams->psd = Copy<SpectrumValue>(txPsd);
+    }
+    if (txMobility && receiverMobility)
+    {
+        *(rxParams->psd) *= pathGainLinear;
+    }
+
+    // if the receiver has a NetDevice, we expect that it is attached to a Node;
+    // otherwise, the reception inherits the context of the transmission
+    uint32_t context = rxNetDevice ? rxNetDevice->GetNode()->GetId() : Simulator::GetContext();
+    // a reception only joins the last batch starting at the same time, so that
+    // the receptions starting at the same time keep the order of their queuing
+    auto [it, inserted] = m_lastRxBatch.insert({delay, m_rxBatches.size()});
+    if (!inserted && m_rxBatches[it->second].context != context)
+    {
+        it->second = m_rxBatches.size();
+        inserted = true;
+    }
+    if (inserted)
+    {
+        m_rxBatches.push_back({delay, context, {}});
+    }
+    m_rxBatches[it->second].rxs.push_back({rxParams, receiver});
+}
+
+void
+SpectrumChannel::FlushStartRx()
+{
+    NS_LOG_FUNCTION(this << m_rxBatches.size());
+    for (auto& batch : m_rxBatches)
+    {
+        if (batch.rxs.size() == 1)
+        {
+            Simulator::ScheduleWithContext(batch.context,
+                                           batch.delay,
+                                           &SpectrumChannel::StartRx,
+                                           this,
+                                           batch.rxs.front().params,
+                                           batch.rxs.front().receiver);
+        }
+        else
+        {
+            Simulator::ScheduleWithContext(batch.context,
+                                           batch.delay,
+                                           &SpectrumChannel::StartRxBatch,
+                                           this,
+                                           std::move(batch.rxs));
+        }
+    }
+    m_rxBatches.clear();
+    m_lastRxBatch.clear();
+}
+
+void
+SpectrumChannel::StartRx(Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver)
+{
+    NS_LOG_FUNCTION(this << params << receiver);
+    receiver->StartRx(params);
+}
+
+void
+SpectrumChannel::StartRxBatch(std::vector<PendingRx> rxs)
+{
+    NS_LOG_FUNCTION(this << rxs.size());
+    for (auto& rx : rxs)
+    {
+        StartRx(rx.params, rx.receiver);
+    }
+}
+
 } // namespace ns3
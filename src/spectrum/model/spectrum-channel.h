@@ -27,11 +27,15 @@
 #include <ns3/phased-array-spectrum-propagation-loss-model.h>
 #include <ns3/propagation-delay-model.h>
 #include <ns3/propagation-loss-model.h>
+#include <ns3/spatial-grid-index.h>
 #include <ns3/spectrum-phy.h>
 #include <ns3/spectrum-propagation-loss-model.h>
 #include <ns3/spectrum-signal-parameters.h>
 #include <ns3/traced-callback.h>
 
+#include <map>
+#include <vector>
+
 namespace ns3
 {
 
@@ -187,6 +191,59 @@ class SpectrumChannel : public Channel
     typedef void (*SignalParametersTracedCallback)(Ptr<SpectrumSignalParameters> params);
 
   protected:
+    /**
+     * Mark the index of the receivers by position as outdated. Subclasses
+     * must call this method whenever a receiver is added or removed.
+     */
+    void InvalidateRxIndex();
+
+    /**
+     * Get the receivers that may be reached by a transmission, i.e., those
+     * within MaxRange of the transmitter and those without a mobility model.
+     * The receivers are looked up in a SpatialGridIndex, which is built at
+     * the first call following InvalidateRxIndex().
+     *
+     * \param txMobility the mobility model of the transmitter
+     * \param rxPhys all the receivers attached to the channel (the same container
+     *        must be passed until the next call to InvalidateRxIndex())
+     * \return the positions in rxPhys of the candidate receivers, in increasing order
+     */
+    const std::vector<std::size_t>& GetRxCandidates(Ptr<MobilityModel> txMobility,
+                                                    const std::vector<Ptr<SpectrumPhy>>& rxPhys);
+
+    /**
+     * Compute the signal received by a receiver, and queue the start of its
+     * reception unless the receiver is out of range. The queued receptions
+     * are scheduled by FlushStartRx().
+     *
+     * \param txParams the parameters of the transmitted signal
+     * \param txPsd the PSD of the transmitted signal, converted to the
+     *        SpectrumModel of the receiver
+     * \param txMobility the mobility model of the transmitter
+     * \param receiver the receiver
+     */
+    void PropagateToReceiver(Ptr<const SpectrumSignalParameters> txParams,
+                             Ptr<const SpectrumValue> txPsd,
+                             Ptr<MobilityModel> txMobility,
+                             Ptr<SpectrumPhy> receiver);
+
+    /**
+     * Schedule the receptions queued by PropagateToReceiver(). Consecutive
+     * receptions starting at the same time in the context of the same node
+     * are delivered by a single event, so that the receptions starting at the
+     * same time are still delivered in the order in which they were queued.
+     */
+    void FlushStartRx();
+
+    /**
+     * Start the reception of a signal at a receiver, after the propagation delay.
+     * The default implementation hands the signal to the receiver unchanged.
+     *
+     * \param params the parameters of the received signal
+     * \param receiver the receiver
+     */
+    virtual void StartRx(Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
+
     /**
      * The `PathLoss` trace source. Exporting the pointers to the Tx and Rx
      * SpectrumPhy and a pathloss value, in dB.
@@ -218,6 +275,14 @@ class SpectrumChannel : public Channel
      */
     double m_maxLossDb;
 
+    /**
+     * Maximum range [m].
+     *
+     * Any device farther than this distance is considered out of range.
+     * Zero means no limit.
+     */
+    double m_maxRange;
+
     /**
      * Single-frequency propagation loss model to be used with this channel.
      */
@@ -237,6 +302,44 @@ class SpectrumChannel : public Channel
      * Frequency-dependent propagation loss model to be used with this channel.
      */
     Ptr<PhasedArraySpectrumPropagationLossModel> m_phasedArraySpectrumPropagationLoss;
+
+  private:
+    /**
+     * A reception waiting to be scheduled
+     */
+    struct PendingRx
+    {
+        Ptr<SpectrumSignalParameters> params; //!< Parameters of the received signal
+        Ptr<SpectrumPhy> receiver;            //!< Receiver
+    };
+
+    /**
+     * The receptions starting after the same delay in the same context
+     */
+    struct RxBatch
+    {
+        Time delay;                 //!< Propagation delay
+        uint32_t context;           //!< Context of the reception event
+        std::vector<PendingRx> rxs; //!< Receptions, in the order they were queued
+    };
+
+    /**
+     * Start the reception of a batch of signals
+     *
+     * \param rxs the receptions
+     */
+    void StartRxBatch(std::vector<PendingRx> rxs);
+
+    std::vector<RxBatch> m_rxBatches; //!< Receptions queued by PropagateToReceiver
+    std::map<Time, std::size_t> m_lastRxBatch; //!< Position in m_rxBatches of the last
+                                               //!< batch queued for each delay
+
+    SpatialGridIndex m_rxIndex;                //!< Index of the receivers by position
+    bool m_rxIndexValid;                       //!< The index matches the receivers
+    std::vector<std::size_t> m_indexedRx;      //!< Receivers in m_rxIndex, by item identifier
+    std::vector<std::size_t> m_unindexedRx;    //!< Receivers without mobility model
+    std::vector<std::size_t> m_indexQuery;     //!< Items returned by the last index query
+    std::vector<std::size_t> m_rxCandidates;   //!< Receivers returned by GetRxCandidates
 };
 
 } // namespace ns3
@@ -22,6 +22,7 @@
 #include <ns3/spectrum-converter.h>
 
 #include <algorithm>
+#include <iterator>
 
 namespace ns3
 {
@@ -39,15 +40,33 @@ SpectrumConverter::SpectrumConverter(Ptr<const SpectrumModel> fromSpectrumModel,
     m_fromSpectrumModel = fromSpectrumModel;
     m_toSpectrumModel = toSpectrumModel;
 
+    // If the bands of both models are sorted by frequency, the "from" bands overlapping a
+    // "to" band are contiguous and follow those overlapping the previous "to" band, hence
+    // they can be found by sweeping both models once instead of checking every pair of bands
+    bool sorted = IsSorted(fromSpectrumModel) && IsSorted(toSpectrumModel);
+    NS_LOG_LOGIC("Bands sorted by frequency: " << sorted);
+
     size_t rowPtr = 0;
+    Bands::const_iterator first = fromSpectrumModel->Begin();
     for (Bands::const_iterator toit = toSpectrumModel->Begin(); toit != toSpectrumModel->End();
          ++toit)
     {
-        size_t colInd = 0;
-        for (Bands::const_iterator fromit = fromSpectrumModel->Begin();
-             fromit != fromSpectrumModel->End();
-             ++fromit)
+        if (sorted)
+        {
+            // skip the "from" bands lying below the current "to" band
+            while (first != fromSpectrumModel->End() && first->fh <= toit->fl)
+            {
+                ++first;
+            }
+        }
+        size_t colInd = std::distance(fromSpectrumModel->Begin(), first);
+        for (Bands::const_iterator fromit = first; fromit != fromSpectrumModel->End(); ++fromit)
         {
+            if (sorted && fromit->fl >= toit->fh)
+            {
+                // this band and the following ones lie above the current "to" band
+                break;
+            }
             double c = GetCoefficient(*fromit, *toit);
             NS_LOG_LOGIC("(" << fromit->fl << "," << fromit->fh << ")"
                              << " --> "
@@ -65,6 +84,25 @@ SpectrumConverter::SpectrumConverter(Ptr<const SpectrumModel> fromSpectrumModel,
     }
 }
 
+bool
+SpectrumConverter::IsSorted(Ptr<const SpectrumModel> spectrumModel)
+{
+    Bands::const_iterator prev = spectrumModel->End();
+    for (Bands::const_iterator it = spectrumModel->Begin(); it != spectrumModel->End(); ++it)
+    {
+        if (it->fh <= it->fl)
+        {
+            return false;
+        }
+        if (prev != spectrumModel->End() && (it->fl < prev->fl || it->fh < prev->fh))
+        {
+            return false;
+        }
+        prev = it;
+    }
+    return true;
+}
+
 double
 SpectrumConverter::GetCoefficient(const BandInfo& from, const BandInfo& to) const
 {
@@ -82,21 +120,19 @@ SpectrumConverter::Convert(Ptr<const SpectrumValue> fvvf) const
 
     Ptr<SpectrumValue> tvvf = Create<SpectrumValue>(m_toSpectrumModel);
 
-    Values::iterator tvit = tvvf->ValuesBegin();
+    // sparse matrix-vector product, the matrix being in Compressed Row Storage format
+    Values::const_iterator fromValues = fvvf->ConstValuesBegin();
+    Values::iterator toValues = tvvf->ValuesBegin();
     size_t i = 0; // Index of conversion coefficient
 
-    for (std::vector<size_t>::const_iterator convIt = m_conversionRowPtr.begin();
-         convIt != m_conversionRowPtr.end();
-         ++convIt)
+    for (size_t row = 0; row < m_conversionRowPtr.size(); ++row)
     {
         double sum = 0;
-        while (i < *convIt)
+        for (; i < m_conversionRowPtr[row]; ++i)
         {
-            sum += (*fvvf)[m_conversionColInd.at(i)] * m_conversionMatrix.at(i);
-            i++;
+            sum += fromValues[m_conversionColInd[i]] * m_conversionMatrix[i];
         }
-        *tvit = sum;
-        ++tvit;
+        toValues[row] = sum;
     }
 
     return tvvf;
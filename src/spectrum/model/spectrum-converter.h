@@ -75,6 +75,16 @@ class SpectrumConverter : public SimpleRefCount<SpectrumConverter>
      */
     double GetCoefficient(const BandInfo& from, const BandInfo& to) const;
 
+    /**
+     * Check whether the bands of a SpectrumModel are sorted by frequency
+     *
+     * @param spectrumModel the SpectrumModel
+     *
+     * @return true if the bands have a positive width and both their lower and
+     * higher frequencies are non-decreasing
+     */
+    static bool IsSorted(Ptr<const SpectrumModel> spectrumModel);
+
     std::vector<double> m_conversionMatrix; //!< matrix of conversion coefficients stored in
                                             //!< Compressed Row Storage format
     std::vector<size_t> m_conversionRowPtr; //!< offset of rows in m_conversionMatrix
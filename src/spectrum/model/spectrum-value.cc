@@ -22,6 +22,9 @@
 #include <ns3/math.h>
 #include <ns3/spectrum-value.h>
 
+#include <algorithm>
+#include <utility>
+
 namespace ns3
 {
 
@@ -100,46 +103,42 @@ SpectrumValue::ConstBandsEnd() const
 void
 SpectrumValue::Add(const SpectrumValue& x)
 {
-    Values::iterator it1 = m_values.begin();
-    Values::const_iterator it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    // loops over contiguous arrays, which the compiler can vectorize
+    double* values = m_values.data();
+    const double* other = x.m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 += *it2;
-        ++it1;
-        ++it2;
+        values[i] += other[i];
     }
 }
 
 void
 SpectrumValue::Add(double s)
 {
-    Values::iterator it1 = m_values.begin();
-
-    while (it1 != m_values.end())
+    double* values = m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 += s;
-        ++it1;
+        values[i] += s;
     }
 }
 
 void
 SpectrumValue::Subtract(const SpectrumValue& x)
 {
-    Values::iterator it1 = m_values.begin();
-    Values::const_iterator it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    double* values = m_values.data();
+    const double* other = x.m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 -= *it2;
-        ++it1;
-        ++it2;
+        values[i] -= other[i];
     }
 }
 
@@ -152,46 +151,41 @@ SpectrumValue::Subtract(double s)
 void
 SpectrumValue::Multiply(const SpectrumValue& x)
 {
-    Values::iterator it1 = m_values.begin();
-    Values::const_iterator it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    double* values = m_values.data();
+    const double* other = x.m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 *= *it2;
-        ++it1;
-        ++it2;
+        values[i] *= other[i];
     }
 }
 
 void
 SpectrumValue::Multiply(double s)
 {
-    Values::iterator it1 = m_values.begin();
-
-    while (it1 != m_values.end())
+    double* values = m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 *= s;
-        ++it1;
+        values[i] *= s;
     }
 }
 
 void
 SpectrumValue::Divide(const SpectrumValue& x)
 {
-    Values::iterator it1 = m_values.begin();
-    Values::const_iterator it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    double* values = m_values.data();
+    const double* other = x.m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 /= *it2;
-        ++it1;
-        ++it2;
+        values[i] /= other[i];
     }
 }
 
@@ -199,24 +193,52 @@ void
 SpectrumValue::Divide(double s)
 {
     NS_LOG_FUNCTION(this << s);
-    Values::iterator it1 = m_values.begin();
+    double* values = m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        values[i] /= s;
+    }
+}
 
-    while (it1 != m_values.end())
+void
+SpectrumValue::ReverseSubtract(const SpectrumValue& x)
+{
+    NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
+    NS_ASSERT(m_values.size() == x.m_values.size());
+
+    double* values = m_values.data();
+    const double* other = x.m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 /= s;
-        ++it1;
+        values[i] = other[i] - values[i];
     }
 }
 
 void
-SpectrumValue::ChangeSign()
+SpectrumValue::ReverseDivide(const SpectrumValue& x)
 {
-    Values::iterator it1 = m_values.begin();
+    NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
+    NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    double* values = m_values.data();
+    const double* other = x.m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 = -(*it1);
-        ++it1;
+        values[i] = other[i] / values[i];
+    }
+}
+
+void
+SpectrumValue::ChangeSign()
+{
+    double* values = m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        values[i] = -values[i];
     }
 }
 
@@ -429,9 +451,8 @@ operator+(double lhs, const SpectrumValue& rhs)
 SpectrumValue
 operator-(const SpectrumValue& lhs, const SpectrumValue& rhs)
 {
-    SpectrumValue res = rhs;
-    res.ChangeSign();
-    res.Add(lhs);
+    SpectrumValue res = lhs;
+    res.Subtract(rhs);
     return res;
 }
 
@@ -513,6 +534,125 @@ operator-(const SpectrumValue& rhs)
     return res;
 }
 
+SpectrumValue
+operator+(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Add(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator+(const SpectrumValue& lhs, SpectrumValue&& rhs)
+{
+    rhs.Add(lhs);
+    return std::move(rhs);
+}
+
+SpectrumValue
+operator+(SpectrumValue&& lhs, SpectrumValue&& rhs)
+{
+    lhs.Add(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator+(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Add(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator-(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Subtract(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator-(const SpectrumValue& lhs, SpectrumValue&& rhs)
+{
+    rhs.ReverseSubtract(lhs);
+    return std::move(rhs);
+}
+
+SpectrumValue
+operator-(SpectrumValue&& lhs, SpectrumValue&& rhs)
+{
+    lhs.Subtract(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator-(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Subtract(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator*(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Multiply(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator*(const SpectrumValue& lhs, SpectrumValue&& rhs)
+{
+    rhs.Multiply(lhs);
+    return std::move(rhs);
+}
+
+SpectrumValue
+operator*(SpectrumValue&& lhs, SpectrumValue&& rhs)
+{
+    lhs.Multiply(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator*(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Multiply(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator/(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Divide(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator/(const SpectrumValue& lhs, SpectrumValue&& rhs)
+{
+    rhs.ReverseDivide(lhs);
+    return std::move(rhs);
+}
+
+SpectrumValue
+operator/(SpectrumValue&& lhs, SpectrumValue&& rhs)
+{
+    lhs.Divide(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator/(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Divide(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator-(SpectrumValue&& rhs)
+{
+    rhs.ChangeSign();
+    return std::move(rhs);
+}
+
 SpectrumValue
 Pow(double lhs, const SpectrumValue& rhs)
 {
@@ -612,13 +752,7 @@ SpectrumValue::operator/=(double rhs)
 SpectrumValue&
 SpectrumValue::operator=(double rhs)
 {
-    Values::iterator it1 = m_values.begin();
-
-    while (it1 != m_values.end())
-    {
-        *it1 = rhs;
-        ++it1;
-    }
+    std::fill(m_values.begin(), m_values.end(), rhs);
     return *this;
 }
 
@@ -301,6 +301,180 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      */
     friend SpectrumValue operator-(const SpectrumValue& rhs);
 
+    /*
+     * The following overloads take (at least) a temporary operand and store the result in
+     * its values, hence an expression such as a / (b - c + d) only allocates the values of
+     * its result, which are then computed in place.
+     */
+
+    /**
+     *  addition operator, reusing the values of the temporary lhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     *  addition operator, reusing the values of the temporary rhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(const SpectrumValue& lhs, SpectrumValue&& rhs);
+
+    /**
+     *  addition operator, reusing the values of the temporary lhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(SpectrumValue&& lhs, SpectrumValue&& rhs);
+
+    /**
+     *  addition of a scalar, reusing the values of the temporary lhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(SpectrumValue&& lhs, double rhs);
+
+    /**
+     *  subtraction operator, reusing the values of the temporary lhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs - rhs
+     */
+    friend SpectrumValue operator-(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     *  subtraction operator, reusing the values of the temporary rhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs - rhs
+     */
+    friend SpectrumValue operator-(const SpectrumValue& lhs, SpectrumValue&& rhs);
+
+    /**
+     *  subtraction operator, reusing the values of the temporary lhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs - rhs
+     */
+    friend SpectrumValue operator-(SpectrumValue&& lhs, SpectrumValue&& rhs);
+
+    /**
+     *  subtraction of a scalar, reusing the values of the temporary lhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs - rhs
+     */
+    friend SpectrumValue operator-(SpectrumValue&& lhs, double rhs);
+
+    /**
+     *  Schur product, reusing the values of the temporary lhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     *  Schur product, reusing the values of the temporary rhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(const SpectrumValue& lhs, SpectrumValue&& rhs);
+
+    /**
+     *  Schur product, reusing the values of the temporary lhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(SpectrumValue&& lhs, SpectrumValue&& rhs);
+
+    /**
+     *  multiplication by a scalar, reusing the values of the temporary lhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(SpectrumValue&& lhs, double rhs);
+
+    /**
+     *  division component-by-component, reusing the values of the temporary lhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs / rhs
+     */
+    friend SpectrumValue operator/(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     *  division component-by-component, reusing the values of the temporary rhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs / rhs
+     */
+    friend SpectrumValue operator/(const SpectrumValue& lhs, SpectrumValue&& rhs);
+
+    /**
+     *  division component-by-component, reusing the values of the temporary lhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs / rhs
+     */
+    friend SpectrumValue operator/(SpectrumValue&& lhs, SpectrumValue&& rhs);
+
+    /**
+     *  division by a scalar, reusing the values of the temporary lhs
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs / rhs
+     */
+    friend SpectrumValue operator/(SpectrumValue&& lhs, double rhs);
+
+    /**
+     * unary minus operator, reusing the values of the temporary rhs
+     *
+     * @param rhs Right Hand Side of the operator
+     * @return the value of - rhs
+     */
+    friend SpectrumValue operator-(SpectrumValue&& rhs);
+
     /**
      * left shift operator
      *
@@ -547,6 +721,17 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      * \param s flat value
      */
     void Divide(double s);
+    /**
+     * Replaces each element by the corresponding element of a SpectrumValue minus the element
+     * \param x SpectrumValue
+     */
+    void ReverseSubtract(const SpectrumValue& x);
+    /**
+     * Replaces each element by the corresponding element of a SpectrumValue divided by the
+     * element
+     * \param x SpectrumValue
+     */
+    void ReverseDivide(const SpectrumValue& x);
     /**
      * Change the values sign
      */
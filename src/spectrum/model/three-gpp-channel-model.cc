@@ -29,6 +29,7 @@
 #include "ns3/phased-array-model.h"
 #include "ns3/pointer.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 #include <ns3/simulator.h>
 
 #include <algorithm>
@@ -259,6 +260,7 @@ ThreeGppChannelModel::ThreeGppChannelModel()
 ThreeGppChannelModel::~ThreeGppChannelModel()
 {
     NS_LOG_FUNCTION(this);
+    StopWorkers();
 }
 
 void
@@ -269,6 +271,8 @@ ThreeGppChannelModel::DoDispose()
     {
         m_channelConditionModel->Dispose();
     }
+    StopWorkers();
+    m_precomputations.clear();
     m_channelMatrixMap.clear();
     m_channelParamsMap.clear();
     m_channelConditionModel = nullptr;
@@ -306,6 +310,24 @@ ThreeGppChannelModel::GetTypeId()
                           TimeValue(MilliSeconds(0)),
                           MakeTimeAccessor(&ThreeGppChannelModel::m_updatePeriod),
                           MakeTimeChecker())
+            .AddAttribute("KeepStaticChannels",
+                          "If true, the channel of a pair of nodes that did not move since the "
+                          "channel was generated is not regenerated when the UpdatePeriod "
+                          "expires, as the spatially consistent update procedure would not "
+                          "change it. Ignored if the blockage model is enabled.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ThreeGppChannelModel::m_keepStaticChannels),
+                          MakeBooleanChecker())
+            .AddAttribute("PrecomputeThreads",
+                          "The number of worker threads generating in the background the channel "
+                          "params of each pair of nodes for its next update (0 to disable). The "
+                          "random values of the next update are then drawn in advance, hence the "
+                          "results differ from those obtained without worker threads, but do not "
+                          "depend on their number. Ignored if the UpdatePeriod is zero or if the "
+                          "blockage model is enabled.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::m_precomputeThreads),
+                          MakeUintegerChecker<uint32_t>())
             // attributes for the blockage model
             .AddAttribute("Blockage",
                           "Enable blockage model A (sec 7.6.4.1)",
@@ -1054,7 +1076,9 @@ ThreeGppChannelModel::GetThreeGppTable(Ptr<const ChannelCondition> channelCondit
 
 bool
 ThreeGppChannelModel::ChannelParamsNeedsUpdate(Ptr<const ThreeGppChannelParams> channelParams,
-                                               Ptr<const ChannelCondition> channelCondition) const
+                                               Ptr<const ChannelCondition> channelCondition,
+                                               Ptr<const MobilityModel> aMob,
+                                               Ptr<const MobilityModel> bMob) const
 {
     NS_LOG_FUNCTION(this);
 
@@ -1073,7 +1097,30 @@ ThreeGppChannelModel::ChannelParamsNeedsUpdate(Ptr<const ThreeGppChannelParams>
     {
         NS_LOG_DEBUG("Generation time " << channelParams->m_generatedTime.As(Time::NS) << " now "
                                         << Now().As(Time::NS));
-        update = true;
+
+        // the spatially consistent update of the parameters of a link whose nodes
+        // did not move yields the same parameters, hence they can be kept (this
+        // does not hold if the blockage model is enabled, as the blockers move)
+        bool keep = false;
+        if (!update && m_keepStaticChannels && !m_blockage)
+        {
+            bool aIsFirst = (aMob->GetObject<Node>()->GetId() == channelParams->m_nodeIds.first);
+            const Vector& aPos = aIsFirst ? channelParams->m_nodePositions.first
+                                          : channelParams->m_nodePositions.second;
+            const Vector& bPos = aIsFirst ? channelParams->m_nodePositions.second
+                                          : channelParams->m_nodePositions.first;
+            keep = (aMob->GetPosition() == aPos && bMob->GetPosition() == bPos);
+        }
+
+        if (keep)
+        {
+            NS_LOG_DEBUG("The nodes did not move, keep the channel params");
+            m_cacheStats.staticReuses++;
+        }
+        else
+        {
+            update = true;
+        }
     }
 
     return update;
@@ -1124,7 +1171,7 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
     {
         channelParams = m_channelParamsMap[channelParamsKey];
         // check if it has to be updated
-        updateParams = ChannelParamsNeedsUpdate(channelParams, condition);
+        updateParams = ChannelParamsNeedsUpdate(channelParams, condition, aMob, bMob);
     }
     else
     {
@@ -1154,9 +1201,25 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
         // shuffle all the arrays to perform random coupling
         // Step 9: Generate the cross polarization power ratios
         // Step 10: Draw initial phases
-        channelParams = GenerateChannelParameters(condition, table3gpp, aMob, bMob);
+        if (m_precomputeThreads > 0 && !m_updatePeriod.IsZero() && !m_blockage)
+        {
+            channelParams = GetPrecomputedChannelParameters(channelParamsKey,
+                                                            condition,
+                                                            table3gpp,
+                                                            aMob,
+                                                            bMob);
+        }
+        else
+        {
+            channelParams = GenerateChannelParameters(condition, table3gpp, aMob, bMob);
+        }
         // store or replace the channel parameters
         m_channelParamsMap[channelParamsKey] = channelParams;
+        m_cacheStats.paramsMisses++;
+    }
+    else
+    {
+        m_cacheStats.paramsHits++;
     }
 
     if (m_channelMatrixMap.find(channelMatrixKey) != m_channelMatrixMap.end())
@@ -1185,6 +1248,13 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
 
         // store or replace the channel matrix in the channel map
         m_channelMatrixMap[channelMatrixKey] = channelMatrix;
+        m_cacheStats.matrixMisses++;
+    }
+    else
+    {
+        // the channel matrix is reciprocal, hence the same realization is returned
+        // for both directions of the link
+        m_cacheStats.matrixHits++;
     }
 
     return channelMatrix;
@@ -1217,19 +1287,71 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
                                                 const Ptr<const MobilityModel> bMob) const
 {
     NS_LOG_FUNCTION(this);
-    // create a channel matrix instance
-    Ptr<ThreeGppChannelParams> channelParams = Create<ThreeGppChannelParams>();
-    channelParams->m_generatedTime = Simulator::Now();
-    channelParams->m_nodeIds =
+
+    ParamsInputs inputs;
+    inputs.losCondition = channelCondition->GetLosCondition();
+    inputs.o2iCondition = channelCondition->GetO2iCondition();
+    inputs.nodeIds =
         std::make_pair(aMob->GetObject<Node>()->GetId(), bMob->GetObject<Node>()->GetId());
-    channelParams->m_losCondition = channelCondition->GetLosCondition();
-    channelParams->m_o2iCondition = channelCondition->GetO2iCondition();
+    inputs.nodePositions = std::make_pair(aMob->GetPosition(), bMob->GetPosition());
+    inputs.table3gpp = PeekPointer(table3gpp);
+
+    // the channel params object is created first, as it stores the state of the
+    // blockage model
+    Ptr<ThreeGppChannelParams> channelParams = Create<ThreeGppChannelParams>();
+    ParamsRandomValues values(this);
+    SetChannelParams(channelParams,
+                     inputs,
+                     DoGenerateChannelParameters(inputs, values, PeekPointer(channelParams)),
+                     Simulator::Now());
+    return channelParams;
+}
+
+void
+ThreeGppChannelModel::SetChannelParams(Ptr<ThreeGppChannelParams> channelParams,
+                                       const ParamsInputs& inputs,
+                                       GeneratedParams&& params,
+                                       Time generatedTime)
+{
+    channelParams->m_generatedTime = generatedTime;
+    channelParams->m_nodeIds = inputs.nodeIds;
+    channelParams->m_nodePositions = inputs.nodePositions;
+    channelParams->m_losCondition = inputs.losCondition;
+    channelParams->m_o2iCondition = inputs.o2iCondition;
+    channelParams->m_delay = std::move(params.m_delay);
+    channelParams->m_angle = std::move(params.m_angle);
+    channelParams->m_alpha = std::move(params.m_alpha);
+    channelParams->m_D = std::move(params.m_D);
+    channelParams->m_DS = params.m_DS;
+    channelParams->m_K_factor = params.m_K_factor;
+    channelParams->m_reducedClusterNumber = params.m_reducedClusterNumber;
+    channelParams->m_rayAodRadian = std::move(params.m_rayAodRadian);
+    channelParams->m_rayAoaRadian = std::move(params.m_rayAoaRadian);
+    channelParams->m_rayZodRadian = std::move(params.m_rayZodRadian);
+    channelParams->m_rayZoaRadian = std::move(params.m_rayZoaRadian);
+    channelParams->m_clusterPhase = std::move(params.m_clusterPhase);
+    channelParams->m_crossPolarizationPowerRatios =
+        std::move(params.m_crossPolarizationPowerRatios);
+    channelParams->m_clusterPower = std::move(params.m_clusterPower);
+    channelParams->m_attenuation_dB = std::move(params.m_attenuation_dB);
+    channelParams->m_cluster1st = params.m_cluster1st;
+    channelParams->m_cluster2nd = params.m_cluster2nd;
+}
+
+ThreeGppChannelModel::GeneratedParams
+ThreeGppChannelModel::DoGenerateChannelParameters(const ParamsInputs& inputs,
+                                                  ParamsRandomValues& values,
+                                                  ThreeGppChannelParams* channelParams) const
+{
+    NS_LOG_FUNCTION(this);
+    const ParamsTable* table3gpp = inputs.table3gpp;
+    GeneratedParams params;
 
     // Step 4: Generate large scale parameters. All LSPS are uncorrelated.
     DoubleVector LSPsIndep;
     DoubleVector LSPs;
     uint8_t paramNum = 6;
-    if (channelParams->m_losCondition == ChannelCondition::LOS)
+    if (inputs.losCondition == ChannelCondition::LOS)
     {
         paramNum = 7;
     }
@@ -1237,7 +1359,7 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
     // Generate paramNum independent LSPs.
     for (uint8_t iter = 0; iter < paramNum; iter++)
     {
-        LSPsIndep.push_back(m_normalRv->GetValue());
+        LSPsIndep.push_back(values.GetNormal());
     }
     for (uint8_t row = 0; row < paramNum; row++)
     {
@@ -1256,7 +1378,7 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
     double ZSA;
     double ZSD;
     double kFactor = 0;
-    if (channelParams->m_losCondition == ChannelCondition::LOS)
+    if (inputs.losCondition == ChannelCondition::LOS)
     {
         kFactor = LSPs[1] * table3gpp->m_sigK + table3gpp->m_uK;
         DS = pow(10, LSPs[2] * table3gpp->m_sigLgDS + table3gpp->m_uLgDS);
@@ -1279,8 +1401,8 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
     ZSA = std::min(ZSA, 52.0);
 
     // save DS and K_factor parameters in the structure
-    channelParams->m_DS = DS;
-    channelParams->m_K_factor = kFactor;
+    params.m_DS = DS;
+    params.m_K_factor = kFactor;
 
     NS_LOG_INFO("K-factor=" << kFactor << ", DS=" << DS << ", ASD=" << ASD << ", ASA=" << ASA
                             << ", ZSD=" << ZSD << ", ZSA=" << ZSA);
@@ -1290,7 +1412,7 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
     double minTau = 100.0;
     for (uint8_t cIndex = 0; cIndex < table3gpp->m_numOfCluster; cIndex++)
     {
-        double tau = -1 * table3gpp->m_rTau * DS * log(m_uniformRv->GetValue(0, 1)); //(7.5-1)
+        double tau = -1 * table3gpp->m_rTau * DS * log(values.GetUniform(0, 1)); //(7.5-1)
         if (minTau > tau)
         {
             minTau = tau;
@@ -1315,23 +1437,22 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
         double power =
             exp(-1 * clusterDelay[cIndex] * (table3gpp->m_rTau - 1) / table3gpp->m_rTau / DS) *
             pow(10,
-                -1 * m_normalRv->GetValue() * table3gpp->m_perClusterShadowingStd / 10); //(7.5-5)
+                -1 * values.GetNormal() * table3gpp->m_perClusterShadowingStd / 10); //(7.5-5)
         powerSum += power;
         clusterPower.push_back(power);
     }
-    channelParams->m_clusterPower = clusterPower;
+    params.m_clusterPower = clusterPower;
 
     double powerMax = 0;
 
     for (uint8_t cIndex = 0; cIndex < table3gpp->m_numOfCluster; cIndex++)
     {
-        channelParams->m_clusterPower[cIndex] =
-            channelParams->m_clusterPower[cIndex] / powerSum; //(7.5-6)
+        params.m_clusterPower[cIndex] = params.m_clusterPower[cIndex] / powerSum; //(7.5-6)
     }
 
     DoubleVector clusterPowerForAngles; // this power is only for equation (7.5-9) and (7.5-14), not
                                         // for (7.5-22)
-    if (channelParams->m_losCondition == ChannelCondition::LOS)
+    if (inputs.losCondition == ChannelCondition::LOS)
     {
         double kLinear = pow(10, kFactor / 10);
 
@@ -1339,13 +1460,12 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
         {
             if (cIndex == 0)
             {
-                clusterPowerForAngles.push_back(channelParams->m_clusterPower[cIndex] /
-                                                    (1 + kLinear) +
+                clusterPowerForAngles.push_back(params.m_clusterPower[cIndex] / (1 + kLinear) +
                                                 kLinear / (1 + kLinear)); //(7.5-8)
             }
             else
             {
-                clusterPowerForAngles.push_back(channelParams->m_clusterPower[cIndex] /
+                clusterPowerForAngles.push_back(params.m_clusterPower[cIndex] /
                                                 (1 + kLinear)); //(7.5-8)
             }
             if (powerMax < clusterPowerForAngles[cIndex])
@@ -1358,7 +1478,7 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
     {
         for (uint8_t cIndex = 0; cIndex < table3gpp->m_numOfCluster; cIndex++)
         {
-            clusterPowerForAngles.push_back(channelParams->m_clusterPower[cIndex]); //(7.5-6)
+            clusterPowerForAngles.push_back(params.m_clusterPower[cIndex]); //(7.5-6)
             if (powerMax < clusterPowerForAngles[cIndex])
             {
                 powerMax = clusterPowerForAngles[cIndex];
@@ -1374,19 +1494,19 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
         if (clusterPowerForAngles[cIndex - 1] < thresh * powerMax)
         {
             clusterPowerForAngles.erase(clusterPowerForAngles.begin() + cIndex - 1);
-            channelParams->m_clusterPower.erase(channelParams->m_clusterPower.begin() + cIndex - 1);
+            params.m_clusterPower.erase(params.m_clusterPower.begin() + cIndex - 1);
             clusterDelay.erase(clusterDelay.begin() + cIndex - 1);
         }
     }
 
-    NS_ASSERT(channelParams->m_clusterPower.size() < UINT8_MAX);
-    channelParams->m_reducedClusterNumber = channelParams->m_clusterPower.size();
+    NS_ASSERT(params.m_clusterPower.size() < UINT8_MAX);
+    params.m_reducedClusterNumber = params.m_clusterPower.size();
     // Resume step 5 to compute the delay for LoS condition.
-    if (channelParams->m_losCondition == ChannelCondition::LOS)
+    if (inputs.losCondition == ChannelCondition::LOS)
     {
         double cTau =
             0.7705 - 0.0433 * kFactor + 2e-4 * pow(kFactor, 2) + 17e-6 * pow(kFactor, 3); //(7.5-3)
-        for (uint8_t cIndex = 0; cIndex < channelParams->m_reducedClusterNumber; cIndex++)
+        for (uint8_t cIndex = 0; cIndex < params.m_reducedClusterNumber; cIndex++)
         {
             clusterDelay[cIndex] = clusterDelay[cIndex] / cTau; //(7.5-4)
         }
@@ -1438,7 +1558,7 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
 
     double cPhi = cNlos;
 
-    if (channelParams->m_losCondition == ChannelCondition::LOS)
+    if (inputs.losCondition == ChannelCondition::LOS)
     {
         cPhi *= (1.1035 - 0.028 * kFactor - 2e-3 * pow(kFactor, 2) +
                  1e-4 * pow(kFactor, 3)); //(7.5-10))
@@ -1472,7 +1592,7 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
     }
 
     double cTheta = cNlos;
-    if (channelCondition->IsLos())
+    if (inputs.losCondition == ChannelCondition::LOS)
     {
         cTheta *= (1.3086 + 0.0339 * kFactor - 0.0077 * pow(kFactor, 2) +
                    2e-4 * pow(kFactor, 3)); //(7.5-15)
@@ -1482,7 +1602,7 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
     DoubleVector clusterAod;
     DoubleVector clusterZoa;
     DoubleVector clusterZod;
-    for (uint8_t cIndex = 0; cIndex < channelParams->m_reducedClusterNumber; cIndex++)
+    for (uint8_t cIndex = 0; cIndex < params.m_reducedClusterNumber; cIndex++)
     {
         double logCalc = -1 * log(clusterPowerForAngles[cIndex] / powerMax);
         double angle = 2 * sqrt(logCalc) / 1.4 / cPhi; //(7.5-9)
@@ -1493,36 +1613,36 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
         clusterZod.push_back(ZSD * angle);
     }
 
-    Angles sAngle(bMob->GetPosition(), aMob->GetPosition());
-    Angles uAngle(aMob->GetPosition(), bMob->GetPosition());
+    Angles sAngle(inputs.nodePositions.second, inputs.nodePositions.first);
+    Angles uAngle(inputs.nodePositions.first, inputs.nodePositions.second);
 
-    for (uint8_t cIndex = 0; cIndex < channelParams->m_reducedClusterNumber; cIndex++)
+    for (uint8_t cIndex = 0; cIndex < params.m_reducedClusterNumber; cIndex++)
     {
         int Xn = 1;
-        if (m_uniformRv->GetValue(0, 1) < 0.5)
+        if (values.GetUniform(0, 1) < 0.5)
         {
             Xn = -1;
         }
-        clusterAoa[cIndex] = clusterAoa[cIndex] * Xn + (m_normalRv->GetValue() * ASA / 7) +
+        clusterAoa[cIndex] = clusterAoa[cIndex] * Xn + (values.GetNormal() * ASA / 7) +
                              RadiansToDegrees(uAngle.GetAzimuth()); //(7.5-11)
-        clusterAod[cIndex] = clusterAod[cIndex] * Xn + (m_normalRv->GetValue() * ASD / 7) +
+        clusterAod[cIndex] = clusterAod[cIndex] * Xn + (values.GetNormal() * ASD / 7) +
                              RadiansToDegrees(sAngle.GetAzimuth());
-        if (channelCondition->IsO2i())
+        if (inputs.o2iCondition == ChannelCondition::O2I)
         {
             clusterZoa[cIndex] =
-                clusterZoa[cIndex] * Xn + (m_normalRv->GetValue() * ZSA / 7) + 90; //(7.5-16)
+                clusterZoa[cIndex] * Xn + (values.GetNormal() * ZSA / 7) + 90; //(7.5-16)
         }
         else
         {
-            clusterZoa[cIndex] = clusterZoa[cIndex] * Xn + (m_normalRv->GetValue() * ZSA / 7) +
+            clusterZoa[cIndex] = clusterZoa[cIndex] * Xn + (values.GetNormal() * ZSA / 7) +
                                  RadiansToDegrees(uAngle.GetInclination()); //(7.5-16)
         }
-        clusterZod[cIndex] = clusterZod[cIndex] * Xn + (m_normalRv->GetValue() * ZSD / 7) +
+        clusterZod[cIndex] = clusterZod[cIndex] * Xn + (values.GetNormal() * ZSD / 7) +
                              RadiansToDegrees(sAngle.GetInclination()) +
                              table3gpp->m_offsetZOD; //(7.5-19)
     }
 
-    if (channelParams->m_losCondition == ChannelCondition::LOS)
+    if (inputs.losCondition == ChannelCondition::LOS)
     {
         // The 7.5-12 can be rewrite as Theta_n,ZOA = Theta_n,ZOA - (Theta_1,ZOA - Theta_LOS,ZOA) =
         // Theta_n,ZOA - diffZOA, Similar as AOD, ZSA and ZSD.
@@ -1531,7 +1651,7 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
         double diffZsa = clusterZoa[0] - RadiansToDegrees(uAngle.GetInclination());
         double diffZsd = clusterZod[0] - RadiansToDegrees(sAngle.GetInclination());
 
-        for (uint8_t cIndex = 0; cIndex < channelParams->m_reducedClusterNumber; cIndex++)
+        for (uint8_t cIndex = 0; cIndex < params.m_reducedClusterNumber; cIndex++)
         {
             clusterAoa[cIndex] -= diffAoa; //(7.5-12)
             clusterAod[cIndex] -= diffAod;
@@ -1603,11 +1723,14 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
     DoubleVector attenuationDb;
     if (m_blockage)
     {
-        attenuationDb = CalcAttenuationOfBlockage(channelParams, clusterAoa, clusterZoa);
-        for (uint8_t cInd = 0; cInd < channelParams->m_reducedClusterNumber; cInd++)
+        NS_ASSERT_MSG(channelParams, "The blockage model needs the channel params object");
+        attenuationDb = CalcAttenuationOfBlockage(Ptr<ThreeGppChannelParams>(channelParams),
+                                                  clusterAoa,
+                                                  clusterZoa);
+        for (uint8_t cInd = 0; cInd < params.m_reducedClusterNumber; cInd++)
         {
-            channelParams->m_clusterPower[cInd] =
-                channelParams->m_clusterPower[cInd] / pow(10, attenuationDb[cInd] / 10);
+            params.m_clusterPower[cInd] =
+                params.m_clusterPower[cInd] / pow(10, attenuationDb[cInd] / 10);
         }
     }
     else
@@ -1616,28 +1739,28 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
     }
 
     // store attenuation
-    channelParams->m_attenuation_dB = attenuationDb;
+    params.m_attenuation_dB = attenuationDb;
 
     // Step 8: Coupling of rays within a cluster for both azimuth and elevation
     // shuffle all the arrays to perform random coupling
     MatrixBasedChannelModel::Double2DVector rayAoaRadian(
-        channelParams->m_reducedClusterNumber,
+        params.m_reducedClusterNumber,
         DoubleVector(table3gpp->m_raysPerCluster,
                      0)); // rayAoaRadian[n][m], where n is cluster index, m is ray index
     MatrixBasedChannelModel::Double2DVector rayAodRadian(
-        channelParams->m_reducedClusterNumber,
+        params.m_reducedClusterNumber,
         DoubleVector(table3gpp->m_raysPerCluster,
                      0)); // rayAodRadian[n][m], where n is cluster index, m is ray index
     MatrixBasedChannelModel::Double2DVector rayZoaRadian(
-        channelParams->m_reducedClusterNumber,
+        params.m_reducedClusterNumber,
         DoubleVector(table3gpp->m_raysPerCluster,
                      0)); // rayZoaRadian[n][m], where n is cluster index, m is ray index
     MatrixBasedChannelModel::Double2DVector rayZodRadian(
-        channelParams->m_reducedClusterNumber,
+        params.m_reducedClusterNumber,
         DoubleVector(table3gpp->m_raysPerCluster,
                      0)); // rayZodRadian[n][m], where n is cluster index, m is ray index
 
-    for (uint8_t nInd = 0; nInd < channelParams->m_reducedClusterNumber; nInd++)
+    for (uint8_t nInd = 0; nInd < params.m_reducedClusterNumber; nInd++)
     {
         for (uint8_t mInd = 0; mInd < table3gpp->m_raysPerCluster; mInd++)
         {
@@ -1654,26 +1777,34 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
         }
     }
 
-    for (uint8_t cIndex = 0; cIndex < channelParams->m_reducedClusterNumber; cIndex++)
+    for (uint8_t cIndex = 0; cIndex < params.m_reducedClusterNumber; cIndex++)
     {
-        Shuffle(&rayAodRadian[cIndex][0], &rayAodRadian[cIndex][table3gpp->m_raysPerCluster]);
-        Shuffle(&rayAoaRadian[cIndex][0], &rayAoaRadian[cIndex][table3gpp->m_raysPerCluster]);
-        Shuffle(&rayZodRadian[cIndex][0], &rayZodRadian[cIndex][table3gpp->m_raysPerCluster]);
-        Shuffle(&rayZoaRadian[cIndex][0], &rayZoaRadian[cIndex][table3gpp->m_raysPerCluster]);
+        Shuffle(&rayAodRadian[cIndex][0],
+                &rayAodRadian[cIndex][table3gpp->m_raysPerCluster],
+                values);
+        Shuffle(&rayAoaRadian[cIndex][0],
+                &rayAoaRadian[cIndex][table3gpp->m_raysPerCluster],
+                values);
+        Shuffle(&rayZodRadian[cIndex][0],
+                &rayZodRadian[cIndex][table3gpp->m_raysPerCluster],
+                values);
+        Shuffle(&rayZoaRadian[cIndex][0],
+                &rayZoaRadian[cIndex][table3gpp->m_raysPerCluster],
+                values);
     }
 
     // store values
-    channelParams->m_rayAodRadian = rayAodRadian;
-    channelParams->m_rayAoaRadian = rayAoaRadian;
-    channelParams->m_rayZodRadian = rayZodRadian;
-    channelParams->m_rayZoaRadian = rayZoaRadian;
+    params.m_rayAodRadian = rayAodRadian;
+    params.m_rayAoaRadian = rayAoaRadian;
+    params.m_rayZodRadian = rayZodRadian;
+    params.m_rayZoaRadian = rayZoaRadian;
 
     // Step 9: Generate the cross polarization power ratios
     // Step 10: Draw initial phases
     Double2DVector crossPolarizationPowerRatios; // vector containing the cross polarization power
                                                  // ratios, as defined by 7.5-21
     Double3DVector clusterPhase; // rayAoaRadian[n][m], where n is cluster index, m is ray index
-    for (uint8_t nInd = 0; nInd < channelParams->m_reducedClusterNumber; nInd++)
+    for (uint8_t nInd = 0; nInd < params.m_reducedClusterNumber; nInd++)
     {
         DoubleVector temp; // used to store the XPR values
         Double2DVector
@@ -1683,11 +1814,12 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
             double uXprLinear = pow(10, table3gpp->m_uXpr / 10);     // convert to linear
             double sigXprLinear = pow(10, table3gpp->m_sigXpr / 10); // convert to linear
 
-            temp.push_back(std::pow(10, (m_normalRv->GetValue() * sigXprLinear + uXprLinear) / 10));
+            temp.push_back(
+                std::pow(10, (values.GetNormal() * sigXprLinear + uXprLinear) / 10));
             DoubleVector temp3; // used to store the PHI valuse
             for (uint8_t pInd = 0; pInd < 4; pInd++)
             {
-                temp3.push_back(m_uniformRv->GetValue(-1 * M_PI, M_PI));
+                temp3.push_back(values.GetUniform(-1 * M_PI, M_PI));
             }
             temp2.push_back(temp3);
         }
@@ -1695,31 +1827,31 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
         clusterPhase.push_back(temp2);
     }
     // store the cluster phase
-    channelParams->m_clusterPhase = clusterPhase;
-    channelParams->m_crossPolarizationPowerRatios = crossPolarizationPowerRatios;
+    params.m_clusterPhase = clusterPhase;
+    params.m_crossPolarizationPowerRatios = crossPolarizationPowerRatios;
 
     uint8_t cluster1st = 0;
     uint8_t cluster2nd = 0; // first and second strongest cluster;
     double maxPower = 0;
-    for (uint8_t cIndex = 0; cIndex < channelParams->m_reducedClusterNumber; cIndex++)
+    for (uint8_t cIndex = 0; cIndex < params.m_reducedClusterNumber; cIndex++)
     {
-        if (maxPower < channelParams->m_clusterPower[cIndex])
+        if (maxPower < params.m_clusterPower[cIndex])
         {
-            maxPower = channelParams->m_clusterPower[cIndex];
+            maxPower = params.m_clusterPower[cIndex];
             cluster1st = cIndex;
         }
     }
-    channelParams->m_cluster1st = cluster1st;
+    params.m_cluster1st = cluster1st;
     maxPower = 0;
-    for (uint8_t cIndex = 0; cIndex < channelParams->m_reducedClusterNumber; cIndex++)
+    for (uint8_t cIndex = 0; cIndex < params.m_reducedClusterNumber; cIndex++)
     {
-        if (maxPower < channelParams->m_clusterPower[cIndex] && cluster1st != cIndex)
+        if (maxPower < params.m_clusterPower[cIndex] && cluster1st != cIndex)
         {
-            maxPower = channelParams->m_clusterPower[cIndex];
+            maxPower = params.m_clusterPower[cIndex];
             cluster2nd = cIndex;
         }
     }
-    channelParams->m_cluster2nd = cluster2nd;
+    params.m_cluster2nd = cluster2nd;
 
     NS_LOG_INFO("1st strongest cluster:" << +cluster1st
                                          << ", 2nd strongest cluster:" << +cluster2nd);
@@ -1782,12 +1914,12 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
         clusterZod.push_back(clusterZod[max]);
     }
 
-    channelParams->m_delay = clusterDelay;
-    channelParams->m_angle.clear();
-    channelParams->m_angle.push_back(clusterAoa);
-    channelParams->m_angle.push_back(clusterZoa);
-    channelParams->m_angle.push_back(clusterAod);
-    channelParams->m_angle.push_back(clusterZod);
+    params.m_delay = clusterDelay;
+    params.m_angle.clear();
+    params.m_angle.push_back(clusterAoa);
+    params.m_angle.push_back(clusterZoa);
+    params.m_angle.push_back(clusterAod);
+    params.m_angle.push_back(clusterZod);
 
     // Compute alpha and D as described in 3GPP TR 37.885 v15.3.0, Sec. 6.2.3
     // These terms account for an additional Doppler contribution due to the
@@ -1805,9 +1937,9 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
 
     // 2 or 4 is added to account for additional subrays for the 1st and 2nd clusters, if there is
     // only one cluster then would be added 2 more subrays (see creation of Husn channel matrix)
-    uint8_t updatedClusterNumber = (channelParams->m_reducedClusterNumber == 1)
-                                       ? channelParams->m_reducedClusterNumber + 2
-                                       : channelParams->m_reducedClusterNumber + 4;
+    uint8_t updatedClusterNumber = (params.m_reducedClusterNumber == 1)
+                                       ? params.m_reducedClusterNumber + 2
+                                       : params.m_reducedClusterNumber + 4;
 
     for (uint8_t cIndex = 0; cIndex < updatedClusterNumber; cIndex++)
     {
@@ -1815,18 +1947,181 @@ ThreeGppChannelModel::GenerateChannelParameters(const Ptr<const ChannelCondition
         double D = 0;
         if (cIndex != 0)
         {
-            alpha = m_uniformRvDoppler->GetValue(-1, 1);
-            D = m_uniformRvDoppler->GetValue(-m_vScatt, m_vScatt);
+            alpha = values.GetDoppler(-1, 1);
+            D = values.GetDoppler(-m_vScatt, m_vScatt);
         }
         dopplerTermAlpha.push_back(alpha);
         dopplerTermD.push_back(D);
     }
-    channelParams->m_alpha = dopplerTermAlpha;
-    channelParams->m_D = dopplerTermD;
+    params.m_alpha = dopplerTermAlpha;
+    params.m_D = dopplerTermD;
+
+    return params;
+}
+
+Ptr<ThreeGppChannelModel::ThreeGppChannelParams>
+ThreeGppChannelModel::GetPrecomputedChannelParameters(uint64_t channelParamsKey,
+                                                      Ptr<const ChannelCondition> channelCondition,
+                                                      Ptr<const ParamsTable> table3gpp,
+                                                      Ptr<const MobilityModel> aMob,
+                                                      Ptr<const MobilityModel> bMob)
+{
+    NS_LOG_FUNCTION(this << channelParamsKey);
+
+    ParamsInputs inputs;
+    inputs.losCondition = channelCondition->GetLosCondition();
+    inputs.o2iCondition = channelCondition->GetO2iCondition();
+    inputs.nodeIds =
+        std::make_pair(aMob->GetObject<Node>()->GetId(), bMob->GetObject<Node>()->GetId());
+    inputs.nodePositions = std::make_pair(aMob->GetPosition(), bMob->GetPosition());
+    inputs.table3gpp = PeekPointer(table3gpp);
+    Time now = Simulator::Now();
+
+    auto [it, inserted] = m_precomputations.try_emplace(channelParamsKey);
+    LinkPrecomputation& link = it->second;
+    Ptr<ThreeGppChannelParams> channelParams = Create<ThreeGppChannelParams>();
+    if (inserted)
+    {
+        // first generation of the params of this pair of nodes
+        ParamsRandomValues values(this);
+        SetChannelParams(channelParams,
+                         inputs,
+                         DoGenerateChannelParameters(inputs, values, nullptr),
+                         now);
+    }
+    else
+    {
+        // the predicted positions are computed differently than by the mobility
+        // models, hence they are compared with a tolerance (1 um) covering the
+        // rounding errors only
+        auto isClose = [](const Vector& a, const Vector& b) {
+            return CalculateDistance(a, b) < 1e-6;
+        };
+        bool sameOrder = (link.inputs.nodeIds == inputs.nodeIds);
+        const Vector& aPos =
+            sameOrder ? link.inputs.nodePositions.first : link.inputs.nodePositions.second;
+        const Vector& bPos =
+            sameOrder ? link.inputs.nodePositions.second : link.inputs.nodePositions.first;
+        bool predicted = (link.inputs.losCondition == inputs.losCondition &&
+                          link.inputs.o2iCondition == inputs.o2iCondition &&
+                          isClose(aPos, inputs.nodePositions.first) &&
+                          isClose(bPos, inputs.nodePositions.second));
+
+        // wait for the background generation to complete; the task is destroyed
+        // here, so that its captures are not released by a worker thread
+        GeneratedParams precomputed = link.params.get();
+        link.task.reset();
+        if (predicted)
+        {
+            NS_LOG_DEBUG("Use the channel params generated in the background");
+            SetChannelParams(channelParams, link.inputs, std::move(precomputed), now);
+            m_cacheStats.precomputedParams++;
+        }
+        else
+        {
+            NS_LOG_DEBUG("Generate the channel params with the current inputs");
+            link.values.Rewind(this);
+            SetChannelParams(channelParams,
+                             inputs,
+                             DoGenerateChannelParameters(inputs, link.values, nullptr),
+                             now);
+        }
+
+        // the update occurs at the first call to GetChannel after the expiration of
+        // the update period
+        link.updateDelay = std::max(now - link.expirationTime, Time(0));
+    }
+
+    // predict the inputs of the next update, assuming that the channel condition
+    // does not change, that the nodes keep moving with their current velocity and
+    // that the update is delayed as much as the current one
+    link.expirationTime = now + m_updatePeriod;
+    double dt = (m_updatePeriod + link.updateDelay).GetSeconds();
+    Vector aVel = aMob->GetVelocity();
+    Vector bVel = bMob->GetVelocity();
+    Vector aPos = inputs.nodePositions.first + Vector(aVel.x * dt, aVel.y * dt, aVel.z * dt);
+    Vector bPos = inputs.nodePositions.second + Vector(bVel.x * dt, bVel.y * dt, bVel.z * dt);
+    double x = aPos.x - bPos.x;
+    double y = aPos.y - bPos.y;
+    double distance2D = sqrt(x * x + y * y);
+    double hUt = std::min(aPos.z, bPos.z);
+    double hBs = std::max(aPos.z, bPos.z);
+
+    link.table3gpp = GetThreeGppTable(channelCondition, hBs, hUt, distance2D);
+    link.inputs = inputs;
+    link.inputs.nodePositions = std::make_pair(aPos, bPos);
+    link.inputs.table3gpp = PeekPointer(link.table3gpp);
+
+    // the random values of the next update are drawn now, whether or not the params
+    // are generated with the predicted inputs, so that the random variables are used
+    // in the same order in both cases
+    link.values.Draw(this, link.table3gpp);
+
+    // the job works on copies of the inputs and of the random values, which are plain
+    // data, and cannot draw values on demand, since it does not run on the simulation
+    // thread. The table referenced by the inputs is kept alive by the link and the
+    // task is owned by the link, so that no reference count is changed by the workers
+    link.task = std::make_unique<std::packaged_task<GeneratedParams()>>(
+        [this, inputs = link.inputs, values = link.values]() mutable {
+            values.Rewind(nullptr);
+            return DoGenerateChannelParameters(inputs, values, nullptr);
+        });
+    link.params = link.task->get_future();
+
+    std::unique_lock<std::mutex> lock(m_jobsMutex);
+    if (m_workers.empty())
+    {
+        NS_LOG_DEBUG("Start " << m_precomputeThreads << " worker threads");
+        m_stopWorkers = false;
+        for (uint32_t i = 0; i < m_precomputeThreads; i++)
+        {
+            m_workers.emplace_back(&ThreeGppChannelModel::RunWorker, this);
+        }
+    }
+    m_jobs.push_back(link.task.get());
+    lock.unlock();
+    m_jobsCondition.notify_one();
 
     return channelParams;
 }
 
+void
+ThreeGppChannelModel::RunWorker()
+{
+    while (true)
+    {
+        std::packaged_task<GeneratedParams()>* job;
+        {
+            std::unique_lock<std::mutex> lock(m_jobsMutex);
+            m_jobsCondition.wait(lock, [this]() { return m_stopWorkers || !m_jobs.empty(); });
+            if (m_jobs.empty())
+            {
+                // the worker threads have to stop and all the jobs are completed
+                return;
+            }
+            job = m_jobs.front();
+            m_jobs.pop_front();
+        }
+        (*job)();
+    }
+}
+
+void
+ThreeGppChannelModel::StopWorkers()
+{
+    NS_LOG_FUNCTION(this);
+    {
+        std::unique_lock<std::mutex> lock(m_jobsMutex);
+        m_stopWorkers = true;
+    }
+    m_jobsCondition.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+    m_workers.clear();
+}
+
 Ptr<MatrixBasedChannelModel::ChannelMatrix>
 ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelParams,
                                     Ptr<const ParamsTable> table3gpp,
@@ -1874,38 +2169,33 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
 
     // Step 11: Generate channel coefficients for each cluster n and each receiver
     //  and transmitter element pair u,s.
-    Complex3DVector hUsn; // channel coffecient hUsn[u][s][n];
     // where u and s are receive and transmit antenna element, n is cluster index.
     // NOTE Since each of the strongest 2 clusters are divided into 3 sub-clusters,
-    // the total cluster will be numReducedCLuster + 4.
+    // the total cluster will be numReducedCLuster + 4. The coefficients of the
+    // second and third sub-clusters are stored after those of the reduced clusters,
+    // in increasing order of the index of the cluster they are derived from.
     uint64_t uSize = uAntenna->GetNumberOfElements();
     uint64_t sSize = sAntenna->GetNumberOfElements();
-
-    hUsn.resize(uSize);
-    for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
-    {
-        hUsn[uIndex].resize(sSize);
-        for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
-        {
-            hUsn[uIndex][sIndex].resize(channelParams->m_reducedClusterNumber);
-        }
-    }
-
-    NS_ASSERT(channelParams->m_reducedClusterNumber <= channelParams->m_clusterPhase.size());
-    NS_ASSERT(channelParams->m_reducedClusterNumber <= channelParams->m_clusterPower.size());
-    NS_ASSERT(channelParams->m_reducedClusterNumber <=
-              channelParams->m_crossPolarizationPowerRatios.size());
-    NS_ASSERT(channelParams->m_reducedClusterNumber <= rayZoaRadian.size());
-    NS_ASSERT(channelParams->m_reducedClusterNumber <= rayZodRadian.size());
-    NS_ASSERT(channelParams->m_reducedClusterNumber <= rayAoaRadian.size());
-    NS_ASSERT(channelParams->m_reducedClusterNumber <= rayAodRadian.size());
-    NS_ASSERT(table3gpp->m_raysPerCluster <= channelParams->m_clusterPhase[0].size());
-    NS_ASSERT(table3gpp->m_raysPerCluster <=
-              channelParams->m_crossPolarizationPowerRatios[0].size());
-    NS_ASSERT(table3gpp->m_raysPerCluster <= rayZoaRadian[0].size());
-    NS_ASSERT(table3gpp->m_raysPerCluster <= rayZodRadian[0].size());
-    NS_ASSERT(table3gpp->m_raysPerCluster <= rayAoaRadian[0].size());
-    NS_ASSERT(table3gpp->m_raysPerCluster <= rayAodRadian[0].size());
+    uint8_t numReducedCluster = channelParams->m_reducedClusterNumber;
+    uint8_t firstStrongCluster = std::min(channelParams->m_cluster1st, channelParams->m_cluster2nd);
+    uint8_t numSubClusters = (channelParams->m_cluster1st == channelParams->m_cluster2nd) ? 2 : 4;
+    uint8_t raysPerCluster = table3gpp->m_raysPerCluster;
+
+    Complex3DVector hUsn(uSize, sSize, numReducedCluster + numSubClusters); // hUsn(u, s, n)
+
+    NS_ASSERT(numReducedCluster <= channelParams->m_clusterPhase.size());
+    NS_ASSERT(numReducedCluster <= channelParams->m_clusterPower.size());
+    NS_ASSERT(numReducedCluster <= channelParams->m_crossPolarizationPowerRatios.size());
+    NS_ASSERT(numReducedCluster <= rayZoaRadian.size());
+    NS_ASSERT(numReducedCluster <= rayZodRadian.size());
+    NS_ASSERT(numReducedCluster <= rayAoaRadian.size());
+    NS_ASSERT(numReducedCluster <= rayAodRadian.size());
+    NS_ASSERT(raysPerCluster <= channelParams->m_clusterPhase[0].size());
+    NS_ASSERT(raysPerCluster <= channelParams->m_crossPolarizationPowerRatios[0].size());
+    NS_ASSERT(raysPerCluster <= rayZoaRadian[0].size());
+    NS_ASSERT(raysPerCluster <= rayZodRadian[0].size());
+    NS_ASSERT(raysPerCluster <= rayAoaRadian[0].size());
+    NS_ASSERT(raysPerCluster <= rayAodRadian[0].size());
 
     double x = sMob->GetPosition().x - uMob->GetPosition().x;
     double y = sMob->GetPosition().y - uMob->GetPosition().y;
@@ -1920,70 +2210,122 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
     Angles sAngle(uMob->GetPosition(), sMob->GetPosition());
     Angles uAngle(sMob->GetPosition(), uMob->GetPosition());
 
+    // The field patterns, the polarization terms and the directions of the rays do
+    // not depend on the antenna elements, hence they are computed once per ray
+    // (with arrays indexed by (ray, cluster)). Only the phase differences due to the
+    // location of the elements are computed for each element.
+    ComplexValArray polarization(raysPerCluster, numReducedCluster);
+    ValArray<Vector> rxDirection(raysPerCluster, numReducedCluster);
+    ValArray<Vector> txDirection(raysPerCluster, numReducedCluster);
+    for (uint8_t nIndex = 0; nIndex < numReducedCluster; nIndex++)
+    {
+        bool isStrongCluster =
+            (nIndex == channelParams->m_cluster1st || nIndex == channelParams->m_cluster2nd);
+        for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
+        {
+            const DoubleVector& initialPhase = channelParams->m_clusterPhase[nIndex][mIndex];
+            NS_ASSERT(4 <= initialPhase.size());
+            double k = channelParams->m_crossPolarizationPowerRatios[nIndex][mIndex];
+            // lambda_0 is accounted in the antenna spacing uLoc and sLoc.
+            rxDirection(mIndex, nIndex) =
+                Vector(sin(rayZoaRadian[nIndex][mIndex]) * cos(rayAoaRadian[nIndex][mIndex]),
+                       sin(rayZoaRadian[nIndex][mIndex]) * sin(rayAoaRadian[nIndex][mIndex]),
+                       cos(rayZoaRadian[nIndex][mIndex]));
+            txDirection(mIndex, nIndex) =
+                Vector(sin(rayZodRadian[nIndex][mIndex]) * cos(rayAodRadian[nIndex][mIndex]),
+                       sin(rayZodRadian[nIndex][mIndex]) * sin(rayAodRadian[nIndex][mIndex]),
+                       cos(rayZodRadian[nIndex][mIndex]));
+
+            double rxFieldPatternPhi;
+            double rxFieldPatternTheta;
+            double txFieldPatternPhi;
+            double txFieldPatternTheta;
+            if (!isStrongCluster)
+            {
+                std::tie(rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern(
+                    Angles(channelParams->m_rayAoaRadian[nIndex][mIndex],
+                           channelParams->m_rayZoaRadian[nIndex][mIndex]));
+                std::tie(txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern(
+                    Angles(channelParams->m_rayAodRadian[nIndex][mIndex],
+                           channelParams->m_rayZodRadian[nIndex][mIndex]));
+            }
+            else
+            {
+                // ZML:Just remind me that the angle offsets for the 3 subclusters were not
+                // generated correctly.
+                std::tie(rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern(
+                    Angles(rayAoaRadian[nIndex][mIndex], rayZoaRadian[nIndex][mIndex]));
+                std::tie(txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern(
+                    Angles(rayAodRadian[nIndex][mIndex], rayZodRadian[nIndex][mIndex]));
+            }
+            polarization(mIndex, nIndex) =
+                std::complex<double>(cos(initialPhase[0]), sin(initialPhase[0])) *
+                    rxFieldPatternTheta * txFieldPatternTheta +
+                std::complex<double>(cos(initialPhase[1]), sin(initialPhase[1])) *
+                    std::sqrt(1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
+                std::complex<double>(cos(initialPhase[2]), sin(initialPhase[2])) *
+                    std::sqrt(1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
+                std::complex<double>(cos(initialPhase[3]), sin(initialPhase[3])) *
+                    rxFieldPatternPhi * txFieldPatternPhi;
+        }
+    }
+
+    // phase shifts of the rays at the transmit antenna elements, indexed by (ray, cluster, s)
+    ComplexValArray txPhaseShifts(raysPerCluster, numReducedCluster, sSize);
+    for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
+    {
+        Vector sLoc = sAntenna->GetElementLocation(sIndex);
+        std::complex<double>* txPhaseShift = txPhaseShifts.GetPagePtr(sIndex);
+        for (std::size_t i = 0; i < txDirection.GetSize(); i++)
+        {
+            double txPhaseDiff = 2 * M_PI *
+                                 (txDirection[i].x * sLoc.x + txDirection[i].y * sLoc.y +
+                                  txDirection[i].z * sLoc.z);
+            txPhaseShift[i] = std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+        }
+    }
+
+    // phase shifts of the rays at the current receive antenna element, indexed by (ray, cluster)
+    ComplexValArray rxPhaseShifts(raysPerCluster, numReducedCluster);
+
     // The following for loops computes the channel coefficients
     for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
     {
         Vector uLoc = uAntenna->GetElementLocation(uIndex);
+        for (std::size_t i = 0; i < rxDirection.GetSize(); i++)
+        {
+            double rxPhaseDiff = 2 * M_PI *
+                                 (rxDirection[i].x * uLoc.x + rxDirection[i].y * uLoc.y +
+                                  rxDirection[i].z * uLoc.z);
+            rxPhaseShifts[i] = std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff));
+        }
 
         for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
         {
             Vector sLoc = sAntenna->GetElementLocation(sIndex);
 
-            for (uint8_t nIndex = 0; nIndex < channelParams->m_reducedClusterNumber; nIndex++)
+            for (uint8_t nIndex = 0; nIndex < numReducedCluster; nIndex++)
             {
+                // the rays of a cluster are contiguous
+                const std::complex<double>* pol = &polarization(0, nIndex);
+                const std::complex<double>* rxShift = &rxPhaseShifts(0, nIndex);
+                const std::complex<double>* txShift = &txPhaseShifts(0, nIndex, sIndex);
+                double clusterAmplitude =
+                    sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
+
                 // Compute the N-2 weakest cluster, assuming 0 slant angle and a
                 // polarization slant angle configured in the array (7.5-22)
                 if (nIndex != channelParams->m_cluster1st && nIndex != channelParams->m_cluster2nd)
                 {
                     std::complex<double> rays(0, 0);
-                    for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
+                    for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
                     {
-                        DoubleVector initialPhase = channelParams->m_clusterPhase[nIndex][mIndex];
-                        double k = channelParams->m_crossPolarizationPowerRatios[nIndex][mIndex];
-                        // lambda_0 is accounted in the antenna spacing uLoc and sLoc.
-                        double rxPhaseDiff = 2 * M_PI *
-                                             (sin(rayZoaRadian[nIndex][mIndex]) *
-                                                  cos(rayAoaRadian[nIndex][mIndex]) * uLoc.x +
-                                              sin(rayZoaRadian[nIndex][mIndex]) *
-                                                  sin(rayAoaRadian[nIndex][mIndex]) * uLoc.y +
-                                              cos(rayZoaRadian[nIndex][mIndex]) * uLoc.z);
-
-                        double txPhaseDiff = 2 * M_PI *
-                                             (sin(rayZodRadian[nIndex][mIndex]) *
-                                                  cos(rayAodRadian[nIndex][mIndex]) * sLoc.x +
-                                              sin(rayZodRadian[nIndex][mIndex]) *
-                                                  sin(rayAodRadian[nIndex][mIndex]) * sLoc.y +
-                                              cos(rayZodRadian[nIndex][mIndex]) * sLoc.z);
                         // NOTE Doppler is computed in the CalcBeamformingGain function and is
                         // simplified to only account for the center angle of each cluster.
-
-                        double rxFieldPatternPhi;
-                        double rxFieldPatternTheta;
-                        double txFieldPatternPhi;
-                        double txFieldPatternTheta;
-                        std::tie(rxFieldPatternPhi, rxFieldPatternTheta) =
-                            uAntenna->GetElementFieldPattern(
-                                Angles(channelParams->m_rayAoaRadian[nIndex][mIndex],
-                                       channelParams->m_rayZoaRadian[nIndex][mIndex]));
-                        std::tie(txFieldPatternPhi, txFieldPatternTheta) =
-                            sAntenna->GetElementFieldPattern(
-                                Angles(channelParams->m_rayAodRadian[nIndex][mIndex],
-                                       channelParams->m_rayZodRadian[nIndex][mIndex]));
-                        NS_ASSERT(4 <= initialPhase.size());
-                        rays += (std::complex<double>(cos(initialPhase[0]), sin(initialPhase[0])) *
-                                     rxFieldPatternTheta * txFieldPatternTheta +
-                                 std::complex<double>(cos(initialPhase[1]), sin(initialPhase[1])) *
-                                     std::sqrt(1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
-                                 std::complex<double>(cos(initialPhase[2]), sin(initialPhase[2])) *
-                                     std::sqrt(1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
-                                 std::complex<double>(cos(initialPhase[3]), sin(initialPhase[3])) *
-                                     rxFieldPatternPhi * txFieldPatternPhi) *
-                                std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
-                                std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+                        rays += pol[mIndex] * rxShift[mIndex] * txShift[mIndex];
                     }
-                    rays *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                    hUsn[uIndex][sIndex][nIndex] = rays;
+                    rays *= clusterAmplitude;
+                    hUsn(uIndex, sIndex, nIndex) = rays;
                 }
                 else //(7.5-28)
                 {
@@ -1991,50 +2333,10 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
                     std::complex<double> raysSub2(0, 0);
                     std::complex<double> raysSub3(0, 0);
 
-                    for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
+                    for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
                     {
-                        double k = channelParams->m_crossPolarizationPowerRatios[nIndex][mIndex];
-
-                        // ZML:Just remind me that the angle offsets for the 3 subclusters were not
-                        // generated correctly.
-                        DoubleVector initialPhase = channelParams->m_clusterPhase[nIndex][mIndex];
-                        NS_ASSERT(4 <= initialPhase.size());
-
-                        double rxPhaseDiff = 2 * M_PI *
-                                             (sin(rayZoaRadian[nIndex][mIndex]) *
-                                                  cos(rayAoaRadian[nIndex][mIndex]) * uLoc.x +
-                                              sin(rayZoaRadian[nIndex][mIndex]) *
-                                                  sin(rayAoaRadian[nIndex][mIndex]) * uLoc.y +
-                                              cos(rayZoaRadian[nIndex][mIndex]) * uLoc.z);
-                        double txPhaseDiff = 2 * M_PI *
-                                             (sin(rayZodRadian[nIndex][mIndex]) *
-                                                  cos(rayAodRadian[nIndex][mIndex]) * sLoc.x +
-                                              sin(rayZodRadian[nIndex][mIndex]) *
-                                                  sin(rayAodRadian[nIndex][mIndex]) * sLoc.y +
-                                              cos(rayZodRadian[nIndex][mIndex]) * sLoc.z);
-
-                        double rxFieldPatternPhi;
-                        double rxFieldPatternTheta;
-                        double txFieldPatternPhi;
-                        double txFieldPatternTheta;
-                        std::tie(rxFieldPatternPhi, rxFieldPatternTheta) =
-                            uAntenna->GetElementFieldPattern(
-                                Angles(rayAoaRadian[nIndex][mIndex], rayZoaRadian[nIndex][mIndex]));
-                        std::tie(txFieldPatternPhi, txFieldPatternTheta) =
-                            sAntenna->GetElementFieldPattern(
-                                Angles(rayAodRadian[nIndex][mIndex], rayZodRadian[nIndex][mIndex]));
-
                         std::complex<double> raySub =
-                            (std::complex<double>(cos(initialPhase[0]), sin(initialPhase[0])) *
-                                 rxFieldPatternTheta * txFieldPatternTheta +
-                             std::complex<double>(cos(initialPhase[1]), sin(initialPhase[1])) *
-                                 sqrt(1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
-                             std::complex<double>(cos(initialPhase[2]), sin(initialPhase[2])) *
-                                 sqrt(1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
-                             std::complex<double>(cos(initialPhase[3]), sin(initialPhase[3])) *
-                                 rxFieldPatternPhi * txFieldPatternPhi) *
-                            std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
-                            std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+                            pol[mIndex] * rxShift[mIndex] * txShift[mIndex];
 
                         switch (mIndex)
                         {
@@ -2057,15 +2359,14 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
                             break;
                         }
                     }
-                    raysSub1 *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                    raysSub2 *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                    raysSub3 *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                    hUsn[uIndex][sIndex][nIndex] = raysSub1;
-                    hUsn[uIndex][sIndex].push_back(raysSub2);
-                    hUsn[uIndex][sIndex].push_back(raysSub3);
+                    raysSub1 *= clusterAmplitude;
+                    raysSub2 *= clusterAmplitude;
+                    raysSub3 *= clusterAmplitude;
+                    uint8_t subClusterIndex =
+                        numReducedCluster + (nIndex == firstStrongCluster ? 0 : 2);
+                    hUsn(uIndex, sIndex, nIndex) = raysSub1;
+                    hUsn(uIndex, sIndex, subClusterIndex) = raysSub2;
+                    hUsn(uIndex, sIndex, subClusterIndex + 1) = raysSub3;
                 }
             }
 
@@ -2103,14 +2404,13 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
 
                 double kLinear = pow(10, channelParams->m_K_factor / 10);
                 // the LOS path should be attenuated if blockage is enabled.
-                hUsn[uIndex][sIndex][0] =
-                    sqrt(1 / (kLinear + 1)) * hUsn[uIndex][sIndex][0] +
+                hUsn(uIndex, sIndex, 0) =
+                    sqrt(1 / (kLinear + 1)) * hUsn(uIndex, sIndex, 0) +
                     sqrt(kLinear / (1 + kLinear)) * ray /
                         pow(10, channelParams->m_attenuation_dB[0] / 10); //(7.5-30) for tau = tau1
-                double tempSize = hUsn[uIndex][sIndex].size();
-                for (uint8_t nIndex = 1; nIndex < tempSize; nIndex++)
+                for (std::size_t nIndex = 1; nIndex < hUsn.GetNumPages(); nIndex++)
                 {
-                    hUsn[uIndex][sIndex][nIndex] *=
+                    hUsn(uIndex, sIndex, nIndex) *=
                         sqrt(1 / (kLinear + 1)); //(7.5-30) for tau = tau2...taunN
                 }
             }
@@ -2118,18 +2418,12 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
     }
 
     NS_LOG_DEBUG("Husn (sAntenna, uAntenna):" << sAntenna->GetId() << ", " << uAntenna->GetId());
-    for (auto& i : hUsn)
+    for (std::size_t i = 0; i < hUsn.GetSize(); i++)
     {
-        for (auto& j : i)
-        {
-            for (auto& k : j)
-            {
-                NS_LOG_DEBUG(" " << k << ",");
-            }
-        }
+        NS_LOG_DEBUG(" " << hUsn[i] << ",");
     }
-    NS_LOG_INFO("size of coefficient matrix =[" << hUsn.size() << "][" << hUsn[0].size() << "]["
-                                                << hUsn[0][0].size() << "]");
+    NS_LOG_INFO("size of coefficient matrix =[" << hUsn.GetNumRows() << "][" << hUsn.GetNumCols()
+                                                << "][" << hUsn.GetNumPages() << "]");
     channelMatrix->m_channel = hUsn;
     return channelMatrix;
 }
@@ -2407,12 +2701,111 @@ ThreeGppChannelModel::CalcAttenuationOfBlockage(
 }
 
 void
-ThreeGppChannelModel::Shuffle(double* first, double* last) const
+ThreeGppChannelModel::Shuffle(double* first, double* last, ParamsRandomValues& values) const
 {
     for (auto i = (last - first) - 1; i > 0; --i)
     {
-        std::swap(first[i], first[m_uniformRvShuffle->GetInteger(0, i)]);
+        std::swap(first[i], first[values.GetShuffleInteger(i)]);
+    }
+}
+
+ThreeGppChannelModel::ParamsRandomValues::ParamsRandomValues(const ThreeGppChannelModel* model)
+    : m_model(model)
+{
+}
+
+void
+ThreeGppChannelModel::ParamsRandomValues::Draw(const ThreeGppChannelModel* model,
+                                               Ptr<const ParamsTable> table3gpp)
+{
+    // see DoGenerateChannelParameters: up to 7 LSPs, then one value per cluster
+    // for the delays and the shadowing, five per cluster for the angles, one per
+    // ray for the XPR, four per ray for the phases, one per ray but the first
+    // for each of the four shuffles and two per cluster (including up to four
+    // sub-clusters but the first cluster) for the Doppler terms
+    std::size_t nClusters = table3gpp->m_numOfCluster;
+    std::size_t nRays = nClusters * table3gpp->m_raysPerCluster;
+    m_normal.resize(7 + 5 * nClusters + nRays);
+    m_uniform.resize(2 * nClusters + 4 * nRays);
+    m_shuffle.resize(4 * (nRays - nClusters));
+    m_doppler.resize(2 * (nClusters + 3));
+    for (auto& value : m_normal)
+    {
+        value = model->m_normalRv->GetValue();
+    }
+    for (auto& value : m_uniform)
+    {
+        value = model->m_uniformRv->GetValue(0, 1);
+    }
+    for (auto& value : m_shuffle)
+    {
+        value = model->m_uniformRvShuffle->GetValue(0, 1);
+    }
+    for (auto& value : m_doppler)
+    {
+        value = model->m_uniformRvDoppler->GetValue(0, 1);
+    }
+    Rewind(nullptr);
+}
+
+void
+ThreeGppChannelModel::ParamsRandomValues::Rewind(const ThreeGppChannelModel* model)
+{
+    m_model = model;
+    m_normalIndex = 0;
+    m_uniformIndex = 0;
+    m_shuffleIndex = 0;
+    m_dopplerIndex = 0;
+}
+
+double
+ThreeGppChannelModel::ParamsRandomValues::GetNormal()
+{
+    if (m_normalIndex < m_normal.size())
+    {
+        return m_normal[m_normalIndex++];
     }
+    NS_ASSERT_MSG(m_model, "No more normal values drawn in advance");
+    return m_model->m_normalRv->GetValue();
+}
+
+double
+ThreeGppChannelModel::ParamsRandomValues::GetUniform(double min, double max)
+{
+    if (m_uniformIndex < m_uniform.size())
+    {
+        return min + m_uniform[m_uniformIndex++] * (max - min);
+    }
+    NS_ASSERT_MSG(m_model, "No more uniform values drawn in advance");
+    return m_model->m_uniformRv->GetValue(min, max);
+}
+
+uint32_t
+ThreeGppChannelModel::ParamsRandomValues::GetShuffleInteger(uint32_t max)
+{
+    if (m_shuffleIndex < m_shuffle.size())
+    {
+        return static_cast<uint32_t>(m_shuffle[m_shuffleIndex++] * (max + 1.0));
+    }
+    NS_ASSERT_MSG(m_model, "No more values to shuffle the rays drawn in advance");
+    return m_model->m_uniformRvShuffle->GetInteger(0, max);
+}
+
+double
+ThreeGppChannelModel::ParamsRandomValues::GetDoppler(double min, double max)
+{
+    if (m_dopplerIndex < m_doppler.size())
+    {
+        return min + m_doppler[m_dopplerIndex++] * (max - min);
+    }
+    NS_ASSERT_MSG(m_model, "No more values for the Doppler terms drawn in advance");
+    return m_model->m_uniformRvDoppler->GetValue(min, max);
+}
+
+const ThreeGppChannelModel::CacheStats&
+ThreeGppChannelModel::GetCacheStats() const
+{
+    return m_cacheStats;
 }
 
 int64_t
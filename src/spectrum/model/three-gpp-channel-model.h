@@ -30,7 +30,14 @@
 #include <ns3/random-variable-stream.h>
 
 #include <complex.h>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -139,6 +146,27 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
      */
     int64_t AssignStreams(int64_t stream);
 
+    /**
+     * Counters of the lookups in the maps storing the channel params and the
+     * channel matrices
+     */
+    struct CacheStats
+    {
+        uint64_t paramsHits{0};        //!< number of times the stored channel params were reused
+        uint64_t paramsMisses{0};      //!< number of times the channel params were (re)generated
+        uint64_t matrixHits{0};        //!< number of times a stored channel matrix was reused
+        uint64_t matrixMisses{0};      //!< number of times a channel matrix was (re)generated
+        uint64_t staticReuses{0};      //!< number of times the channel params of a link whose nodes
+                                       //!< did not move were kept after the update period expired
+        uint64_t precomputedParams{0}; //!< number of times the channel params generated in the
+                                       //!< background were used
+    };
+
+    /**
+     * \return the counters of the lookups performed by GetChannel
+     */
+    const CacheStats& GetCacheStats() const;
+
   protected:
     /**
      * Wrap an (azimuth, inclination) angle pair in a valid range.
@@ -155,13 +183,6 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
      */
     static std::pair<double, double> WrapAngles(double azimuthRad, double inclinationRad);
 
-    /**
-     * \brief Shuffle the elements of a simple sequence container of type double
-     * \param first Pointer to the first element among the elements to be shuffled
-     * \param last Pointer to the last element among the elements to be shuffled
-     */
-    void Shuffle(double* first, double* last) const;
-
     /**
      * Extends the struct ChannelParams by including information that is used
      * within the ThreeGppChannelModel class
@@ -179,6 +200,9 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
         MatrixBasedChannelModel::Double2DVector m_nonSelfBlocking; //!< store the blockages
         Vector m_preLocUT; //!< location of UT when generating the previous channel
         Vector m_locUT;    //!< location of UT
+        std::pair<Vector, Vector>
+            m_nodePositions; //!< positions of the nodes (in the order of m_nodeIds) when
+                             //!< the channel params were generated
         MatrixBasedChannelModel::Double2DVector
             m_norRvAngles; //!< stores the normal variable for random angles angle[cluster][id]
                            //!< generated for equation (7.6-11)-(7.6-14), where id =
@@ -245,6 +269,85 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
                               //!< ASA, ZSD, ZSA]
     };
 
+    /**
+     * The random values used to generate the channel params of a pair of nodes.
+     * They are either drawn on demand from the random variables of the model or
+     * taken from values drawn in advance by Draw(), so that the params can be
+     * generated out of the simulation thread. When the values drawn in advance
+     * are exhausted, the next values are drawn on demand, if allowed.
+     */
+    class ParamsRandomValues
+    {
+      public:
+        /**
+         * Create an object drawing the values on demand from the random variables
+         * of the given model
+         * \param model the model whose random variables are used, or nullptr to
+         *              forbid the draws on demand
+         */
+        ParamsRandomValues(const ThreeGppChannelModel* model = nullptr);
+
+        /**
+         * Draw in advance from the random variables of the given model the largest
+         * number of values needed to generate the channel params with the given table
+         * \param model the model whose random variables are used
+         * \param table3gpp the 3GPP parameters table
+         */
+        void Draw(const ThreeGppChannelModel* model, Ptr<const ParamsTable> table3gpp);
+
+        /**
+         * Restart from the first value drawn in advance
+         * \param model the model whose random variables are used when the values
+         *              drawn in advance are exhausted, or nullptr to forbid it
+         */
+        void Rewind(const ThreeGppChannelModel* model);
+
+        /**
+         * \return a value of the standard normal distribution
+         */
+        double GetNormal();
+
+        /**
+         * \param min the lower bound
+         * \param max the upper bound
+         * \return a value uniformly distributed in [min, max)
+         */
+        double GetUniform(double min, double max);
+
+        /**
+         * \param max the upper bound
+         * \return an integer uniformly distributed in [0, max], used to shuffle the rays
+         */
+        uint32_t GetShuffleInteger(uint32_t max);
+
+        /**
+         * \param min the lower bound
+         * \param max the upper bound
+         * \return a value uniformly distributed in [min, max), used to compute the
+         *         additional Doppler contribution
+         */
+        double GetDoppler(double min, double max);
+
+      private:
+        const ThreeGppChannelModel* m_model; //!< the model drawing the values on demand
+        std::vector<double> m_normal;        //!< standard normal values drawn in advance
+        std::vector<double> m_uniform;       //!< uniform values in [0, 1) drawn in advance
+        std::vector<double> m_shuffle;       //!< uniform values in [0, 1) to shuffle the rays
+        std::vector<double> m_doppler;       //!< uniform values in [0, 1) for the Doppler terms
+        std::size_t m_normalIndex{0};        //!< index of the next normal value
+        std::size_t m_uniformIndex{0};       //!< index of the next uniform value
+        std::size_t m_shuffleIndex{0};       //!< index of the next value to shuffle the rays
+        std::size_t m_dopplerIndex{0};       //!< index of the next value for the Doppler terms
+    };
+
+    /**
+     * \brief Shuffle the elements of a simple sequence container of type double
+     * \param first Pointer to the first element among the elements to be shuffled
+     * \param last Pointer to the last element among the elements to be shuffled
+     * \param values the random values used to shuffle the elements
+     */
+    void Shuffle(double* first, double* last, ParamsRandomValues& values) const;
+
     /**
      * Get the parameters needed to apply the channel generation procedure
      * \param channelCondition the channel condition
@@ -319,13 +422,22 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
         const DoubleVector& clusterZOA) const;
 
     /**
-     * Check if the channel params has to be updated
+     * Check if the channel params has to be updated. When the update period is
+     * over, the channel params are kept if KeepStaticChannels is enabled and neither
+     * node moved since the channel params were generated, because the spatially
+     * consistent update of the channel (procedure A in Sec. 7.6.3.2 of 3GPP TR 38.901)
+     * does not change the parameters of a link whose end points are still.
+     *
      * \param channelParams channel params
      * \param channelCondition the channel condition
+     * \param aMob mobility model of the a device
+     * \param bMob mobility model of the b device
      * \return true if the channel params has to be updated, false otherwise
      */
     bool ChannelParamsNeedsUpdate(Ptr<const ThreeGppChannelParams> channelParams,
-                                  Ptr<const ChannelCondition> channelCondition) const;
+                                  Ptr<const ChannelCondition> channelCondition,
+                                  Ptr<const MobilityModel> aMob,
+                                  Ptr<const MobilityModel> bMob) const;
 
     /**
      * Check if the channel matrix has to be updated (it needs update when the channel params
@@ -337,6 +449,129 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
     bool ChannelMatrixNeedsUpdate(Ptr<const ThreeGppChannelParams> channelParams,
                                   Ptr<const ChannelMatrix> channelMatrix);
 
+    /**
+     * The inputs of the generation of the channel params of a pair of nodes
+     */
+    struct ParamsInputs
+    {
+        ChannelCondition::LosConditionValue losCondition; //!< the LOS condition
+        ChannelCondition::O2iConditionValue o2iCondition; //!< the O2I condition
+        std::pair<uint32_t, uint32_t> nodeIds;            //!< the IDs of the nodes a and b
+        std::pair<Vector, Vector> nodePositions;          //!< the positions of the nodes a and b
+        const ParamsTable* table3gpp{nullptr};            //!< the 3GPP parameters table, kept
+                                                          //!< alive by the caller
+    };
+
+    /**
+     * The channel params generated by DoGenerateChannelParameters, stored in plain
+     * data so that they can be generated out of the simulation thread. The members
+     * are those of ThreeGppChannelParams with the same name.
+     */
+    struct GeneratedParams
+    {
+        DoubleVector m_delay;                          //!< cluster delays
+        Double2DVector m_angle;                        //!< cluster angles
+        DoubleVector m_alpha;                          //!< alpha term per cluster
+        DoubleVector m_D;                              //!< D term per cluster
+        double m_DS{0};                                //!< delay spread
+        double m_K_factor{0};                          //!< K factor
+        uint8_t m_reducedClusterNumber{0};             //!< reduced cluster number
+        Double2DVector m_rayAodRadian;                 //!< AOD angles
+        Double2DVector m_rayAoaRadian;                 //!< AOA angles
+        Double2DVector m_rayZodRadian;                 //!< ZOD angles
+        Double2DVector m_rayZoaRadian;                 //!< ZOA angles
+        Double3DVector m_clusterPhase;                 //!< initial random phases
+        Double2DVector m_crossPolarizationPowerRatios; //!< cross polarization ratios
+        DoubleVector m_clusterPower;                   //!< cluster powers
+        DoubleVector m_attenuation_dB;                 //!< blockage attenuations
+        uint8_t m_cluster1st{0};                       //!< first strongest cluster
+        uint8_t m_cluster2nd{0};                       //!< second strongest cluster
+    };
+
+    /**
+     * Generate the channel params of a pair of nodes, as described in the
+     * documentation of GenerateChannelParameters. This method does not access
+     * the simulator, the mobility models nor any reference counted object, hence
+     * it can be run by the worker threads, provided that the blockage model is
+     * disabled.
+     *
+     * \param inputs the inputs of the generation
+     * \param values the random values to use
+     * \param channelParams the channel params object storing the state of the
+     *                      blockage model, only used if the blockage model is enabled
+     * \return the channel params
+     */
+    GeneratedParams DoGenerateChannelParameters(const ParamsInputs& inputs,
+                                                ParamsRandomValues& values,
+                                                ThreeGppChannelParams* channelParams) const;
+
+    /**
+     * Store the given generated channel params in a channel params object
+     *
+     * \param channelParams the channel params object
+     * \param inputs the inputs of the generation
+     * \param params the generated channel params
+     * \param generatedTime the generation time
+     */
+    static void SetChannelParams(Ptr<ThreeGppChannelParams> channelParams,
+                                 const ParamsInputs& inputs,
+                                 GeneratedParams&& params,
+                                 Time generatedTime);
+
+    /**
+     * Return the channel params of the pair of nodes a and b for the current update,
+     * when the update period is not zero. At each update, the inputs of the next
+     * update are predicted, assuming that the channel condition does not change,
+     * that the nodes keep moving with their current velocity and that the delay
+     * between the expiration of the update period and the update is the same as
+     * for the current update, and the random values of the next update are drawn
+     * in advance. The params are generated with the predicted inputs by the worker
+     * threads, and are used if the prediction turns out right, otherwise they are
+     * generated now with the current inputs. In both cases, the same random values
+     * are used, hence the params do not depend on the number of worker threads.
+     *
+     * \param channelParamsKey the key of the pair of nodes
+     * \param channelCondition the channel condition
+     * \param table3gpp the 3GPP parameters table
+     * \param aMob the a node mobility model
+     * \param bMob the b node mobility model
+     * \return the channel params
+     */
+    Ptr<ThreeGppChannelParams> GetPrecomputedChannelParameters(
+        uint64_t channelParamsKey,
+        Ptr<const ChannelCondition> channelCondition,
+        Ptr<const ParamsTable> table3gpp,
+        Ptr<const MobilityModel> aMob,
+        Ptr<const MobilityModel> bMob);
+
+    /**
+     * Main loop of the worker threads, which run the queued jobs until StopWorkers
+     * is called
+     */
+    void RunWorker();
+
+    /**
+     * Run the queued jobs and join the worker threads
+     */
+    void StopWorkers();
+
+    /**
+     * The state of the background generation of the channel params of a pair of nodes
+     */
+    struct LinkPrecomputation
+    {
+        ParamsInputs inputs;              //!< the predicted inputs of the next update
+        Ptr<const ParamsTable> table3gpp; //!< the 3GPP parameters table of the next update
+        ParamsRandomValues values;        //!< the random values of the next update
+        Time expirationTime;              //!< the expiration time of the update period
+        Time updateDelay; //!< the delay between the expiration of the update period
+                          //!< and the last update
+        std::unique_ptr<std::packaged_task<GeneratedParams()>>
+            task; //!< the generation of the params of the next update, run by a worker thread
+        std::future<GeneratedParams>
+            params; //!< the params being generated in the background for the next update
+    };
+
     std::unordered_map<uint64_t, Ptr<ChannelMatrix>>
         m_channelMatrixMap; //!< map containing the channel realizations per pair of
                             //!< PhasedAntennaArray instances, the key of this map is reciprocal
@@ -367,6 +602,20 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
     bool m_portraitMode;           //!< true if potrait mode, false if landscape
     double m_blockerSpeed;         //!< the blocker speed
 
+    bool m_keepStaticChannels;       //!< whether to keep the channel params of still links
+    mutable CacheStats m_cacheStats; //!< counters of the lookups performed by GetChannel
+
+    // background generation of the channel params
+    uint32_t m_precomputeThreads;             //!< the number of worker threads
+    std::unordered_map<uint64_t, LinkPrecomputation>
+        m_precomputations;                    //!< the background generations per pair of nodes
+    std::vector<std::thread> m_workers;       //!< the worker threads
+    std::deque<std::packaged_task<GeneratedParams()>*>
+        m_jobs; //!< the jobs waiting for a worker thread, owned by m_precomputations
+    std::mutex m_jobsMutex;                   //!< mutex protecting m_jobs and m_stopWorkers
+    std::condition_variable m_jobsCondition;  //!< notifies the worker threads of new jobs
+    bool m_stopWorkers{false};                //!< whether the worker threads have to stop
+
     static const uint8_t PHI_INDEX = 0; //!< index of the PHI value in the m_nonSelfBlocking array
     static const uint8_t X_INDEX = 1;   //!< index of the X value in the m_nonSelfBlocking array
     static const uint8_t THETA_INDEX =
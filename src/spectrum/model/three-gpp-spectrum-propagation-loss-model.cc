@@ -31,6 +31,7 @@
 #include "ns3/pointer.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 
 #include <map>
 
@@ -73,7 +74,15 @@ ThreeGppSpectrumPropagationLossModel::GetTypeId()
                 StringValue("ns3::ThreeGppChannelModel"),
                 MakePointerAccessor(&ThreeGppSpectrumPropagationLossModel::SetChannelModel,
                                     &ThreeGppSpectrumPropagationLossModel::GetChannelModel),
-                MakePointerChecker<MatrixBasedChannelModel>());
+                MakePointerChecker<MatrixBasedChannelModel>())
+            .AddAttribute("LongTermCacheSize",
+                          "The maximum number of pairs of beamforming vectors for which the long "
+                          "term component of the channel between a pair of antenna arrays is "
+                          "stored",
+                          UintegerValue(8),
+                          MakeUintegerAccessor(
+                              &ThreeGppSpectrumPropagationLossModel::m_longTermCacheSize),
+                          MakeUintegerChecker<uint32_t>(1));
     return tid;
 }
 
@@ -122,32 +131,33 @@ ThreeGppSpectrumPropagationLossModel::CalcLongTerm(
     uint16_t sAntenna = static_cast<uint16_t>(sW.size());
     uint16_t uAntenna = static_cast<uint16_t>(uW.size());
 
-    NS_ASSERT(uAntenna == params->m_channel.size());
-    NS_ASSERT(sAntenna == params->m_channel.at(0).size());
+    NS_ASSERT(uAntenna == params->m_channel.GetNumRows());
+    NS_ASSERT(sAntenna == params->m_channel.GetNumCols());
 
     NS_LOG_DEBUG("CalcLongTerm with sAntenna " << sAntenna << " uAntenna " << uAntenna);
     // store the long term part to reduce computation load
     // only the small scale fading needs to be updated if the large scale parameters and antenna
     // weights remain unchanged.
-    PhasedArrayModel::ComplexVector longTerm;
-    uint8_t numCluster = static_cast<uint8_t>(params->m_channel[0][0].size());
+    auto numCluster = params->m_channel.GetNumPages();
+    PhasedArrayModel::ComplexVector longTerm(numCluster);
 
-    NS_ASSERT(uAntenna == params->m_channel.size());
-    NS_ASSERT(sAntenna == params->m_channel.at(0).size());
-
-    for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
+    // the channel matrix of each cluster is a contiguous page of the channel
+    // tensor (u index first), hence the inner loop runs over contiguous elements
+    for (std::size_t cIndex = 0; cIndex < numCluster; cIndex++)
     {
+        const std::complex<double>* hUs = params->m_channel.GetPagePtr(cIndex);
         std::complex<double> txSum(0, 0);
         for (uint16_t sIndex = 0; sIndex < sAntenna; sIndex++)
         {
+            const std::complex<double>* hU = hUs + sIndex * uAntenna;
             std::complex<double> rxSum(0, 0);
             for (uint16_t uIndex = 0; uIndex < uAntenna; uIndex++)
             {
-                rxSum = rxSum + uW[uIndex] * params->m_channel[uIndex][sIndex][cIndex];
+                rxSum = rxSum + uW[uIndex] * hU[uIndex];
             }
             txSum = txSum + sW[sIndex] * rxSum;
         }
-        longTerm.push_back(txSum);
+        longTerm[cIndex] = txSum;
     }
     return longTerm;
 }
@@ -165,8 +175,8 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
 
     Ptr<SpectrumValue> tempPsd = Copy<SpectrumValue>(txPsd);
 
-    // channel[rx][tx][cluster]
-    uint8_t numCluster = static_cast<uint8_t>(channelMatrix->m_channel[0][0].size());
+    // channel(rx, tx, cluster)
+    uint8_t numCluster = static_cast<uint8_t>(channelMatrix->m_channel.GetNumPages());
 
     // compute the doppler term
     // NOTE the update of Doppler is simplified by only taking the center angle of
@@ -245,6 +255,14 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
 
     NS_ASSERT(numCluster <= doppler.size());
 
+    // the product of the long term component and of the doppler term does not
+    // depend on the sub-band
+    PhasedArrayModel::ComplexVector longTermDoppler(numCluster);
+    for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
+    {
+        longTermDoppler[cIndex] = longTerm[cIndex] * doppler[cIndex];
+    }
+
     // apply the doppler term and the propagation delay to the long term component
     // to obtain the beamforming gain
     auto vit = tempPsd->ValuesBegin();      // psd iterator
@@ -258,7 +276,7 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
             for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
             {
                 double delay = -2 * M_PI * fsb * (channelParams->m_delay[cIndex]);
-                subsbandGain = subsbandGain + longTerm[cIndex] * doppler[cIndex] *
+                subsbandGain = subsbandGain + longTermDoppler[cIndex] *
                                                   std::complex<double>(cos(delay), sin(delay));
             }
             *vit = (*vit) * (norm(subsbandGain));
@@ -293,51 +311,59 @@ ThreeGppSpectrumPropagationLossModel::GetLongTerm(
         uW = aPhasedArrayModel->GetBeamformingVector();
     }
 
-    bool update = false;   // indicates whether the long term has to be updated
-    bool notFound = false; // indicates if the long term has not been computed yet
-
-    // compute the long term key, the key is unique for each tx-rx pair
+    // compute the long term key, the key is unique for each tx-rx pair and it is
+    // reciprocal, hence the long term components are shared by both directions
     uint64_t longTermId =
         MatrixBasedChannelModel::GetKey(aPhasedArrayModel->GetId(), bPhasedArrayModel->GetId());
+    auto& longTermList = m_longTermMap[longTermId];
 
-    // look for the long term in the map and check if it is valid
-    if (m_longTermMap.find(longTermId) != m_longTermMap.end())
+    // discard the long term components computed with a previous channel realization
+    if (!longTermList.empty() &&
+        longTermList.front()->m_channel->m_generatedTime != channelMatrix->m_generatedTime)
     {
-        NS_LOG_DEBUG("found the long term component in the map");
-        longTerm = m_longTermMap[longTermId]->m_longTerm;
-
-        // check if the channel matrix has been updated
-        // or the s beam has been changed
-        // or the u beam has been changed
-        update = (m_longTermMap[longTermId]->m_channel->m_generatedTime !=
-                      channelMatrix->m_generatedTime ||
-                  m_longTermMap[longTermId]->m_sW != sW || m_longTermMap[longTermId]->m_uW != uW);
+        NS_LOG_DEBUG("the channel matrix has been updated");
+        longTermList.clear();
     }
-    else
+
+    // look for the long term component computed with the current beam pair
+    for (auto it = longTermList.begin(); it != longTermList.end(); ++it)
     {
-        NS_LOG_DEBUG("long term component NOT found");
-        notFound = true;
+        if ((*it)->m_sW == sW && (*it)->m_uW == uW)
+        {
+            NS_LOG_DEBUG("found the long term component in the map");
+            m_longTermCacheStats.hits++;
+            // move the beam pair to the front of the list
+            longTermList.splice(longTermList.begin(), longTermList, it);
+            return longTermList.front()->m_longTerm;
+        }
     }
 
-    if (update || notFound)
+    NS_LOG_DEBUG("compute the long term");
+    m_longTermCacheStats.misses++;
+    longTerm = CalcLongTerm(channelMatrix, sW, uW);
+
+    // store the long term
+    Ptr<LongTerm> longTermItem = Create<LongTerm>();
+    longTermItem->m_longTerm = longTerm;
+    longTermItem->m_channel = channelMatrix;
+    longTermItem->m_sW = sW;
+    longTermItem->m_uW = uW;
+
+    longTermList.push_front(longTermItem);
+    if (longTermList.size() > m_longTermCacheSize)
     {
-        NS_LOG_DEBUG("compute the long term");
-        // compute the long term component
-        longTerm = CalcLongTerm(channelMatrix, sW, uW);
-
-        // store the long term
-        Ptr<LongTerm> longTermItem = Create<LongTerm>();
-        longTermItem->m_longTerm = longTerm;
-        longTermItem->m_channel = channelMatrix;
-        longTermItem->m_sW = sW;
-        longTermItem->m_uW = uW;
-
-        m_longTermMap[longTermId] = longTermItem;
+        longTermList.pop_back();
     }
 
     return longTerm;
 }
 
+const ThreeGppSpectrumPropagationLossModel::LongTermCacheStats&
+ThreeGppSpectrumPropagationLossModel::GetLongTermCacheStats() const
+{
+    return m_longTermCacheStats;
+}
+
 Ptr<SpectrumValue>
 ThreeGppSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity(
     Ptr<const SpectrumSignalParameters> params,
@@ -26,6 +26,7 @@
 #include "ns3/random-variable-stream.h"
 
 #include <complex.h>
+#include <list>
 #include <map>
 #include <unordered_map>
 
@@ -107,9 +108,11 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
      * the product between the cluster matrices and the TX and RX beamforming
      * vectors (w_rx^T H^n_ab w_tx), and accounts for the Doppler component and
      * the propagation delay.
-     * To reduce the computational load, the long term component associated with
-     * a certain channel is cached and recomputed only when the channel realization
-     * is updated, or when the beamforming vectors change.
+     * To reduce the computational load, the long term components associated with
+     * a certain channel are cached for up to LongTermCacheSize pairs of beamforming
+     * vectors, and recomputed only when the channel realization is updated, or
+     * when a pair of beamforming vectors not in the cache is used. The cache is
+     * shared by both directions of the link, since the channel is reciprocal.
      *
      * \param params tx parameters
      * \param a first node mobility model
@@ -125,6 +128,20 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
         Ptr<const PhasedArrayModel> aPhasedArrayModel,
         Ptr<const PhasedArrayModel> bPhasedArrayModel) const override;
 
+    /**
+     * Counters of the lookups of the long term components
+     */
+    struct LongTermCacheStats
+    {
+        uint64_t hits{0};   //!< number of times a cached long term component was reused
+        uint64_t misses{0}; //!< number of times a long term component was computed
+    };
+
+    /**
+     * \return the counters of the lookups of the long term components
+     */
+    const LongTermCacheStats& GetLongTermCacheStats() const;
+
   private:
     /**
      * Data structure that stores the long term component for a tx-rx pair
@@ -148,9 +165,11 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
     double GetFrequency() const;
 
     /**
-     * Looks for the long term component in m_longTermMap. If found, checks
-     * whether it has to be updated. If not found or if it has to be updated,
-     * calls the method CalcLongTerm to compute it.
+     * Looks for the long term component computed with the current beamforming
+     * vectors in m_longTermMap. The long term components computed with a previous
+     * realization of the channel matrix are discarded. If not found, calls the
+     * method CalcLongTerm to compute it and stores it in the cache, evicting the
+     * least recently used beam pair if the cache is full.
      * \param channelMatrix the channel matrix
      * \param aPhasedArrayModel the antenna array of the tx device
      * \param bPhasedArrayModel the antenna array of the rx device
@@ -190,8 +209,11 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
         const Vector& sSpeed,
         const Vector& uSpeed) const;
 
-    mutable std::unordered_map<uint64_t, Ptr<const LongTerm>>
-        m_longTermMap;                           //!< map containing the long term components
+    mutable std::unordered_map<uint64_t, std::list<Ptr<const LongTerm>>>
+        m_longTermMap; //!< map containing the long term components per pair of antenna arrays,
+                       //!< in order from the most to the least recently used beam pair
+    uint32_t m_longTermCacheSize; //!< maximum number of beam pairs stored per antenna pair
+    mutable LongTermCacheStats m_longTermCacheStats; //!< counters of the long term lookups
     Ptr<MatrixBasedChannelModel> m_channelModel; //!< the model to generate the channel matrix
 };
 } // namespace ns3
@@ -30,6 +30,7 @@
 #include <cmath>
 #include <map>
 #include <sstream>
+#include <tuple>
 
 namespace ns3
 {
@@ -140,6 +141,103 @@ WifiSpectrumValueHelper::GetSpectrumModel(uint32_t centerFrequency,
     return ret;
 }
 
+///< Identifier of a transmit PSD built from an OFDM spectrum mask
+struct WifiTxPsdId
+{
+    /// The function building the PSD
+    enum Type : uint8_t
+    {
+        OFDM = 0,
+        DUPLICATED_20MHZ,
+        HT_OFDM,
+        HE_OFDM
+    };
+
+    Type m_type;                              ///< the function building the PSD
+    uint32_t m_centerFrequency;               ///< center frequency (in MHz)
+    uint16_t m_channelWidth;                  ///< channel width (in MHz)
+    double m_txPowerW;                        ///< transmit power (in W)
+    uint16_t m_guardBandwidth;                ///< guard band width (in MHz)
+    double m_minInnerBandDbr;                 ///< minimum relative power in the inner band
+    double m_minOuterBandDbr;                 ///< minimum relative power in the outer band
+    double m_lowestPointDbr;                  ///< relative power of the outermost subcarriers
+    std::vector<bool> m_puncturedSubchannels; ///< punctured 20 MHz subchannels
+};
+
+/**
+ * Less than operator
+ * \param a the first transmit PSD identifier to compare
+ * \param b the second transmit PSD identifier to compare
+ * \returns true if the first identifier is less than the second identifier
+ */
+bool
+operator<(const WifiTxPsdId& a, const WifiTxPsdId& b)
+{
+    return std::tie(a.m_type,
+                    a.m_centerFrequency,
+                    a.m_channelWidth,
+                    a.m_txPowerW,
+                    a.m_guardBandwidth,
+                    a.m_minInnerBandDbr,
+                    a.m_minOuterBandDbr,
+                    a.m_lowestPointDbr,
+                    a.m_puncturedSubchannels) < std::tie(b.m_type,
+                                                         b.m_centerFrequency,
+                                                         b.m_channelWidth,
+                                                         b.m_txPowerW,
+                                                         b.m_guardBandwidth,
+                                                         b.m_minInnerBandDbr,
+                                                         b.m_minOuterBandDbr,
+                                                         b.m_lowestPointDbr,
+                                                         b.m_puncturedSubchannels);
+}
+
+static std::map<WifiTxPsdId, Ptr<const SpectrumValue>>
+    g_wifiTxPsdMap; ///< the transmit PSDs built so far
+
+/// Maximum number of transmit PSDs stored in g_wifiTxPsdMap
+static const std::size_t WIFI_TX_PSD_MAP_MAX_SIZE = 256;
+
+/**
+ * Look up a transmit PSD built previously. Building a PSD from an OFDM spectrum mask
+ * takes a number of operations (including powers) per band, while transmitters use the
+ * same few configurations for all their PPDUs.
+ *
+ * \param key the identifier of the PSD
+ * \return a copy of the PSD built previously with the given identifier, if any, or a
+ *         null pointer otherwise
+ */
+static Ptr<SpectrumValue>
+FindTxPsd(const WifiTxPsdId& key)
+{
+    auto it = g_wifiTxPsdMap.find(key);
+    if (it == g_wifiTxPsdMap.end())
+    {
+        return nullptr;
+    }
+    NS_LOG_LOGIC("Reusing the transmit PSD built previously");
+    return it->second->Copy();
+}
+
+/**
+ * Store a copy of a transmit PSD, so that it can be returned by FindTxPsd.
+ *
+ * \param key the identifier of the PSD
+ * \param psd the PSD
+ * \return the given PSD
+ */
+static Ptr<SpectrumValue>
+StoreTxPsd(const WifiTxPsdId& key, Ptr<SpectrumValue> psd)
+{
+    if (g_wifiTxPsdMap.size() >= WIFI_TX_PSD_MAP_MAX_SIZE)
+    {
+        // the transmit power is likely to be adapted at every PPDU, start over
+        g_wifiTxPsdMap.clear();
+    }
+    g_wifiTxPsdMap.emplace(key, psd->Copy());
+    return psd;
+}
+
 // Power allocated to 71 center subbands out of 135 total subbands in the band
 Ptr<SpectrumValue>
 WifiSpectrumValueHelper::CreateDsssTxPowerSpectralDensity(uint32_t centerFrequency,
@@ -180,6 +278,19 @@ WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity(uint32_t centerFrequen
 {
     NS_LOG_FUNCTION(centerFrequency << channelWidth << txPowerW << guardBandwidth << minInnerBandDbr
                                     << minOuterBandDbr << lowestPointDbr);
+    WifiTxPsdId key{WifiTxPsdId::OFDM,
+                    centerFrequency,
+                    channelWidth,
+                    txPowerW,
+                    guardBandwidth,
+                    minInnerBandDbr,
+                    minOuterBandDbr,
+                    lowestPointDbr,
+                    {}};
+    if (Ptr<SpectrumValue> psd = FindTxPsd(key))
+    {
+        return psd;
+    }
     uint32_t bandBandwidth = 0;
     uint32_t innerSlopeWidth = 0;
     switch (channelWidth)
@@ -238,7 +349,7 @@ WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity(uint32_t centerFrequen
                               lowestPointDbr);
     NormalizeSpectrumMask(c, txPowerW);
     NS_ASSERT_MSG(std::abs(txPowerW - Integral(*c)) < 1e-6, "Power allocation failed");
-    return c;
+    return StoreTxPsd(key, c);
 }
 
 Ptr<SpectrumValue>
@@ -254,6 +365,19 @@ WifiSpectrumValueHelper::CreateDuplicated20MhzTxPowerSpectralDensity(
 {
     NS_LOG_FUNCTION(centerFrequency << channelWidth << txPowerW << guardBandwidth << minInnerBandDbr
                                     << minOuterBandDbr << lowestPointDbr);
+    WifiTxPsdId key{WifiTxPsdId::DUPLICATED_20MHZ,
+                    centerFrequency,
+                    channelWidth,
+                    txPowerW,
+                    guardBandwidth,
+                    minInnerBandDbr,
+                    minOuterBandDbr,
+                    lowestPointDbr,
+                    puncturedSubchannels};
+    if (Ptr<SpectrumValue> psd = FindTxPsd(key))
+    {
+        return psd;
+    }
     uint32_t bandBandwidth = 312500;
     Ptr<SpectrumValue> c = Create<SpectrumValue>(
         GetSpectrumModel(centerFrequency, channelWidth, bandBandwidth, guardBandwidth));
@@ -314,7 +438,7 @@ WifiSpectrumValueHelper::CreateDuplicated20MhzTxPowerSpectralDensity(
                               lowestPointDbr);
     NormalizeSpectrumMask(c, txPowerW);
     NS_ASSERT_MSG(std::abs(txPowerW - Integral(*c)) < 1e-6, "Power allocation failed");
-    return c;
+    return StoreTxPsd(key, c);
 }
 
 Ptr<SpectrumValue>
@@ -328,6 +452,19 @@ WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity(uint32_t centerFrequ
 {
     NS_LOG_FUNCTION(centerFrequency << channelWidth << txPowerW << guardBandwidth << minInnerBandDbr
                                     << minOuterBandDbr << lowestPointDbr);
+    WifiTxPsdId key{WifiTxPsdId::HT_OFDM,
+                    centerFrequency,
+                    channelWidth,
+                    txPowerW,
+                    guardBandwidth,
+                    minInnerBandDbr,
+                    minOuterBandDbr,
+                    lowestPointDbr,
+                    {}};
+    if (Ptr<SpectrumValue> psd = FindTxPsd(key))
+    {
+        return psd;
+    }
     uint32_t bandBandwidth = 312500;
     Ptr<SpectrumValue> c = Create<SpectrumValue>(
         GetSpectrumModel(centerFrequency, channelWidth, bandBandwidth, guardBandwidth));
@@ -379,7 +516,7 @@ WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity(uint32_t centerFrequ
                               lowestPointDbr);
     NormalizeSpectrumMask(c, txPowerW);
     NS_ASSERT_MSG(std::abs(txPowerW - Integral(*c)) < 1e-6, "Power allocation failed");
-    return c;
+    return StoreTxPsd(key, c);
 }
 
 Ptr<SpectrumValue>
@@ -395,6 +532,19 @@ WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
 {
     NS_LOG_FUNCTION(centerFrequency << channelWidth << txPowerW << guardBandwidth << minInnerBandDbr
                                     << minOuterBandDbr << lowestPointDbr);
+    WifiTxPsdId key{WifiTxPsdId::HE_OFDM,
+                    centerFrequency,
+                    channelWidth,
+                    txPowerW,
+                    guardBandwidth,
+                    minInnerBandDbr,
+                    minOuterBandDbr,
+                    lowestPointDbr,
+                    puncturedSubchannels};
+    if (Ptr<SpectrumValue> psd = FindTxPsd(key))
+    {
+        return psd;
+    }
     uint32_t bandBandwidth = 78125;
     Ptr<SpectrumValue> c = Create<SpectrumValue>(
         GetSpectrumModel(centerFrequency, channelWidth, bandBandwidth, guardBandwidth));
@@ -512,7 +662,7 @@ WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
                               puncturedSlopeWidth);
     NormalizeSpectrumMask(c, txPowerW);
     NS_ASSERT_MSG(std::abs(txPowerW - Integral(*c)) < 1e-6, "Power allocation failed");
-    return c;
+    return StoreTxPsd(key, c);
 }
 
 Ptr<SpectrumValue>
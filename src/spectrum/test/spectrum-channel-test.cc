@@ -0,0 +1,373 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/constant-acceleration-mobility-model.h>
+#include <ns3/constant-velocity-mobility-model.h>
+#include <ns3/core-module.h>
+#include <ns3/friis-spectrum-propagation-loss.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/net-device.h>
+#include <ns3/node.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/simple-net-device.h>
+#include <ns3/single-model-spectrum-channel.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/test.h>
+
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Minimal SpectrumPhy recording the signals it receives
+ */
+class SpectrumChannelTestPhy : public SpectrumPhy
+{
+  public:
+    /// A reception: time (ns), receiver identifier, received power (W)
+    using Rx = std::tuple<int64_t, uint32_t, double>;
+
+    /**
+     * Constructor
+     *
+     * \param id the identifier of the PHY
+     * \param model the RX spectrum model
+     * \param rxs the container of the receptions
+     */
+    SpectrumChannelTestPhy(uint32_t id, Ptr<const SpectrumModel> model, std::vector<Rx>* rxs);
+
+    void SetDevice(Ptr<NetDevice> d) override;
+    Ptr<NetDevice> GetDevice() const override;
+    void SetMobility(Ptr<MobilityModel> m) override;
+    Ptr<MobilityModel> GetMobility() const override;
+    void SetChannel(Ptr<SpectrumChannel> c) override;
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override;
+    Ptr<Object> GetAntenna() const override;
+    void StartRx(Ptr<SpectrumSignalParameters> params) override;
+
+  private:
+    void DoDispose() override;
+
+    uint32_t m_id;                    //!< Identifier of the PHY
+    Ptr<const SpectrumModel> m_model; //!< RX spectrum model
+    Ptr<MobilityModel> m_mobility;    //!< Mobility model
+    Ptr<NetDevice> m_device;          //!< NetDevice, if any
+    std::vector<Rx>* m_rxs;           //!< Container of the receptions
+};
+
+SpectrumChannelTestPhy::SpectrumChannelTestPhy(uint32_t id,
+                                               Ptr<const SpectrumModel> model,
+                                               std::vector<Rx>* rxs)
+    : m_id(id),
+      m_model(model),
+      m_rxs(rxs)
+{
+}
+
+void
+SpectrumChannelTestPhy::DoDispose()
+{
+    m_model = nullptr;
+    m_mobility = nullptr;
+    m_device = nullptr;
+    SpectrumPhy::DoDispose();
+}
+
+void
+SpectrumChannelTestPhy::SetDevice(Ptr<NetDevice> d)
+{
+    m_device = d;
+}
+
+Ptr<NetDevice>
+SpectrumChannelTestPhy::GetDevice() const
+{
+    return m_device;
+}
+
+void
+SpectrumChannelTestPhy::SetMobility(Ptr<MobilityModel> m)
+{
+    m_mobility = m;
+}
+
+Ptr<MobilityModel>
+SpectrumChannelTestPhy::GetMobility() const
+{
+    return m_mobility;
+}
+
+void
+SpectrumChannelTestPhy::SetChannel(Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+SpectrumChannelTestPhy::GetRxSpectrumModel() const
+{
+    return m_model;
+}
+
+Ptr<Object>
+SpectrumChannelTestPhy::GetAntenna() const
+{
+    return nullptr;
+}
+
+void
+SpectrumChannelTestPhy::StartRx(Ptr<SpectrumSignalParameters> params)
+{
+    m_rxs->emplace_back(Simulator::Now().GetNanoSeconds(), m_id, Integral(*params->psd));
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Check that limiting the range of a SpectrumChannel does not change
+ * the signals received within MaxLossDb.
+ *
+ * Thirty PHYs, some of them moving, transmit in turn. With the Friis model
+ * at 5.15 GHz, a loss of 80 dB is reached at about 46 m; the scenario is run
+ * with MaxLossDb set to 80 dB, first without range limit and then with a
+ * MaxRange of 50 m, and the receptions must be identical. For the
+ * MultiModelSpectrumChannel, half of the PHYs use a different spectrum model,
+ * so that the transmitted signals are converted.
+ */
+class SpectrumChannelMaxRangeTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param multiModel whether to test the MultiModelSpectrumChannel rather
+     *        than the SingleModelSpectrumChannel
+     */
+    SpectrumChannelMaxRangeTestCase(bool multiModel);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run the scenario
+     *
+     * \param maxRange the MaxRange attribute of the channel
+     * \return the receptions
+     */
+    std::vector<SpectrumChannelTestPhy::Rx> RunScenario(double maxRange);
+
+    bool m_multiModel; //!< Test the MultiModelSpectrumChannel
+};
+
+SpectrumChannelMaxRangeTestCase::SpectrumChannelMaxRangeTestCase(bool multiModel)
+    : TestCase(std::string("Check the receptions with a limited range, ") +
+               (multiModel ? "MultiModelSpectrumChannel" : "SingleModelSpectrumChannel")),
+      m_multiModel(multiModel)
+{
+}
+
+std::vector<SpectrumChannelTestPhy::Rx>
+SpectrumChannelMaxRangeTestCase::RunScenario(double maxRange)
+{
+    std::vector<SpectrumChannelTestPhy::Rx> rxs;
+
+    std::vector<double> fine{5150e6, 5155e6, 5160e6, 5165e6, 5170e6};
+    std::vector<double> coarse{5150e6, 5160e6, 5170e6};
+    Ptr<SpectrumModel> txModel = Create<SpectrumModel>(fine);
+    Ptr<SpectrumModel> otherModel = Create<SpectrumModel>(coarse);
+
+    Ptr<SpectrumChannel> channel;
+    if (m_multiModel)
+    {
+        channel = CreateObject<MultiModelSpectrumChannel>();
+    }
+    else
+    {
+        channel = CreateObject<SingleModelSpectrumChannel>();
+    }
+    channel->AddPropagationLossModel(CreateObject<FriisPropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    channel->SetAttribute("MaxLossDb", DoubleValue(80));
+    channel->SetAttribute("MaxRange", DoubleValue(maxRange));
+
+    std::vector<Ptr<SpectrumChannelTestPhy>> phys;
+    for (uint32_t i = 0; i < 30; i++)
+    {
+        Ptr<SpectrumModel> model = (m_multiModel && i % 2 == 1) ? otherModel : txModel;
+        auto phy = CreateObject<SpectrumChannelTestPhy>(i, model, &rxs);
+        // the position of this model is a function of the time only, whereas models
+        // updating their position whenever it is queried have rounding errors depending
+        // on the queries, which the range limit makes less frequent
+        auto mobility = CreateObject<ConstantAccelerationMobilityModel>();
+        mobility->SetPosition(Vector(15.0 * (i % 6), 12.0 * (i / 6), 1.5));
+        if (i % 3 == 0)
+        {
+            mobility->SetVelocityAndAcceleration(Vector(4.0, -2.0 + i / 6, 0), Vector(0, 0, 0));
+        }
+        phy->SetMobility(mobility);
+        channel->AddRx(phy);
+        phys.push_back(phy);
+    }
+
+    for (uint32_t i = 0; i < 90; i++)
+    {
+        auto params = Create<SpectrumSignalParameters>();
+        params->psd = Create<SpectrumValue>(txModel);
+        *params->psd = 1e-9;
+        params->duration = MicroSeconds(100);
+        params->txPhy = phys[(7 * i) % phys.size()];
+        Simulator::Schedule(MilliSeconds(100 * i), &SpectrumChannel::StartTx, channel, params);
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+
+    return rxs;
+}
+
+void
+SpectrumChannelMaxRangeTestCase::DoRun()
+{
+    auto unlimited = RunScenario(0);
+    auto limited = RunScenario(50);
+
+    NS_TEST_ASSERT_MSG_GT(unlimited.size(), 200, "Too few receptions for a meaningful test");
+    NS_TEST_ASSERT_MSG_EQ(limited.size(), unlimited.size(), "Unexpected number of receptions");
+    for (std::size_t i = 0; i < unlimited.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ((limited[i] == unlimited[i]), true, "Reception " << i << " differs");
+    }
+
+    auto shorter = RunScenario(20);
+    NS_TEST_EXPECT_MSG_LT(shorter.size(), unlimited.size(), "The range limit had no effect");
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Check that the receptions starting at the same time in the same
+ * context are delivered by a single event, in the order of the receivers.
+ *
+ * Eight PHYs are located on a circle centered on the transmitter, hence they
+ * all receive the signal after the same delay. Either none of them has a
+ * NetDevice, or the third and the sixth ones are attached to a node, so
+ * that their receptions run in another context and split the batch.
+ */
+class SpectrumChannelBatchedRxTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param mixedContexts whether two of the receivers are attached to a node
+     */
+    SpectrumChannelBatchedRxTestCase(bool mixedContexts);
+
+  private:
+    void DoRun() override;
+
+    bool m_mixedContexts; //!< Two of the receivers are attached to a node
+};
+
+SpectrumChannelBatchedRxTestCase::SpectrumChannelBatchedRxTestCase(bool mixedContexts)
+    : TestCase(std::string("Check the batched delivery of simultaneous receptions") +
+               (mixedContexts ? " in several contexts" : "")),
+      m_mixedContexts(mixedContexts)
+{
+}
+
+void
+SpectrumChannelBatchedRxTestCase::DoRun()
+{
+    std::vector<SpectrumChannelTestPhy::Rx> rxs;
+    std::vector<double> freqs{5150e6, 5160e6, 5170e6};
+    Ptr<SpectrumModel> model = Create<SpectrumModel>(freqs);
+
+    auto channel = CreateObject<SingleModelSpectrumChannel>();
+    channel->AddPropagationLossModel(CreateObject<FriisPropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    Ptr<Node> node = m_mixedContexts ? CreateObject<Node>() : nullptr;
+    std::vector<Ptr<SpectrumChannelTestPhy>> phys;
+    for (uint32_t i = 0; i < 9; i++)
+    {
+        auto phy = CreateObject<SpectrumChannelTestPhy>(i, model, &rxs);
+        auto mobility = CreateObject<ConstantVelocityMobilityModel>();
+        if (i > 0)
+        {
+            double angle = 2 * M_PI * i / 8;
+            mobility->SetPosition(Vector(30 * std::cos(angle), 30 * std::sin(angle), 0));
+        }
+        if (m_mixedContexts && i % 3 == 0 && i > 0)
+        {
+            auto device = CreateObject<SimpleNetDevice>();
+            node->AddDevice(device);
+            phy->SetDevice(device);
+        }
+        phy->SetMobility(mobility);
+        channel->AddRx(phy);
+        phys.push_back(phy);
+    }
+
+    auto params = Create<SpectrumSignalParameters>();
+    params->psd = Create<SpectrumValue>(model);
+    *params->psd = 1e-9;
+    params->duration = MicroSeconds(100);
+    params->txPhy = phys[0];
+    Simulator::Schedule(MilliSeconds(1), &SpectrumChannel::StartTx, channel, params);
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(rxs.size(), 8, "Unexpected number of receptions");
+    for (uint32_t i = 0; i < rxs.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(std::get<0>(rxs[i]), std::get<0>(rxs[0]), "Unexpected RX time");
+        NS_TEST_EXPECT_MSG_EQ(std::get<1>(rxs[i]), i + 1, "Unexpected order of the receptions");
+    }
+    // one event for the transmission, one for each run of consecutive receptions
+    // in the same context: {1, 2}, {3}, {4, 5}, {6} and {7, 8} with mixed contexts,
+    // plus the initialization of the node and of its two devices
+    uint64_t expectedEvents = m_mixedContexts ? 9 : 2;
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetEventCount(),
+                          expectedEvents,
+                          "Receptions were not batched");
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief SpectrumChannel TestSuite
+ */
+class SpectrumChannelTestSuite : public TestSuite
+{
+  public:
+    SpectrumChannelTestSuite();
+};
+
+SpectrumChannelTestSuite::SpectrumChannelTestSuite()
+    : TestSuite("spectrum-channel", UNIT)
+{
+    AddTestCase(new SpectrumChannelMaxRangeTestCase(false), TestCase::QUICK);
+    AddTestCase(new SpectrumChannelMaxRangeTestCase(true), TestCase::QUICK);
+    AddTestCase(new SpectrumChannelBatchedRxTestCase(false), TestCase::QUICK);
+    AddTestCase(new SpectrumChannelBatchedRxTestCase(true), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static SpectrumChannelTestSuite g_spectrumChannelTestSuite;
@@ -25,6 +25,7 @@
 #include <ns3/spectrum-value.h>
 #include <ns3/test.h>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -226,6 +227,25 @@ SpectrumValueTestSuite::SpectrumValueTestSuite()
     AddTestCase(new SpectrumValueTestCase(tv5, v5, "tv5 *= v2"), TestCase::QUICK);
     AddTestCase(new SpectrumValueTestCase(tv6, v6, "tv6 div= v2"), TestCase::QUICK);
 
+    // operators storing the result in the values of a temporary operand
+    tv3 = (v1 * 1.0) + (v2 * 1.0);
+    tv4 = v1 - (v2 * 1.0);
+    tv5 = (v1 * 1.0) * v2;
+    tv6 = v1 / (v2 * 1.0);
+
+    AddTestCase(new SpectrumValueTestCase(tv3, v3, "tv3 = (v1 * 1) + (v2 * 1)"), TestCase::QUICK);
+    AddTestCase(new SpectrumValueTestCase(tv4, v4, "tv4 = v1 - (v2 * 1)"), TestCase::QUICK);
+    AddTestCase(new SpectrumValueTestCase(tv5, v5, "tv5 = (v1 * 1) * v2"), TestCase::QUICK);
+    AddTestCase(new SpectrumValueTestCase(tv6, v6, "tv6 = v1 div (v2 * 1)"), TestCase::QUICK);
+
+    SpectrumValue sinr(f);
+    for (std::size_t i = 0; i < 5; i++)
+    {
+        sinr[i] = v1[i] / (v2[i] - v1[i] + v3[i]);
+    }
+    AddTestCase(new SpectrumValueTestCase(v1 / (v2 - v1 + v3), sinr, "v1 div (v2 - v1 + v3)"),
+                TestCase::QUICK);
+
     SpectrumValue tv7a(f);
     SpectrumValue tv8a(f);
     SpectrumValue tv9a(f);
@@ -346,6 +366,17 @@ SpectrumConverterTestSuite::SpectrumConverterTestSuite()
     //   NS_LOG_LOGIC(t21b);
     //   NS_LOG_LOGIC(*res);
     AddTestCase(new SpectrumValueTestCase(t21b, *res, ""), TestCase::QUICK);
+
+    // the same conversion from a model whose bands are not sorted by frequency
+    Bands reversed(sof2->Begin(), sof2->End());
+    std::reverse(reversed.begin(), reversed.end());
+    Ptr<SpectrumModel> sof2r = Create<SpectrumModel>(reversed);
+    Ptr<SpectrumValue> v2r = Create<SpectrumValue>(sof2r);
+    std::reverse_copy(v2b->ConstValuesBegin(), v2b->ConstValuesEnd(), v2r->ValuesBegin());
+    SpectrumConverter c2r1(sof2r, sof1);
+    res = c2r1.Convert(v2r);
+    AddTestCase(new SpectrumValueTestCase(t21b, *res, "conversion from unsorted bands"),
+                TestCase::QUICK);
 }
 
 /// Static variable for test initialization
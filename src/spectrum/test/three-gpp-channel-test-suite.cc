@@ -17,14 +17,17 @@
 
 #include "ns3/abort.h"
 #include "ns3/angles.h"
+#include "ns3/boolean.h"
 #include "ns3/channel-condition-model.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/double.h"
 #include "ns3/isotropic-antenna-model.h"
 #include "ns3/log.h"
 #include "ns3/node-container.h"
 #include "ns3/pointer.h"
+#include "ns3/rng-seed-manager.h"
 #include "ns3/simple-net-device.h"
 #include "ns3/simulator.h"
 #include "ns3/spectrum-signal-parameters.h"
@@ -106,7 +109,7 @@ ThreeGppChannelMatrixComputationTest::DoComputeNorm(Ptr<ThreeGppChannelModel> ch
         channelModel->GetChannel(txMob, rxMob, txAntenna, rxAntenna);
 
     double channelNorm = 0;
-    uint8_t numTotClusters = channelMatrix->m_channel.at(0).at(0).size();
+    uint8_t numTotClusters = channelMatrix->m_channel.GetNumPages();
     for (uint8_t cIndex = 0; cIndex < numTotClusters; cIndex++)
     {
         double clusterNorm = 0;
@@ -115,8 +118,7 @@ ThreeGppChannelMatrixComputationTest::DoComputeNorm(Ptr<ThreeGppChannelModel> ch
             for (uint32_t uIndex = 0; uIndex < rxAntennaElements; uIndex++)
             {
                 clusterNorm +=
-                    std::pow(std::abs(channelMatrix->m_channel.at(uIndex).at(sIndex).at(cIndex)),
-                             2);
+                    std::pow(std::abs(channelMatrix->m_channel(uIndex, sIndex, cIndex)), 2);
             }
         }
         channelNorm += clusterNorm;
@@ -189,11 +191,11 @@ ThreeGppChannelMatrixComputationTest::DoRun()
 
     // check the channel matrix dimensions
     NS_TEST_ASSERT_MSG_EQ(
-        channelMatrix->m_channel.at(0).size(),
+        channelMatrix->m_channel.GetNumCols(),
         txAntennaElements[0] * txAntennaElements[1],
         "The second dimension of H should be equal to the number of tx antenna elements");
     NS_TEST_ASSERT_MSG_EQ(
-        channelMatrix->m_channel.size(),
+        channelMatrix->m_channel.GetNumRows(),
         rxAntennaElements[0] * rxAntennaElements[1],
         "The first dimension of H should be equal to the number of rx antenna elements");
 
@@ -683,6 +685,470 @@ ThreeGppSpectrumPropagationLossModelTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup spectrum-tests
+ *
+ * Test case for the caches of the ThreeGppChannelModel and of the
+ * ThreeGppSpectrumPropagationLossModel classes.
+ * 1) checks that the same channel matrix is returned for both directions of a link
+ * 2) checks that, if KeepStaticChannels is enabled, the channel of a link whose
+ *    nodes did not move is kept after the update period expires, and that it is
+ *    regenerated as soon as a node moves
+ * 3) checks that the long term components are cached for multiple beam pairs and
+ *    shared by both directions of a link
+ */
+class ThreeGppChannelCacheTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     */
+    ThreeGppChannelCacheTest();
+
+  private:
+    /**
+     * Build the test scenario
+     */
+    void DoRun() override;
+
+    /**
+     * Check that the channel matrix is kept while the nodes do not move and
+     * regenerated when a node moves
+     * \param channelModel the ThreeGppChannelModel object used to generate the channel matrix
+     * \param txMob the mobility model of the first node
+     * \param rxMob the mobility model of the second node
+     * \param txAntenna the antenna object associated to the first node
+     * \param rxAntenna the antenna object associated to the second node
+     */
+    void CheckStaticChannel(Ptr<ThreeGppChannelModel> channelModel,
+                            Ptr<MobilityModel> txMob,
+                            Ptr<MobilityModel> rxMob,
+                            Ptr<PhasedArrayModel> txAntenna,
+                            Ptr<PhasedArrayModel> rxAntenna);
+
+    Ptr<const ThreeGppChannelModel::ChannelMatrix>
+        m_channel; //!< the channel matrix generated at the beginning of the simulation
+};
+
+ThreeGppChannelCacheTest::ThreeGppChannelCacheTest()
+    : TestCase("Check the caches of the channel matrices and of the long term components")
+{
+}
+
+void
+ThreeGppChannelCacheTest::CheckStaticChannel(Ptr<ThreeGppChannelModel> channelModel,
+                                             Ptr<MobilityModel> txMob,
+                                             Ptr<MobilityModel> rxMob,
+                                             Ptr<PhasedArrayModel> txAntenna,
+                                             Ptr<PhasedArrayModel> rxAntenna)
+{
+    NS_TEST_ASSERT_MSG_EQ((channelModel->GetChannel(txMob, rxMob, txAntenna, rxAntenna) ==
+                           m_channel),
+                          true,
+                          "The channel of a static link should be kept");
+    NS_TEST_ASSERT_MSG_EQ(channelModel->GetCacheStats().staticReuses,
+                          1,
+                          "Unexpected number of reuses of the channel params of a static link");
+
+    rxMob->SetPosition(Vector(100.0, 1.0, 1.6));
+    NS_TEST_ASSERT_MSG_EQ((channelModel->GetChannel(txMob, rxMob, txAntenna, rxAntenna) !=
+                           m_channel),
+                          true,
+                          "The channel should be regenerated when a node moves");
+    NS_TEST_ASSERT_MSG_EQ(channelModel->GetCacheStats().paramsMisses,
+                          2,
+                          "Unexpected number of generations of the channel params");
+    NS_TEST_ASSERT_MSG_EQ(channelModel->GetCacheStats().matrixMisses,
+                          2,
+                          "Unexpected number of generations of the channel matrix");
+}
+
+void
+ThreeGppChannelCacheTest::DoRun()
+{
+    // create the ThreeGppSpectrumPropagationLossModel object and set the
+    // attributes of the associated ThreeGppChannelModel object
+    Ptr<ThreeGppSpectrumPropagationLossModel> lossModel =
+        CreateObject<ThreeGppSpectrumPropagationLossModel>();
+    lossModel->SetChannelModelAttribute("Frequency", DoubleValue(28.0e9));
+    lossModel->SetChannelModelAttribute("Scenario", StringValue("UMa"));
+    Ptr<ChannelConditionModel> condModel = CreateObject<AlwaysLosChannelConditionModel>();
+    lossModel->SetChannelModelAttribute("ChannelConditionModel", PointerValue(condModel));
+    lossModel->SetChannelModelAttribute("UpdatePeriod", TimeValue(MilliSeconds(100)));
+    lossModel->SetChannelModelAttribute("KeepStaticChannels", BooleanValue(true));
+    Ptr<ThreeGppChannelModel> channelModel =
+        DynamicCast<ThreeGppChannelModel>(lossModel->GetChannelModel());
+
+    // create the tx and rx nodes
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    // create the tx and rx mobility models and set their positions
+    Ptr<MobilityModel> txMob = CreateObject<ConstantPositionMobilityModel>();
+    txMob->SetPosition(Vector(0.0, 0.0, 10.0));
+    Ptr<MobilityModel> rxMob = CreateObject<ConstantPositionMobilityModel>();
+    rxMob->SetPosition(Vector(100.0, 0.0, 1.6));
+
+    // associate the nodes and the mobility models
+    nodes.Get(0)->AggregateObject(txMob);
+    nodes.Get(1)->AggregateObject(rxMob);
+
+    // create the tx and rx antennas
+    Ptr<PhasedArrayModel> txAntenna = CreateObjectWithAttributes<UniformPlanarArray>(
+        "NumColumns",
+        UintegerValue(2),
+        "NumRows",
+        UintegerValue(2),
+        "AntennaElement",
+        PointerValue(CreateObject<IsotropicAntennaModel>()));
+    Ptr<PhasedArrayModel> rxAntenna = CreateObjectWithAttributes<UniformPlanarArray>(
+        "NumColumns",
+        UintegerValue(2),
+        "NumRows",
+        UintegerValue(2),
+        "AntennaElement",
+        PointerValue(CreateObject<IsotropicAntennaModel>()));
+
+    // 1) the channel matrix is reciprocal, hence the same matrix is returned for
+    // both directions of the link
+    m_channel = channelModel->GetChannel(txMob, rxMob, txAntenna, rxAntenna);
+    NS_TEST_ASSERT_MSG_EQ((channelModel->GetChannel(rxMob, txMob, rxAntenna, txAntenna) ==
+                           m_channel),
+                          true,
+                          "The same channel should be returned for the reverse link");
+    NS_TEST_ASSERT_MSG_EQ(channelModel->GetCacheStats().matrixHits,
+                          1,
+                          "Unexpected number of reuses of the channel matrix");
+    NS_TEST_ASSERT_MSG_EQ(channelModel->GetCacheStats().matrixMisses,
+                          1,
+                          "Unexpected number of generations of the channel matrix");
+
+    // 3) alternate two beam pairs and the direction of the link, the long term
+    // components are computed only once per beam pair
+    Ptr<SpectrumSignalParameters> txParams = Create<SpectrumSignalParameters>();
+    txParams->psd = WifiSpectrumValue5MhzFactory().CreateTxPowerSpectralDensity(0.1, 1);
+
+    Angles toRx(rxMob->GetPosition(), txMob->GetPosition());
+    Angles toTx(txMob->GetPosition(), rxMob->GetPosition());
+    PhasedArrayModel::ComplexVector txBeams[]{
+        txAntenna->GetBeamformingVector(toRx),
+        txAntenna->GetBeamformingVector(Angles(toRx.GetAzimuth() + M_PI / 4,
+                                               toRx.GetInclination()))};
+    rxAntenna->SetBeamformingVector(rxAntenna->GetBeamformingVector(toTx));
+
+    Ptr<SpectrumValue> rxPsd[2];
+    for (std::size_t i = 0; i < 2; i++)
+    {
+        txAntenna->SetBeamformingVector(txBeams[i]);
+        rxPsd[i] =
+            lossModel->DoCalcRxPowerSpectralDensity(txParams, txMob, rxMob, txAntenna, rxAntenna);
+    }
+    for (std::size_t i = 0; i < 2; i++)
+    {
+        txAntenna->SetBeamformingVector(txBeams[i]);
+        Ptr<SpectrumValue> rxPsdReverse =
+            lossModel->DoCalcRxPowerSpectralDensity(txParams, rxMob, txMob, rxAntenna, txAntenna);
+        for (std::size_t j = 0; j < rxPsd[i]->GetValuesN(); j++)
+        {
+            NS_TEST_ASSERT_MSG_EQ((*rxPsdReverse)[j],
+                                  (*rxPsd[i])[j],
+                                  "The rx PSD computed with the cached long term is different");
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(lossModel->GetLongTermCacheStats().misses,
+                          2,
+                          "The long term should be computed once per beam pair");
+    NS_TEST_ASSERT_MSG_EQ(lossModel->GetLongTermCacheStats().hits,
+                          2,
+                          "The long term should be reused for known beam pairs");
+
+    // 2) check that the channel of the static link is kept after the update period
+    Simulator::Schedule(MilliSeconds(101),
+                        &ThreeGppChannelCacheTest::CheckStaticChannel,
+                        this,
+                        channelModel,
+                        txMob,
+                        rxMob,
+                        txAntenna,
+                        rxAntenna);
+
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * Test case for the background generation of the channel params of the
+ * ThreeGppChannelModel class. It checks that the channel params generated in
+ * the background are used when the nodes are at the predicted positions and
+ * that they are discarded when a node moves unexpectedly.
+ */
+class ThreeGppChannelPrecomputationTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     */
+    ThreeGppChannelPrecomputationTest();
+
+  private:
+    /**
+     * Build the test scenario
+     */
+    void DoRun() override;
+
+    /**
+     * Retrieve the channel matrix and check that it has been updated
+     * \param channelModel the ThreeGppChannelModel object used to generate the channel matrix
+     * \param txMob the mobility model of the first node
+     * \param rxMob the mobility model of the second node
+     * \param txAntenna the antenna object associated to the first node
+     * \param rxAntenna the antenna object associated to the second node
+     * \param precomputed the expected number of times the precomputed params were used
+     */
+    void DoGetChannel(Ptr<ThreeGppChannelModel> channelModel,
+                      Ptr<MobilityModel> txMob,
+                      Ptr<MobilityModel> rxMob,
+                      Ptr<PhasedArrayModel> txAntenna,
+                      Ptr<PhasedArrayModel> rxAntenna,
+                      uint64_t precomputed);
+
+    Ptr<const ThreeGppChannelModel::ChannelMatrix>
+        m_currentChannel; //!< used by DoGetChannel to store the current channel matrix
+};
+
+ThreeGppChannelPrecomputationTest::ThreeGppChannelPrecomputationTest()
+    : TestCase("Check the background generation of the channel params")
+{
+}
+
+void
+ThreeGppChannelPrecomputationTest::DoGetChannel(Ptr<ThreeGppChannelModel> channelModel,
+                                                Ptr<MobilityModel> txMob,
+                                                Ptr<MobilityModel> rxMob,
+                                                Ptr<PhasedArrayModel> txAntenna,
+                                                Ptr<PhasedArrayModel> rxAntenna,
+                                                uint64_t precomputed)
+{
+    Ptr<const ThreeGppChannelModel::ChannelMatrix> channelMatrix =
+        channelModel->GetChannel(txMob, rxMob, txAntenna, rxAntenna);
+    NS_TEST_ASSERT_MSG_EQ((channelMatrix != m_currentChannel),
+                          true,
+                          Simulator::Now().GetMilliSeconds()
+                              << " The channel matrix is not updated");
+    NS_TEST_ASSERT_MSG_EQ(channelModel->GetCacheStats().precomputedParams,
+                          precomputed,
+                          Simulator::Now().GetMilliSeconds()
+                              << " Unexpected number of uses of the precomputed params");
+    m_currentChannel = channelMatrix;
+}
+
+void
+ThreeGppChannelPrecomputationTest::DoRun()
+{
+    uint32_t updatePeriodMs = 10; // update period in ms
+
+    // create the ThreeGppChannelModel object used to generate the channel matrix
+    Ptr<ThreeGppChannelModel> channelModel = CreateObject<ThreeGppChannelModel>();
+    channelModel->SetAttribute("Frequency", DoubleValue(28.0e9));
+    channelModel->SetAttribute("Scenario", StringValue("UMi-StreetCanyon"));
+    channelModel->SetAttribute("ChannelConditionModel",
+                               PointerValue(CreateObject<AlwaysLosChannelConditionModel>()));
+    channelModel->SetAttribute("UpdatePeriod", TimeValue(MilliSeconds(updatePeriodMs)));
+    channelModel->SetAttribute("PrecomputeThreads", UintegerValue(2));
+
+    // create the tx and rx nodes
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    // create the tx and rx mobility models and set their positions
+    Ptr<MobilityModel> txMob = CreateObject<ConstantPositionMobilityModel>();
+    txMob->SetPosition(Vector(0.0, 0.0, 10.0));
+    Ptr<MobilityModel> rxMob = CreateObject<ConstantPositionMobilityModel>();
+    rxMob->SetPosition(Vector(50.0, 0.0, 1.6));
+
+    // associate the nodes and the mobility models
+    nodes.Get(0)->AggregateObject(txMob);
+    nodes.Get(1)->AggregateObject(rxMob);
+
+    // create the tx and rx antennas
+    Ptr<PhasedArrayModel> txAntenna = CreateObjectWithAttributes<UniformPlanarArray>(
+        "NumColumns",
+        UintegerValue(2),
+        "NumRows",
+        UintegerValue(2),
+        "AntennaElement",
+        PointerValue(CreateObject<IsotropicAntennaModel>()));
+    Ptr<PhasedArrayModel> rxAntenna = CreateObjectWithAttributes<UniformPlanarArray>(
+        "NumColumns",
+        UintegerValue(2),
+        "NumRows",
+        UintegerValue(2),
+        "AntennaElement",
+        PointerValue(CreateObject<IsotropicAntennaModel>()));
+
+    // the channel params of the first realization are generated synchronously,
+    // those of the next realizations of the static link in the background
+    for (uint64_t i = 0; i < 3; i++)
+    {
+        Simulator::Schedule(MilliSeconds(1 + i * (updatePeriodMs + 1)),
+                            &ThreeGppChannelPrecomputationTest::DoGetChannel,
+                            this,
+                            channelModel,
+                            txMob,
+                            rxMob,
+                            txAntenna,
+                            rxAntenna,
+                            i);
+    }
+
+    // the rx node moves, the precomputed params are discarded
+    Simulator::Schedule(MilliSeconds(1 + 2 * (updatePeriodMs + 1) + 1),
+                        &MobilityModel::SetPosition,
+                        rxMob,
+                        Vector(60.0, 0.0, 1.6));
+    Simulator::Schedule(MilliSeconds(1 + 3 * (updatePeriodMs + 1)),
+                        &ThreeGppChannelPrecomputationTest::DoGetChannel,
+                        this,
+                        channelModel,
+                        txMob,
+                        rxMob,
+                        txAntenna,
+                        rxAntenna,
+                        2);
+
+    Simulator::Run();
+    NS_TEST_ASSERT_MSG_EQ(channelModel->GetCacheStats().paramsMisses,
+                          4,
+                          "Unexpected number of generations of the channel params");
+    channelModel->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * Test case for the background generation of the channel params of moving nodes.
+ * The channel of a pair of nodes moving with a constant velocity is requested
+ * every millisecond: the params generated in the background for the predicted
+ * positions must be used and the channel matrices must not depend on the number
+ * of worker threads.
+ */
+class ThreeGppChannelMovingPrecomputationTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     */
+    ThreeGppChannelMovingPrecomputationTest();
+
+  private:
+    /**
+     * Build the test scenario
+     */
+    void DoRun() override;
+
+    /**
+     * Request the channel matrix of the pair of nodes every millisecond
+     * \param precomputeThreads the PrecomputeThreads attribute of the channel model
+     * \param precomputedParams used to return the number of uses of the precomputed params
+     * \return the channel matrices
+     */
+    std::vector<ComplexValArray> GetChannels(uint32_t precomputeThreads,
+                                             uint64_t& precomputedParams);
+};
+
+ThreeGppChannelMovingPrecomputationTest::ThreeGppChannelMovingPrecomputationTest()
+    : TestCase("Check the background generation of the channel params of moving nodes")
+{
+}
+
+std::vector<ComplexValArray>
+ThreeGppChannelMovingPrecomputationTest::GetChannels(uint32_t precomputeThreads,
+                                                     uint64_t& precomputedParams)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    Ptr<ThreeGppChannelModel> channelModel = CreateObject<ThreeGppChannelModel>();
+    channelModel->SetAttribute("Frequency", DoubleValue(28.0e9));
+    channelModel->SetAttribute("Scenario", StringValue("UMi-StreetCanyon"));
+    channelModel->SetAttribute("ChannelConditionModel",
+                               PointerValue(CreateObject<AlwaysLosChannelConditionModel>()));
+    channelModel->SetAttribute("UpdatePeriod", TimeValue(MilliSeconds(10)));
+    channelModel->SetAttribute("PrecomputeThreads", UintegerValue(precomputeThreads));
+    channelModel->AssignStreams(1);
+
+    NodeContainer nodes;
+    nodes.Create(2);
+    Ptr<MobilityModel> txMob = CreateObject<ConstantPositionMobilityModel>();
+    txMob->SetPosition(Vector(0.0, 0.0, 10.0));
+    Ptr<ConstantVelocityMobilityModel> rxMob = CreateObject<ConstantVelocityMobilityModel>();
+    rxMob->SetPosition(Vector(50.0, 0.0, 1.6));
+    rxMob->SetVelocity(Vector(3.0, 4.0, 0.0));
+    nodes.Get(0)->AggregateObject(txMob);
+    nodes.Get(1)->AggregateObject(rxMob);
+
+    Ptr<PhasedArrayModel> txAntenna = CreateObjectWithAttributes<UniformPlanarArray>(
+        "NumColumns",
+        UintegerValue(2),
+        "NumRows",
+        UintegerValue(2),
+        "AntennaElement",
+        PointerValue(CreateObject<IsotropicAntennaModel>()));
+    Ptr<PhasedArrayModel> rxAntenna = CreateObjectWithAttributes<UniformPlanarArray>(
+        "NumColumns",
+        UintegerValue(2),
+        "NumRows",
+        UintegerValue(2),
+        "AntennaElement",
+        PointerValue(CreateObject<IsotropicAntennaModel>()));
+
+    std::vector<ComplexValArray> channels;
+    for (uint32_t i = 1; i <= 60; i++)
+    {
+        Simulator::Schedule(MilliSeconds(i), [&]() {
+            channels.push_back(
+                channelModel->GetChannel(txMob, rxMob, txAntenna, rxAntenna)->m_channel);
+        });
+    }
+    Simulator::Run();
+    precomputedParams = channelModel->GetCacheStats().precomputedParams;
+    channelModel->Dispose();
+    Simulator::Destroy();
+    return channels;
+}
+
+void
+ThreeGppChannelMovingPrecomputationTest::DoRun()
+{
+    uint64_t precomputedParams;
+    GetChannels(0, precomputedParams);
+    NS_TEST_ASSERT_MSG_EQ(precomputedParams,
+                          0,
+                          "The params cannot be generated in the background without threads");
+
+    // the params are updated at 12, 23, 34, 45 and 56 ms, the delay between the
+    // expiration of the update period and the first update is not predicted
+    std::vector<ComplexValArray> channels = GetChannels(1, precomputedParams);
+    NS_TEST_ASSERT_MSG_EQ(precomputedParams, 4, "Unexpected number of uses of the params");
+
+    for (uint32_t threads : {2, 3})
+    {
+        std::vector<ComplexValArray> precomputedChannels = GetChannels(threads, precomputedParams);
+        NS_TEST_ASSERT_MSG_EQ(precomputedParams, 4, "Unexpected number of uses of the params");
+        NS_TEST_ASSERT_MSG_EQ(precomputedChannels.size(), channels.size(), "Unexpected size");
+        for (std::size_t i = 0; i < channels.size(); i++)
+        {
+            NS_TEST_ASSERT_MSG_EQ((precomputedChannels[i] == channels[i]),
+                                  true,
+                                  "Channel at " << i + 1 << " ms differs with " << threads
+                                                << " threads");
+        }
+    }
+}
+
 /**
  * \ingroup spectrum-tests
  *
@@ -703,6 +1169,9 @@ ThreeGppChannelTestSuite::ThreeGppChannelTestSuite()
     AddTestCase(new ThreeGppChannelMatrixComputationTest, TestCase::QUICK);
     AddTestCase(new ThreeGppChannelMatrixUpdateTest, TestCase::QUICK);
     AddTestCase(new ThreeGppSpectrumPropagationLossModelTest, TestCase::QUICK);
+    AddTestCase(new ThreeGppChannelCacheTest, TestCase::QUICK);
+    AddTestCase(new ThreeGppChannelPrecomputationTest, TestCase::QUICK);
+    AddTestCase(new ThreeGppChannelMovingPrecomputationTest, TestCase::QUICK);
 }
 
 /// Static variable for test initialization
@@ -0,0 +1,237 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3tcp-socket-writer.h"
+
+#include "ns3/config.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-global-routing-helper.h"
+#include "ns3/log.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/segmentation-offload-tag.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/tcp-header.h"
+#include "ns3/tcp-socket-base.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("Ns3TcpTsoTest");
+
+/**
+ * \ingroup system-tests-tcp
+ *
+ * \brief Checks that TCP segmentation offload is invisible on the wire.
+ *
+ * A bulk transfer crosses a router over two point-to-point links, the
+ * second one being the bottleneck. The transfer is run without and with
+ * segmentation offload: the packets received by each device, their
+ * reception times and their sizes must be the same in both runs.
+ */
+class Ns3TcpTsoTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param tsoMaxSegments Max number of segments in a super-segment.
+     */
+    Ns3TcpTsoTestCase(uint32_t tsoMaxSegments);
+
+  private:
+    void DoRun() override;
+
+    /// A packet received by a device
+    struct Reception
+    {
+        std::string device; //!< Trace context of the receiving device.
+        Time time;          //!< Reception time.
+        uint32_t size;      //!< Packet size, point-to-point header included.
+    };
+
+    /**
+     * Run the transfer.
+     *
+     * \param tsoMaxSegments Max number of segments in a super-segment.
+     * \return the packets received by the devices
+     */
+    std::vector<Reception> RunTransfer(uint32_t tsoMaxSegments);
+
+    /**
+     * Record a packet received by a device.
+     * \param context The trace context.
+     * \param p The received packet.
+     */
+    void PhyRxEnd(std::string context, Ptr<const Packet> p);
+
+    /**
+     * Count the super-segments sent by a socket.
+     * \param p The packet.
+     * \param header The TCP header.
+     * \param socket The sending socket.
+     */
+    void SocketTx(Ptr<const Packet> p, const TcpHeader& header, Ptr<const TcpSocketBase> socket);
+
+    uint32_t m_tsoMaxSegments;           //!< Max number of segments in a super-segment.
+    std::vector<Reception> m_receptions; //!< Packets received in the current run.
+    uint32_t m_superSegments;            //!< Super-segments sent in the current run.
+};
+
+Ns3TcpTsoTestCase::Ns3TcpTsoTestCase(uint32_t tsoMaxSegments)
+    : TestCase("Check that super-segments of up to " + std::to_string(tsoMaxSegments) +
+               " segments do not change the packets on the wire"),
+      m_tsoMaxSegments(tsoMaxSegments),
+      m_superSegments(0)
+{
+}
+
+void
+Ns3TcpTsoTestCase::PhyRxEnd(std::string context, Ptr<const Packet> p)
+{
+    m_receptions.push_back({context, Simulator::Now(), p->GetSize()});
+}
+
+void
+Ns3TcpTsoTestCase::SocketTx(Ptr<const Packet> p,
+                            const TcpHeader& header,
+                            Ptr<const TcpSocketBase> socket)
+{
+    SegmentationOffloadTag tsoTag;
+    if (p->PeekPacketTag(tsoTag))
+    {
+        m_superSegments++;
+    }
+}
+
+std::vector<Ns3TcpTsoTestCase::Reception>
+Ns3TcpTsoTestCase::RunTransfer(uint32_t tsoMaxSegments)
+{
+    m_receptions.clear();
+    m_superSegments = 0;
+
+    uint16_t sinkPort = 50000;
+
+    // Full-sized segments fill the MTU of the point-to-point links
+    Config::SetDefault("ns3::TcpSocket::SegmentSize", UintegerValue(1448));
+    Config::SetDefault("ns3::TcpSocketBase::TsoMaxSegments", UintegerValue(tsoMaxSegments));
+
+    NodeContainer nodes;
+    nodes.Create(3);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue("10Mbps"));
+    pointToPoint.SetChannelAttribute("Delay", StringValue("2ms"));
+    NetDeviceContainer accessDevices = pointToPoint.Install(nodes.Get(0), nodes.Get(1));
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue("2Mbps"));
+    pointToPoint.SetChannelAttribute("Delay", StringValue("10ms"));
+    NetDeviceContainer bottleneckDevices = pointToPoint.Install(nodes.Get(1), nodes.Get(2));
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.252");
+    address.Assign(accessDevices);
+    address.SetBase("10.1.2.0", "255.255.255.252");
+    Ipv4InterfaceContainer bottleneckInterfaces = address.Assign(bottleneckDevices);
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    Ptr<SocketWriter> socketWriter = CreateObject<SocketWriter>();
+    Address sinkAddress(InetSocketAddress(bottleneckInterfaces.GetAddress(1), sinkPort));
+    socketWriter->Setup(nodes.Get(0), sinkAddress);
+    nodes.Get(0)->AddApplication(socketWriter);
+    socketWriter->SetStartTime(Seconds(0.));
+
+    PacketSinkHelper sink("ns3::TcpSocketFactory",
+                          InetSocketAddress(Ipv4Address::GetAny(), sinkPort));
+    ApplicationContainer apps = sink.Install(nodes.Get(2));
+    apps.Start(Seconds(0.));
+
+    Config::Connect("/NodeList/*/DeviceList/*/$ns3::PointToPointNetDevice/PhyRxEnd",
+                    MakeCallback(&Ns3TcpTsoTestCase::PhyRxEnd, this));
+    // The socket of the writer is created when the application starts
+    Simulator::Schedule(Seconds(0.5), [this]() {
+        Config::ConnectWithoutContext("/NodeList/0/$ns3::TcpL4Protocol/SocketList/*/Tx",
+                                      MakeCallback(&Ns3TcpTsoTestCase::SocketTx, this));
+    });
+
+    // The FIN is sent with the last segment of data
+    Simulator::Schedule(Seconds(1), &SocketWriter::Write, socketWriter, 100000);
+    Simulator::Schedule(Seconds(1), &SocketWriter::Close, socketWriter);
+
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+    Simulator::Destroy();
+    Config::Reset();
+
+    return m_receptions;
+}
+
+void
+Ns3TcpTsoTestCase::DoRun()
+{
+    std::vector<Reception> reference = RunTransfer(1);
+    NS_TEST_ASSERT_MSG_EQ(m_superSegments, 0, "Super-segments sent without TSO");
+    // the data segments are received by the router and by the receiver
+    NS_TEST_ASSERT_MSG_GT(reference.size(), 2 * (100000 / 1448), "Transfer not completed");
+
+    std::vector<Reception> receptions = RunTransfer(m_tsoMaxSegments);
+    NS_TEST_ASSERT_MSG_GT(m_superSegments, 0, "No super-segment was sent");
+
+    NS_TEST_ASSERT_MSG_EQ(receptions.size(), reference.size(), "Different number of packets");
+    for (std::size_t i = 0; i < receptions.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(receptions[i].device,
+                              reference[i].device,
+                              "Packet " << i << " received by a different device");
+        NS_TEST_ASSERT_MSG_EQ(receptions[i].time,
+                              reference[i].time,
+                              "Packet " << i << " received at a different time");
+        NS_TEST_ASSERT_MSG_EQ(receptions[i].size,
+                              reference[i].size,
+                              "Packet " << i << " of a different size");
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(receptions[i].size, 1502, "Packet larger than the MTU");
+    }
+}
+
+/**
+ * \ingroup system-tests-tcp
+ *
+ * TCP segmentation offload TestSuite.
+ */
+class Ns3TcpTsoTestSuite : public TestSuite
+{
+  public:
+    Ns3TcpTsoTestSuite();
+};
+
+Ns3TcpTsoTestSuite::Ns3TcpTsoTestSuite()
+    : TestSuite("ns3-tcp-tso", SYSTEM)
+{
+    AddTestCase(new Ns3TcpTsoTestCase(4), TestCase::QUICK);
+    AddTestCase(new Ns3TcpTsoTestCase(16), TestCase::QUICK);
+}
+
+/// Do not forget to allocate an instance of this TestSuite.
+static Ns3TcpTsoTestSuite g_ns3TcpTsoTestSuite;
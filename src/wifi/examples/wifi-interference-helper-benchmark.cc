@@ -0,0 +1,252 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program measures the time spent by InterferenceHelper to track the
+// signals received by a PHY and to compute the SNR and PER of the PPDUs.
+//
+// An InterferenceHelper is configured with a number of bands (by default 74,
+// i.e., the number of 26-tone RUs in a 160 MHz channel). Signals arrive
+// according to a Poisson process; each of them covers a random number of
+// contiguous bands (as an OFDMA RU or a full channel would), with a random
+// power and duration. As done by SpectrumWifiPhy, the power of a signal is
+// given for all the bands, those it does not cover having a null power. One
+// signal out of --rxInterval is "received" if the PHY is not already receiving:
+// at its end, its SNR and PER are computed on each of the bands it covers.
+//
+// The program prints the wall clock time of the run and a checksum of the
+// computed PERs, which allows to compare the results of different versions of
+// InterferenceHelper.
+//
+// Example:
+//   ./ns3 run "wifi-interference-helper-benchmark --nSignals=200000 --nBands=148"
+//
+
+#include "ns3/command-line.h"
+#include "ns3/double.h"
+#include "ns3/interference-helper.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/ofdm-phy.h"
+#include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-mac-header.h"
+#include "ns3/wifi-ppdu.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/wifi-utils.h"
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("WifiInterferenceHelperBenchmark");
+
+/**
+ * \ingroup wifi
+ *
+ * Generate signals and feed them to an InterferenceHelper
+ */
+class InterferenceHelperBenchmark
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param nBands the number of bands
+     * \param meanInterArrival the mean time between the arrival of two signals
+     * \param rxInterval one signal out of rxInterval is received
+     */
+    InterferenceHelperBenchmark(uint32_t nBands, Time meanInterArrival, uint32_t rxInterval);
+
+    /**
+     * Run the benchmark
+     *
+     * \param nSignals the number of signals to generate
+     */
+    void Run(uint32_t nSignals);
+
+  private:
+    /**
+     * Add a signal to the InterferenceHelper and schedule the next one
+     *
+     * \param remaining the number of signals left to generate
+     */
+    void AddSignal(uint32_t remaining);
+
+    /**
+     * Compute the SNR and PER of a received signal at its end
+     *
+     * \param event the event of the received signal
+     * \param first the index of the first band covered by the signal
+     * \param width the number of bands covered by the signal
+     */
+    void EndRx(Ptr<Event> event, uint32_t first, uint32_t width);
+
+    Ptr<InterferenceHelper> m_interference;        //!< the InterferenceHelper
+    std::vector<WifiSpectrumBand> m_bands;         //!< the bands
+    Ptr<ExponentialRandomVariable> m_interArrival; //!< inter-arrival time (us)
+    Ptr<UniformRandomVariable> m_uniform;          //!< durations, powers and bands
+    WifiTxVector m_txVector;                       //!< the TXVECTOR of the PPDUs
+    Ptr<const WifiPpdu> m_ppdu;                    //!< the PPDU of the signals
+    uint32_t m_rxInterval;   //!< one signal out of m_rxInterval is received
+    uint32_t m_nSignals{0};  //!< number of signals generated
+    uint32_t m_nRx{0};       //!< number of received signals
+    bool m_rxing{false};     //!< whether a signal is being received
+    double m_checksum{0};    //!< sum of the computed PERs
+};
+
+InterferenceHelperBenchmark::InterferenceHelperBenchmark(uint32_t nBands,
+                                                         Time meanInterArrival,
+                                                         uint32_t rxInterval)
+    : m_txVector(OfdmPhy::GetOfdmRate6Mbps(), 0, WIFI_PREAMBLE_LONG, 800, 1, 1, 0, 20, false),
+      m_rxInterval(rxInterval)
+{
+    m_interference = CreateObject<InterferenceHelper>();
+    m_interference->SetNoiseFigure(DbToRatio(7));
+    m_interference->SetErrorRateModel(CreateObject<NistErrorRateModel>());
+    for (uint32_t i = 0; i < nBands; i++)
+    {
+        // 26 subcarriers per band
+        m_bands.emplace_back(26 * i, 26 * i + 25);
+        m_interference->AddBand(m_bands.back());
+    }
+
+    m_interArrival = CreateObject<ExponentialRandomVariable>();
+    m_interArrival->SetAttribute("Mean", DoubleValue(meanInterArrival.GetMicroSeconds()));
+    m_interArrival->SetStream(1);
+    m_uniform = CreateObject<UniformRandomVariable>();
+    m_uniform->SetStream(2);
+
+    WifiMacHeader hdr;
+    hdr.SetType(WIFI_MAC_QOSDATA);
+    hdr.SetQosTid(0);
+    m_ppdu = Create<WifiPpdu>(Create<WifiPsdu>(Create<Packet>(1000), hdr), m_txVector, 5180);
+}
+
+void
+InterferenceHelperBenchmark::AddSignal(uint32_t remaining)
+{
+    // the signal covers 1, 2, 4... contiguous bands
+    uint32_t maxLog = 0;
+    while ((2U << maxLog) <= m_bands.size())
+    {
+        maxLog++;
+    }
+    uint32_t width = 1U << m_uniform->GetInteger(0, maxLog);
+    uint32_t first = m_uniform->GetInteger(0, (m_bands.size() / width) - 1) * width;
+    RxPowerWattPerChannelBand rxPowerW;
+    for (uint32_t i = 0; i < m_bands.size(); i++)
+    {
+        double powerW = 0;
+        if (i >= first && i < first + width)
+        {
+            powerW = DbmToW(m_uniform->GetValue(-90, -60));
+        }
+        rxPowerW.insert({m_bands[i], powerW});
+    }
+    Time duration = MicroSeconds(m_uniform->GetInteger(50, 500));
+
+    bool rx = !m_rxing && (m_nSignals % m_rxInterval == 0);
+    if (rx)
+    {
+        m_rxing = true;
+        m_interference->NotifyRxStart();
+    }
+    Ptr<Event> event = m_interference->Add(m_ppdu, m_txVector, duration, rxPowerW);
+    if (rx)
+    {
+        Simulator::Schedule(duration,
+                            &InterferenceHelperBenchmark::EndRx,
+                            this,
+                            event,
+                            first,
+                            width);
+    }
+    m_nSignals++;
+
+    if (remaining > 1)
+    {
+        Simulator::Schedule(MicroSeconds(m_interArrival->GetInteger()),
+                            &InterferenceHelperBenchmark::AddSignal,
+                            this,
+                            remaining - 1);
+    }
+}
+
+void
+InterferenceHelperBenchmark::EndRx(Ptr<Event> event, uint32_t first, uint32_t width)
+{
+    Time preamble = WifiPhy::CalculatePhyPreambleAndHeaderDuration(m_txVector);
+    for (uint32_t i = first; i < first + width; i++)
+    {
+        auto snrPer =
+            m_interference->CalculatePayloadSnrPer(event,
+                                                   20,
+                                                   m_bands[i],
+                                                   SU_STA_ID,
+                                                   {Seconds(0), event->GetDuration() - preamble});
+        m_checksum += snrPer.per;
+    }
+    m_nRx++;
+    m_rxing = false;
+    m_interference->NotifyRxEnd(Simulator::Now());
+}
+
+void
+InterferenceHelperBenchmark::Run(uint32_t nSignals)
+{
+    Simulator::ScheduleNow(&InterferenceHelperBenchmark::AddSignal, this, nSignals);
+
+    SystemWallClockMs clock;
+    clock.Start();
+    Simulator::Run();
+    int64_t elapsed = clock.End();
+
+    std::cout << "bands: " << m_bands.size() << ", signals: " << m_nSignals
+              << ", received: " << m_nRx << ", wall clock: " << elapsed << " ms"
+              << ", PER checksum: " << std::setprecision(15) << m_checksum << std::endl;
+
+    m_interference->Dispose();
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nBands = 74;
+    uint32_t nSignals = 50000;
+    uint32_t rxInterval = 10;
+    Time meanInterArrival = MicroSeconds(40);
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("nBands", "Number of bands", nBands);
+    cmd.AddValue("nSignals", "Number of signals", nSignals);
+    cmd.AddValue("rxInterval", "One signal out of rxInterval is received", rxInterval);
+    cmd.AddValue("meanInterArrival", "Mean time between two signals", meanInterArrival);
+    cmd.Parse(argc, argv);
+
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    InterferenceHelperBenchmark benchmark(nBands, meanInterArrival, rxInterval);
+    benchmark.Run(nSignals);
+
+    return 0;
+}
@@ -80,6 +80,19 @@ SpectrumWifiPhyHelper::SetChannel(uint8_t linkId, std::string channelName)
     m_channels.at(linkId) = channel;
 }
 
+void
+SpectrumWifiPhyHelper::SetPhyType(std::string type)
+{
+    TypeId tid = TypeId::LookupByName(type);
+    NS_ABORT_MSG_IF(tid != SpectrumWifiPhy::GetTypeId() &&
+                        !tid.IsChildOf(SpectrumWifiPhy::GetTypeId()),
+                    type << " is not a SpectrumWifiPhy");
+    for (auto& phy : m_phy)
+    {
+        phy.SetTypeId(type);
+    }
+}
+
 std::vector<Ptr<WifiPhy>>
 SpectrumWifiPhyHelper::Create(Ptr<Node> node, Ptr<WifiNetDevice> device) const
 {
@@ -73,6 +73,16 @@ class SpectrumWifiPhyHelper : public WifiPhyHelper
      */
     void SetChannel(uint8_t linkId, std::string channelName);
 
+    /**
+     * \param type the type of the PHYs created by a call to Install, i.e.,
+     *        ns3::SpectrumWifiPhy (the default) or a subclass, such as
+     *        ns3::AbstractedWifiPhy
+     *
+     * The attributes already set on the PHYs are kept, hence they must also
+     * be attributes of the given type.
+     */
+    void SetPhyType(std::string type);
+
   private:
     /**
      * \param node the node on which we wish to create a wifi PHY
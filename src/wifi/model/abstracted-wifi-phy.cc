@@ -0,0 +1,516 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "abstracted-wifi-phy.h"
+
+#include "error-rate-model.h"
+#include "interference-helper.h"
+#include "preamble-detection-model.h"
+#include "wifi-phy-state-helper.h"
+#include "wifi-ppdu.h"
+#include "wifi-psdu.h"
+#include "wifi-utils.h"
+
+#include "ns3/abort.h"
+#include "ns3/enum.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AbstractedWifiPhy");
+
+NS_OBJECT_ENSURE_REGISTERED(AbstractedWifiPhy);
+
+/// Smallest SNR (dB) of the mutual information tables
+static constexpr double MI_MIN_SNR_DB = -10;
+/// Largest SNR (dB) of the mutual information tables
+static constexpr double MI_MAX_SNR_DB = 50;
+/// Resolution (dB) of the mutual information tables
+static constexpr double MI_STEP_DB = 0.25;
+
+TypeId
+AbstractedWifiPhy::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::AbstractedWifiPhy")
+            .SetParent<SpectrumWifiPhy>()
+            .SetGroupName("Wifi")
+            .AddConstructor<AbstractedWifiPhy>()
+            .AddAttribute("EffectiveSnrMapping",
+                          "The mapping used to combine the SNRs of the 20 MHz subchannels "
+                          "occupied by a PPDU into an effective SNR.",
+                          EnumValue(AbstractedWifiPhy::EESM),
+                          MakeEnumAccessor(&AbstractedWifiPhy::m_mapping),
+                          MakeEnumChecker(AbstractedWifiPhy::EESM,
+                                          "EESM",
+                                          AbstractedWifiPhy::MIESM,
+                                          "MIESM"));
+    return tid;
+}
+
+AbstractedWifiPhy::AbstractedWifiPhy()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+AbstractedWifiPhy::~AbstractedWifiPhy()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+AbstractedWifiPhy::SetEesmBeta(uint16_t constellationSize, double beta)
+{
+    NS_LOG_FUNCTION(this << constellationSize << beta);
+    NS_ASSERT(beta > 0);
+    m_eesmBetas[constellationSize] = beta;
+}
+
+double
+AbstractedWifiPhy::GetEesmBeta(uint16_t constellationSize) const
+{
+    auto it = m_eesmBetas.find(constellationSize);
+    if (it != m_eesmBetas.end())
+    {
+        return it->second;
+    }
+    if (constellationSize <= 2)
+    {
+        return 1;
+    }
+    return 2 * (constellationSize - 1) / 3.0;
+}
+
+bool
+AbstractedWifiPhy::IsAbstracted(Ptr<const WifiPpdu> ppdu) const
+{
+    WifiModulationClass modulation = ppdu->GetTxVector().GetModulationClass();
+    return ppdu->GetType() == WIFI_PPDU_TYPE_SU && modulation != WIFI_MOD_CLASS_DSSS &&
+           modulation != WIFI_MOD_CLASS_HR_DSSS &&
+           m_phyEntities.find(modulation) != m_phyEntities.end();
+}
+
+void
+AbstractedWifiPhy::StartReceivePreamble(Ptr<const WifiPpdu> ppdu,
+                                        RxPowerWattPerChannelBand& rxPowersW,
+                                        Time rxDuration)
+{
+    NS_LOG_FUNCTION(this << ppdu << rxDuration);
+    if (!IsAbstracted(ppdu))
+    {
+        WifiPhy::StartReceivePreamble(ppdu, rxPowersW, rxDuration);
+        return;
+    }
+
+    const WifiTxVector& txVector = ppdu->GetTxVector();
+    Ptr<Event> event = m_interference->Add(ppdu, txVector, rxDuration, rxPowersW);
+    auto reason = CanStartAbstractedRx(ppdu);
+    if (!reason)
+    {
+        reason = CheckPhyHeader(event);
+    }
+    if (reason)
+    {
+        NS_LOG_DEBUG("Drop PPDU " << ppdu->GetUid() << ": " << *reason);
+        NotifyRxDrop(ppdu->GetPsdu(), *reason);
+        if (!IsStateSleep() && !IsStateOff() && rxDuration > m_state->GetDelayUntilIdle())
+        {
+            SwitchMaybeToCcaBusy(ppdu);
+        }
+        return;
+    }
+
+    NS_LOG_DEBUG("Receive PPDU " << ppdu->GetUid() << " until "
+                                 << (Simulator::Now() + rxDuration).As(Time::US));
+    m_currentEvent = event;
+    m_interference->NotifyRxStart();
+    NotifyRxBegin(ppdu->GetPsdu(), event->GetRxPowerWPerBand());
+    m_state->SwitchToRx(rxDuration);
+    // PHY-RXSTART is notified at the start of the PPDU, with the time left until its end
+    NotifyRxPayloadBegin(txVector, rxDuration);
+    m_endPhyRxEvent =
+        Simulator::Schedule(rxDuration, &AbstractedWifiPhy::EndReceive, this, event);
+}
+
+std::optional<WifiPhyRxfailureReason>
+AbstractedWifiPhy::CanStartAbstractedRx(Ptr<const WifiPpdu> ppdu) const
+{
+    switch (m_state->GetState())
+    {
+    case WifiPhyState::OFF:
+        return POWERED_OFF;
+    case WifiPhyState::SLEEP:
+        return SLEEPING;
+    case WifiPhyState::SWITCHING:
+        return CHANNEL_SWITCHING;
+    case WifiPhyState::TX:
+        return TXING;
+    case WifiPhyState::RX:
+        return RXING;
+    case WifiPhyState::IDLE:
+    case WifiPhyState::CCA_BUSY:
+        break;
+    default:
+        NS_FATAL_ERROR("Invalid WifiPhy state.");
+        break;
+    }
+    if (ppdu->IsTruncatedTx())
+    {
+        return TRUNCATED_TX;
+    }
+    if (m_currentEvent || !m_currentPreambleEvents.empty())
+    {
+        // the PHY entities are processing the preamble of a MU PPDU
+        return BUSY_DECODING_PREAMBLE;
+    }
+    return std::nullopt;
+}
+
+std::optional<WifiPhyRxfailureReason>
+AbstractedWifiPhy::CheckPhyHeader(Ptr<Event> event)
+{
+    NS_LOG_FUNCTION(this << *event);
+    const WifiTxVector& txVector = event->GetTxVector();
+    uint16_t measurementWidth = std::min<uint16_t>(GetChannelWidth(), 20);
+    WifiSpectrumBand measurementBand =
+        (GetChannelWidth() % 20 != 0)
+            ? GetBand(measurementWidth)
+            : GetBand(measurementWidth,
+                      GetOperatingChannel().GetPrimaryChannelIndex(measurementWidth));
+
+    double rxPowerW = event->GetRxPowerW(measurementBand);
+    double snr = m_interference->CalculateSnr(event, measurementWidth, 1, measurementBand);
+    NS_LOG_DEBUG("SNR(dB)=" << RatioToDb(snr) << " at the start of the PPDU");
+    Ptr<PreambleDetectionModel> preambleDetectionModel = GetPreambleDetectionModel();
+    if ((!preambleDetectionModel && rxPowerW <= 0) ||
+        (preambleDetectionModel &&
+         !preambleDetectionModel->IsPreambleDetected(rxPowerW, snr, measurementWidth)))
+    {
+        return PREAMBLE_DETECT_FAILURE;
+    }
+
+    // the fields of the PHY header, in chronological order
+    static const std::map<WifiPpduField, WifiPhyRxfailureReason> headerFields{
+        {WIFI_PPDU_FIELD_NON_HT_HEADER, L_SIG_FAILURE},
+        {WIFI_PPDU_FIELD_HT_SIG, HT_SIG_FAILURE},
+        {WIFI_PPDU_FIELD_SIG_A, SIG_A_FAILURE},
+        {WIFI_PPDU_FIELD_U_SIG, U_SIG_FAILURE},
+        {WIFI_PPDU_FIELD_EHT_SIG, EHT_SIG_FAILURE}};
+    auto sections = GetStaticPhyEntity(txVector.GetModulationClass())
+                        ->GetPhyHeaderSections(txVector, event->GetStartTime());
+    for (const auto& [field, reason] : headerFields)
+    {
+        if (sections.find(field) == sections.end())
+        {
+            continue;
+        }
+        auto snrPer = m_interference->CalculatePhyHeaderSnrPer(event,
+                                                               measurementWidth,
+                                                               measurementBand,
+                                                               field);
+        if (m_random->GetValue() <= snrPer.per)
+        {
+            return reason;
+        }
+    }
+
+    if (!GetPhyEntity(txVector.GetModulationClass())->IsModeSupported(txVector.GetMode()) ||
+        txVector.GetNss() > GetMaxSupportedRxSpatialStreams() ||
+        (txVector.GetModulationClass() >= WIFI_MOD_CLASS_HT &&
+         txVector.GetChannelWidth() > GetChannelWidth()))
+    {
+        return UNSUPPORTED_SETTINGS;
+    }
+    return std::nullopt;
+}
+
+std::pair<uint16_t, std::vector<WifiSpectrumBand>>
+AbstractedWifiPhy::GetSubchannels(const WifiTxVector& txVector)
+{
+    uint16_t width = std::min(GetChannelWidth(), txVector.GetChannelWidth());
+    if (GetChannelWidth() % 20 != 0)
+    {
+        return {width, {GetBand(width)}};
+    }
+    uint8_t first = GetOperatingChannel().GetPrimaryChannelIndex(width) * (width / 20);
+    std::vector<WifiSpectrumBand> bands;
+    for (uint8_t i = 0; i < width / 20; ++i)
+    {
+        bands.push_back(GetBand(20, first + i));
+    }
+    return {20, bands};
+}
+
+void
+AbstractedWifiPhy::EndReceive(Ptr<Event> event)
+{
+    NS_LOG_FUNCTION(this << *event);
+    NS_ASSERT(event == m_currentEvent);
+    Ptr<const WifiPpdu> ppdu = event->GetPpdu();
+    const WifiTxVector& txVector = event->GetTxVector();
+    Ptr<const WifiPsdu> psdu = ppdu->GetPsdu();
+    WifiMode mode = txVector.GetMode();
+    Time payloadDuration = event->GetDuration() - CalculatePhyPreambleAndHeaderDuration(txVector);
+
+    const auto [width, subchannels] = GetSubchannels(txVector);
+    auto chunks = m_interference->CalculatePayloadSnrChunks(event, width, subchannels);
+    std::vector<double> effectiveSnrs;
+    double meanSnr = 0;
+    for (const auto& chunk : chunks)
+    {
+        effectiveSnrs.push_back(GetEffectiveSnr(chunk.snr, mode.GetConstellationSize()));
+        meanSnr += effectiveSnrs.back() * (chunk.end - chunk.start).GetSeconds();
+    }
+    meanSnr /= payloadDuration.GetSeconds();
+
+    // evaluate the MPDUs over the chunks they overlap with
+    Ptr<ErrorRateModel> errorRateModel = m_interference->GetErrorRateModel();
+    uint64_t rate = mode.GetDataRate(txVector);
+    std::size_t nMpdus = psdu->GetNMpdus();
+    MpduType mpduType =
+        (nMpdus > 1) ? FIRST_MPDU_IN_AGGREGATE : (psdu->IsSingle() ? SINGLE_MPDU : NORMAL_MPDU);
+    uint32_t totalAmpduSize = 0;
+    double totalAmpduNumSymbols = 0.0;
+    Time mpduStart;
+    std::vector<bool> statusPerMpdu;
+    for (std::size_t i = 0; i < nMpdus;)
+    {
+        uint32_t size = (mpduType == NORMAL_MPDU) ? psdu->GetSize() : psdu->GetAmpduSubframeSize(i);
+        Time mpduEnd = Min(payloadDuration,
+                           mpduStart + GetPayloadDuration(size,
+                                                          txVector,
+                                                          GetPhyBand(),
+                                                          mpduType,
+                                                          true,
+                                                          totalAmpduSize,
+                                                          totalAmpduNumSymbols,
+                                                          SU_STA_ID));
+        double psr = 1;
+        for (std::size_t k = 0; k < chunks.size(); ++k)
+        {
+            Time overlap = Min(mpduEnd, chunks[k].end) - Max(mpduStart, chunks[k].start);
+            if (overlap.IsStrictlyPositive())
+            {
+                uint64_t nbits =
+                    static_cast<uint64_t>(rate * overlap.GetSeconds()) / txVector.GetNss();
+                psr *= errorRateModel->GetChunkSuccessRate(mode,
+                                                           txVector,
+                                                           effectiveSnrs[k],
+                                                           nbits,
+                                                           GetNumberOfAntennas(),
+                                                           WIFI_PPDU_FIELD_DATA);
+            }
+        }
+        NS_LOG_DEBUG("MPDU #" << i << ": PER=" << 1 - psr);
+        statusPerMpdu.push_back(m_random->GetValue() > 1 - psr);
+
+        ++i;
+        mpduStart = mpduEnd;
+        mpduType = (i == (nMpdus - 1)) ? LAST_MPDU_IN_AGGREGATE : MIDDLE_MPDU_IN_AGGREGATE;
+    }
+
+    double signalW = 0;
+    for (const auto& band : subchannels)
+    {
+        signalW += event->GetRxPowerW(band);
+    }
+    RxSignalInfo rxSignalInfo;
+    rxSignalInfo.snr = meanSnr;
+    rxSignalInfo.rssi = WToDbm(signalW);
+
+    if (nMpdus > 1)
+    {
+        auto mpdu = psdu->begin();
+        for (std::size_t i = 0; i < nMpdus; ++i, ++mpdu)
+        {
+            if (statusPerMpdu[i])
+            {
+                m_state->NotifyRxMpdu(Create<WifiPsdu>(*mpdu, false), rxSignalInfo, txVector);
+            }
+        }
+    }
+
+    NotifyRxEnd(psdu);
+    if (std::count(statusPerMpdu.begin(), statusPerMpdu.end(), true) > 0)
+    {
+        SignalNoiseDbm signalNoise;
+        signalNoise.signal = WToDbm(signalW);
+        signalNoise.noise = WToDbm(signalW / meanSnr);
+        NotifyMonitorSniffRx(psdu, GetFrequency(), txVector, signalNoise, statusPerMpdu, SU_STA_ID);
+        m_state->NotifyRxPsduSucceeded(psdu, rxSignalInfo, txVector, SU_STA_ID, statusPerMpdu);
+        m_state->SwitchFromRxEndOk();
+        m_previouslyRxPpduUid = ppdu->GetUid();
+    }
+    else
+    {
+        m_state->NotifyRxPsduFailed(psdu, meanSnr);
+        m_state->SwitchFromRxEndError();
+    }
+
+    m_interference->NotifyRxEnd(Simulator::Now());
+    m_currentEvent = nullptr;
+    SwitchMaybeToCcaBusy(ppdu);
+}
+
+double
+AbstractedWifiPhy::GetEffectiveSnr(const std::vector<double>& snrs,
+                                   uint16_t constellationSize) const
+{
+    NS_ASSERT(!snrs.empty());
+    if (std::adjacent_find(snrs.begin(), snrs.end(), std::not_equal_to<double>()) == snrs.end())
+    {
+        // flat channel: no need to map
+        return snrs.front();
+    }
+    double effectiveSnr = 0;
+    if (m_mapping == EESM)
+    {
+        // exp(-snr / beta) is normalized by its largest value, to avoid underflows
+        double beta = GetEesmBeta(constellationSize);
+        double minSnr = *std::min_element(snrs.begin(), snrs.end());
+        double sum = 0;
+        for (auto snr : snrs)
+        {
+            sum += std::exp(-(snr - minSnr) / beta);
+        }
+        effectiveSnr = minSnr - beta * std::log(sum / snrs.size());
+    }
+    else
+    {
+        double mi = 0;
+        for (auto snr : snrs)
+        {
+            mi += GetMutualInformation(snr, constellationSize);
+        }
+        effectiveSnr = GetSnrFromMutualInformation(mi / snrs.size(), constellationSize);
+    }
+    NS_LOG_DEBUG("Effective SNR(dB)=" << RatioToDb(effectiveSnr) << " over " << snrs.size()
+                                      << " subchannels");
+    return effectiveSnr;
+}
+
+/**
+ * \param nPoints the number of points of the constellation
+ * \param energy the average energy of the points
+ * \param noiseVariance the variance of the noise
+ * \return the mutual information (in bits per symbol) between the input and the output of a
+ *         real AWGN channel whose input is a PAM constellation with equiprobable points
+ */
+static double
+GetPamMutualInformation(uint16_t nPoints, double energy, double noiseVariance)
+{
+    // the points are (2i - nPoints + 1) * a, i = 0..nPoints-1
+    double a = std::sqrt(3 * energy / (nPoints * nPoints - 1));
+    std::vector<double> points;
+    for (uint16_t i = 0; i < nPoints; ++i)
+    {
+        points.push_back((2 * i - nPoints + 1) * a);
+    }
+    // the expectation over the noise is computed with the trapezoidal rule, which converges
+    // very fast for Gaussian integrands; by symmetry, only half of the points are averaged
+    double sigma = std::sqrt(noiseVariance);
+    double sum = 0;
+    double weights = 0;
+    for (double z = -6; z <= 6; z += 0.25)
+    {
+        double weight = std::exp(-z * z / 2);
+        double n = sigma * z;
+        double expectation = 0;
+        for (uint16_t i = 0; i < (nPoints + 1) / 2; ++i)
+        {
+            double likelihoods = 0;
+            for (auto point : points)
+            {
+                double d = points[i] - point;
+                likelihoods += std::exp(-(d * d + 2 * d * n) / (2 * noiseVariance));
+            }
+            expectation += std::log2(likelihoods);
+        }
+        sum += weight * expectation;
+        weights += weight;
+    }
+    return std::log2(nPoints) - sum / weights / ((nPoints + 1) / 2);
+}
+
+const std::vector<double>&
+AbstractedWifiPhy::GetMutualInformationTable(uint16_t constellationSize)
+{
+    static std::map<uint16_t, std::vector<double>> tables;
+    auto [it, inserted] = tables.try_emplace(constellationSize);
+    if (inserted)
+    {
+        NS_LOG_DEBUG("Compute the mutual information of " << constellationSize << "-QAM");
+        auto pamSize = static_cast<uint16_t>(std::lround(std::sqrt(constellationSize)));
+        NS_ABORT_MSG_IF(constellationSize > 2 && pamSize * pamSize != constellationSize,
+                        "Unsupported constellation size " << constellationSize);
+        auto n =
+            static_cast<std::size_t>(std::lround((MI_MAX_SNR_DB - MI_MIN_SNR_DB) / MI_STEP_DB));
+        for (std::size_t i = 0; i <= n; ++i)
+        {
+            double snr = DbToRatio(MI_MIN_SNR_DB + i * MI_STEP_DB);
+            // unit energy symbols; the noise has a variance of 1 / (2 * snr) per dimension
+            double mi = (constellationSize <= 2)
+                            ? GetPamMutualInformation(2, 1, 1 / (2 * snr))
+                            : 2 * GetPamMutualInformation(pamSize, 0.5, 1 / (2 * snr));
+            // enforce monotonicity despite rounding errors
+            it->second.push_back(it->second.empty() ? mi : std::max(mi, it->second.back()));
+        }
+    }
+    return it->second;
+}
+
+double
+AbstractedWifiPhy::GetMutualInformation(double snr, uint16_t constellationSize)
+{
+    const auto& table = GetMutualInformationTable(constellationSize);
+    double index = (RatioToDb(snr) - MI_MIN_SNR_DB) / MI_STEP_DB;
+    if (!(index > 0))
+    {
+        return table.front();
+    }
+    if (index >= table.size() - 1)
+    {
+        return table.back();
+    }
+    auto i = static_cast<std::size_t>(index);
+    double frac = index - i;
+    return table[i] + frac * (table[i + 1] - table[i]);
+}
+
+double
+AbstractedWifiPhy::GetSnrFromMutualInformation(double mi, uint16_t constellationSize)
+{
+    const auto& table = GetMutualInformationTable(constellationSize);
+    auto it = std::lower_bound(table.begin(), table.end(), mi);
+    if (it == table.begin())
+    {
+        return DbToRatio(MI_MIN_SNR_DB);
+    }
+    if (it == table.end())
+    {
+        return DbToRatio(MI_MAX_SNR_DB);
+    }
+    auto i = static_cast<std::size_t>(std::distance(table.begin(), it)) - 1;
+    double frac = (*it > table[i]) ? (mi - table[i]) / (*it - table[i]) : 0;
+    return DbToRatio(MI_MIN_SNR_DB + (i + frac) * MI_STEP_DB);
+}
+
+} // namespace ns3
@@ -0,0 +1,171 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ABSTRACTED_WIFI_PHY_H
+#define ABSTRACTED_WIFI_PHY_H
+
+#include "spectrum-wifi-phy.h"
+
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace ns3
+{
+
+class Event;
+
+/**
+ * \brief 802.11 PHY layer model with an abstracted reception of SU PPDUs
+ * \ingroup wifi
+ *
+ * This PHY transmits like SpectrumWifiPhy, but it does not go through the
+ * reception state machine of the PHY entities for SU PPDUs (except DSSS and
+ * HR/DSSS ones). The reception of such a PPDU is decided upon its arrival, if
+ * the PHY is neither transmitting nor receiving: the preamble detection model
+ * (if any) is queried with the SNR at the start of the PPDU, and the PHY
+ * header fields are checked against the SNR at the start of the PPDU, without
+ * waiting for their end. If the PPDU is received, the PHY switches to RX until
+ * the end of the PPDU and notifies the start of the PSDU (PHY-RXSTART) right
+ * away. Only the end of the PPDU is scheduled: the success of the MPDUs is then
+ * evaluated and the correct MPDUs are delivered at once. Frame capture, the
+ * post-reception error model and OBSS PD spatial reuse are not modeled. MU
+ * PPDUs go through the PHY entities as in SpectrumWifiPhy.
+ *
+ * The success rate of the payload is computed by a link-to-system mapping:
+ * over each interval during which the interference does not change, the SNIRs
+ * in the 20 MHz subchannels occupied by the PPDU are combined into an effective
+ * SNR, which is passed to the error rate model of the InterferenceHelper
+ * (pre-computed error rate models, such as TableBasedErrorRateModel or
+ * NistErrorRateModel with a SuccessRateTableStep, keep this cheap). The
+ * available mappings are the Exponential Effective SNR Mapping (EESM) and the
+ * Mutual Information Effective SNR Mapping (MIESM). They only differ from the
+ * SNR computed by SpectrumWifiPhy when the SNIR is not the same in all the
+ * subchannels (e.g., with partial overlap of the interferers or frequency
+ * selective propagation loss models).
+ */
+class AbstractedWifiPhy : public SpectrumWifiPhy
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    AbstractedWifiPhy();
+    ~AbstractedWifiPhy() override;
+
+    /// Effective SNR mappings
+    enum EffectiveSnrMapping
+    {
+        EESM = 0, //!< Exponential Effective SNR Mapping
+        MIESM     //!< Mutual Information Effective SNR Mapping
+    };
+
+    void StartReceivePreamble(Ptr<const WifiPpdu> ppdu,
+                              RxPowerWattPerChannelBand& rxPowersW,
+                              Time rxDuration) override;
+
+    /**
+     * Set the calibration factor of EESM for a constellation. By default,
+     * beta is 2 * (M - 1) / 3 for M-QAM and 1 for BPSK, which corresponds to
+     * the Chernoff bound on the pairwise error probability of the nearest
+     * points of the constellation.
+     *
+     * \param constellationSize the size of the constellation
+     * \param beta the calibration factor
+     */
+    void SetEesmBeta(uint16_t constellationSize, double beta);
+
+    /**
+     * \param constellationSize the size of the constellation
+     * \return the calibration factor of EESM for the constellation
+     */
+    double GetEesmBeta(uint16_t constellationSize) const;
+
+    /**
+     * Combine the SNRs of the subchannels into an effective SNR with the
+     * mapping of this PHY.
+     *
+     * \param snrs the SNRs (linear scale) of the subchannels
+     * \param constellationSize the size of the constellation
+     * \return the effective SNR (linear scale)
+     */
+    double GetEffectiveSnr(const std::vector<double>& snrs, uint16_t constellationSize) const;
+
+    /**
+     * \param snr the SNR (linear scale)
+     * \param constellationSize the size of the constellation (2 for BPSK, a power of 4 otherwise)
+     * \return the mutual information (in bits per symbol) between the input and
+     *         the output of an AWGN channel with the given constellation
+     */
+    static double GetMutualInformation(double snr, uint16_t constellationSize);
+
+  private:
+    /**
+     * \param ppdu the PPDU
+     * \return whether the reception of the PPDU is abstracted
+     */
+    bool IsAbstracted(Ptr<const WifiPpdu> ppdu) const;
+
+    /**
+     * \param ppdu the PPDU
+     * \return the reason the reception of the PPDU cannot start, if any
+     */
+    std::optional<WifiPhyRxfailureReason> CanStartAbstractedRx(Ptr<const WifiPpdu> ppdu) const;
+
+    /**
+     * \param txVector the TXVECTOR of the PPDU
+     * \return the width (in MHz) of the subchannels occupied by the PPDU and their bands
+     */
+    std::pair<uint16_t, std::vector<WifiSpectrumBand>> GetSubchannels(
+        const WifiTxVector& txVector);
+
+    /**
+     * Check the preamble and the PHY header of the PPDU against the SNR at its start.
+     *
+     * \param event the event of the PPDU
+     * \return the reason the PPDU is not received, if any
+     */
+    std::optional<WifiPhyRxfailureReason> CheckPhyHeader(Ptr<Event> event);
+
+    /**
+     * Evaluate the reception of the MPDUs of the PPDU and notify the MAC.
+     *
+     * \param event the event of the PPDU
+     */
+    void EndReceive(Ptr<Event> event);
+
+    /**
+     * \param mi the mutual information (in bits per symbol)
+     * \param constellationSize the size of the constellation
+     * \return the SNR (linear scale) whose mutual information is the given one
+     */
+    static double GetSnrFromMutualInformation(double mi, uint16_t constellationSize);
+
+    /**
+     * \param constellationSize the size of the constellation
+     * \return the mutual information of the constellation sampled on a grid of SNR values
+     */
+    static const std::vector<double>& GetMutualInformationTable(uint16_t constellationSize);
+
+    EffectiveSnrMapping m_mapping;          //!< the effective SNR mapping
+    std::map<uint16_t, double> m_eesmBetas; //!< EESM calibration factors, by constellation size
+};
+
+} // namespace ns3
+
+#endif /* ABSTRACTED_WIFI_PHY_H */
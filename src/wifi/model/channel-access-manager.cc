@@ -24,6 +24,7 @@
 #include "wifi-phy-listener.h"
 #include "wifi-phy.h"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 
@@ -35,6 +36,8 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("ChannelAccessManager");
 
+NS_OBJECT_ENSURE_REGISTERED(ChannelAccessManager);
+
 /**
  * Listener for PHY events. Forwards to ChannelAccessManager
  */
@@ -115,6 +118,27 @@ class PhyListener : public ns3::WifiPhyListener
  *      Implement the channel access manager of all Txop holders
  ****************************************************************/
 
+TypeId
+ChannelAccessManager::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ChannelAccessManager")
+            .SetParent<Object>()
+            .SetGroupName("Wifi")
+            .AddConstructor<ChannelAccessManager>()
+            .AddAttribute("AnalyticBackoff",
+                          "If true, the access timeout is moved every time the state of the "
+                          "medium changes, so that it only expires when the backoff of a Txop "
+                          "expires, rather than expiring while the medium is busy and being "
+                          "rescheduled then. The times at which access is granted are the same, "
+                          "but the devices granted access at the same time may start "
+                          "transmitting in a different order.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ChannelAccessManager::m_analyticBackoff),
+                          MakeBooleanChecker());
+    return tid;
+}
+
 ChannelAccessManager::ChannelAccessManager()
     : m_lastAckTimeoutEnd(MicroSeconds(0)),
       m_lastCtsTimeoutEnd(MicroSeconds(0)),
@@ -125,6 +149,7 @@ ChannelAccessManager::ChannelAccessManager()
       m_lastSwitchingEnd(MicroSeconds(0)),
       m_sleeping(false),
       m_off(false),
+      m_analyticBackoff(false),
       m_phyListener(nullptr),
       m_linkId(0)
 {
@@ -368,12 +393,13 @@ ChannelAccessManager::DoGrantDcfAccess()
     NS_LOG_FUNCTION(this);
     uint32_t k = 0;
     Time now = Simulator::Now();
+    Time accessGrantStart = GetAccessGrantStart();
     for (Txops::iterator i = m_txops.begin(); i != m_txops.end(); k++)
     {
         Ptr<Txop> txop = *i;
         if (txop->GetAccessStatus(m_linkId) == Txop::REQUESTED &&
             (!txop->IsQosTxop() || !StaticCast<QosTxop>(txop)->EdcaDisabled(m_linkId)) &&
-            GetBackoffEndFor(txop) <= now)
+            GetBackoffEndFor(txop, accessGrantStart) <= now)
         {
             /**
              * This is the first Txop we find with an expired backoff and which
@@ -388,7 +414,7 @@ ChannelAccessManager::DoGrantDcfAccess()
             {
                 Ptr<Txop> otherTxop = *j;
                 if (otherTxop->GetAccessStatus(m_linkId) == Txop::REQUESTED &&
-                    GetBackoffEndFor(otherTxop) <= now)
+                    GetBackoffEndFor(otherTxop, accessGrantStart) <= now)
                 {
                     NS_LOG_DEBUG(
                         "dcf " << k << " needs access. backoff expired. internal collision. slots="
@@ -435,6 +461,7 @@ ChannelAccessManager::DoGrantDcfAccess()
                 // but did not transmit anything
                 i--;
                 k = std::distance(m_txops.begin(), i);
+                accessGrantStart = GetAccessGrantStart();
             }
         }
         i++;
@@ -498,10 +525,15 @@ ChannelAccessManager::GetAccessGrantStart(bool ignoreNav) const
 Time
 ChannelAccessManager::GetBackoffStartFor(Ptr<Txop> txop)
 {
-    NS_LOG_FUNCTION(this << txop);
-    Time mostRecentEvent =
-        std::max({txop->GetBackoffStart(m_linkId),
-                  GetAccessGrantStart() + (txop->GetAifsn(m_linkId) * GetSlot())});
+    return GetBackoffStartFor(txop, GetAccessGrantStart());
+}
+
+Time
+ChannelAccessManager::GetBackoffStartFor(Ptr<Txop> txop, Time accessGrantStart)
+{
+    NS_LOG_FUNCTION(this << txop << accessGrantStart.As(Time::US));
+    Time mostRecentEvent = std::max({txop->GetBackoffStart(m_linkId),
+                                     accessGrantStart + (txop->GetAifsn(m_linkId) * GetSlot())});
     NS_LOG_DEBUG("Backoff start: " << mostRecentEvent.As(Time::US));
 
     return mostRecentEvent;
@@ -510,8 +542,15 @@ ChannelAccessManager::GetBackoffStartFor(Ptr<Txop> txop)
 Time
 ChannelAccessManager::GetBackoffEndFor(Ptr<Txop> txop)
 {
-    NS_LOG_FUNCTION(this << txop);
-    Time backoffEnd = GetBackoffStartFor(txop) + (txop->GetBackoffSlots(m_linkId) * GetSlot());
+    return GetBackoffEndFor(txop, GetAccessGrantStart());
+}
+
+Time
+ChannelAccessManager::GetBackoffEndFor(Ptr<Txop> txop, Time accessGrantStart)
+{
+    NS_LOG_FUNCTION(this << txop << accessGrantStart.As(Time::US));
+    Time backoffEnd = GetBackoffStartFor(txop, accessGrantStart) +
+                      (txop->GetBackoffSlots(m_linkId) * GetSlot());
     NS_LOG_DEBUG("Backoff end: " << backoffEnd.As(Time::US));
 
     return backoffEnd;
@@ -522,9 +561,10 @@ ChannelAccessManager::UpdateBackoff()
 {
     NS_LOG_FUNCTION(this);
     uint32_t k = 0;
+    Time accessGrantStart = GetAccessGrantStart();
     for (auto txop : m_txops)
     {
-        Time backoffStart = GetBackoffStartFor(txop);
+        Time backoffStart = GetBackoffStartFor(txop, accessGrantStart);
         if (backoffStart <= Simulator::Now())
         {
             uint32_t nIntSlots = ((Simulator::Now() - backoffStart) / GetSlot()).GetHigh();
@@ -562,11 +602,12 @@ ChannelAccessManager::DoRestartAccessTimeoutIfNeeded()
      */
     bool accessTimeoutNeeded = false;
     Time expectedBackoffEnd = Simulator::GetMaximumSimulationTime();
+    Time accessGrantStart = GetAccessGrantStart();
     for (auto txop : m_txops)
     {
         if (txop->GetAccessStatus(m_linkId) == Txop::REQUESTED)
         {
-            Time tmp = GetBackoffEndFor(txop);
+            Time tmp = GetBackoffEndFor(txop, accessGrantStart);
             if (tmp > Simulator::Now())
             {
                 accessTimeoutNeeded = true;
@@ -584,6 +625,13 @@ ChannelAccessManager::DoRestartAccessTimeoutIfNeeded()
         {
             m_accessTimeout.Cancel();
         }
+        else if (m_analyticBackoff && m_accessTimeout.IsRunning() &&
+                 Simulator::GetDelayLeft(m_accessTimeout) < expectedBackoffDelay)
+        {
+            // the access timeout would expire before any backoff does, only to be
+            // restarted: remove it from the scheduler and schedule the actual expiry
+            Simulator::Remove(m_accessTimeout);
+        }
         if (m_accessTimeout.IsExpired())
         {
             m_accessTimeout = Simulator::Schedule(expectedBackoffDelay,
@@ -593,6 +641,15 @@ ChannelAccessManager::DoRestartAccessTimeoutIfNeeded()
     }
 }
 
+void
+ChannelAccessManager::NotifyMediumStateChanged()
+{
+    if (m_analyticBackoff)
+    {
+        DoRestartAccessTimeoutIfNeeded();
+    }
+}
+
 uint16_t
 ChannelAccessManager::GetLargestIdlePrimaryChannel(Time interval, Time end)
 {
@@ -651,6 +708,7 @@ ChannelAccessManager::NotifyRxStartNow(Time duration)
     m_lastRx.start = Simulator::Now();
     m_lastRx.end = m_lastRx.start + duration;
     m_lastRxReceivedOk = true;
+    NotifyMediumStateChanged();
 }
 
 void
@@ -660,6 +718,7 @@ ChannelAccessManager::NotifyRxEndOkNow()
     NS_LOG_DEBUG("rx end ok");
     m_lastRx.end = Simulator::Now();
     m_lastRxReceivedOk = true;
+    NotifyMediumStateChanged();
 }
 
 void
@@ -670,6 +729,7 @@ ChannelAccessManager::NotifyRxEndErrorNow()
     // we expect the PHY to notify us of the start of a CCA busy period, if needed
     m_lastRx.end = Simulator::Now();
     m_lastRxReceivedOk = false;
+    NotifyMediumStateChanged();
 }
 
 void
@@ -692,6 +752,7 @@ ChannelAccessManager::NotifyTxStartNow(Time duration)
     NS_LOG_DEBUG("tx start for " << duration);
     UpdateBackoff();
     m_lastTxEnd = now + duration;
+    NotifyMediumStateChanged();
 }
 
 void
@@ -715,6 +776,10 @@ ChannelAccessManager::NotifyCcaBusyStartNow(Time duration,
             m_lastPer20MHzBusyEnd[chIdx] = now + per20MhzDurations[chIdx];
         }
     }
+    if (channelType == WIFI_CHANLIST_PRIMARY)
+    {
+        NotifyMediumStateChanged();
+    }
 }
 
 void
@@ -858,6 +923,7 @@ ChannelAccessManager::NotifyNavStartNow(Time duration)
     NS_LOG_DEBUG("nav start for=" << duration);
     UpdateBackoff();
     m_lastNavEnd = std::max(m_lastNavEnd, Simulator::Now() + duration);
+    NotifyMediumStateChanged();
 }
 
 void
@@ -866,6 +932,7 @@ ChannelAccessManager::NotifyAckTimeoutStartNow(Time duration)
     NS_LOG_FUNCTION(this << duration);
     NS_ASSERT(m_lastAckTimeoutEnd < Simulator::Now());
     m_lastAckTimeoutEnd = Simulator::Now() + duration;
+    NotifyMediumStateChanged();
 }
 
 void
@@ -881,6 +948,7 @@ ChannelAccessManager::NotifyCtsTimeoutStartNow(Time duration)
 {
     NS_LOG_FUNCTION(this << duration);
     m_lastCtsTimeoutEnd = Simulator::Now() + duration;
+    NotifyMediumStateChanged();
 }
 
 void
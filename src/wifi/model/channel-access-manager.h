@@ -56,6 +56,12 @@ class FrameExchangeManager;
 class ChannelAccessManager : public Object
 {
   public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
     ChannelAccessManager();
     ~ChannelAccessManager() override;
 
@@ -275,6 +281,17 @@ class ChannelAccessManager : public Object
      * \return the time when the backoff procedure started
      */
     Time GetBackoffStartFor(Ptr<Txop> txop);
+    /**
+     * Return the time when the backoff procedure started for the given Txop,
+     * given the time returned by GetAccessGrantStart(), which does not depend
+     * on the Txop and can thus be computed once for all the Txops.
+     *
+     * \param txop the Txop
+     * \param accessGrantStart the time at which access could start to be granted
+     *
+     * \return the time when the backoff procedure started
+     */
+    Time GetBackoffStartFor(Ptr<Txop> txop, Time accessGrantStart);
     /**
      * Return the time when the backoff procedure
      * ended (or will ended) for the given Txop.
@@ -284,6 +301,16 @@ class ChannelAccessManager : public Object
      * \return the time when the backoff procedure ended (or will ended)
      */
     Time GetBackoffEndFor(Ptr<Txop> txop);
+    /**
+     * Return the time when the backoff procedure ended (or will end) for the
+     * given Txop, given the time returned by GetAccessGrantStart().
+     *
+     * \param txop the Txop
+     * \param accessGrantStart the time at which access could start to be granted
+     *
+     * \return the time when the backoff procedure ended (or will end)
+     */
+    Time GetBackoffEndFor(Ptr<Txop> txop, Time accessGrantStart);
     /**
      * This method determines whether the medium has been idle during a period (of
      * non-null duration) immediately preceding the time this method is called. If
@@ -295,7 +322,18 @@ class ChannelAccessManager : public Object
      */
     void UpdateLastIdlePeriod();
 
+    /**
+     * Schedule the access timeout at the earliest time at which the backoff of a
+     * Txop requesting access expires, if any. In analytic backoff mode, a running
+     * access timeout that would expire before such time is rescheduled, so that
+     * it does not expire while the medium is busy.
+     */
     void DoRestartAccessTimeoutIfNeeded();
+    /**
+     * In analytic backoff mode, bring the access timeout up to date after a change
+     * of the medium state; do nothing otherwise.
+     */
+    void NotifyMediumStateChanged();
 
     /**
      * Called when access timeout should occur
@@ -358,6 +396,7 @@ class ChannelAccessManager : public Object
     bool m_off;                 //!< flag whether it is in off state
     Time m_eifsNoDifs;          //!< EIFS no DIFS time
     EventId m_accessTimeout;    //!< the access timeout ID
+    bool m_analyticBackoff;     //!< whether the access timeout follows medium state changes
     PhyListener* m_phyListener; //!< the PHY listener
     Ptr<WifiPhy> m_phy;         //!< pointer to the PHY
     Ptr<FrameExchangeManager> m_feManager; //!< pointer to the Frame Exchange Manager
@@ -310,6 +310,20 @@ void
 InterferenceHelper::AppendEvent(Ptr<Event> event, bool isStartOfdmaRxing)
 {
     NS_LOG_FUNCTION(this << event << isStartOfdmaRxing);
+    if (!m_rxing)
+    {
+        // Discard the changes that occurred before the last one preceding the start of the
+        // event in all the bands, including those the event does not occupy: the signals only
+        // received on a band while the PHY is receiving would otherwise never be discarded.
+        for (auto niIt = m_niChangesPerBand.begin(); niIt != m_niChangesPerBand.end(); ++niIt)
+        {
+            auto previousPosition = GetPreviousPosition(event->GetStartTime(), niIt);
+            if (previousPosition != niIt->second.begin())
+            {
+                niIt->second.erase(niIt->second.begin() + 1, previousPosition);
+            }
+        }
+    }
     for (const auto& it : event->GetRxPowerWPerBand())
     {
         WifiSpectrumBand band = it.first;
@@ -323,8 +337,9 @@ InterferenceHelper::AppendEvent(Ptr<Event> event, bool isStartOfdmaRxing)
         if (!m_rxing)
         {
             m_firstPowerPerBand.find(band)->second = previousPowerStart;
-            // Always leave the first zero power noise event in the list
-            niIt->second.erase(++(niIt->second.begin()), ++previousPowerPosition);
+            // The changes that occurred before the start of the event are no longer
+            // needed. Always leave the first zero power noise event in the list
+            niIt->second.erase(niIt->second.begin() + 1, previousPowerPosition + 1);
         }
         else if (isStartOfdmaRxing)
         {
@@ -335,8 +350,10 @@ InterferenceHelper::AppendEvent(Ptr<Event> event, bool isStartOfdmaRxing)
         }
         auto first =
             AddNiChangeEvent(event->GetStartTime(), NiChange(previousPowerStart, event), niIt);
+        // the end of the event is inserted after its start, which keeps its position
+        auto firstIndex = std::distance(niIt->second.begin(), first);
         auto last = AddNiChangeEvent(event->GetEndTime(), NiChange(previousPowerEnd, event), niIt);
-        for (auto i = first; i != last; ++i)
+        for (auto i = niIt->second.begin() + firstIndex; i != last; ++i)
         {
             i->second.AddPower(it.second);
         }
@@ -397,7 +414,7 @@ InterferenceHelper::CalculateSnr(double signal,
 
 double
 InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
-                                                NiChangesPerBand* nis,
+                                                NiChanges* nis,
                                                 WifiSpectrumBand band) const
 {
     NS_LOG_FUNCTION(this << band.first << band.second);
@@ -406,25 +423,29 @@ InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
     double noiseInterferenceW = firstPower_it->second;
     auto niIt = m_niChangesPerBand.find(band);
     NS_ASSERT(niIt != m_niChangesPerBand.end());
-    auto it = niIt->second.find(event->GetStartTime());
-    for (; it != niIt->second.end() && it->first < Simulator::Now(); ++it)
+    const auto& changes = niIt->second;
+    auto start =
+        std::lower_bound(changes.cbegin(),
+                         changes.cend(),
+                         event->GetStartTime(),
+                         [](const auto& change, const Time& t) { return change.first < t; });
+    NS_ASSERT(start != changes.cend() && start->first == event->GetStartTime());
+    auto it = start;
+    for (; it != changes.cend() && it->first < Simulator::Now(); ++it)
     {
         noiseInterferenceW = it->second.GetPower() - event->GetRxPowerW(band);
     }
-    it = niIt->second.find(event->GetStartTime());
-    NS_ASSERT(it != niIt->second.end());
-    for (; it != niIt->second.end() && it->second.GetEvent() != event; ++it)
+    for (it = start; it != changes.cend() && it->second.GetEvent() != event; ++it)
     {
         ;
     }
-    NiChanges ni;
-    ni.emplace(event->GetStartTime(), NiChange(0, event));
-    while (++it != niIt->second.end() && it->second.GetEvent() != event)
+    nis->clear();
+    nis->emplace_back(event->GetStartTime(), NiChange(0, event));
+    while (++it != changes.cend() && it->second.GetEvent() != event)
     {
-        ni.insert(*it);
+        nis->push_back(*it);
     }
-    ni.emplace(event->GetEndTime(), NiChange(0, event));
-    nis->insert({band, ni});
+    nis->emplace_back(event->GetEndTime(), NiChange(0, event));
     NS_ASSERT_MSG(noiseInterferenceW >= 0,
                   "CalculateNoiseInterferenceW returns negative value " << noiseInterferenceW);
     return noiseInterferenceW;
@@ -476,7 +497,7 @@ InterferenceHelper::CalculatePayloadChunkSuccessRate(double snir,
 double
 InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
                                         uint16_t channelWidth,
-                                        NiChangesPerBand* nis,
+                                        const NiChanges& nis,
                                         WifiSpectrumBand band,
                                         uint16_t staId,
                                         std::pair<Time, Time> window) const
@@ -484,8 +505,7 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
     NS_LOG_FUNCTION(this << channelWidth << band.first << band.second << staId << window.first
                          << window.second);
     double psr = 1.0; /* Packet Success Rate */
-    const auto& niIt = nis->find(band)->second;
-    auto j = niIt.cbegin();
+    auto j = nis.cbegin();
     Time previous = j->first;
     WifiMode payloadMode = event->GetTxVector().GetMode(staId);
     Time phyPayloadStart = j->first;
@@ -500,7 +520,7 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
     Time windowEnd = phyPayloadStart + window.second;
     double noiseInterferenceW = m_firstPowerPerBand.find(band)->second;
     double powerW = event->GetRxPowerW(band);
-    while (++j != niIt.cend())
+    while (++j != nis.cend())
     {
         Time current = j->first;
         NS_LOG_DEBUG("previous= " << previous << ", current=" << current);
@@ -546,15 +566,14 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
 double
 InterferenceHelper::CalculatePhyHeaderSectionPsr(
     Ptr<const Event> event,
-    NiChangesPerBand* nis,
+    const NiChanges& nis,
     uint16_t channelWidth,
     WifiSpectrumBand band,
     PhyEntity::PhyHeaderSections phyHeaderSections) const
 {
     NS_LOG_FUNCTION(this << band.first << band.second);
     double psr = 1.0; /* Packet Success Rate */
-    auto niIt = nis->find(band)->second;
-    auto j = niIt.begin();
+    auto j = nis.cbegin();
 
     NS_ASSERT(!phyHeaderSections.empty());
     Time stopLastSection = Seconds(0);
@@ -566,7 +585,7 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(
     Time previous = j->first;
     double noiseInterferenceW = m_firstPowerPerBand.find(band)->second;
     double powerW = event->GetRxPowerW(band);
-    while (++j != niIt.end())
+    while (++j != nis.cend())
     {
         Time current = j->first;
         NS_LOG_DEBUG("previous= " << previous << ", current=" << current);
@@ -608,18 +627,17 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(
 
 double
 InterferenceHelper::CalculatePhyHeaderPer(Ptr<const Event> event,
-                                          NiChangesPerBand* nis,
+                                          const NiChanges& nis,
                                           uint16_t channelWidth,
                                           WifiSpectrumBand band,
                                           WifiPpduField header) const
 {
     NS_LOG_FUNCTION(this << band.first << band.second << header);
-    auto niIt = nis->find(band)->second;
     auto phyEntity = WifiPhy::GetStaticPhyEntity(event->GetTxVector().GetModulationClass());
 
     PhyEntity::PhyHeaderSections sections;
     for (const auto& section :
-         phyEntity->GetPhyHeaderSections(event->GetTxVector(), niIt.begin()->first))
+         phyEntity->GetPhyHeaderSections(event->GetTxVector(), nis.front().first))
     {
         if (section.first == header)
         {
@@ -644,7 +662,7 @@ InterferenceHelper::CalculatePayloadSnrPer(Ptr<Event> event,
 {
     NS_LOG_FUNCTION(this << channelWidth << band.first << band.second << staId
                          << relativeMpduStartStop.first << relativeMpduStartStop.second);
-    NiChangesPerBand ni;
+    NiChanges ni;
     double noiseInterferenceW = CalculateNoiseInterferenceW(event, &ni, band);
     double snr = CalculateSnr(event->GetRxPowerW(band),
                               noiseInterferenceW,
@@ -654,7 +672,7 @@ InterferenceHelper::CalculatePayloadSnrPer(Ptr<Event> event,
     /* calculate the SNIR at the start of the MPDU (located through windowing) and accumulate
      * all SNIR changes in the SNIR vector.
      */
-    double per = CalculatePayloadPer(event, channelWidth, &ni, band, staId, relativeMpduStartStop);
+    double per = CalculatePayloadPer(event, channelWidth, ni, band, staId, relativeMpduStartStop);
 
     return PhyEntity::SnrPer(snr, per);
 }
@@ -665,7 +683,7 @@ InterferenceHelper::CalculateSnr(Ptr<Event> event,
                                  uint8_t nss,
                                  WifiSpectrumBand band) const
 {
-    NiChangesPerBand ni;
+    NiChanges ni;
     double noiseInterferenceW = CalculateNoiseInterferenceW(event, &ni, band);
     double snr = CalculateSnr(event->GetRxPowerW(band), noiseInterferenceW, channelWidth, nss);
     return snr;
@@ -678,14 +696,14 @@ InterferenceHelper::CalculatePhyHeaderSnrPer(Ptr<Event> event,
                                              WifiPpduField header) const
 {
     NS_LOG_FUNCTION(this << band.first << band.second << header);
-    NiChangesPerBand ni;
+    NiChanges ni;
     double noiseInterferenceW = CalculateNoiseInterferenceW(event, &ni, band);
     double snr = CalculateSnr(event->GetRxPowerW(band), noiseInterferenceW, channelWidth, 1);
 
     /* calculate the SNIR at the start of the PHY header and accumulate
      * all SNIR changes in the SNIR vector.
      */
-    double per = CalculatePhyHeaderPer(event, &ni, channelWidth, band, header);
+    double per = CalculatePhyHeaderPer(event, ni, channelWidth, band, header);
 
     return PhyEntity::SnrPer(snr, per);
 }
@@ -706,7 +724,10 @@ InterferenceHelper::EraseEvents()
 InterferenceHelper::NiChanges::iterator
 InterferenceHelper::GetNextPosition(Time moment, NiChangesPerBand::iterator niIt)
 {
-    return niIt->second.upper_bound(moment);
+    return std::upper_bound(niIt->second.begin(),
+                            niIt->second.end(),
+                            moment,
+                            [](const Time& t, const auto& change) { return t < change.first; });
 }
 
 InterferenceHelper::NiChanges::iterator
@@ -725,6 +746,59 @@ InterferenceHelper::AddNiChangeEvent(Time moment, NiChange change, NiChangesPerB
     return niIt->second.insert(GetNextPosition(moment, niIt), std::make_pair(moment, change));
 }
 
+std::vector<InterferenceHelper::SnrChunk>
+InterferenceHelper::CalculatePayloadSnrChunks(Ptr<Event> event,
+                                              uint16_t channelWidth,
+                                              const std::vector<WifiSpectrumBand>& bands) const
+{
+    NS_LOG_FUNCTION(this << *event << channelWidth << bands.size());
+    const WifiTxVector& txVector = event->GetTxVector();
+    Time payloadStart =
+        event->GetStartTime() + WifiPhy::CalculatePhyPreambleAndHeaderDuration(txVector);
+
+    // the boundaries of the intervals are the NI changes of all the bands
+    std::vector<NiChanges> nis(bands.size());
+    std::vector<double> noiseInterferenceW(bands.size());
+    std::vector<Time> boundaries{payloadStart, event->GetEndTime()};
+    for (std::size_t i = 0; i < bands.size(); ++i)
+    {
+        CalculateNoiseInterferenceW(event, &nis[i], bands[i]);
+        noiseInterferenceW[i] = m_firstPowerPerBand.find(bands[i])->second;
+        for (const auto& change : nis[i])
+        {
+            if (change.first > payloadStart && change.first < event->GetEndTime())
+            {
+                boundaries.push_back(change.first);
+            }
+        }
+    }
+    std::sort(boundaries.begin(), boundaries.end());
+    boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+
+    // the first and last NiChange of each band are the start and end of the event
+    std::vector<std::size_t> next(bands.size(), 1);
+    std::vector<SnrChunk> chunks;
+    chunks.reserve(boundaries.size() - 1);
+    for (std::size_t k = 0; k + 1 < boundaries.size(); ++k)
+    {
+        SnrChunk chunk{boundaries[k] - payloadStart, boundaries[k + 1] - payloadStart, {}};
+        chunk.snr.reserve(bands.size());
+        for (std::size_t i = 0; i < bands.size(); ++i)
+        {
+            double powerW = event->GetRxPowerW(bands[i]);
+            while (next[i] + 1 < nis[i].size() && nis[i][next[i]].first <= boundaries[k])
+            {
+                noiseInterferenceW[i] = nis[i][next[i]].second.GetPower() - powerW;
+                ++next[i];
+            }
+            chunk.snr.push_back(
+                CalculateSnr(powerW, noiseInterferenceW[i], channelWidth, txVector.GetNss()));
+        }
+        chunks.push_back(std::move(chunk));
+    }
+    return chunks;
+}
+
 void
 InterferenceHelper::NotifyRxStart()
 {
@@ -24,6 +24,8 @@
 
 #include "ns3/object.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -270,6 +272,34 @@ class InterferenceHelper : public Object
                                                       WifiSpectrumBand band,
                                                       WifiPpduField header) const;
 
+    /**
+     * A time interval of the PHY payload of an event during which the noise
+     * and interference is constant in all the bands of interest.
+     */
+    struct SnrChunk
+    {
+        Time start;              //!< start of the interval, relative to the start of the payload
+        Time end;                //!< end of the interval, relative to the start of the payload
+        std::vector<double> snr; //!< SNIR (linear scale) in each band
+    };
+
+    /**
+     * Calculate the SNIR of the PHY payload of a SU PPDU in each of the given
+     * bands, over each of the intervals during which the noise and interference
+     * does not change in any of them. This is what effective SNR mappings
+     * (e.g., EESM) take as input.
+     *
+     * \param event the event corresponding to the first time the corresponding PPDU arrives
+     * \param channelWidth the width (in MHz) of each band
+     * \param bands the bands
+     *
+     * \return the intervals covering the PHY payload, in chronological order
+     */
+    std::vector<SnrChunk> CalculatePayloadSnrChunks(
+        Ptr<Event> event,
+        uint16_t channelWidth,
+        const std::vector<WifiSpectrumBand>& bands) const;
+
     /**
      * Notify that RX has started.
      */
@@ -384,9 +414,13 @@ class InterferenceHelper : public Object
     };
 
     /**
-     * typedef for a multimap of NiChange
+     * typedef for a vector of NiChange, sorted by time. The changes occurring
+     * at the same time are kept in the order they were added. Each NiChange
+     * holds the total power received after the change, so that the power at
+     * any time is found by a binary search, without having to sum the powers
+     * of the overlapping events.
      */
-    typedef std::multimap<Time, NiChange> NiChanges;
+    typedef std::vector<std::pair<Time, NiChange>> NiChanges;
 
     /**
      * Map of NiChanges per band
@@ -406,13 +440,13 @@ class InterferenceHelper : public Object
      * Calculate noise and interference power in W.
      *
      * \param event the event
-     * \param nis the NiChanges
+     * \param nis the NiChanges of the band occurring during the event (output)
      * \param band the band
      *
      * \return noise and interference power
      */
     double CalculateNoiseInterferenceW(Ptr<Event> event,
-                                       NiChangesPerBand* nis,
+                                       NiChanges* nis,
                                        WifiSpectrumBand band) const;
     /**
      * Calculate the error rate of the given PHY payload only in the provided time
@@ -421,7 +455,7 @@ class InterferenceHelper : public Object
      *
      * \param event the event
      * \param channelWidth the channel width used to transmit the PSDU (in MHz)
-     * \param nis the NiChanges
+     * \param nis the NiChanges of the band occurring during the event
      * \param band identify the band used by the PSDU
      * \param staId the station ID of the PSDU (only used for MU)
      * \param window time window (pair of start and end times) of PHY payload to focus on
@@ -430,7 +464,7 @@ class InterferenceHelper : public Object
      */
     double CalculatePayloadPer(Ptr<const Event> event,
                                uint16_t channelWidth,
-                               NiChangesPerBand* nis,
+                               const NiChanges& nis,
                                WifiSpectrumBand band,
                                uint16_t staId,
                                std::pair<Time, Time> window) const;
@@ -439,7 +473,7 @@ class InterferenceHelper : public Object
      * can be divided into multiple chunks (e.g. due to interference from other transmissions).
      *
      * \param event the event
-     * \param nis the NiChanges
+     * \param nis the NiChanges of the band occurring during the event
      * \param channelWidth the channel width (in MHz) for header measurement
      * \param band the band
      * \param header the PHY header to consider
@@ -447,7 +481,7 @@ class InterferenceHelper : public Object
      * \return the error rate of the HT PHY header
      */
     double CalculatePhyHeaderPer(Ptr<const Event> event,
-                                 NiChangesPerBand* nis,
+                                 const NiChanges& nis,
                                  uint16_t channelWidth,
                                  WifiSpectrumBand band,
                                  WifiPpduField header) const;
@@ -455,7 +489,7 @@ class InterferenceHelper : public Object
      * Calculate the success rate of the PHY header sections for the provided event.
      *
      * \param event the event
-     * \param nis the NiChanges
+     * \param nis the NiChanges of the band occurring during the event
      * \param channelWidth the channel width (in MHz) for header measurement
      * \param band the band
      * \param phyHeaderSections the map of PHY header sections (\see PhyEntity::PhyHeaderSections)
@@ -463,7 +497,7 @@ class InterferenceHelper : public Object
      * \return the success rate of the PHY header sections
      */
     double CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
-                                        NiChangesPerBand* nis,
+                                        const NiChanges& nis,
                                         uint16_t channelWidth,
                                         WifiSpectrumBand band,
                                         PhyEntity::PhyHeaderSections phyHeaderSections) const;
@@ -20,12 +20,16 @@
 
 #include "nist-error-rate-model.h"
 
+#include "success-rate-table.h"
 #include "wifi-tx-vector.h"
 
+#include "ns3/double.h"
 #include "ns3/log.h"
 
 #include <bitset>
 #include <cmath>
+#include <map>
+#include <tuple>
 
 namespace ns3
 {
@@ -40,11 +44,19 @@ NistErrorRateModel::GetTypeId()
     static TypeId tid = TypeId("ns3::NistErrorRateModel")
                             .SetParent<ErrorRateModel>()
                             .SetGroupName("Wifi")
-                            .AddConstructor<NistErrorRateModel>();
+                            .AddConstructor<NistErrorRateModel>()
+                            .AddAttribute("SuccessRateTableStep",
+                                          "The resolution (in dB) of the pre-computed tables from "
+                                          "which the chunk success rates are interpolated. "
+                                          "If zero, the success rates are computed analytically.",
+                                          DoubleValue(0),
+                                          MakeDoubleAccessor(&NistErrorRateModel::m_tableStep),
+                                          MakeDoubleChecker<double>(0));
     return tid;
 }
 
 NistErrorRateModel::NistErrorRateModel()
+    : m_tableStep(0)
 {
 }
 
@@ -180,6 +192,62 @@ NistErrorRateModel::GetFecQamBer(uint16_t constellationSize,
     return pms;
 }
 
+double
+NistErrorRateModel::GetFecErrorProbability(uint16_t constellationSize,
+                                           uint8_t bValue,
+                                           double snr) const
+{
+    double ber;
+    if (constellationSize == 2)
+    {
+        ber = GetBpskBer(snr);
+    }
+    else if (constellationSize == 4)
+    {
+        ber = GetQpskBer(snr);
+    }
+    else
+    {
+        ber = GetQamBer(constellationSize, snr);
+    }
+    if (ber == 0.0)
+    {
+        return 0.0;
+    }
+    return std::min(CalculatePe(ber, bValue), 1.0);
+}
+
+std::optional<double>
+NistErrorRateModel::LookupSuccessRate(uint16_t constellationSize,
+                                      uint8_t bValue,
+                                      double snr,
+                                      uint64_t nbits) const
+{
+    if (m_tableStep == 0)
+    {
+        return std::nullopt;
+    }
+    // the tables only depend on their parameters, hence they are shared by all the models
+    static std::map<std::tuple<double, uint16_t, uint8_t>, SuccessRateTable> tables;
+    auto key = std::make_tuple(m_tableStep, constellationSize, bValue);
+    auto it = tables.find(key);
+    if (it == tables.end())
+    {
+        NS_LOG_DEBUG("Compute the table for M=" << constellationSize << " b=" << +bValue);
+        it = tables
+                 .emplace(key,
+                          SuccessRateTable(
+                              [this, constellationSize, bValue](double snr) {
+                                  return GetFecErrorProbability(constellationSize, bValue, snr);
+                              },
+                              -20,
+                              70,
+                              m_tableStep))
+                 .first;
+    }
+    return it->second.GetSuccessRate(snr, nbits);
+}
+
 uint8_t
 NistErrorRateModel::GetBValue(WifiCodeRate codeRate) const
 {
@@ -213,6 +281,13 @@ NistErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
     NS_LOG_FUNCTION(this << mode << snr << nbits << +numRxAntennas << field << staId);
     if (mode.GetModulationClass() >= WIFI_MOD_CLASS_ERP_OFDM)
     {
+        if (auto successRate = LookupSuccessRate(mode.GetConstellationSize(),
+                                                 GetBValue(mode.GetCodeRate()),
+                                                 snr,
+                                                 nbits))
+        {
+            return *successRate;
+        }
         if (mode.GetConstellationSize() == 2)
         {
             return GetFecBpskBer(snr, nbits, GetBValue(mode.GetCodeRate()));
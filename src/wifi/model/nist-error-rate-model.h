@@ -23,6 +23,8 @@
 #include "error-rate-model.h"
 #include "wifi-mode.h"
 
+#include <optional>
+
 namespace ns3
 {
 
@@ -53,6 +55,31 @@ class NistErrorRateModel : public ErrorRateModel
                                  uint8_t numRxAntennas,
                                  WifiPpduField field,
                                  uint16_t staId) const override;
+    /**
+     * Return the success rate of a chunk interpolated from the pre-computed
+     * tables, if enabled and if the interpolation is accurate enough.
+     *
+     * \param constellationSize the constellation size (M)
+     * \param bValue the bValue such that coding rate = bValue / (bValue + 1)
+     * \param snr SNR ratio (in linear scale)
+     * \param nbits the number of bits in the chunk
+     *
+     * \return the interpolated success rate, if any
+     */
+    std::optional<double> LookupSuccessRate(uint16_t constellationSize,
+                                            uint8_t bValue,
+                                            double snr,
+                                            uint64_t nbits) const;
+    /**
+     * Return the probability that a bit is in error after applying FEC.
+     *
+     * \param constellationSize the constellation size (M)
+     * \param bValue the bValue such that coding rate = bValue / (bValue + 1)
+     * \param snr SNR ratio (in linear scale)
+     *
+     * \return the probability that a bit is in error after applying FEC
+     */
+    double GetFecErrorProbability(uint16_t constellationSize, uint8_t bValue, double snr) const;
     /**
      * Return the bValue such that coding rate = bValue / (bValue + 1).
      *
@@ -128,6 +155,8 @@ class NistErrorRateModel : public ErrorRateModel
                         double snr,
                         uint64_t nbits,
                         uint8_t bValue) const;
+
+    double m_tableStep; //!< resolution (in dB) of the success rate tables, zero if disabled
 };
 
 } // namespace ns3
@@ -389,6 +389,13 @@ AparfWifiManager::DoGetDataTxVector(WifiRemoteStation* st, uint16_t allowedWidth
         GetAggregation(station));
 }
 
+bool
+AparfWifiManager::DoIsDataTxVectorCacheable() const
+{
+    // rate and power only change when a transmission outcome is reported
+    return true;
+}
+
 WifiTxVector
 AparfWifiManager::DoGetRtsTxVector(WifiRemoteStation* st)
 {
@@ -85,6 +85,7 @@ class AparfWifiManager : public WifiRemoteStationManager
     void DoReportFinalDataFailed(WifiRemoteStation* station) override;
     WifiTxVector DoGetDataTxVector(WifiRemoteStation* station, uint16_t allowedWidth) override;
     WifiTxVector DoGetRtsTxVector(WifiRemoteStation* station) override;
+    bool DoIsDataTxVectorCacheable() const override;
 
     /** Check for initializations.
      *
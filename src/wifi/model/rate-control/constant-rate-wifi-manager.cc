@@ -45,7 +45,8 @@ ConstantRateWifiManager::GetTypeId()
             .AddAttribute("DataMode",
                           "The transmission mode to use for every data packet transmission",
                           StringValue("OfdmRate6Mbps"),
-                          MakeWifiModeAccessor(&ConstantRateWifiManager::m_dataMode),
+                          MakeWifiModeAccessor(&ConstantRateWifiManager::SetDataMode,
+                                               &ConstantRateWifiManager::GetDataMode),
                           MakeWifiModeChecker())
             .AddAttribute("ControlMode",
                           "The transmission mode to use for every RTS packet transmission.",
@@ -65,6 +66,20 @@ ConstantRateWifiManager::~ConstantRateWifiManager()
     NS_LOG_FUNCTION(this);
 }
 
+void
+ConstantRateWifiManager::SetDataMode(WifiMode mode)
+{
+    NS_LOG_FUNCTION(this << mode);
+    m_dataMode = mode;
+    InvalidateDataTxVectors();
+}
+
+WifiMode
+ConstantRateWifiManager::GetDataMode() const
+{
+    return m_dataMode;
+}
+
 WifiRemoteStation*
 ConstantRateWifiManager::DoCreateStation() const
 {
@@ -146,6 +161,13 @@ ConstantRateWifiManager::DoGetDataTxVector(WifiRemoteStation* st, uint16_t allow
         GetAggregation(st));
 }
 
+bool
+ConstantRateWifiManager::DoIsDataTxVectorCacheable() const
+{
+    // the TXVECTOR only depends on the configuration and on the station capabilities
+    return true;
+}
+
 WifiTxVector
 ConstantRateWifiManager::DoGetRtsTxVector(WifiRemoteStation* st)
 {
@@ -44,6 +44,17 @@ class ConstantRateWifiManager : public WifiRemoteStationManager
     ~ConstantRateWifiManager() override;
 
   private:
+    /**
+     * Set the transmission mode to use for every data packet transmission.
+     *
+     * \param mode the transmission mode
+     */
+    void SetDataMode(WifiMode mode);
+    /**
+     * \return the transmission mode to use for every data packet transmission
+     */
+    WifiMode GetDataMode() const;
+
     WifiRemoteStation* DoCreateStation() const override;
     void DoReportRxOk(WifiRemoteStation* station, double rxSnr, WifiMode txMode) override;
     void DoReportRtsFailed(WifiRemoteStation* station) override;
@@ -62,6 +73,7 @@ class ConstantRateWifiManager : public WifiRemoteStationManager
     void DoReportFinalDataFailed(WifiRemoteStation* station) override;
     WifiTxVector DoGetDataTxVector(WifiRemoteStation* station, uint16_t allowedWidth) override;
     WifiTxVector DoGetRtsTxVector(WifiRemoteStation* station) override;
+    bool DoIsDataTxVectorCacheable() const override;
 
     WifiMode m_dataMode; //!< Wifi mode for unicast Data frames
     WifiMode m_ctlMode;  //!< Wifi mode for RTS frames
@@ -358,6 +358,13 @@ ParfWifiManager::DoGetDataTxVector(WifiRemoteStation* st, uint16_t allowedWidth)
         GetAggregation(station));
 }
 
+bool
+ParfWifiManager::DoIsDataTxVectorCacheable() const
+{
+    // rate and power only change when a transmission outcome is reported
+    return true;
+}
+
 WifiTxVector
 ParfWifiManager::DoGetRtsTxVector(WifiRemoteStation* st)
 {
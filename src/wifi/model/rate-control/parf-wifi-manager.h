@@ -74,6 +74,7 @@ class ParfWifiManager : public WifiRemoteStationManager
     void DoReportFinalDataFailed(WifiRemoteStation* station) override;
     WifiTxVector DoGetDataTxVector(WifiRemoteStation* station, uint16_t allowedWidth) override;
     WifiTxVector DoGetRtsTxVector(WifiRemoteStation* station) override;
+    bool DoIsDataTxVectorCacheable() const override;
 
     /** Check for initializations.
      *
@@ -0,0 +1,105 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "success-rate-table.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SuccessRateTable");
+
+/// Smallest value of h, for which the success rate is one
+static const double H_MIN = std::log(std::numeric_limits<double>::min());
+/// Largest value of h, for which the success rate of a single unit is zero
+static const double H_MAX = std::log(1000.0);
+/// Value of h above which the success rate is not interpolated (p = 0.1)
+static const double H_EXACT = std::log(-std::log1p(-0.1));
+
+SuccessRateTable::SuccessRateTable(ErrorProbability errorProbability,
+                                   double minSnrDb,
+                                   double maxSnrDb,
+                                   double stepDb)
+    : m_minSnrDb(minSnrDb),
+      m_stepDb(stepDb)
+{
+    NS_LOG_FUNCTION(this << minSnrDb << maxSnrDb << stepDb);
+    NS_ASSERT_MSG(stepDb > 0 && maxSnrDb > minSnrDb, "Invalid SNR grid");
+    auto size = static_cast<std::size_t>(std::ceil((maxSnrDb - minSnrDb) / stepDb)) + 1;
+    m_h.reserve(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        double p = errorProbability(std::pow(10.0, (minSnrDb + i * stepDb) / 10.0));
+        double h;
+        if (p <= 0)
+        {
+            h = H_MIN;
+        }
+        else if (p >= 1)
+        {
+            h = H_MAX;
+        }
+        else
+        {
+            h = std::clamp(std::log(-std::log1p(-p)), H_MIN, H_MAX);
+        }
+        m_h.push_back(h);
+    }
+}
+
+std::optional<double>
+SuccessRateTable::GetSuccessRate(double snr, double nUnits) const
+{
+    double h;
+    double x = (10.0 * std::log10(snr) - m_minSnrDb) / m_stepDb;
+    if (!(x >= 0))
+    {
+        // below the grid (or zero SNR): the success rate is zero if p reached one
+        if (m_h.front() < H_MAX)
+        {
+            return std::nullopt;
+        }
+        h = H_MAX;
+    }
+    else if (x >= m_h.size() - 1)
+    {
+        // above the grid: the success rate is one if p reached zero
+        if (m_h.back() > H_MIN)
+        {
+            return std::nullopt;
+        }
+        h = H_MIN;
+    }
+    else
+    {
+        auto i = static_cast<std::size_t>(x);
+        double h0 = m_h[i];
+        double h1 = m_h[i + 1];
+        if (std::max(h0, h1) > H_EXACT && std::min(h0, h1) < H_MAX)
+        {
+            return std::nullopt;
+        }
+        h = h0 + (x - i) * (h1 - h0);
+    }
+    return std::exp(-nUnits * std::exp(h));
+}
+
+} // namespace ns3
@@ -0,0 +1,84 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SUCCESS_RATE_TABLE_H
+#define SUCCESS_RATE_TABLE_H
+
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup wifi
+ * \brief Pre-computed success rates of chunks of independent units (e.g., bits)
+ *
+ * Error rate models such as NistErrorRateModel and YansErrorRateModel compute
+ * the probability p(snr) that a decoded bit is in error, and the success rate
+ * of a chunk of n bits as (1 - p)^n. The table samples
+ * h = ln(-ln(1 - p)) on a uniform grid of SNR values (in dB) and returns the
+ * success rate exp(-n * exp(h)), where h is linearly interpolated between two
+ * points of the grid. Since n only scales the exponent, a single table serves
+ * chunks of any size, and an error e on h translates into an absolute error
+ * on the success rate of at most e / exp(1), whatever the value of n.
+ *
+ * h is smooth as long as p is small, but it diverges as p approaches one: the
+ * table does not return a value for the cells of the grid where p exceeds 0.1,
+ * unless p is equal to one at both ends of the cell. Beyond the ends of the
+ * grid, the success rate is only returned if p is zero (for large SNRs) or
+ * one (for small SNRs) at the end of the grid. The error probability is
+ * assumed to be non-increasing with the SNR.
+ */
+class SuccessRateTable
+{
+  public:
+    /**
+     * Callback returning the error probability of a unit (between zero and one)
+     * given the SNR (linear scale)
+     */
+    using ErrorProbability = std::function<double(double)>;
+
+    /**
+     * Create a table. The callback is only invoked by the constructor.
+     *
+     * \param errorProbability the error probability of a unit
+     * \param minSnrDb the smallest SNR (in dB) of the grid
+     * \param maxSnrDb the largest SNR (in dB) of the grid
+     * \param stepDb the resolution (in dB) of the grid
+     */
+    SuccessRateTable(ErrorProbability errorProbability,
+                     double minSnrDb,
+                     double maxSnrDb,
+                     double stepDb);
+
+    /**
+     * \param snr the SNR (linear scale)
+     * \param nUnits the number of units in the chunk
+     * \return the success rate of the chunk, if it can be interpolated with
+     *         sufficient accuracy
+     */
+    std::optional<double> GetSuccessRate(double snr, double nUnits) const;
+
+  private:
+    double m_minSnrDb;       //!< the smallest SNR (in dB) of the grid
+    double m_stepDb;         //!< the resolution (in dB) of the grid
+    std::vector<double> m_h; //!< ln(-ln(1 - p)) at each point of the grid
+};
+
+} // namespace ns3
+
+#endif /* SUCCESS_RATE_TABLE_H */
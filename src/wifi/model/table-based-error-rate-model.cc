@@ -32,6 +32,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <map>
 
 namespace ns3
 {
@@ -43,6 +44,89 @@ NS_OBJECT_ENSURE_REGISTERED(TableBasedErrorRateModel);
 
 NS_LOG_COMPONENT_DEFINE("TableBasedErrorRateModel");
 
+/**
+ * \brief PERs of a table for all the SNR values within the range of the table,
+ * spaced by the precision used to round the SNR
+ */
+struct DensePerTable
+{
+    int64_t first;           //!< index of the first SNR value, i.e., SNR (dB) * 10^SNR_PRECISION
+    std::vector<double> per; //!< PER for each SNR value
+};
+
+/**
+ * Interpolate the PER of a table for a rounded SNR within the range of the table
+ *
+ * \param table the table
+ * \param roundedSnr the rounded SNR (in dB)
+ * \return the PER
+ */
+static double
+InterpolatePer(const SnrPerTable& table, double roundedSnr)
+{
+    auto itTable = std::find_if(table.cbegin(),
+                                table.cend(),
+                                [&roundedSnr](const std::pair<double, double>& element) {
+                                    return element.first == roundedSnr;
+                                });
+    if (itTable != table.cend())
+    {
+        return itTable->second;
+    }
+    double a = 0.0;
+    double b = 0.0;
+    double previousSnr = 0.0;
+    double nextSnr = 0.0;
+    for (auto i = table.cbegin(); i != table.cend(); ++i)
+    {
+        if (i->first < roundedSnr)
+        {
+            previousSnr = i->first;
+            a = i->second;
+        }
+        else
+        {
+            nextSnr = i->first;
+            b = i->second;
+            break;
+        }
+    }
+    return a + (roundedSnr - previousSnr) * (b - a) / (nextSnr - previousSnr);
+}
+
+/**
+ * Get the PER of a table for all the SNR values within its range, which are
+ * computed the first time the table is used.
+ *
+ * \param table the table
+ * \return the dense table
+ */
+static const DensePerTable&
+GetDensePerTable(const SnrPerTable& table)
+{
+    static std::map<const SnrPerTable*, DensePerTable> denseTables;
+    auto it = denseTables.find(&table);
+    if (it != denseTables.end())
+    {
+        return it->second;
+    }
+    double multiplier = std::round(std::pow(10.0, SNR_PRECISION));
+    double minSnr = table.cbegin()->first;
+    double maxSnr = (--table.cend())->first;
+    auto first = std::llround(minSnr * multiplier);
+    if (first / multiplier < minSnr)
+    {
+        first++;
+    }
+    DensePerTable& dense = denseTables[&table];
+    dense.first = first;
+    for (auto index = first; index / multiplier <= maxSnr; ++index)
+    {
+        dense.per.push_back(InterpolatePer(table, index / multiplier));
+    }
+    return dense;
+}
+
 TypeId
 TableBasedErrorRateModel::GetTypeId()
 {
@@ -186,51 +270,24 @@ TableBasedErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
 
     auto errorTable = (ldpc ? AwgnErrorTableLdpc1458
                             : (size < m_threshold ? AwgnErrorTableBcc32 : AwgnErrorTableBcc1458));
+    // the PER of each rounded SNR value within the range of the table is pre-computed
     const auto& itVector = errorTable[mcs];
-    auto itTable = std::find_if(itVector.cbegin(),
-                                itVector.cend(),
-                                [&roundedSnr](const std::pair<double, double>& element) {
-                                    return element.first == roundedSnr;
-                                });
     double minSnr = itVector.cbegin()->first;
     double maxSnr = (--itVector.cend())->first;
     double per;
-    if (itTable == itVector.cend())
+    if (roundedSnr < minSnr)
     {
-        if (roundedSnr < minSnr)
-        {
-            per = 1.0;
-        }
-        else if (roundedSnr > maxSnr)
-        {
-            per = 0.0;
-        }
-        else
-        {
-            double a = 0.0;
-            double b = 0.0;
-            double previousSnr = 0.0;
-            double nextSnr = 0.0;
-            for (auto i = itVector.cbegin(); i != itVector.cend(); ++i)
-            {
-                if (i->first < roundedSnr)
-                {
-                    previousSnr = i->first;
-                    a = i->second;
-                }
-                else
-                {
-                    nextSnr = i->first;
-                    b = i->second;
-                    break;
-                }
-            }
-            per = a + (roundedSnr - previousSnr) * (b - a) / (nextSnr - previousSnr);
-        }
+        per = 1.0;
+    }
+    else if (roundedSnr > maxSnr)
+    {
+        per = 0.0;
     }
     else
     {
-        per = itTable->second;
+        const auto& dense = GetDensePerTable(itVector);
+        double multiplier = std::round(std::pow(10.0, SNR_PRECISION));
+        per = dense.per[std::llround(roundedSnr * multiplier) - dense.first];
     }
 
     uint16_t tableSize = (ldpc ? ERROR_TABLE_LDPC_FRAME_SIZE
@@ -27,27 +27,83 @@
 namespace ns3
 {
 
+WifiMacQueueContainer::WifiMacQueueContainer()
+    : m_expiredQueue(m_allocator)
+{
+}
+
 void
 WifiMacQueueContainer::clear()
 {
     m_queues.clear();
     m_expiredQueue.clear();
     m_nBytesPerQueue.clear();
+    m_expiryTimes.clear();
+    m_expiryQueue.clear();
+}
+
+WifiMacQueueContainer::ContainerQueue&
+WifiMacQueueContainer::DoGetQueue(const WifiContainerQueueId& queueId) const
+{
+    // all the container queues draw their nodes from the pool of the container
+    return m_queues.try_emplace(queueId, m_allocator).first->second;
+}
+
+void
+WifiMacQueueContainer::SetExpiryTime(const WifiContainerQueueId& queueId,
+                                     std::optional<Time> expiryTime) const
+{
+    auto it = m_expiryTimes.find(queueId);
+    if (it != m_expiryTimes.end())
+    {
+        if (expiryTime == it->second)
+        {
+            return;
+        }
+        m_expiryQueue.erase({it->second, queueId});
+        if (!expiryTime)
+        {
+            m_expiryTimes.erase(it);
+            return;
+        }
+        it->second = *expiryTime;
+    }
+    else if (!expiryTime)
+    {
+        return;
+    }
+    else
+    {
+        m_expiryTimes.emplace(queueId, *expiryTime);
+    }
+    m_expiryQueue.emplace(*expiryTime, queueId);
 }
 
 WifiMacQueueContainer::iterator
 WifiMacQueueContainer::insert(const_iterator pos, Ptr<WifiMpdu> item)
 {
     WifiContainerQueueId queueId = GetQueueId(item);
+    auto& queue = DoGetQueue(queueId);
 
-    NS_ABORT_MSG_UNLESS(pos == m_queues[queueId].cend() || GetQueueId(pos->mpdu) == queueId,
+    NS_ABORT_MSG_UNLESS(pos == queue.cend() || GetQueueId(pos->mpdu) == queueId,
                         "pos iterator does not point to the correct container queue");
     NS_ABORT_MSG_IF(!item->IsOriginal(), "Only the original copy of an MPDU can be inserted");
 
     auto [it, ret] = m_nBytesPerQueue.insert({queueId, 0});
     it->second += item->GetSize();
 
-    return m_queues[queueId].emplace(pos, item);
+    if (pos == queue.cbegin())
+    {
+        // the expiry time of the new head is not set yet: use the current time, which
+        // is not later than the expiry time unless the lifetime already expired
+        auto expiryIt = m_expiryTimes.find(queueId);
+        if (expiryIt == m_expiryTimes.end() || expiryIt->second > Simulator::Now())
+        {
+            SetExpiryTime(queueId, Simulator::Now());
+        }
+    }
+
+    return queue.emplace(pos, item);
 }
 
 WifiMacQueueContainer::iterator
@@ -64,7 +120,15 @@ WifiMacQueueContainer::erase(const_iterator pos)
     NS_ASSERT(it->second >= pos->mpdu->GetSize());
     it->second -= pos->mpdu->GetSize();
 
-    return m_queues[queueId].erase(pos);
+    auto& queue = DoGetQueue(queueId);
+    auto next = queue.erase(pos);
+    if (next == queue.begin())
+    {
+        // the head of the queue has been removed
+        SetExpiryTime(queueId,
+                      queue.empty() ? std::nullopt : std::optional<Time>(next->expiryTime));
+    }
+    return next;
 }
 
 Ptr<WifiMpdu>
@@ -97,7 +161,7 @@ WifiMacQueueContainer::GetQueueId(Ptr<const WifiMpdu> mpdu)
 const WifiMacQueueContainer::ContainerQueue&
 WifiMacQueueContainer::GetQueue(const WifiContainerQueueId& queueId) const
 {
-    return m_queues[queueId];
+    return DoGetQueue(queueId);
 }
 
 uint32_t
@@ -113,11 +177,12 @@ WifiMacQueueContainer::GetNBytes(const WifiContainerQueueId& queueId) const
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
 WifiMacQueueContainer::ExtractExpiredMpdus(const WifiContainerQueueId& queueId) const
 {
-    return DoExtractExpiredMpdus(m_queues[queueId]);
+    return DoExtractExpiredMpdus(queueId, DoGetQueue(queueId));
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
-WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
+WifiMacQueueContainer::DoExtractExpiredMpdus(const WifiContainerQueueId& queueId,
+                                             ContainerQueue& queue) const
 {
     iterator firstExpiredIt = queue.begin();
     iterator lastExpiredIt = firstExpiredIt;
@@ -131,7 +196,6 @@ WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
         lastExpiredIt->inflights.clear();
         lastExpiredIt->deleter(lastExpiredIt->mpdu);
 
-        WifiContainerQueueId queueId = GetQueueId(lastExpiredIt->mpdu);
         auto it = m_nBytesPerQueue.find(queueId);
         NS_ASSERT(it != m_nBytesPerQueue.end());
         NS_ASSERT(it->second >= lastExpiredIt->mpdu->GetSize());
@@ -140,6 +204,10 @@ WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
         ++lastExpiredIt;
     }
 
+    SetExpiryTime(queueId,
+                  lastExpiredIt == queue.end() ? std::nullopt
+                                               : std::optional<Time>(lastExpiredIt->expiryTime));
+
     if (lastExpiredIt != firstExpiredIt)
     {
         // transfer MPDUs with expired lifetime to the tail of m_expiredQueue
@@ -154,10 +222,14 @@ std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
 WifiMacQueueContainer::ExtractAllExpiredMpdus() const
 {
     iterator firstExpiredIt = m_expiredQueue.end();
+    Time now = Simulator::Now();
 
-    for (auto& queue : m_queues)
+    // only visit the container queues whose head may have expired. Visiting a container
+    // queue sets the expiry time of its head to a time in the future (or removes it)
+    while (!m_expiryQueue.empty() && m_expiryQueue.cbegin()->first <= now)
     {
-        auto [firstIt, lastIt] = DoExtractExpiredMpdus(queue.second);
+        WifiContainerQueueId queueId = m_expiryQueue.cbegin()->second;
+        auto [firstIt, lastIt] = DoExtractExpiredMpdus(queueId, DoGetQueue(queueId));
 
         if (firstIt != lastIt && firstExpiredIt == m_expiredQueue.end())
         {
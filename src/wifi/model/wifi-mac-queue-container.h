@@ -25,6 +25,8 @@
 #include "ns3/mac48-address.h"
 
 #include <list>
+#include <optional>
+#include <set>
 #include <tuple>
 #include <unordered_map>
 
@@ -92,17 +94,27 @@ namespace ns3
  *
  * This container holds multiple container queues organized in an hash table
  * whose keys are WifiContainerQueueId tuples identifying the container queues.
+ * The nodes of all the container queues are drawn from a pool of memory blocks
+ * owned by the container.
+ *
+ * In order to find the MPDUs whose lifetime expired without visiting all the
+ * container queues, the container keeps the non-empty container queues sorted
+ * by a lower bound of the expiry time of the MPDU at their head (the expiry
+ * time of an MPDU is only set after it has been inserted, hence the container
+ * uses the insertion time until the container queue is next inspected).
  */
 class WifiMacQueueContainer
 {
   public:
     /// Type of a queue held by the container
-    using ContainerQueue = std::list<WifiMacQueueElem>;
+    using ContainerQueue = WifiMacQueueElemList;
     /// iterator over elements in a container queue
     using iterator = ContainerQueue::iterator;
     /// const iterator over elements in a container queue
     using const_iterator = ContainerQueue::const_iterator;
 
+    WifiMacQueueContainer();
+
     /**
      * Erase all elements from the container.
      */
@@ -188,21 +200,48 @@ class WifiMacQueueContainer
     std::pair<iterator, iterator> GetAllExpiredMpdus() const;
 
   private:
+    /**
+     * Get a reference to the container queue identified by the given QueueId.
+     * The container queue is created if it does not exist.
+     *
+     * \param queueId the given QueueId
+     * \return a reference to the container queue identified by the given QueueId
+     */
+    ContainerQueue& DoGetQueue(const WifiContainerQueueId& queueId) const;
+
     /**
      * Transfer MPDUs with expired lifetime in the given container queue to the
      * container queue storing MPDUs with expired lifetime.
      *
+     * \param queueId the QueueId identifying the given container queue
      * \param queue the given container queue
      * \return the range [first, last) of iterators pointing to the MPDUs transferred
      *         to the container queue storing MPDUs with expired lifetime
      */
-    std::pair<iterator, iterator> DoExtractExpiredMpdus(ContainerQueue& queue) const;
+    std::pair<iterator, iterator> DoExtractExpiredMpdus(const WifiContainerQueueId& queueId,
+                                                        ContainerQueue& queue) const;
+
+    /**
+     * Set the time after which the MPDU at the head of the given container queue
+     * may have expired.
+     *
+     * \param queueId the QueueId identifying the container queue
+     * \param expiryTime the expiry time, if the container queue is not empty
+     */
+    void SetExpiryTime(const WifiContainerQueueId& queueId,
+                       std::optional<Time> expiryTime) const;
 
+    WifiMacQueueElemAllocator<WifiMacQueueElem>
+        m_allocator; //!< the allocator of the nodes of the container queues
     mutable std::unordered_map<WifiContainerQueueId, ContainerQueue>
         m_queues;                          //!< the container queues
     mutable ContainerQueue m_expiredQueue; //!< queue storing MPDUs with expired lifetime
     mutable std::unordered_map<WifiContainerQueueId, uint32_t>
         m_nBytesPerQueue; //!< size in bytes of the container queues
+    mutable std::unordered_map<WifiContainerQueueId, Time>
+        m_expiryTimes; //!< the expiry time of the head of the non-empty container queues
+    mutable std::set<std::pair<Time, WifiContainerQueueId>>
+        m_expiryQueue; //!< the non-empty container queues sorted by the expiry time of their head
 };
 
 } // namespace ns3
@@ -21,6 +21,11 @@
 
 #include "wifi-mpdu.h"
 
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <cstddef>
+
 namespace ns3
 {
 
@@ -38,4 +43,49 @@ WifiMacQueueElem::~WifiMacQueueElem()
     inflights.clear();
 }
 
+WifiMacQueueElemPool::~WifiMacQueueElemPool()
+{
+    NS_ASSERT_MSG(m_freeBlocks.size() == m_nBlocks, "Some blocks are still in use");
+}
+
+void*
+WifiMacQueueElemPool::Allocate(std::size_t size)
+{
+    if (m_blockSize == 0)
+    {
+        // round up the size of the blocks to preserve the alignment of the slabs
+        constexpr std::size_t align = alignof(std::max_align_t);
+        m_blockSize = (size + align - 1) / align * align;
+    }
+    if (size > m_blockSize)
+    {
+        return ::operator new(size);
+    }
+    if (m_freeBlocks.empty())
+    {
+        // grow the pool geometrically, up to a fixed number of blocks per slab
+        std::size_t nBlocks = std::clamp<std::size_t>(m_nBlocks, 16, 1024);
+        m_slabs.emplace_back(new char[nBlocks * m_blockSize]);
+        for (std::size_t i = nBlocks; i > 0; --i)
+        {
+            m_freeBlocks.push_back(m_slabs.back().get() + (i - 1) * m_blockSize);
+        }
+        m_nBlocks += nBlocks;
+    }
+    void* block = m_freeBlocks.back();
+    m_freeBlocks.pop_back();
+    return block;
+}
+
+void
+WifiMacQueueElemPool::Deallocate(void* block, std::size_t size)
+{
+    if (size > m_blockSize)
+    {
+        ::operator delete(block);
+        return;
+    }
+    m_freeBlocks.push_back(block);
+}
+
 } // namespace ns3
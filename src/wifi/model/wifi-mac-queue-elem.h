@@ -25,7 +25,10 @@
 #include "ns3/callback.h"
 #include "ns3/nstime.h"
 
+#include <list>
 #include <map>
+#include <memory>
+#include <vector>
 
 namespace ns3
 {
@@ -66,6 +69,142 @@ struct WifiMacQueueElem
     ~WifiMacQueueElem();
 };
 
+/**
+ * \ingroup wifi
+ * Pool of memory blocks of the same size.
+ *
+ * The first allocation determines the size of the blocks. Blocks are carved out
+ * of slabs of increasing size and are recycled when released; the memory is
+ * only returned to the system when the pool is destroyed. Requests for a
+ * larger size are forwarded to the global operator new.
+ */
+class WifiMacQueueElemPool
+{
+  public:
+    WifiMacQueueElemPool() = default;
+    ~WifiMacQueueElemPool();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    WifiMacQueueElemPool(const WifiMacQueueElemPool&) = delete;
+    WifiMacQueueElemPool& operator=(const WifiMacQueueElemPool&) = delete;
+
+    /**
+     * \param size the size of the memory block
+     * \return a pointer to the allocated memory block
+     */
+    void* Allocate(std::size_t size);
+
+    /**
+     * \param block a pointer to a memory block returned by Allocate()
+     * \param size the size of the memory block
+     */
+    void Deallocate(void* block, std::size_t size);
+
+  private:
+    std::size_t m_blockSize{0};                   ///< the size of the blocks of the pool
+    std::size_t m_nBlocks{0};                     ///< the total number of blocks
+    std::vector<void*> m_freeBlocks;              ///< the blocks that are not in use
+    std::vector<std::unique_ptr<char[]>> m_slabs; ///< the slabs the blocks are carved out of
+};
+
+/**
+ * \ingroup wifi
+ * Allocator drawing the nodes of the lists of WifiMacQueueElem objects from a
+ * WifiMacQueueElemPool.
+ *
+ * Copies of an allocator share its pool, which is released when the last copy
+ * is destroyed. Allocators sharing the same pool compare equal, hence elements
+ * can be spliced between lists using them.
+ *
+ * \tparam T the type of the allocated objects
+ */
+template <class T>
+class WifiMacQueueElemAllocator
+{
+  public:
+    /// Type of the allocated objects
+    using value_type = T;
+
+    /**
+     * Create an allocator with a new pool.
+     */
+    WifiMacQueueElemAllocator()
+        : m_pool(std::make_shared<WifiMacQueueElemPool>())
+    {
+    }
+
+    /**
+     * Create an allocator sharing the pool of the given allocator.
+     *
+     * \tparam U the type of the objects allocated by the given allocator
+     * \param other the given allocator
+     */
+    template <class U>
+    WifiMacQueueElemAllocator(const WifiMacQueueElemAllocator<U>& other) noexcept
+        : m_pool(other.m_pool)
+    {
+    }
+
+    /**
+     * \param n the number of objects
+     * \return a pointer to the storage for the given number of objects
+     */
+    T* allocate(std::size_t n)
+    {
+        if (n == 1)
+        {
+            return static_cast<T*>(m_pool->Allocate(sizeof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    /**
+     * \param p a pointer to the storage returned by allocate()
+     * \param n the number of objects
+     */
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        if (n == 1)
+        {
+            m_pool->Deallocate(p, sizeof(T));
+            return;
+        }
+        ::operator delete(p);
+    }
+
+    /**
+     * \tparam U the type of the objects allocated by the given allocator
+     * \param other the given allocator
+     * \return true if the given allocator shares the pool of this allocator
+     */
+    template <class U>
+    bool operator==(const WifiMacQueueElemAllocator<U>& other) const noexcept
+    {
+        return m_pool == other.m_pool;
+    }
+
+    /**
+     * \tparam U the type of the objects allocated by the given allocator
+     * \param other the given allocator
+     * \return true if the given allocator does not share the pool of this allocator
+     */
+    template <class U>
+    bool operator!=(const WifiMacQueueElemAllocator<U>& other) const noexcept
+    {
+        return m_pool != other.m_pool;
+    }
+
+  private:
+    template <class U>
+    friend class WifiMacQueueElemAllocator;
+
+    std::shared_ptr<WifiMacQueueElemPool> m_pool; ///< the pool of memory blocks
+};
+
+/// List of WifiMacQueueElem objects whose nodes are drawn from a pool
+using WifiMacQueueElemList =
+    std::list<WifiMacQueueElem, WifiMacQueueElemAllocator<WifiMacQueueElem>>;
+
 } // namespace ns3
 
 #endif /* WIFI_MAC_QUEUE_ELEM_H */
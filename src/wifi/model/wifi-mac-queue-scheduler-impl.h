@@ -32,6 +32,7 @@
 #include <vector>
 
 class WifiMacQueueDropOldestTest;
+class WifiMacQueueExpiryTest;
 
 namespace ns3
 {
@@ -52,6 +53,8 @@ class WifiMacQueueSchedulerImpl : public WifiMacQueueScheduler
   public:
     /// allow WifiMacQueueDropOldestTest class access
     friend class ::WifiMacQueueDropOldestTest;
+    /// allow WifiMacQueueExpiryTest class access
+    friend class ::WifiMacQueueExpiryTest;
 
     /**
      * \brief Get the type ID.
@@ -130,11 +133,12 @@ class WifiMacQueueSchedulerImpl : public WifiMacQueueScheduler
     struct QueueInfo
     {
         std::optional<typename SortedQueues::iterator>
-            priorityIt;             /**< iterator pointing to the entry
-                                         for this queue in the sorted list */
-        std::list<uint8_t> linkIds; /**< IDs of the links over which packets contained in this
-                                         queue can be sent over. Empty means that packets in this
-                                         queue can be sent over any link */
+            priorityIt;      /**< iterator pointing to the entry
+                                  for this queue in the sorted list */
+        uint16_t linkIds{0}; /**< bitmap of the IDs of the links over which packets contained
+                                  in this queue can be sent over (bit i is set if link i can be
+                                  used). Zero means that packets in this queue can be sent over
+                                  any link */
     };
 
     /**
@@ -313,7 +317,8 @@ WifiMacQueueSchedulerImpl<Priority, Compare>::InitQueueInfo(AcIndex ac,
             NS_ASSERT(GetMac());
             auto linkId = GetMac()->GetLinkIdByAddress(std::get<Mac48Address>(queueId));
             NS_ASSERT(linkId.has_value());
-            queueInfoIt->second.linkIds = {*linkId};
+            NS_ASSERT(*linkId < 16);
+            queueInfoIt->second.linkIds = 1 << *linkId;
         }
     }
     return queueInfoIt;
@@ -365,7 +370,7 @@ WifiMacQueueSchedulerImpl<Priority, Compare>::GetLinkIds(AcIndex ac,
 {
     auto queueInfoIt = InitQueueInfo(ac, queueId);
 
-    if (queueInfoIt->second.linkIds.empty())
+    if (queueInfoIt->second.linkIds == 0)
     {
         // return the IDs of all available links
         NS_ASSERT(GetMac() != nullptr);
@@ -373,7 +378,15 @@ WifiMacQueueSchedulerImpl<Priority, Compare>::GetLinkIds(AcIndex ac,
         std::iota(linkIds.begin(), linkIds.end(), 0);
         return linkIds;
     }
-    return queueInfoIt->second.linkIds;
+    std::list<uint8_t> linkIds;
+    for (uint8_t linkId = 0; linkId < 16; linkId++)
+    {
+        if (queueInfoIt->second.linkIds & (1 << linkId))
+        {
+            linkIds.push_back(linkId);
+        }
+    }
+    return linkIds;
 }
 
 template <class Priority, class Compare>
@@ -384,7 +397,12 @@ WifiMacQueueSchedulerImpl<Priority, Compare>::SetLinkIds(AcIndex ac,
 {
     NS_LOG_FUNCTION(this << +ac);
     auto [queueInfoIt, ret] = m_perAcInfo[ac].queueInfoMap.insert({queueId, QueueInfo()});
-    queueInfoIt->second.linkIds = linkIds;
+    queueInfoIt->second.linkIds = 0;
+    for (const auto linkId : linkIds)
+    {
+        NS_ASSERT_MSG(linkId < 16, "Invalid link ID " << +linkId);
+        queueInfoIt->second.linkIds |= (1 << linkId);
+    }
 }
 
 template <class Priority, class Compare>
@@ -426,9 +444,9 @@ WifiMacQueueSchedulerImpl<Priority, Compare>::DoGetNext(
     while (sortedQueuesIt != m_perAcInfo[ac].sortedQueues.end())
     {
         const auto& queueInfoPair = sortedQueuesIt->second.get();
-        const auto& linkIds = queueInfoPair.second.linkIds;
+        const auto linkIds = queueInfoPair.second.linkIds;
 
-        if (linkIds.empty() || std::find(linkIds.begin(), linkIds.end(), linkId) != linkIds.end())
+        if (linkIds == 0 || (linkIds & (1 << linkId)) != 0)
         {
             // Packets in this queue can be sent over the link we got channel access on.
             // Now remove packets with expired lifetime from this queue.
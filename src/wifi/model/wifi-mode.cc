@@ -90,12 +90,21 @@ WifiMode::GetPhyRate(uint16_t channelWidth) const
 uint64_t
 WifiMode::GetPhyRate(uint16_t channelWidth, uint16_t guardInterval, uint8_t nss) const
 {
+    WifiModeFactory::WifiModeItem* item = WifiModeFactory::GetFactory()->Get(m_uid);
+    uint64_t key = channelWidth | (static_cast<uint64_t>(guardInterval) << 16) |
+                   (static_cast<uint64_t>(nss) << 32);
+    if (auto it = item->phyRates.find(key); it != item->phyRates.end())
+    {
+        return it->second;
+    }
     WifiTxVector txVector;
     txVector.SetMode(WifiMode(m_uid));
     txVector.SetChannelWidth(channelWidth);
     txVector.SetGuardInterval(guardInterval);
     txVector.SetNss(nss);
-    return GetPhyRate(txVector);
+    uint64_t rate = item->GetPhyRateCallback(txVector, SU_STA_ID);
+    item->phyRates.emplace(key, rate);
+    return rate;
 }
 
 uint64_t
@@ -122,12 +131,21 @@ uint64_t
 WifiMode::GetDataRate(uint16_t channelWidth, uint16_t guardInterval, uint8_t nss) const
 {
     NS_ASSERT(nss <= 8);
+    WifiModeFactory::WifiModeItem* item = WifiModeFactory::GetFactory()->Get(m_uid);
+    uint64_t key = channelWidth | (static_cast<uint64_t>(guardInterval) << 16) |
+                   (static_cast<uint64_t>(nss) << 32);
+    if (auto it = item->dataRates.find(key); it != item->dataRates.end())
+    {
+        return it->second;
+    }
     WifiTxVector txVector;
     txVector.SetMode(WifiMode(m_uid));
     txVector.SetChannelWidth(channelWidth);
     txVector.SetGuardInterval(guardInterval);
     txVector.SetNss(nss);
-    return GetDataRate(txVector);
+    uint64_t rate = item->GetDataRateCallback(txVector, SU_STA_ID);
+    item->dataRates.emplace(key, rate);
+    return rate;
 }
 
 WifiCodeRate
@@ -304,6 +322,8 @@ WifiModeFactory::CreateWifiMode(std::string uniqueName,
     item->GetConstellationSizeCallback = constellationSizeCallback;
     item->GetPhyRateCallback = phyRateCallback;
     item->GetDataRateCallback = dataRateCallback;
+    item->phyRates.clear();
+    item->dataRates.clear();
     item->GetNonHtReferenceRateCallback = MakeNullCallback<uint64_t>();
     item->IsAllowedCallback = isAllowedCallback;
 
@@ -340,6 +360,8 @@ WifiModeFactory::CreateWifiMcs(std::string uniqueName,
     item->GetConstellationSizeCallback = constellationSizeCallback;
     item->GetPhyRateCallback = phyRateCallback;
     item->GetDataRateCallback = dataRateCallback;
+    item->phyRates.clear();
+    item->dataRates.clear();
     item->GetNonHtReferenceRateCallback = nonHtReferenceRateCallback;
     item->IsAllowedCallback = isAllowedCallback;
 
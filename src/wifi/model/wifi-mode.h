@@ -26,6 +26,7 @@
 #include "ns3/attribute-helper.h"
 #include "ns3/callback.h"
 
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -424,6 +425,10 @@ class WifiModeFactory
                                            ///< WifiModeItem
         AllowedCallback
             IsAllowedCallback; ///< Callback to check whether a given combination of is allowed
+        std::unordered_map<uint64_t, uint64_t>
+            phyRates; ///< PHY rates (bps) already computed, by channel width, GI and NSS
+        std::unordered_map<uint64_t, uint64_t>
+            dataRates; ///< data rates (bps) already computed, by channel width, GI and NSS
     };
 
     /**
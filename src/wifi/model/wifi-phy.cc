@@ -43,9 +43,11 @@
 #include "ns3/simulator.h"
 #include "ns3/string.h"
 #include "ns3/tuple.h"
+#include "ns3/uinteger.h"
 #include "ns3/vht-configuration.h"
 
 #include <algorithm>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -432,6 +434,71 @@ WifiPhy::GetStaticPhyEntities()
     return g_staticPhyEntities;
 }
 
+/**
+ * The durations computed by CalculateTxDuration for SU PPDUs, indexed by the
+ * parameters of the TXVECTOR, the PSDU size, the band and the STA-ID packed
+ * into two 64-bit words.
+ */
+struct WifiPhy::TxDurationCache
+{
+    /// the cache key
+    using Key = std::pair<uint64_t, uint64_t>;
+
+    /// Hash function of the cache key
+    struct KeyHash
+    {
+        /**
+         * \param key the cache key
+         * \return the hash of the key
+         */
+        std::size_t operator()(const Key& key) const
+        {
+            return std::hash<uint64_t>()(key.first ^ (key.second * 0x9e3779b97f4a7c15));
+        }
+    };
+
+    std::unordered_map<Key, Time, KeyHash> durations; //!< the memoized durations
+    std::size_t maxSize{4096};                        //!< maximum number of stored durations
+    TxDurationCacheStats stats;                       //!< hit statistics
+};
+
+WifiPhy::TxDurationCache&
+WifiPhy::GetTxDurationCache()
+{
+    static TxDurationCache g_txDurationCache;
+    return g_txDurationCache;
+}
+
+WifiPhy::TxDurationCacheStats
+WifiPhy::GetTxDurationCacheStats()
+{
+    return GetTxDurationCache().stats;
+}
+
+void
+WifiPhy::ResetTxDurationCacheStats()
+{
+    GetTxDurationCache().stats = TxDurationCacheStats();
+}
+
+void
+WifiPhy::SetTxDurationCacheSize(uint32_t size)
+{
+    NS_LOG_FUNCTION(size);
+    auto& cache = GetTxDurationCache();
+    cache.maxSize = size;
+    if (cache.durations.size() > size)
+    {
+        cache.durations.clear();
+    }
+}
+
+uint32_t
+WifiPhy::GetTxDurationCacheSize()
+{
+    return GetTxDurationCache().maxSize;
+}
+
 Ptr<WifiPhyStateHelper>
 WifiPhy::GetState() const
 {
@@ -654,6 +721,12 @@ WifiPhy::SetPreambleDetectionModel(const Ptr<PreambleDetectionModel> model)
     m_preambleDetectionModel = model;
 }
 
+Ptr<PreambleDetectionModel>
+WifiPhy::GetPreambleDetectionModel() const
+{
+    return m_preambleDetectionModel;
+}
+
 void
 WifiPhy::SetWifiRadioEnergyModel(const Ptr<WifiRadioEnergyModel> wifiRadioEnergyModel)
 {
@@ -1454,9 +1527,52 @@ WifiPhy::CalculateTxDuration(uint32_t size,
                              WifiPhyBand band,
                              uint16_t staId)
 {
+    auto& cache = GetTxDurationCache();
+    // the duration of MU PPDUs also depends on the per-user information and on the
+    // RU allocation, hence only the duration of SU PPDUs is memoized. This includes
+    // the DL MU PPDUs sent to a single user over the whole channel (e.g., 11be SU
+    // transmissions), whose duration only depends on the mode and NSS of that user
+    bool isSu = !txVector.IsMu();
+    if (txVector.IsDlMu())
+    {
+        const auto& userInfos = txVector.GetHeMuUserInfoMap();
+        isSu = userInfos.size() == 1 && userInfos.count(staId) == 1 &&
+               userInfos.at(staId).ru.GetRuType() == HeRu::GetRuType(txVector.GetChannelWidth());
+    }
+    if (cache.maxSize == 0 || !isSu)
+    {
+        Time duration = CalculatePhyPreambleAndHeaderDuration(txVector) +
+                        GetPayloadDuration(size, txVector, band, NORMAL_MPDU, staId);
+        NS_ASSERT(duration.IsStrictlyPositive());
+        return duration;
+    }
+
+    const TxDurationCache::Key key{
+        txVector.GetMode(staId).GetUid() |
+            (static_cast<uint64_t>(txVector.GetPreambleType()) << 16) |
+            (static_cast<uint64_t>(txVector.GetChannelWidth()) << 24) |
+            (static_cast<uint64_t>(txVector.GetGuardInterval()) << 40) |
+            (static_cast<uint64_t>(txVector.GetNss(staId) & 0x0f) << 56) |
+            (static_cast<uint64_t>(txVector.GetNess() & 0x0f) << 60),
+        size | (static_cast<uint64_t>(staId) << 32) | (static_cast<uint64_t>(band) << 48) |
+            (static_cast<uint64_t>(txVector.IsAggregation()) << 56) |
+            (static_cast<uint64_t>(txVector.IsStbc()) << 57) |
+            (static_cast<uint64_t>(txVector.IsLdpc()) << 58)};
+    if (auto it = cache.durations.find(key); it != cache.durations.end())
+    {
+        cache.stats.hits++;
+        return it->second;
+    }
+
+    cache.stats.misses++;
     Time duration = CalculatePhyPreambleAndHeaderDuration(txVector) +
                     GetPayloadDuration(size, txVector, band, NORMAL_MPDU, staId);
     NS_ASSERT(duration.IsStrictlyPositive());
+    if (cache.durations.size() >= cache.maxSize)
+    {
+        cache.durations.clear();
+    }
+    cache.durations.emplace(key, duration);
     return duration;
 }
 
@@ -1537,6 +1653,12 @@ WifiPhy::NotifyRxBegin(Ptr<const WifiPsdu> psdu, const RxPowerWattPerChannelBand
     }
 }
 
+void
+WifiPhy::NotifyRxPayloadBegin(const WifiTxVector& txVector, Time psduDuration)
+{
+    m_phyRxPayloadBeginTrace(txVector, psduDuration);
+}
+
 void
 WifiPhy::NotifyRxEnd(Ptr<const WifiPsdu> psdu)
 {
@@ -107,9 +107,9 @@ class WifiPhy : public Object
      * \param rxPowersW the receive power in W per band
      * \param rxDuration the duration of the PPDU
      */
-    void StartReceivePreamble(Ptr<const WifiPpdu> ppdu,
-                              RxPowerWattPerChannelBand& rxPowersW,
-                              Time rxDuration);
+    virtual void StartReceivePreamble(Ptr<const WifiPpdu> ppdu,
+                                      RxPowerWattPerChannelBand& rxPowersW,
+                                      Time rxDuration);
 
     /**
      * For HE receptions only, check and possibly modify the transmit power restriction state at
@@ -321,6 +321,38 @@ class WifiPhy : public Object
      */
     static Time GetStartOfPacketDuration(const WifiTxVector& txVector);
 
+    /// Statistics of the cache of the durations computed by CalculateTxDuration
+    struct TxDurationCacheStats
+    {
+        uint64_t hits{0};   //!< number of durations found in the cache
+        uint64_t misses{0}; //!< number of durations computed (and stored in the cache)
+    };
+
+    /**
+     * \return the statistics of the cache of the durations computed by CalculateTxDuration
+     */
+    static TxDurationCacheStats GetTxDurationCacheStats();
+
+    /**
+     * Reset the statistics of the cache of the durations computed by CalculateTxDuration.
+     */
+    static void ResetTxDurationCacheStats();
+
+    /**
+     * Set the maximum number of durations stored by the cache of the durations computed
+     * by CalculateTxDuration (4096 by default). The cache is shared by all the PHYs. It
+     * is emptied when full and disabled if the given size is zero.
+     *
+     * \param size the maximum number of durations stored by the cache
+     */
+    static void SetTxDurationCacheSize(uint32_t size);
+
+    /**
+     * \return the maximum number of durations stored by the cache of the durations
+     *         computed by CalculateTxDuration
+     */
+    static uint32_t GetTxDurationCacheSize();
+
     /**
      * The WifiPhy::GetModeList() method is used
      * (e.g., by a WifiRemoteStationManager) to determine the set of
@@ -564,6 +596,14 @@ class WifiPhy : public Object
      * \param rxPowersW the receive power per channel band in Watts
      */
     void NotifyRxBegin(Ptr<const WifiPsdu> psdu, const RxPowerWattPerChannelBand& rxPowersW);
+    /**
+     * Public method used to fire a PhyRxPayloadBegin trace.
+     * Implemented for encapsulation purposes.
+     *
+     * \param txVector the TXVECTOR used to transmit the PPDU
+     * \param psduDuration the remaining duration of the PSDU
+     */
+    void NotifyRxPayloadBegin(const WifiTxVector& txVector, Time psduDuration);
     /**
      * Public method used to fire a PhyRxEnd trace.
      * Implemented for encapsulation purposes.
@@ -983,6 +1023,10 @@ class WifiPhy : public Object
      * \param preambleDetectionModel the preamble detection model
      */
     void SetPreambleDetectionModel(const Ptr<PreambleDetectionModel> preambleDetectionModel);
+    /**
+     * \return the preamble detection model, if any
+     */
+    Ptr<PreambleDetectionModel> GetPreambleDetectionModel() const;
     /**
      * Sets the wifi radio energy model.
      *
@@ -1413,6 +1457,14 @@ class WifiPhy : public Object
      */
     static std::map<WifiModulationClass, Ptr<PhyEntity>>& GetStaticPhyEntities();
 
+    struct TxDurationCache;
+
+    /**
+     * \return the cache of the durations computed by CalculateTxDuration, which is
+     *         shared by all the PHYs
+     */
+    static TxDurationCache& GetTxDurationCache();
+
     WifiStandard m_standard;        //!< WifiStandard
     WifiPhyBand m_band;             //!< WifiPhyBand
     ChannelTuple m_channelSettings; //!< Store operating channel settings until initialization
@@ -135,7 +135,10 @@ WifiRemoteStationManager::GetTypeId()
 }
 
 WifiRemoteStationManager::WifiRemoteStationManager()
-    : m_useNonErpProtection(false),
+    : m_lastStation(Mac48Address(), nullptr),
+      m_dataTxVectorGeneration(0),
+      m_localConfiguration(0, 0, 0, false, 0),
+      m_useNonErpProtection(false),
       m_useNonHtProtection(false),
       m_shortPreambleEnabled(false),
       m_shortSlotTimeEnabled(false)
@@ -171,6 +174,7 @@ WifiRemoteStationManager::SetupPhy(const Ptr<WifiPhy> phy)
     {
         m_defaultTxMcs = HtPhy::GetHtMcs(0);
     }
+    // Reset() also discards the TXVECTORs cached for the previous PHY
     Reset();
 }
 
@@ -224,6 +228,7 @@ WifiRemoteStationManager::SetShortPreambleEnabled(bool enable)
 {
     NS_LOG_FUNCTION(this << enable);
     m_shortPreambleEnabled = enable;
+    InvalidateDataTxVectors();
 }
 
 void
@@ -326,6 +331,7 @@ WifiRemoteStationManager::AddSupportedPhyPreamble(Mac48Address address,
     NS_LOG_FUNCTION(this << address << isShortPreambleSupported);
     NS_ASSERT(!address.IsGroup());
     LookupState(address)->m_shortPreamble = isShortPreambleSupported;
+    InvalidateDataTxVectors();
 }
 
 void
@@ -364,6 +370,7 @@ WifiRemoteStationManager::AddSupportedMode(Mac48Address address, WifiMode mode)
         state->m_ofdmSupported = true;
     }
     state->m_operationalRateSet.push_back(mode);
+    InvalidateDataTxVectors();
 }
 
 void
@@ -381,6 +388,7 @@ WifiRemoteStationManager::AddAllSupportedModes(Mac48Address address)
             AddBasicMode(mode);
         }
     }
+    InvalidateDataTxVectors();
 }
 
 void
@@ -394,6 +402,7 @@ WifiRemoteStationManager::AddAllSupportedMcs(Mac48Address address)
     {
         state->m_operationalMcsSet.push_back(mcs);
     }
+    InvalidateDataTxVectors();
 }
 
 void
@@ -402,6 +411,7 @@ WifiRemoteStationManager::RemoveAllSupportedMcs(Mac48Address address)
     NS_LOG_FUNCTION(this << address);
     NS_ASSERT(!address.IsGroup());
     LookupState(address)->m_operationalMcsSet.clear();
+    InvalidateDataTxVectors();
 }
 
 void
@@ -418,6 +428,7 @@ WifiRemoteStationManager::AddSupportedMcs(Mac48Address address, WifiMode mcs)
         }
     }
     state->m_operationalMcsSet.push_back(mcs);
+    InvalidateDataTxVectors();
 }
 
 bool
@@ -638,10 +649,26 @@ WifiRemoteStationManager::GetDataTxVector(const WifiMacHeader& header, uint16_t
     }
     else
     {
-        txVector = DoGetDataTxVector(Lookup(address), allowedWidth);
-        txVector.SetLdpc(txVector.GetMode().GetModulationClass() < WIFI_MOD_CLASS_HT
-                             ? 0
-                             : UseLdpcForDestination(address));
+        WifiRemoteStation* station = Lookup(address);
+        CheckLocalConfiguration();
+        if (station->m_dataTxVector && station->m_dataTxVectorWidth == allowedWidth &&
+            station->m_dataTxVectorGeneration == m_dataTxVectorGeneration)
+        {
+            txVector = *station->m_dataTxVector;
+        }
+        else
+        {
+            txVector = DoGetDataTxVector(station, allowedWidth);
+            txVector.SetLdpc(txVector.GetMode().GetModulationClass() < WIFI_MOD_CLASS_HT
+                                 ? 0
+                                 : UseLdpcForDestination(address));
+            if (DoIsDataTxVectorCacheable())
+            {
+                station->m_dataTxVector = txVector;
+                station->m_dataTxVectorWidth = allowedWidth;
+                station->m_dataTxVectorGeneration = m_dataTxVectorGeneration;
+            }
+        }
     }
     Ptr<HeConfiguration> heConfiguration = m_wifiPhy->GetDevice()->GetHeConfiguration();
     if (heConfiguration)
@@ -919,7 +946,9 @@ WifiRemoteStationManager::ReportRtsFailed(const WifiMacHeader& header)
     AcIndex ac = QosUtilsMapTidToAc((header.IsQosData()) ? header.GetQosTid() : 0);
     m_ssrc[ac]++;
     m_macTxRtsFailed(header.GetAddr1());
-    DoReportRtsFailed(Lookup(header.GetAddr1()));
+    WifiRemoteStation* station = Lookup(header.GetAddr1());
+    DoReportRtsFailed(station);
+    station->m_dataTxVector.reset();
 }
 
 void
@@ -939,7 +968,9 @@ WifiRemoteStationManager::ReportDataFailed(Ptr<const WifiMpdu> mpdu)
         m_ssrc[ac]++;
     }
     m_macTxDataFailed(mpdu->GetHeader().GetAddr1());
-    DoReportDataFailed(Lookup(mpdu->GetHeader().GetAddr1()));
+    WifiRemoteStation* station = Lookup(mpdu->GetHeader().GetAddr1());
+    DoReportDataFailed(station);
+    station->m_dataTxVector.reset();
 }
 
 void
@@ -955,6 +986,7 @@ WifiRemoteStationManager::ReportRtsOk(const WifiMacHeader& header,
     station->m_state->m_info.NotifyTxSuccess(m_ssrc[ac]);
     m_ssrc[ac] = 0;
     DoReportRtsOk(station, ctsSnr, ctsMode, rtsSnr);
+    station->m_dataTxVector.reset();
 }
 
 void
@@ -986,6 +1018,7 @@ WifiRemoteStationManager::ReportDataOk(Ptr<const WifiMpdu> mpdu,
                    dataSnr,
                    dataTxVector.GetChannelWidth(),
                    dataTxVector.GetNss(GetStaId(hdr.GetAddr1(), dataTxVector)));
+    station->m_dataTxVector.reset();
 }
 
 void
@@ -999,6 +1032,7 @@ WifiRemoteStationManager::ReportFinalRtsFailed(const WifiMacHeader& header)
     m_ssrc[ac] = 0;
     m_macTxFinalRtsFailed(header.GetAddr1());
     DoReportFinalRtsFailed(station);
+    station->m_dataTxVector.reset();
 }
 
 void
@@ -1021,6 +1055,7 @@ WifiRemoteStationManager::ReportFinalDataFailed(Ptr<const WifiMpdu> mpdu)
     }
     m_macTxFinalDataFailed(mpdu->GetHeader().GetAddr1());
     DoReportFinalDataFailed(station);
+    station->m_dataTxVector.reset();
 }
 
 void
@@ -1036,6 +1071,7 @@ WifiRemoteStationManager::ReportRxOk(Mac48Address address,
     WifiRemoteStation* station = Lookup(address);
     DoReportRxOk(station, rxSignalInfo.snr, txVector.GetMode(GetStaId(address, txVector)));
     station->m_rssiAndUpdateTimePair = std::make_pair(rxSignalInfo.rssi, Simulator::Now());
+    station->m_dataTxVector.reset();
 }
 
 void
@@ -1053,13 +1089,15 @@ WifiRemoteStationManager::ReportAmpduTxStatus(Mac48Address address,
     {
         m_macTxDataFailed(address);
     }
-    DoReportAmpduTxStatus(Lookup(address),
+    WifiRemoteStation* station = Lookup(address);
+    DoReportAmpduTxStatus(station,
                           nSuccessfulMpdus,
                           nFailedMpdus,
                           rxSnr,
                           dataSnr,
                           dataTxVector.GetChannelWidth(),
                           dataTxVector.GetNss(GetStaId(address, dataTxVector)));
+    station->m_dataTxVector.reset();
 }
 
 bool
@@ -1390,10 +1428,18 @@ WifiRemoteStation*
 WifiRemoteStationManager::Lookup(Mac48Address address) const
 {
     NS_LOG_FUNCTION(this << address);
+    // consecutive lookups are very often for the same station (e.g., to get the
+    // TXVECTOR of a frame and then to report the outcome of its transmission)
+    if (m_lastStation.second != nullptr && m_lastStation.first == address)
+    {
+        return m_lastStation.second;
+    }
+
     auto stationIt = m_stations.find(address);
 
     if (stationIt != m_stations.end())
     {
+        m_lastStation = {address, stationIt->second};
         return stationIt->second;
     }
 
@@ -1401,6 +1447,7 @@ WifiRemoteStationManager::Lookup(Mac48Address address) const
     station->m_state = LookupState(address).get();
     station->m_rssiAndUpdateTimePair = std::make_pair(0, Seconds(0));
     const_cast<WifiRemoteStationManager*>(this)->m_stations.insert({address, station});
+    m_lastStation = {address, station};
     return station;
 }
 
@@ -1416,6 +1463,7 @@ WifiRemoteStationManager::SetQosSupport(Mac48Address from, bool qosSupported)
 {
     NS_LOG_FUNCTION(this << from << qosSupported);
     LookupState(from)->m_qosSupported = qosSupported;
+    InvalidateDataTxVectors();
 }
 
 void
@@ -1441,6 +1489,7 @@ WifiRemoteStationManager::AddStationHtCapabilities(Mac48Address from, HtCapabili
         }
     }
     state->m_htCapabilities = Create<const HtCapabilities>(htCapabilities);
+    InvalidateDataTxVectors();
 }
 
 void
@@ -1469,6 +1518,7 @@ WifiRemoteStationManager::AddStationVhtCapabilities(Mac48Address from,
         }
     }
     state->m_vhtCapabilities = Create<const VhtCapabilities>(vhtCapabilities);
+    InvalidateDataTxVectors();
 }
 
 void
@@ -1523,6 +1573,7 @@ WifiRemoteStationManager::AddStationHeCapabilities(Mac48Address from, HeCapabili
     }
     state->m_heCapabilities = Create<const HeCapabilities>(heCapabilities);
     SetQosSupport(from, true);
+    InvalidateDataTxVectors();
 }
 
 void
@@ -1535,6 +1586,7 @@ WifiRemoteStationManager::AddStationEhtCapabilities(Mac48Address from,
     // TODO: to be completed
     state->m_ehtCapabilities = Create<const EhtCapabilities>(ehtCapabilities);
     SetQosSupport(from, true);
+    InvalidateDataTxVectors();
 }
 
 Ptr<const HtCapabilities>
@@ -1630,10 +1682,12 @@ WifiRemoteStationManager::Reset()
         delete (state.second);
     }
     m_stations.clear();
+    m_lastStation = {Mac48Address(), nullptr};
     m_bssBasicRateSet.clear();
     m_bssBasicMcsSet.clear();
     m_ssrc.fill(0);
     m_slrc.fill(0);
+    InvalidateDataTxVectors();
 }
 
 void
@@ -1652,6 +1706,7 @@ WifiRemoteStationManager::AddBasicMode(WifiMode mode)
         }
     }
     m_bssBasicRateSet.push_back(mode);
+    InvalidateDataTxVectors();
 }
 
 uint8_t
@@ -1719,6 +1774,7 @@ WifiRemoteStationManager::AddBasicMcs(WifiMode mcs)
         }
     }
     m_bssBasicMcsSet.push_back(mcs);
+    InvalidateDataTxVectors();
 }
 
 uint8_t
@@ -1776,6 +1832,35 @@ WifiRemoteStationManager::DoNeedFragmentation(WifiRemoteStation* station,
     return normally;
 }
 
+bool
+WifiRemoteStationManager::DoIsDataTxVectorCacheable() const
+{
+    return false;
+}
+
+void
+WifiRemoteStationManager::InvalidateDataTxVectors()
+{
+    NS_LOG_FUNCTION(this);
+    m_dataTxVectorGeneration++;
+}
+
+void
+WifiRemoteStationManager::CheckLocalConfiguration()
+{
+    LocalConfiguration configuration{m_wifiPhy->GetNumberOfAntennas(),
+                                     m_wifiPhy->GetMaxSupportedTxSpatialStreams(),
+                                     m_wifiPhy->GetMaxSupportedRxSpatialStreams(),
+                                     GetShortGuardIntervalSupported(),
+                                     GetGuardInterval()};
+    if (configuration != m_localConfiguration)
+    {
+        NS_LOG_DEBUG("The local configuration changed");
+        m_localConfiguration = configuration;
+        InvalidateDataTxVectors();
+    }
+}
+
 void
 WifiRemoteStationManager::DoReportAmpduTxStatus(WifiRemoteStation* station,
                                                 uint16_t nSuccessfulMpdus,
@@ -2039,6 +2124,7 @@ void
 WifiRemoteStationManager::SetDefaultTxPowerLevel(uint8_t txPower)
 {
     m_defaultTxPowerLevel = txPower;
+    InvalidateDataTxVectors();
 }
 
 uint8_t
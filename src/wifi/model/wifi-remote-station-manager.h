@@ -23,6 +23,7 @@
 #include "qos-utils.h"
 #include "wifi-mode.h"
 #include "wifi-remote-station-info.h"
+#include "wifi-tx-vector.h"
 #include "wifi-utils.h"
 
 #include "ns3/data-rate.h"
@@ -37,6 +38,7 @@
 #include <array>
 #include <memory>
 #include <optional>
+#include <tuple>
 #include <unordered_map>
 
 namespace ns3
@@ -47,7 +49,6 @@ class WifiMac;
 class WifiMacHeader;
 class Packet;
 class WifiMpdu;
-class WifiTxVector;
 
 struct WifiRemoteStationState;
 struct RxSignalInfo;
@@ -70,6 +71,9 @@ struct WifiRemoteStation
     std::pair<double, Time>
         m_rssiAndUpdateTimePair; //!< RSSI (in dBm) of the most recent packet received from the
                                  //!< remote station along with update time
+    std::optional<WifiTxVector> m_dataTxVector; //!< cached TXVECTOR for data frames, if any
+    uint16_t m_dataTxVectorWidth{0};            //!< allowed width of the cached TXVECTOR (MHz)
+    uint64_t m_dataTxVectorGeneration{0};       //!< configuration generation of the cached TXVECTOR
 };
 
 /**
@@ -1191,6 +1195,14 @@ class WifiRemoteStationManager : public Object
      */
     uint8_t GetNess(const WifiRemoteStation* station) const;
 
+    /**
+     * Discard the TXVECTORs for data frames cached for all the remote stations.
+     * This method is called whenever the configuration of the local or of a
+     * remote station changes, and by rate control algorithms whose TXVECTORs
+     * can be cached (see DoIsDataTxVectorCacheable) when their configuration changes.
+     */
+    void InvalidateDataTxVectors();
+
   private:
     /**
      * If the given TXVECTOR is used for a MU transmission, return the STAID of
@@ -1243,6 +1255,18 @@ class WifiRemoteStationManager : public Object
     virtual bool DoNeedFragmentation(WifiRemoteStation* station,
                                      Ptr<const Packet> packet,
                                      bool normally);
+    /**
+     * Rate control algorithms whose TXVECTOR for data frames only changes when
+     * they are notified of the outcome of a transmission or of a reception (i.e.,
+     * through the Report* methods) or when the configuration of the local or of the
+     * remote station changes can return true, so that DoGetDataTxVector is only
+     * called again after such events. Algorithms which, e.g., sample the rates
+     * or draw random numbers for each frame must return false (the default).
+     *
+     * \return whether the TXVECTOR for data frames returned by DoGetDataTxVector
+     *         can be cached
+     */
+    virtual bool DoIsDataTxVectorCacheable() const;
     /**
      * \return a new station data structure
      */
@@ -1372,6 +1396,15 @@ class WifiRemoteStationManager : public Object
      */
     WifiRemoteStation* Lookup(Mac48Address address) const;
 
+    /**
+     * Discard the TXVECTORs for data frames cached for all the remote stations if
+     * the local configuration read by the rate control algorithms (number of
+     * antennas, maximum number of spatial streams, guard interval) changed since
+     * the last call. This configuration can be changed at runtime through the PHY
+     * and the HT/HE configurations, which do not notify the station manager.
+     */
+    void CheckLocalConfiguration();
+
     /**
      * Actually sets the fragmentation threshold, it also checks the validity of
      * the given threshold.
@@ -1425,6 +1458,14 @@ class WifiRemoteStationManager : public Object
 
     StationStates m_states; //!< States of known stations
     Stations m_stations;    //!< Information for each known stations
+    mutable std::pair<Mac48Address, WifiRemoteStation*>
+        m_lastStation; //!< the station returned by the last call to Lookup, if any
+    uint64_t m_dataTxVectorGeneration; //!< incremented when the cached TXVECTORs are discarded
+
+    /// Number of antennas, maximum number of TX and RX spatial streams, short GI
+    /// support and HE guard interval (ns) of the local station
+    using LocalConfiguration = std::tuple<uint8_t, uint8_t, uint8_t, bool, uint16_t>;
+    LocalConfiguration m_localConfiguration; //!< local configuration when last checked
 
     WifiMode m_defaultTxMode; //!< The default transmission mode
     WifiMode m_defaultTxMcs;  //!< The default transmission modulation-coding scheme (MCS)
@@ -20,12 +20,16 @@
 
 #include "yans-error-rate-model.h"
 
+#include "success-rate-table.h"
 #include "wifi-tx-vector.h"
 #include "wifi-utils.h"
 
+#include "ns3/double.h"
 #include "ns3/log.h"
 
 #include <cmath>
+#include <map>
+#include <tuple>
 
 namespace ns3
 {
@@ -40,11 +44,19 @@ YansErrorRateModel::GetTypeId()
     static TypeId tid = TypeId("ns3::YansErrorRateModel")
                             .SetParent<ErrorRateModel>()
                             .SetGroupName("Wifi")
-                            .AddConstructor<YansErrorRateModel>();
+                            .AddConstructor<YansErrorRateModel>()
+                            .AddAttribute("SuccessRateTableStep",
+                                          "The resolution (in dB) of the pre-computed tables from "
+                                          "which the chunk success rates are interpolated. "
+                                          "If zero, the success rates are computed analytically.",
+                                          DoubleValue(0),
+                                          MakeDoubleAccessor(&YansErrorRateModel::m_tableStep),
+                                          MakeDoubleChecker<double>(0));
     return tid;
 }
 
 YansErrorRateModel::YansErrorRateModel()
+    : m_tableStep(0)
 {
 }
 
@@ -153,6 +165,11 @@ YansErrorRateModel::GetFecBpskBer(double snr,
                                   uint32_t adFree) const
 {
     NS_LOG_FUNCTION(this << snr << nbits << signalSpread << phyRate << dFree << adFree);
+    if (auto successRate =
+            LookupSuccessRate(snr * signalSpread / phyRate, nbits, 2, dFree, adFree, 0))
+    {
+        return *successRate;
+    }
     double ber = GetBpskBer(snr, signalSpread, phyRate);
     if (ber == 0.0)
     {
@@ -177,6 +194,15 @@ YansErrorRateModel::GetFecQamBer(double snr,
 {
     NS_LOG_FUNCTION(this << snr << nbits << signalSpread << phyRate << m << dFree << adFree
                          << adFreePlusOne);
+    if (auto successRate = LookupSuccessRate(snr * signalSpread / phyRate,
+                                             nbits,
+                                             m,
+                                             dFree,
+                                             adFree,
+                                             adFreePlusOne))
+    {
+        return *successRate;
+    }
     double ber = GetQamBer(snr, m, signalSpread, phyRate);
     if (ber == 0.0)
     {
@@ -193,6 +219,64 @@ YansErrorRateModel::GetFecQamBer(double snr,
     return pms;
 }
 
+double
+YansErrorRateModel::GetFecErrorProbability(double ebNo,
+                                           uint32_t m,
+                                           uint32_t dFree,
+                                           uint32_t adFree,
+                                           uint32_t adFreePlusOne) const
+{
+    double ber = (m == 2 ? GetBpskBer(ebNo, 1, 1) : GetQamBer(ebNo, m, 1, 1));
+    if (ber == 0.0)
+    {
+        return 0.0;
+    }
+    double pmu = adFree * CalculatePd(ber, dFree);
+    if (m != 2)
+    {
+        pmu += adFreePlusOne * CalculatePd(ber, dFree + 1);
+    }
+    return std::min(pmu, 1.0);
+}
+
+std::optional<double>
+YansErrorRateModel::LookupSuccessRate(double ebNo,
+                                      uint64_t nbits,
+                                      uint32_t m,
+                                      uint32_t dFree,
+                                      uint32_t adFree,
+                                      uint32_t adFreePlusOne) const
+{
+    if (m_tableStep == 0)
+    {
+        return std::nullopt;
+    }
+    // the tables only depend on their parameters, hence they are shared by all the models
+    static std::map<std::tuple<double, uint32_t, uint32_t, uint32_t, uint32_t>, SuccessRateTable>
+        tables;
+    auto key = std::make_tuple(m_tableStep, m, dFree, adFree, adFreePlusOne);
+    auto it = tables.find(key);
+    if (it == tables.end())
+    {
+        NS_LOG_DEBUG("Compute the table for m=" << m << " dFree=" << dFree);
+        it = tables
+                 .emplace(key,
+                          SuccessRateTable(
+                              [this, m, dFree, adFree, adFreePlusOne](double ebNo) {
+                                  return GetFecErrorProbability(ebNo,
+                                                                m,
+                                                                dFree,
+                                                                adFree,
+                                                                adFreePlusOne);
+                              },
+                              -20,
+                              70,
+                              m_tableStep))
+                 .first;
+    }
+    return it->second.GetSuccessRate(ebNo, nbits);
+}
+
 double
 YansErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
                                           const WifiTxVector& txVector,
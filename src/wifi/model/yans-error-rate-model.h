@@ -22,6 +22,8 @@
 
 #include "error-rate-model.h"
 
+#include <optional>
+
 namespace ns3
 {
 
@@ -165,6 +167,43 @@ class YansErrorRateModel : public ErrorRateModel
                         uint32_t dfree,
                         uint32_t adFree,
                         uint32_t adFreePlusOne) const;
+    /**
+     * Return the probability that a bit is in error after applying FEC.
+     *
+     * \param ebNo the energy per bit to noise ratio (not dB)
+     * \param m the constellation size (2 for BPSK)
+     * \param dFree
+     * \param adFree
+     * \param adFreePlusOne
+     *
+     * \return the probability that a bit is in error after applying FEC
+     */
+    double GetFecErrorProbability(double ebNo,
+                                  uint32_t m,
+                                  uint32_t dFree,
+                                  uint32_t adFree,
+                                  uint32_t adFreePlusOne) const;
+    /**
+     * Return the success rate of a chunk interpolated from the pre-computed
+     * tables, if enabled and if the interpolation is accurate enough.
+     *
+     * \param ebNo the energy per bit to noise ratio (not dB)
+     * \param nbits the number of bits in the chunk
+     * \param m the constellation size (2 for BPSK)
+     * \param dFree
+     * \param adFree
+     * \param adFreePlusOne
+     *
+     * \return the interpolated success rate, if any
+     */
+    std::optional<double> LookupSuccessRate(double ebNo,
+                                            uint64_t nbits,
+                                            uint32_t m,
+                                            uint32_t dFree,
+                                            uint32_t adFree,
+                                            uint32_t adFreePlusOne) const;
+
+    double m_tableStep; //!< resolution (in dB) of the success rate tables, zero if disabled
 };
 
 } // namespace ns3
@@ -24,6 +24,7 @@
 #include "wifi-utils.h"
 #include "yans-wifi-phy.h"
 
+#include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
@@ -57,11 +58,21 @@ YansWifiChannel::GetTypeId()
                           "A pointer to the propagation delay model attached to this channel.",
                           PointerValue(),
                           MakePointerAccessor(&YansWifiChannel::m_delay),
-                          MakePointerChecker<PropagationDelayModel>());
+                          MakePointerChecker<PropagationDelayModel>())
+            .AddAttribute("MaxRange",
+                          "The distance (m) beyond which receivers are not reached by the "
+                          "transmissions, hence the propagation models are not evaluated for "
+                          "them. If non-zero, the PHYs are indexed by their position so that "
+                          "only those within range are examined. Zero means no limit.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&YansWifiChannel::SetMaxRange,
+                                             &YansWifiChannel::GetMaxRange),
+                          MakeDoubleChecker<double>(0));
     return tid;
 }
 
 YansWifiChannel::YansWifiChannel()
+    : m_maxRange(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -69,6 +80,7 @@ YansWifiChannel::YansWifiChannel()
 YansWifiChannel::~YansWifiChannel()
 {
     NS_LOG_FUNCTION(this);
+    m_index.Clear();
     m_phyList.clear();
 }
 
@@ -86,63 +98,111 @@ YansWifiChannel::SetPropagationDelayModel(const Ptr<PropagationDelayModel> delay
     m_delay = delay;
 }
 
+void
+YansWifiChannel::SetMaxRange(double range)
+{
+    NS_LOG_FUNCTION(this << range);
+    m_maxRange = range;
+    m_index.Clear();
+    if (m_maxRange > 0)
+    {
+        // the PHYs are indexed at the first transmission, when they are all
+        // expected to have a mobility model
+        m_index.SetCellSize(m_maxRange);
+    }
+}
+
+double
+YansWifiChannel::GetMaxRange() const
+{
+    return m_maxRange;
+}
+
 void
 YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double txPowerDbm) const
 {
     NS_LOG_FUNCTION(this << sender << ppdu << txPowerDbm);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
-    for (PhyList::const_iterator i = m_phyList.begin(); i != m_phyList.end(); i++)
+    if (m_maxRange == 0)
     {
-        if (sender != (*i))
+        for (PhyList::const_iterator i = m_phyList.begin(); i != m_phyList.end(); i++)
         {
             // For now don't account for inter channel interference nor channel bonding
-            if ((*i)->GetChannelNumber() != sender->GetChannelNumber())
+            if (sender != (*i) && (*i)->GetChannelNumber() == sender->GetChannelNumber())
             {
-                continue;
-            }
-
-            Ptr<MobilityModel> receiverMobility = (*i)->GetMobility()->GetObject<MobilityModel>();
-            Time delay = m_delay->GetDelay(senderMobility, receiverMobility);
-            double rxPowerDbm = m_loss->CalcRxPower(txPowerDbm, senderMobility, receiverMobility);
-            NS_LOG_DEBUG("propagation: txPower="
-                         << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, "
-                         << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
-                         << "m, delay=" << delay);
-            Ptr<NetDevice> dstNetDevice = (*i)->GetDevice();
-            uint32_t dstNode;
-            if (!dstNetDevice)
-            {
-                dstNode = 0xffffffff;
-            }
-            else
-            {
-                dstNode = dstNetDevice->GetNode()->GetId();
+                Propagate(senderMobility, *i, ppdu, txPowerDbm);
             }
+        }
+        return;
+    }
 
-            Simulator::ScheduleWithContext(dstNode,
-                                           delay,
-                                           &YansWifiChannel::Receive,
-                                           (*i),
-                                           ppdu,
-                                           rxPowerDbm);
+    for (std::size_t i = m_index.GetNItems(); i < m_phyList.size(); i++)
+    {
+        NS_ASSERT_MSG(m_phyList[i]->GetMobility(), "PHY without mobility model");
+        m_index.Add(m_phyList[i]->GetMobility());
+    }
+    m_candidates.clear();
+    m_index.GetCandidates(senderMobility->GetPosition(), m_maxRange, m_candidates);
+    // candidates are sorted, hence receptions are scheduled in the same order as
+    // when iterating over the whole list
+    for (auto i : m_candidates)
+    {
+        const Ptr<YansWifiPhy>& phy = m_phyList[i];
+        if (sender != phy && phy->GetChannelNumber() == sender->GetChannelNumber() &&
+            senderMobility->GetDistanceFrom(phy->GetMobility()) <= m_maxRange)
+        {
+            Propagate(senderMobility, phy, ppdu, txPowerDbm);
         }
     }
 }
 
 void
-YansWifiChannel::Receive(Ptr<YansWifiPhy> phy, Ptr<const WifiPpdu> ppdu, double rxPowerDbm)
+YansWifiChannel::Propagate(Ptr<MobilityModel> senderMobility,
+                           Ptr<YansWifiPhy> receiver,
+                           Ptr<const WifiPpdu> ppdu,
+                           double txPowerDbm) const
 {
-    NS_LOG_FUNCTION(phy << ppdu << rxPowerDbm);
+    Ptr<MobilityModel> receiverMobility = receiver->GetMobility()->GetObject<MobilityModel>();
+    Time delay = m_delay->GetDelay(senderMobility, receiverMobility);
+    double rxPowerDbm = m_loss->CalcRxPower(txPowerDbm, senderMobility, receiverMobility);
+    NS_LOG_DEBUG("propagation: txPower="
+                 << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, "
+                 << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
+                 << "m, delay=" << delay);
     // Do no further processing if signal is too weak
     // Current implementation assumes constant RX power over the PPDU duration
     // Compare received TX power per MHz to normalized RX sensitivity
     uint16_t txWidth = ppdu->GetTransmissionChannelWidth();
-    if ((rxPowerDbm + phy->GetRxGain()) < phy->GetRxSensitivity() + RatioToDb(txWidth / 20.0))
+    if ((rxPowerDbm + receiver->GetRxGain()) <
+        receiver->GetRxSensitivity() + RatioToDb(txWidth / 20.0))
     {
         NS_LOG_INFO("Received signal too weak to process: " << rxPowerDbm << " dBm");
         return;
     }
+    Ptr<NetDevice> dstNetDevice = receiver->GetDevice();
+    uint32_t dstNode;
+    if (!dstNetDevice)
+    {
+        dstNode = 0xffffffff;
+    }
+    else
+    {
+        dstNode = dstNetDevice->GetNode()->GetId();
+    }
+
+    Simulator::ScheduleWithContext(dstNode,
+                                   delay,
+                                   &YansWifiChannel::Receive,
+                                   receiver,
+                                   ppdu,
+                                   rxPowerDbm);
+}
+
+void
+YansWifiChannel::Receive(Ptr<YansWifiPhy> phy, Ptr<const WifiPpdu> ppdu, double rxPowerDbm)
+{
+    NS_LOG_FUNCTION(phy << ppdu << rxPowerDbm);
     RxPowerWattPerChannelBand rxPowerW;
     rxPowerW.insert(
         {std::make_pair(0, 0), (DbmToW(rxPowerDbm + phy->GetRxGain()))}); // dummy band for YANS
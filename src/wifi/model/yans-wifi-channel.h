@@ -21,10 +21,12 @@
 #define YANS_WIFI_CHANNEL_H
 
 #include "ns3/channel.h"
+#include "ns3/spatial-grid-index.h"
 
 namespace ns3
 {
 
+class MobilityModel;
 class NetDevice;
 class PropagationLossModel;
 class PropagationDelayModel;
@@ -41,6 +43,13 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * The signals that reach a receiver below its RX sensitivity are discarded
+ * when the transmission starts, so that no reception event is scheduled for
+ * them. In addition, the MaxRange attribute can be set to the distance beyond
+ * which receivers are not reachable: the channel then keeps its PHYs in a
+ * SpatialGridIndex and only evaluates the propagation models for those within
+ * MaxRange of the sender.
  */
 class YansWifiChannel : public Channel
 {
@@ -96,6 +105,20 @@ class YansWifiChannel : public Channel
      */
     int64_t AssignStreams(int64_t stream);
 
+    /**
+     * Set the distance beyond which receivers are not reached by the
+     * transmissions. A value of zero (the default) disables the limit.
+     *
+     * \param range the maximum range, in meters
+     */
+    void SetMaxRange(double range);
+
+    /**
+     * \return the distance beyond which receivers are not reached, in meters
+     * (zero if unlimited)
+     */
+    double GetMaxRange() const;
+
   private:
     /**
      * A vector of pointers to YansWifiPhy.
@@ -103,9 +126,10 @@ class YansWifiChannel : public Channel
     typedef std::vector<Ptr<YansWifiPhy>> PhyList;
 
     /**
-     * This method is scheduled by Send for each associated YansWifiPhy.
-     * The method then calls the corresponding YansWifiPhy that the first
-     * bit of the PPDU has arrived.
+     * This method is scheduled by Propagate for each YansWifiPhy receiving
+     * the PPDU with enough power for it to be processed. The method then
+     * calls the corresponding YansWifiPhy that the first bit of the
+     * PPDU has arrived.
      *
      * \param receiver the device to which the packet is destined
      * \param ppdu the PPDU being sent
@@ -113,9 +137,26 @@ class YansWifiChannel : public Channel
      */
     static void Receive(Ptr<YansWifiPhy> receiver, Ptr<const WifiPpdu> ppdu, double txPowerDbm);
 
+    /**
+     * Compute the propagation of a PPDU to a receiver and, if the received
+     * signal is strong enough to be processed, schedule its reception.
+     *
+     * \param senderMobility the mobility model of the sender
+     * \param receiver the receiver
+     * \param ppdu the PPDU being sent
+     * \param txPowerDbm the TX power associated to the packet being sent (dBm)
+     */
+    void Propagate(Ptr<MobilityModel> senderMobility,
+                   Ptr<YansWifiPhy> receiver,
+                   Ptr<const WifiPpdu> ppdu,
+                   double txPowerDbm) const;
+
     PhyList m_phyList;                  //!< List of YansWifiPhys connected to this YansWifiChannel
     Ptr<PropagationLossModel> m_loss;   //!< Propagation loss model
     Ptr<PropagationDelayModel> m_delay; //!< Propagation delay model
+    double m_maxRange;                  //!< Distance beyond which receivers are not reached
+    mutable SpatialGridIndex m_index;   //!< Index of the PHYs by position, if m_maxRange > 0
+    mutable std::vector<std::size_t> m_candidates; //!< PHYs returned by the last index query
 };
 
 } // namespace ns3
@@ -18,6 +18,7 @@
  */
 
 #include "ns3/adhoc-wifi-mac.h"
+#include "ns3/boolean.h"
 #include "ns3/channel-access-manager.h"
 #include "ns3/frame-exchange-manager.h"
 #include "ns3/qos-txop.h"
@@ -223,7 +224,11 @@ template <typename TxopType>
 class ChannelAccessManagerTest : public TestCase
 {
   public:
-    ChannelAccessManagerTest();
+    /**
+     * Constructor
+     * \param analyticBackoff whether the channel access manager operates in analytic backoff mode
+     */
+    ChannelAccessManagerTest(bool analyticBackoff = false);
     void DoRun() override;
 
     /**
@@ -412,6 +417,7 @@ class ChannelAccessManagerTest : public TestCase
     Ptr<WifiPhy> m_phy;                                   //!< the PHY object
     TxopTests m_txop;                                     //!< the vector of Txop test instances
     uint32_t m_ackTimeoutValue;                           //!< the Ack timeout value
+    bool m_analyticBackoff; //!< whether the channel access manager operates in analytic mode
 };
 
 template <typename TxopType>
@@ -471,8 +477,10 @@ TxopTest<TxopType>::NotifyWakeUp(uint8_t linkId)
 }
 
 template <typename TxopType>
-ChannelAccessManagerTest<TxopType>::ChannelAccessManagerTest()
-    : TestCase("ChannelAccessManager")
+ChannelAccessManagerTest<TxopType>::ChannelAccessManagerTest(bool analyticBackoff)
+    : TestCase(std::string("ChannelAccessManager") +
+               (analyticBackoff ? " with analytic backoff" : "")),
+      m_analyticBackoff(analyticBackoff)
 {
 }
 
@@ -609,6 +617,7 @@ ChannelAccessManagerTest<TxopType>::StartTest(uint64_t slotTime,
                                               uint16_t chWidth)
 {
     m_ChannelAccessManager = CreateObject<ChannelAccessManagerStub>();
+    m_ChannelAccessManager->SetAttribute("AnalyticBackoff", BooleanValue(m_analyticBackoff));
     m_feManager = CreateObject<FrameExchangeManagerStub<TxopType>>(this);
     m_ChannelAccessManager->SetupFrameExchangeManager(m_feManager);
     m_ChannelAccessManager->SetSlot(MicroSeconds(slotTime));
@@ -1532,6 +1541,7 @@ TxopTestSuite::TxopTestSuite()
     : TestSuite("wifi-devices-dcf", UNIT)
 {
     AddTestCase(new ChannelAccessManagerTest<Txop>, TestCase::QUICK);
+    AddTestCase(new ChannelAccessManagerTest<Txop>(true), TestCase::QUICK);
 }
 
 static TxopTestSuite g_dcfTestSuite;
@@ -1552,6 +1562,7 @@ QosTxopTestSuite::QosTxopTestSuite()
     : TestSuite("wifi-devices-edca", UNIT)
 {
     AddTestCase(new ChannelAccessManagerTest<QosTxop>, TestCase::QUICK);
+    AddTestCase(new ChannelAccessManagerTest<QosTxop>(true), TestCase::QUICK);
 }
 
 static QosTxopTestSuite g_edcaTestSuite;
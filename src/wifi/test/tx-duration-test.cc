@@ -1811,6 +1811,123 @@ PhyHeaderSectionsTest::DoRun()
     CheckPhyHeaderSections(phyEntity->GetPhyHeaderSections(txVector, ppduStart), sections);
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that the durations memoized by WifiPhy::CalculateTxDuration are the
+ * computed ones
+ */
+class TxDurationCacheTest : public TestCase
+{
+  public:
+    TxDurationCacheTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \return the TX durations of a set of PSDU sizes sent with a set of TXVECTORs
+     */
+    std::vector<Time> CalculateTxDurations() const;
+};
+
+TxDurationCacheTest::TxDurationCacheTest()
+    : TestCase("Check the memoization of TX durations")
+{
+}
+
+std::vector<Time>
+TxDurationCacheTest::CalculateTxDurations() const
+{
+    // mode, preamble, channel width, guard interval, NSS and band
+    const std::vector<std::tuple<WifiMode, WifiPreamble, uint16_t, uint16_t, uint8_t, WifiPhyBand>>
+        params{
+            {DsssPhy::GetDsssRate11Mbps(), WIFI_PREAMBLE_SHORT, 22, 800, 1, WIFI_PHY_BAND_2_4GHZ},
+            {ErpOfdmPhy::GetErpOfdmRate54Mbps(),
+             WIFI_PREAMBLE_LONG,
+             20,
+             800,
+             1,
+             WIFI_PHY_BAND_2_4GHZ},
+            {OfdmPhy::GetOfdmRate6Mbps(), WIFI_PREAMBLE_LONG, 20, 800, 1, WIFI_PHY_BAND_5GHZ},
+            {HtPhy::GetHtMcs7(), WIFI_PREAMBLE_HT_MF, 40, 400, 1, WIFI_PHY_BAND_5GHZ},
+            {HtPhy::GetHtMcs7(), WIFI_PREAMBLE_HT_MF, 40, 800, 1, WIFI_PHY_BAND_5GHZ},
+            {HtPhy::GetHtMcs15(), WIFI_PREAMBLE_HT_MF, 20, 800, 2, WIFI_PHY_BAND_2_4GHZ},
+            {VhtPhy::GetVhtMcs9(), WIFI_PREAMBLE_VHT_SU, 80, 400, 2, WIFI_PHY_BAND_5GHZ},
+            {HePhy::GetHeMcs0(), WIFI_PREAMBLE_HE_SU, 20, 3200, 1, WIFI_PHY_BAND_2_4GHZ},
+            {HePhy::GetHeMcs11(), WIFI_PREAMBLE_HE_SU, 160, 800, 4, WIFI_PHY_BAND_6GHZ},
+            {HePhy::GetHeMcs11(), WIFI_PREAMBLE_HE_SU, 160, 1600, 4, WIFI_PHY_BAND_6GHZ},
+            {HePhy::GetHeMcs2(), WIFI_PREAMBLE_HE_ER_SU, 20, 800, 1, WIFI_PHY_BAND_5GHZ},
+        };
+    std::vector<Time> durations;
+    for (const auto& [mode, preamble, width, gi, nss, band] : params)
+    {
+        WifiTxVector txVector;
+        txVector.SetMode(mode);
+        txVector.SetPreambleType(preamble);
+        txVector.SetChannelWidth(width);
+        txVector.SetGuardInterval(gi);
+        txVector.SetNss(nss);
+        txVector.SetNTx(nss);
+        for (uint32_t size : {14, 100, 1536, 8000})
+        {
+            if (size > WifiPhy::GetMaxPsduSize(mode.GetModulationClass()))
+            {
+                continue;
+            }
+            durations.push_back(WifiPhy::CalculateTxDuration(size, txVector, band));
+        }
+    }
+    // 11be SU transmissions: EHT MU PPDUs sent to a single user over the whole channel
+    for (uint16_t width : {20, 80})
+    {
+        WifiTxVector txVector;
+        txVector.SetPreambleType(WIFI_PREAMBLE_EHT_MU);
+        txVector.SetChannelWidth(width);
+        txVector.SetGuardInterval(800);
+        txVector.SetHeMuUserInfo(1, {{HeRu::GetRuType(width), 1, true}, EhtPhy::GetEhtMcs7(), 2});
+        for (uint32_t size : {14, 1536, 8000})
+        {
+            durations.push_back(
+                WifiPhy::CalculateTxDuration(size, txVector, WIFI_PHY_BAND_5GHZ, 1));
+        }
+    }
+    return durations;
+}
+
+void
+TxDurationCacheTest::DoRun()
+{
+    WifiPhy::SetTxDurationCacheSize(0);
+    WifiPhy::ResetTxDurationCacheStats();
+    auto expected = CalculateTxDurations();
+    NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetTxDurationCacheStats().hits +
+                              WifiPhy::GetTxDurationCacheStats().misses,
+                          0,
+                          "The cache should be disabled");
+
+    WifiPhy::SetTxDurationCacheSize(4096);
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        auto durations = CalculateTxDurations();
+        NS_TEST_EXPECT_MSG_EQ((durations == expected), true, "Unexpected memoized durations");
+    }
+    NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetTxDurationCacheStats().hits,
+                          expected.size(),
+                          "Every duration should be found in the cache in the second pass");
+    NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetTxDurationCacheStats().misses,
+                          expected.size(),
+                          "The durations should only be computed in the first pass");
+
+    // a cache smaller than the number of durations is emptied many times
+    WifiPhy::SetTxDurationCacheSize(3);
+    auto durations = CalculateTxDurations();
+    NS_TEST_EXPECT_MSG_EQ((durations == expected), true, "Unexpected memoized durations");
+
+    WifiPhy::SetTxDurationCacheSize(4096);
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1829,6 +1946,7 @@ TxDurationTestSuite::TxDurationTestSuite()
     AddTestCase(new HeSigBDurationTest, TestCase::QUICK);
     AddTestCase(new TxDurationTest, TestCase::QUICK);
     AddTestCase(new PhyHeaderSectionsTest, TestCase::QUICK);
+    AddTestCase(new TxDurationCacheTest, TestCase::QUICK);
 }
 
 static TxDurationTestSuite g_txDurationTestSuite; ///< the test suite
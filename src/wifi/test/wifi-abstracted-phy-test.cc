@@ -0,0 +1,314 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/abstracted-wifi-phy.h"
+#include "ns3/interference-helper.h"
+#include "ns3/log.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/ofdm-phy.h"
+#include "ns3/ofdm-ppdu.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/wifi-mac-header.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/wifi-spectrum-signal-parameters.h"
+#include "ns3/wifi-spectrum-value-helper.h"
+#include "ns3/wifi-utils.h"
+
+#include <cmath>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("WifiAbstractedPhyTest");
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Effective SNR mappings of AbstractedWifiPhy
+ */
+class AbstractedWifiPhyMappingTest : public TestCase
+{
+  public:
+    AbstractedWifiPhyMappingTest();
+
+  private:
+    void DoRun() override;
+};
+
+AbstractedWifiPhyMappingTest::AbstractedWifiPhyMappingTest()
+    : TestCase("Check the effective SNR mappings of AbstractedWifiPhy")
+{
+}
+
+void
+AbstractedWifiPhyMappingTest::DoRun()
+{
+    // BPSK-constrained capacity at Es/N0 = 0 dB
+    NS_TEST_EXPECT_MSG_EQ_TOL(AbstractedWifiPhy::GetMutualInformation(1, 2),
+                              0.721,
+                              0.005,
+                              "Unexpected mutual information of BPSK");
+    // QPSK is made of two BPSK with half the energy each
+    for (double snrDb : {-5.0, 0.0, 3.0, 7.5})
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL(AbstractedWifiPhy::GetMutualInformation(DbToRatio(snrDb), 4),
+                                  2 * AbstractedWifiPhy::GetMutualInformation(
+                                          DbToRatio(snrDb - 10 * std::log10(2)),
+                                          2),
+                                  0.01,
+                                  "Unexpected mutual information of QPSK at " << snrDb << " dB");
+    }
+    for (uint16_t m : {2, 4, 16, 64, 256, 1024, 4096})
+    {
+        NS_TEST_EXPECT_MSG_LT(AbstractedWifiPhy::GetMutualInformation(DbToRatio(-10), m),
+                              0.2,
+                              "Unexpected mutual information of " << m << "-QAM at -10 dB");
+        NS_TEST_EXPECT_MSG_EQ_TOL(AbstractedWifiPhy::GetMutualInformation(DbToRatio(50), m),
+                                  std::log2(m),
+                                  0.001,
+                                  "Unexpected mutual information of " << m << "-QAM at 50 dB");
+    }
+
+    auto phy = CreateObject<AbstractedWifiPhy>();
+    std::vector<double> flat{20, 20, 20, 20};
+    std::vector<double> selective{2, 200};
+    for (auto mapping : {"EESM", "MIESM"})
+    {
+        phy->SetAttribute("EffectiveSnrMapping", StringValue(mapping));
+        NS_TEST_EXPECT_MSG_EQ_TOL(phy->GetEffectiveSnr(flat, 16),
+                                  20,
+                                  1e-9,
+                                  mapping << " does not preserve a flat SNR");
+        for (uint16_t m : {2, 16, 256})
+        {
+            double snr = phy->GetEffectiveSnr(selective, m);
+            NS_TEST_EXPECT_MSG_GT(snr, 2, mapping << " is below the worst subchannel");
+            NS_TEST_EXPECT_MSG_LT(snr, 101, mapping << " is above the mean SNR");
+            if (m > 2)
+            {
+                // denser constellations suffer less from the worst subchannel
+                NS_TEST_EXPECT_MSG_GT(snr,
+                                      phy->GetEffectiveSnr(selective, m / 4),
+                                      mapping << " does not increase with the constellation");
+            }
+        }
+    }
+
+    // EESM tends to the minimum SNR for a small beta and to the mean SNR for a large beta
+    phy->SetAttribute("EffectiveSnrMapping", StringValue("EESM"));
+    phy->SetEesmBeta(16, 0.01);
+    NS_TEST_EXPECT_MSG_EQ_TOL(phy->GetEffectiveSnr(selective, 16),
+                              2,
+                              0.01,
+                              "EESM should be close to the minimum SNR");
+    phy->SetEesmBeta(16, 1e6);
+    NS_TEST_EXPECT_MSG_EQ_TOL(phy->GetEffectiveSnr(selective, 16),
+                              101,
+                              0.01,
+                              "EESM should be close to the mean SNR");
+    phy->Dispose();
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Reception of SU PPDUs by AbstractedWifiPhy
+ *
+ * Isolated PPDUs are received, whereas two PPDUs arriving one microsecond
+ * apart collide: the PHY locks on the first one and fails to decode its payload.
+ */
+class AbstractedWifiPhyReceptionTest : public TestCase
+{
+  public:
+    AbstractedWifiPhyReceptionTest();
+
+  private:
+    void DoSetup() override;
+    void DoTeardown() override;
+    void DoRun() override;
+
+    /**
+     * Inject a PPDU in the PHY
+     * \param txPowerWatts the transmit power in watts
+     */
+    void SendSignal(double txPowerWatts);
+
+    /**
+     * Callback invoked when a PSDU is received
+     * \param psdu the PSDU
+     * \param rxSignalInfo the info on the received signal (\see RxSignalInfo)
+     * \param txVector the transmit vector
+     * \param statusPerMpdu reception status per MPDU
+     */
+    void RxSuccess(Ptr<const WifiPsdu> psdu,
+                   RxSignalInfo rxSignalInfo,
+                   WifiTxVector txVector,
+                   std::vector<bool> statusPerMpdu);
+
+    /**
+     * Callback invoked when a PSDU is not received
+     * \param psdu the PSDU
+     */
+    void RxFailure(Ptr<const WifiPsdu> psdu);
+
+    /**
+     * Callback invoked when a PSDU is dropped
+     * \param p the packet
+     * \param reason the reason
+     */
+    void RxDrop(Ptr<const Packet> p, WifiPhyRxfailureReason reason);
+
+    Ptr<AbstractedWifiPhy> m_phy; ///< the PHY
+    uint64_t m_uid{0};            ///< the UID to use for the next PPDU
+    uint32_t m_countRxSuccess{0}; ///< number of successful receptions
+    uint32_t m_countRxFailure{0}; ///< number of failed receptions
+    uint32_t m_countRxDrop{0};    ///< number of dropped PPDUs
+};
+
+AbstractedWifiPhyReceptionTest::AbstractedWifiPhyReceptionTest()
+    : TestCase("Check the reception of SU PPDUs by AbstractedWifiPhy")
+{
+}
+
+void
+AbstractedWifiPhyReceptionTest::SendSignal(double txPowerWatts)
+{
+    WifiTxVector txVector(OfdmPhy::GetOfdmRate6Mbps(),
+                          0,
+                          WIFI_PREAMBLE_LONG,
+                          800,
+                          1,
+                          1,
+                          0,
+                          20,
+                          false);
+    WifiMacHeader hdr;
+    hdr.SetType(WIFI_MAC_QOSDATA);
+    hdr.SetQosTid(0);
+    Ptr<WifiPsdu> psdu = Create<WifiPsdu>(Create<Packet>(1000), hdr);
+    Time txDuration = m_phy->CalculateTxDuration(psdu->GetSize(), txVector, m_phy->GetPhyBand());
+
+    auto txParams = Create<WifiSpectrumSignalParameters>();
+    txParams->psd =
+        WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity(5180, 20, txPowerWatts, 20);
+    txParams->txPhy = nullptr;
+    txParams->duration = txDuration;
+    txParams->ppdu = Create<OfdmPpdu>(psdu, txVector, 5180, WIFI_PHY_BAND_5GHZ, m_uid++);
+    m_phy->StartRx(txParams);
+}
+
+void
+AbstractedWifiPhyReceptionTest::RxSuccess(Ptr<const WifiPsdu> psdu,
+                                          RxSignalInfo rxSignalInfo,
+                                          WifiTxVector txVector,
+                                          std::vector<bool> statusPerMpdu)
+{
+    NS_LOG_FUNCTION(this << *psdu << rxSignalInfo << txVector);
+    m_countRxSuccess++;
+}
+
+void
+AbstractedWifiPhyReceptionTest::RxFailure(Ptr<const WifiPsdu> psdu)
+{
+    NS_LOG_FUNCTION(this << *psdu);
+    m_countRxFailure++;
+}
+
+void
+AbstractedWifiPhyReceptionTest::RxDrop(Ptr<const Packet> p, WifiPhyRxfailureReason reason)
+{
+    NS_LOG_FUNCTION(this << p << reason);
+    NS_TEST_EXPECT_MSG_EQ(reason, RXING, "Unexpected reason for dropping a PPDU");
+    m_countRxDrop++;
+}
+
+void
+AbstractedWifiPhyReceptionTest::DoSetup()
+{
+    m_phy = CreateObject<AbstractedWifiPhy>();
+    m_phy->SetOperatingChannel(WifiPhy::ChannelTuple{36, 0, WIFI_PHY_BAND_5GHZ, 0});
+    m_phy->ConfigureStandard(WIFI_STANDARD_80211n);
+    m_phy->SetInterferenceHelper(CreateObject<InterferenceHelper>());
+    m_phy->SetErrorRateModel(CreateObject<NistErrorRateModel>());
+    m_phy->SetReceiveOkCallback(MakeCallback(&AbstractedWifiPhyReceptionTest::RxSuccess, this));
+    m_phy->SetReceiveErrorCallback(
+        MakeCallback(&AbstractedWifiPhyReceptionTest::RxFailure, this));
+    m_phy->TraceConnectWithoutContext(
+        "PhyRxDrop",
+        MakeCallback(&AbstractedWifiPhyReceptionTest::RxDrop, this));
+}
+
+void
+AbstractedWifiPhyReceptionTest::DoTeardown()
+{
+    m_phy->Dispose();
+    m_phy = nullptr;
+}
+
+void
+AbstractedWifiPhyReceptionTest::DoRun()
+{
+    double txPowerWatts = 0.010;
+    Simulator::Schedule(Seconds(1),
+                        &AbstractedWifiPhyReceptionTest::SendSignal,
+                        this,
+                        txPowerWatts);
+    Simulator::Schedule(Seconds(2),
+                        &AbstractedWifiPhyReceptionTest::SendSignal,
+                        this,
+                        txPowerWatts);
+    Simulator::Schedule(Seconds(3),
+                        &AbstractedWifiPhyReceptionTest::SendSignal,
+                        this,
+                        txPowerWatts);
+    Simulator::Schedule(MicroSeconds(4000000),
+                        &AbstractedWifiPhyReceptionTest::SendSignal,
+                        this,
+                        txPowerWatts);
+    Simulator::Schedule(MicroSeconds(4000001),
+                        &AbstractedWifiPhyReceptionTest::SendSignal,
+                        this,
+                        txPowerWatts);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(m_countRxSuccess, 3, "Didn't receive the isolated PPDUs");
+    NS_TEST_EXPECT_MSG_EQ(m_countRxFailure, 1, "Didn't fail to receive the colliding PPDU");
+    NS_TEST_EXPECT_MSG_EQ(m_countRxDrop, 1, "Didn't drop the PPDU arriving during RX");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief AbstractedWifiPhy Test Suite
+ */
+class AbstractedWifiPhyTestSuite : public TestSuite
+{
+  public:
+    AbstractedWifiPhyTestSuite();
+};
+
+AbstractedWifiPhyTestSuite::AbstractedWifiPhyTestSuite()
+    : TestSuite("wifi-abstracted-phy", UNIT)
+{
+    AddTestCase(new AbstractedWifiPhyMappingTest, TestCase::QUICK);
+    AddTestCase(new AbstractedWifiPhyReceptionTest, TestCase::QUICK);
+}
+
+static AbstractedWifiPhyTestSuite g_abstractedWifiPhyTestSuite; ///< the test suite
@@ -18,11 +18,13 @@
  *          Sébastien Deronne (sebastien.deronne@gmail.com)
  */
 
+#include "ns3/double.h"
 #include "ns3/dsss-error-rate-model.h"
 #include "ns3/he-phy.h" //includes HT and VHT
 #include "ns3/interference-helper.h"
 #include "ns3/log.h"
 #include "ns3/nist-error-rate-model.h"
+#include "ns3/object-factory.h"
 #include "ns3/table-based-error-rate-model.h"
 #include "ns3/test.h"
 #include "ns3/wifi-phy.h"
@@ -1032,6 +1034,82 @@ TableBasedErrorRateTestCase::DoRun()
     }
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that the chunk success rates interpolated from pre-computed tables
+ * do not deviate from the analytical values by more than a given bound
+ */
+class SuccessRateTableTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param typeId the TypeId of the error rate model
+     */
+    SuccessRateTableTestCase(const std::string& typeId);
+
+  private:
+    void DoRun() override;
+
+    std::string m_typeId; ///< The TypeId of the error rate model
+};
+
+SuccessRateTableTestCase::SuccessRateTableTestCase(const std::string& typeId)
+    : TestCase("Check the accuracy of the success rate tables of " + typeId),
+      m_typeId(typeId)
+{
+}
+
+void
+SuccessRateTableTestCase::DoRun()
+{
+    ObjectFactory factory(m_typeId);
+    Ptr<ErrorRateModel> analytical = factory.Create<ErrorRateModel>();
+    factory.Set("SuccessRateTableStep", DoubleValue(0.01));
+    Ptr<ErrorRateModel> interpolated = factory.Create<ErrorRateModel>();
+
+    const std::vector<std::pair<std::string, WifiPreamble>> modes{
+        {"OfdmRate6Mbps", WIFI_PREAMBLE_LONG},  {"OfdmRate9Mbps", WIFI_PREAMBLE_LONG},
+        {"OfdmRate12Mbps", WIFI_PREAMBLE_LONG}, {"OfdmRate18Mbps", WIFI_PREAMBLE_LONG},
+        {"OfdmRate24Mbps", WIFI_PREAMBLE_LONG}, {"OfdmRate36Mbps", WIFI_PREAMBLE_LONG},
+        {"OfdmRate48Mbps", WIFI_PREAMBLE_LONG}, {"OfdmRate54Mbps", WIFI_PREAMBLE_LONG},
+        {"HtMcs0", WIFI_PREAMBLE_HT_MF},        {"HtMcs5", WIFI_PREAMBLE_HT_MF},
+        {"VhtMcs8", WIFI_PREAMBLE_VHT_SU},      {"VhtMcs9", WIFI_PREAMBLE_VHT_SU},
+        {"HeMcs10", WIFI_PREAMBLE_HE_SU},       {"HeMcs11", WIFI_PREAMBLE_HE_SU},
+    };
+    // the SNR values are not aligned on the grid of the tables
+    double maxError = 0;
+    for (const auto& [name, preamble] : modes)
+    {
+        WifiMode mode(name);
+        WifiTxVector txVector;
+        txVector.SetMode(mode);
+        txVector.SetPreambleType(preamble);
+        // VHT MCS 9 is not allowed at 20 MHz with a single spatial stream
+        txVector.SetChannelWidth(name == "VhtMcs9" ? 40 : 20);
+        for (double snrDb = -10; snrDb <= 60; snrDb += 0.0371)
+        {
+            double snr = std::pow(10.0, snrDb / 10.0);
+            for (uint64_t nbits : {1, 26, 208, 12000, 100000})
+            {
+                double expected = analytical->GetChunkSuccessRate(mode, txVector, snr, nbits);
+                double actual = interpolated->GetChunkSuccessRate(mode, txVector, snr, nbits);
+                NS_TEST_ASSERT_MSG_EQ_TOL(actual,
+                                          expected,
+                                          1e-5,
+                                          "Inaccurate success rate for " << mode << " at SNR "
+                                                                         << snrDb << " dB and "
+                                                                         << nbits << " bits");
+                maxError = std::max(maxError, std::abs(actual - expected));
+            }
+        }
+    }
+    NS_LOG_INFO(m_typeId << ": largest absolute error " << maxError);
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1050,6 +1128,8 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite()
     AddTestCase(new WifiErrorRateModelsTestCaseDsss, TestCase::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseNist, TestCase::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseMimo, TestCase::QUICK);
+    AddTestCase(new SuccessRateTableTestCase("ns3::NistErrorRateModel"), TestCase::QUICK);
+    AddTestCase(new SuccessRateTableTestCase("ns3::YansErrorRateModel"), TestCase::QUICK);
     AddTestCase(new TableBasedErrorRateTestCase("DefaultTableBasedHtMcs0-1458bytes",
                                                 HtPhy::GetHtMcs0(),
                                                 1458),
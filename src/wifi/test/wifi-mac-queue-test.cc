@@ -22,6 +22,8 @@
 #include "ns3/test.h"
 #include "ns3/wifi-mac-queue.h"
 
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -120,6 +122,145 @@ WifiMacQueueDropOldestTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test the removal of the MPDUs with expired lifetime.
+ *
+ * MPDUs addressed to three receivers are enqueued at different times, and
+ * some of them are dequeued or replaced while at the head of their container
+ * queue. The MPDUs with expired lifetime are periodically removed from all the
+ * container queues, and this test checks that exactly the MPDUs whose lifetime
+ * expired are removed.
+ */
+class WifiMacQueueExpiryTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     */
+    WifiMacQueueExpiryTest();
+
+    void DoRun() override;
+
+  private:
+    /**
+     * Enqueue an MPDU
+     * \param receiver the receiver of the MPDU
+     */
+    void Enqueue(Mac48Address receiver);
+
+    /**
+     * Dequeue an MPDU
+     * \param index the index of the MPDU in the order of enqueuing
+     */
+    void Dequeue(std::size_t index);
+
+    /**
+     * Replace an MPDU with a new MPDU, which keeps the expiry time of the former
+     * \param index the index of the MPDU in the order of enqueuing
+     */
+    void Replace(std::size_t index);
+
+    /**
+     * Remove the MPDUs with expired lifetime and check the number of queued MPDUs
+     * \param nExpired the expected number of MPDUs with expired lifetime so far
+     * \param nQueued the expected number of queued MPDUs
+     */
+    void CheckExpired(uint32_t nExpired, uint32_t nQueued);
+
+    Ptr<WifiMacQueue> m_queue;           //!< the queue
+    std::vector<Ptr<WifiMpdu>> m_mpdus; //!< the MPDUs in the order of enqueuing
+    uint32_t m_nExpired{0};              //!< the number of MPDUs with expired lifetime
+};
+
+WifiMacQueueExpiryTest::WifiMacQueueExpiryTest()
+    : TestCase("Test the removal of the MPDUs with expired lifetime")
+{
+}
+
+void
+WifiMacQueueExpiryTest::Enqueue(Mac48Address receiver)
+{
+    WifiMacHeader header;
+    header.SetType(WIFI_MAC_QOSDATA);
+    header.SetAddr1(receiver);
+    header.SetQosTid(0);
+    m_mpdus.push_back(Create<WifiMpdu>(Create<Packet>(100), header));
+    m_queue->Enqueue(m_mpdus.back());
+}
+
+void
+WifiMacQueueExpiryTest::Dequeue(std::size_t index)
+{
+    m_queue->DequeueIfQueued({m_mpdus.at(index)});
+}
+
+void
+WifiMacQueueExpiryTest::Replace(std::size_t index)
+{
+    auto item = Create<WifiMpdu>(Create<Packet>(200), m_mpdus.at(index)->GetHeader());
+    m_queue->Replace(m_mpdus.at(index), item);
+    m_mpdus.at(index) = item;
+}
+
+void
+WifiMacQueueExpiryTest::CheckExpired(uint32_t nExpired, uint32_t nQueued)
+{
+    m_queue->WipeAllExpiredMpdus();
+    NS_TEST_EXPECT_MSG_EQ(m_nExpired,
+                          nExpired,
+                          "Unexpected number of MPDUs with expired lifetime at "
+                              << Simulator::Now().As(Time::MS));
+    NS_TEST_EXPECT_MSG_EQ(m_queue->GetNPackets(),
+                          nQueued,
+                          "Unexpected number of queued MPDUs at "
+                              << Simulator::Now().As(Time::MS));
+}
+
+void
+WifiMacQueueExpiryTest::DoRun()
+{
+    m_queue = CreateObject<WifiMacQueue>(AC_BE);
+    m_queue->SetMaxDelay(MilliSeconds(10));
+    auto scheduler = CreateObject<FcfsWifiQueueScheduler>();
+    scheduler->m_perAcInfo[AC_BE].wifiMacQueue = m_queue;
+    m_queue->SetScheduler(scheduler);
+    m_queue->TraceConnectWithoutContext("Expired",
+                                        Callback<void, Ptr<const WifiMpdu>>(
+                                            [this](Ptr<const WifiMpdu>) { m_nExpired++; }));
+
+    Mac48Address addr1 = Mac48Address::Allocate();
+    Mac48Address addr2 = Mac48Address::Allocate();
+    Mac48Address addr3 = Mac48Address::Allocate();
+
+    Simulator::Schedule(Seconds(0), &WifiMacQueueExpiryTest::Enqueue, this, addr1);   // 0
+    Simulator::Schedule(Seconds(0), &WifiMacQueueExpiryTest::Enqueue, this, addr1);   // 1
+    Simulator::Schedule(MilliSeconds(4), &WifiMacQueueExpiryTest::Enqueue, this, addr2); // 2
+    Simulator::Schedule(MilliSeconds(4), &WifiMacQueueExpiryTest::Enqueue, this, addr1); // 3
+    Simulator::Schedule(MilliSeconds(5), &WifiMacQueueExpiryTest::CheckExpired, this, 0, 4);
+    // dequeue the head of the container queue of addr1
+    Simulator::Schedule(MilliSeconds(6), &WifiMacQueueExpiryTest::Dequeue, this, 0);
+    Simulator::Schedule(MilliSeconds(8), &WifiMacQueueExpiryTest::Enqueue, this, addr3); // 4
+    // replace the head of the container queue of addr2 (expiring at 14 ms)
+    Simulator::Schedule(MilliSeconds(8), &WifiMacQueueExpiryTest::Replace, this, 2);
+    // MPDU 1 expired at 10 ms
+    Simulator::Schedule(MilliSeconds(11), &WifiMacQueueExpiryTest::CheckExpired, this, 1, 3);
+    // MPDUs 2 and 3 expired at 14 ms
+    Simulator::Schedule(MilliSeconds(15), &WifiMacQueueExpiryTest::CheckExpired, this, 3, 1);
+    Simulator::Schedule(MilliSeconds(16), &WifiMacQueueExpiryTest::Enqueue, this, addr1); // 5
+    // MPDU 4 expired at 18 ms
+    Simulator::Schedule(MilliSeconds(19), &WifiMacQueueExpiryTest::CheckExpired, this, 4, 1);
+    // MPDU 5 expired at 26 ms
+    Simulator::Schedule(MilliSeconds(25), &WifiMacQueueExpiryTest::CheckExpired, this, 4, 1);
+    Simulator::Schedule(MilliSeconds(27), &WifiMacQueueExpiryTest::CheckExpired, this, 5, 0);
+    Simulator::Run();
+
+    scheduler->Dispose();
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -136,6 +277,7 @@ WifiMacQueueTestSuite::WifiMacQueueTestSuite()
     : TestSuite("wifi-mac-queue", UNIT)
 {
     AddTestCase(new WifiMacQueueDropOldestTest, TestCase::QUICK);
+    AddTestCase(new WifiMacQueueExpiryTest, TestCase::QUICK);
 }
 
 static WifiMacQueueTestSuite g_wifiMacQueueTestSuite; ///< the test suite
@@ -23,6 +23,7 @@
 #include "ns3/adhoc-wifi-mac.h"
 #include "ns3/ap-wifi-mac.h"
 #include "ns3/config.h"
+#include "ns3/constant-acceleration-mobility-model.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/error-model.h"
 #include "ns3/fcfs-wifi-queue-scheduler.h"
@@ -51,10 +52,13 @@
 #include "ns3/wifi-ppdu.h"
 #include "ns3/wifi-psdu.h"
 #include "ns3/wifi-spectrum-signal-parameters.h"
+#include "ns3/yans-wifi-channel.h"
 #include "ns3/yans-error-rate-model.h"
 #include "ns3/yans-wifi-helper.h"
 #include "ns3/yans-wifi-phy.h"
 
+#include <algorithm>
+
 using namespace ns3;
 
 // Helper function to assign streams to random variables, to control
@@ -3510,6 +3514,486 @@ IdealRateManagerMimoTest::DoRun()
 }
 
 //-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Base class of the tests running a scenario with two configurations that
+ * must produce the same events
+ */
+class RunComparisonTest : public TestCase
+{
+  protected:
+    /**
+     * Constructor
+     * \param name the name of the test
+     */
+    RunComparisonTest(std::string name);
+
+    /**
+     * Check that two runs of a scenario produced the same events.
+     * \tparam Event the type of the events, a tuple whose first element is the time
+     *         of the event (in nanoseconds) and the second element its context
+     * \param reference the events of the reference run
+     * \param other the events of the other run
+     * \param minEvents the minimum number of events of the reference run for the
+     *        comparison to be meaningful
+     */
+    template <typename Event>
+    void CheckSameEvents(const std::vector<Event>& reference,
+                         const std::vector<Event>& other,
+                         std::size_t minEvents);
+};
+
+RunComparisonTest::RunComparisonTest(std::string name)
+    : TestCase(name)
+{
+}
+
+template <typename Event>
+void
+RunComparisonTest::CheckSameEvents(const std::vector<Event>& reference,
+                                   const std::vector<Event>& other,
+                                   std::size_t minEvents)
+{
+    NS_TEST_ASSERT_MSG_GT(reference.size(), minEvents, "Too few events for a meaningful test");
+    NS_TEST_ASSERT_MSG_EQ(other.size(), reference.size(), "Unexpected number of events");
+    for (std::size_t i = 0; i < reference.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ((other[i] == reference[i]),
+                              true,
+                              "Event #" << i << " of " << std::get<1>(reference[i]) << " at "
+                                        << std::get<0>(reference[i]) << " ns differs");
+    }
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Make sure that limiting the range of YansWifiChannel does not change
+ * the receptions of the signals that are strong enough to be processed.
+ *
+ * Forty ad hoc stations, half of them moving (and changing course half-way),
+ * broadcast packets periodically. The scenario is run twice: first with no
+ * range limit, then with a MaxRange (hence a spatial index) just above the
+ * distance at which the received power falls below the RX sensitivity. The
+ * start of the receptions and the drops of packets must be identical.
+ */
+class YansWifiChannelMaxRangeTest : public RunComparisonTest
+{
+  public:
+    YansWifiChannelMaxRangeTest();
+    void DoRun() override;
+
+  private:
+    /// A reception event: time, context, packet size, RX power (W) or drop reason
+    using RxEvent = std::tuple<int64_t, std::string, uint32_t, double>;
+
+    /**
+     * Run the scenario
+     * \param maxRange the MaxRange attribute of the channel
+     * \return the reception events
+     */
+    std::vector<RxEvent> RunScenario(double maxRange);
+
+    /**
+     * Broadcast a packet
+     * \param device the sending device
+     */
+    void SendPacket(Ptr<NetDevice> device);
+
+    /**
+     * Callback invoked when a PHY starts receiving a PSDU
+     * \param context the context
+     * \param packet the packet
+     * \param rxPowersW the received power per band
+     */
+    void RxBegin(std::string context,
+                 Ptr<const Packet> packet,
+                 RxPowerWattPerChannelBand rxPowersW);
+
+    /**
+     * Callback invoked when a PHY drops a packet
+     * \param context the context
+     * \param packet the packet
+     * \param reason the reason of the drop
+     */
+    void RxDrop(std::string context, Ptr<const Packet> packet, WifiPhyRxfailureReason reason);
+
+    std::vector<RxEvent> m_events; ///< reception events of the current run
+};
+
+YansWifiChannelMaxRangeTest::YansWifiChannelMaxRangeTest()
+    : RunComparisonTest("Test receptions with a limited YansWifiChannel range")
+{
+}
+
+void
+YansWifiChannelMaxRangeTest::SendPacket(Ptr<NetDevice> device)
+{
+    device->Send(Create<Packet>(200), Mac48Address::GetBroadcast(), 1);
+    Simulator::Schedule(MilliSeconds(100), &YansWifiChannelMaxRangeTest::SendPacket, this, device);
+}
+
+void
+YansWifiChannelMaxRangeTest::RxBegin(std::string context,
+                                     Ptr<const Packet> packet,
+                                     RxPowerWattPerChannelBand rxPowersW)
+{
+    m_events.emplace_back(Simulator::Now().GetNanoSeconds(),
+                          context,
+                          packet->GetSize(),
+                          rxPowersW.begin()->second);
+}
+
+void
+YansWifiChannelMaxRangeTest::RxDrop(std::string context,
+                                    Ptr<const Packet> packet,
+                                    WifiPhyRxfailureReason reason)
+{
+    m_events.emplace_back(Simulator::Now().GetNanoSeconds(), context, packet->GetSize(), -reason);
+}
+
+std::vector<YansWifiChannelMaxRangeTest::RxEvent>
+YansWifiChannelMaxRangeTest::RunScenario(double maxRange)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    m_events.clear();
+
+    NodeContainer nodes;
+    nodes.Create(40);
+
+    YansWifiChannelHelper channelHelper = YansWifiChannelHelper::Default();
+    Ptr<YansWifiChannel> channel = channelHelper.Create();
+    channel->SetMaxRange(maxRange);
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel);
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate6Mbps"));
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+    wifi.AssignStreams(devices, 100);
+
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                  "DeltaX",
+                                  DoubleValue(130),
+                                  "DeltaY",
+                                  DoubleValue(110),
+                                  "GridWidth",
+                                  UintegerValue(8));
+    // the position of this model is a function of the time only, whereas models updating
+    // their position whenever it is queried (such as ConstantVelocityMobilityModel) have
+    // rounding errors depending on the queries, which the range limit makes less frequent
+    mobility.SetMobilityModel("ns3::ConstantAccelerationMobilityModel");
+    mobility.Install(nodes);
+    for (uint32_t i = 0; i < nodes.GetN(); i += 2)
+    {
+        auto model = nodes.Get(i)->GetObject<ConstantAccelerationMobilityModel>();
+        model->SetVelocityAndAcceleration(Vector(5.0 + i, 20.0 - i, 0), Vector(0, 0, 0));
+        Simulator::Schedule(Seconds(2.5),
+                            &ConstantAccelerationMobilityModel::SetVelocityAndAcceleration,
+                            model,
+                            Vector(-30.0, 2.0 * i, 0),
+                            Vector(0, 0, 0));
+    }
+
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        Simulator::Schedule(MicroSeconds(1000 + 2300 * i),
+                            &YansWifiChannelMaxRangeTest::SendPacket,
+                            this,
+                            devices.Get(i));
+    }
+    Config::Connect("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyRxBegin",
+                    MakeCallback(&YansWifiChannelMaxRangeTest::RxBegin, this));
+    Config::Connect("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyRxDrop",
+                    MakeCallback(&YansWifiChannelMaxRangeTest::RxDrop, this));
+
+    Simulator::Stop(Seconds(5));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    return m_events;
+}
+
+void
+YansWifiChannelMaxRangeTest::DoRun()
+{
+    // With the default models, 16.0206 dBm are received at -101 dBm at about 221 m
+    auto unlimited = RunScenario(0);
+    auto limited = RunScenario(230);
+    CheckSameEvents(unlimited, limited, 1000);
+
+    // a range much shorter than the reach of the signals removes receptions
+    auto shorter = RunScenario(100);
+    NS_TEST_EXPECT_MSG_LT(shorter.size(), unlimited.size(), "The range limit had no effect");
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that the analytic backoff mode of the ChannelAccessManager does not change
+ *        the transmissions in a dense BSS
+ *
+ * Twelve QoS stations in ad hoc mode send unicast frames of all the Access Categories
+ * to the same station, so that each station has several EDCAFs contending for the
+ * medium, the medium is mostly busy and collisions occur. The scenario is run with and
+ * without the AnalyticBackoff attribute of the ChannelAccessManager: the start of the
+ * transmissions must be the same (up to the order of simultaneous transmissions), while
+ * fewer events must be executed in analytic mode.
+ */
+class ChannelAccessAnalyticBackoffTest : public RunComparisonTest
+{
+  public:
+    ChannelAccessAnalyticBackoffTest();
+    void DoRun() override;
+
+  private:
+    /// A transmission: time, context and packet size
+    using TxEvent = std::tuple<int64_t, std::string, uint32_t>;
+
+    /**
+     * Run the scenario
+     * \param analyticBackoff the AnalyticBackoff attribute of the ChannelAccessManager
+     * \return the transmissions and the number of events executed by the simulator
+     */
+    std::pair<std::vector<TxEvent>, uint64_t> RunScenario(bool analyticBackoff);
+
+    /**
+     * Send a packet to the first device
+     * \param device the sending device
+     * \param priority the priority of the packet
+     */
+    void SendPacket(Ptr<NetDevice> device, uint8_t priority);
+
+    /**
+     * Callback invoked when a PHY starts transmitting a PSDU
+     * \param context the context
+     * \param packet the packet
+     * \param txPowerW the transmit power in Watts
+     */
+    void TxBegin(std::string context, Ptr<const Packet> packet, double txPowerW);
+
+    Ptr<NetDevice> m_receiver;  ///< the device all the packets are sent to
+    std::vector<TxEvent> m_txs; ///< transmissions of the current run
+};
+
+ChannelAccessAnalyticBackoffTest::ChannelAccessAnalyticBackoffTest()
+    : RunComparisonTest("Test the analytic backoff mode of the ChannelAccessManager in a dense BSS")
+{
+}
+
+void
+ChannelAccessAnalyticBackoffTest::SendPacket(Ptr<NetDevice> device, uint8_t priority)
+{
+    Ptr<Packet> packet = Create<Packet>(1000);
+    SocketPriorityTag priorityTag;
+    priorityTag.SetPriority(priority);
+    packet->AddPacketTag(priorityTag);
+    device->Send(packet, m_receiver->GetAddress(), 1);
+    Simulator::Schedule(MilliSeconds(2),
+                        &ChannelAccessAnalyticBackoffTest::SendPacket,
+                        this,
+                        device,
+                        priority);
+}
+
+void
+ChannelAccessAnalyticBackoffTest::TxBegin(std::string context,
+                                          Ptr<const Packet> packet,
+                                          double txPowerW)
+{
+    m_txs.emplace_back(Simulator::Now().GetNanoSeconds(), context, packet->GetSize());
+}
+
+std::pair<std::vector<ChannelAccessAnalyticBackoffTest::TxEvent>, uint64_t>
+ChannelAccessAnalyticBackoffTest::RunScenario(bool analyticBackoff)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    m_txs.clear();
+    Config::SetDefault("ns3::ChannelAccessManager::AnalyticBackoff", BooleanValue(analyticBackoff));
+
+    NodeContainer nodes;
+    nodes.Create(12);
+
+    YansWifiChannelHelper channelHelper = YansWifiChannelHelper::Default();
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channelHelper.Create());
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate24Mbps"));
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac", "QosSupported", BooleanValue(true));
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+    wifi.AssignStreams(devices, 100);
+
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                  "DeltaX",
+                                  DoubleValue(5),
+                                  "DeltaY",
+                                  DoubleValue(5),
+                                  "GridWidth",
+                                  UintegerValue(4));
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(nodes);
+
+    m_receiver = devices.Get(0);
+    for (uint32_t i = 1; i < devices.GetN(); i++)
+    {
+        for (uint8_t priority : {0, 1, 4, 6})
+        {
+            Simulator::Schedule(MicroSeconds(1000 + 37 * i + 11 * priority),
+                                &ChannelAccessAnalyticBackoffTest::SendPacket,
+                                this,
+                                devices.Get(i),
+                                priority);
+        }
+    }
+    Config::Connect("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyTxBegin",
+                    MakeCallback(&ChannelAccessAnalyticBackoffTest::TxBegin, this));
+
+    Simulator::Stop(MilliSeconds(500));
+    Simulator::Run();
+    uint64_t eventCount = Simulator::GetEventCount();
+    Simulator::Destroy();
+    m_receiver = nullptr;
+
+    return {m_txs, eventCount};
+}
+
+void
+ChannelAccessAnalyticBackoffTest::DoRun()
+{
+    auto [legacyTxs, legacyEvents] = RunScenario(false);
+    auto [analyticTxs, analyticEvents] = RunScenario(true);
+    Config::SetDefault("ns3::ChannelAccessManager::AnalyticBackoff", BooleanValue(false));
+
+    // the order of the transmissions starting at the same time (i.e., colliding) depends on
+    // the order in which simultaneous events are scheduled, which differs between the two
+    // modes; sorting the transmissions (by time first) makes the comparison independent of it
+    std::sort(legacyTxs.begin(), legacyTxs.end());
+    std::sort(analyticTxs.begin(), analyticTxs.end());
+    CheckSameEvents(legacyTxs, analyticTxs, 1000);
+    NS_TEST_EXPECT_MSG_LT(analyticEvents,
+                          legacyEvents,
+                          "The analytic backoff mode did not save any event");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Make sure that the TXVECTORs for data frames cached by the remote station manager
+ * are discarded when the capabilities of a remote station, the configuration of the rate
+ * control algorithm or the configuration of the PHY change.
+ */
+class DataTxVectorCacheTest : public TestCase
+{
+  public:
+    DataTxVectorCacheTest();
+    void DoRun() override;
+};
+
+DataTxVectorCacheTest::DataTxVectorCacheTest()
+    : TestCase("Check the TXVECTORs cached by the remote station manager")
+{
+}
+
+void
+DataTxVectorCacheTest::DoRun()
+{
+    NodeContainer nodes(1);
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel.Create());
+    phy.Set("ChannelSettings", StringValue("{38, 40, BAND_5GHZ, 0}"));
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211n);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("HtMcs7"),
+                                 "ControlMode",
+                                 StringValue("HtMcs0"));
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+    auto manager = DynamicCast<WifiNetDevice>(devices.Get(0))->GetRemoteStationManager();
+
+    Mac48Address remote1("00:00:00:00:00:01");
+    Mac48Address remote2("00:00:00:00:00:02");
+    HtCapabilities htCapabilities;
+    htCapabilities.SetSupportedChannelWidth(1);
+    for (uint8_t mcs = 0; mcs < 8; mcs++)
+    {
+        htCapabilities.SetRxMcsBitmask(mcs);
+    }
+    manager->AddStationHtCapabilities(remote1, htCapabilities);
+    manager->AddStationHtCapabilities(remote2, htCapabilities);
+
+    WifiMacHeader hdr1(WIFI_MAC_QOSDATA);
+    hdr1.SetAddr1(remote1);
+    WifiMacHeader hdr2(WIFI_MAC_QOSDATA);
+    hdr2.SetAddr1(remote2);
+
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        // the second iteration is served by the cache
+        auto txVector = manager->GetDataTxVector(hdr1, 40);
+        NS_TEST_EXPECT_MSG_EQ(txVector.GetMode(), WifiMode("HtMcs7"), "Unexpected mode");
+        NS_TEST_EXPECT_MSG_EQ(txVector.GetChannelWidth(), 40, "Unexpected channel width");
+        NS_TEST_EXPECT_MSG_EQ(manager->GetDataTxVector(hdr1, 20).GetChannelWidth(),
+                              20,
+                              "The allowed width must be honored");
+    }
+
+    // remote1 now only supports 20 MHz channels
+    htCapabilities.SetSupportedChannelWidth(0);
+    manager->AddStationHtCapabilities(remote1, htCapabilities);
+    NS_TEST_EXPECT_MSG_EQ(manager->GetDataTxVector(hdr1, 40).GetChannelWidth(),
+                          20,
+                          "The cached TXVECTOR was not discarded after a capabilities change");
+    NS_TEST_EXPECT_MSG_EQ(manager->GetDataTxVector(hdr2, 40).GetChannelWidth(),
+                          40,
+                          "The capabilities of another station must not be affected");
+
+    manager->SetAttribute("DataMode", StringValue("HtMcs3"));
+    NS_TEST_EXPECT_MSG_EQ(manager->GetDataTxVector(hdr1, 40).GetMode(),
+                          WifiMode("HtMcs3"),
+                          "The cached TXVECTOR was not discarded after a data mode change");
+    NS_TEST_EXPECT_MSG_EQ(manager->GetDataTxVector(hdr2, 40).GetMode(),
+                          WifiMode("HtMcs3"),
+                          "The cached TXVECTOR was not discarded after a data mode change");
+
+    manager->SetDefaultTxPowerLevel(1);
+    NS_TEST_EXPECT_MSG_EQ(+manager->GetDataTxVector(hdr2, 40).GetTxPowerLevel(),
+                          1,
+                          "The cached TXVECTOR was not discarded after a TX power change");
+
+    // the PHY does not notify the manager of the changes of its configuration
+    DynamicCast<WifiNetDevice>(devices.Get(0))->GetPhy()->SetNumberOfAntennas(2);
+    NS_TEST_EXPECT_MSG_EQ(+manager->GetDataTxVector(hdr2, 40).GetNTx(),
+                          2,
+                          "The cached TXVECTOR was not discarded after an antenna change");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -3636,6 +4120,9 @@ WifiTestSuite::WifiTestSuite()
     AddTestCase(new IdealRateManagerChannelWidthTest, TestCase::QUICK);
     AddTestCase(new IdealRateManagerMimoTest, TestCase::QUICK);
     AddTestCase(new HeRuMcsDataRateTestCase, TestCase::QUICK);
+    AddTestCase(new YansWifiChannelMaxRangeTest, TestCase::QUICK);
+    AddTestCase(new ChannelAccessAnalyticBackoffTest, TestCase::QUICK);
+    AddTestCase(new DataTxVectorCacheTest, TestCase::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite